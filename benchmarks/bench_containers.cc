@@ -0,0 +1,158 @@
+//
+// DarwinCore Foundation - 容器与内存组件微基准
+//
+// 覆盖组件：
+//   - SPSCRingQueue：单线程 push/pop、跨线程传递（生产者/消费者绑定不同 CPU）
+//   - MPMCRingQueue：单线程 push/pop、2 生产者 + 2 消费者
+//   - LRUCache：命中读取、写入触发淘汰
+//   - ObjectPool：acquire / 归还
+//   - MemoryPool：小块分配 / 释放（对照 malloc/free）
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <darwincore/foundation/container/LRUCache.h>
+#include <darwincore/foundation/container/ObjectPool.h>
+#include <darwincore/foundation/container/RingQueue.h>
+#include <darwincore/foundation/memory/MemoryAllocator.h>
+
+#include "benchmark.h"
+
+using darwincore::bench::DoNotOptimize;
+using darwincore::bench::PinCurrentThread;
+using darwincore::bench::Runner;
+using namespace darwincore::container;
+
+namespace {
+
+constexpr size_t kQueueCapacity = 4096;
+
+/// 启动 producers 个生产者和 consumers 个消费者线程，传递 ops 个元素
+template <typename Queue>
+void Transfer(Queue& queue, size_t ops, int producers, int consumers) {
+  std::atomic<size_t> consumed{0};
+  std::vector<std::thread> threads;
+  int cpu = 0;
+  for (int p = 0; p < producers; ++p) {
+    size_t count = ops / producers + (p == 0 ? ops % producers : 0);
+    threads.emplace_back([&queue, count, cpu] {
+      PinCurrentThread(cpu);
+      for (size_t i = 0; i < count;) {
+        if (queue.push(i)) {
+          ++i;
+        }
+      }
+    });
+    ++cpu;
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&queue, &consumed, ops, cpu] {
+      PinCurrentThread(cpu);
+      while (consumed.load(std::memory_order_relaxed) < ops) {
+        if (auto value = queue.pop()) {
+          DoNotOptimize(*value);
+          consumed.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+    ++cpu;
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void AddRingQueueBenchmarks(Runner& runner) {
+  auto spsc = std::make_shared<SPSCRingQueue<uint64_t>>(kQueueCapacity);
+  runner.Add("spsc_ring/push_pop", 100000, 0, [spsc](size_t ops) {
+    for (size_t i = 0; i < ops; ++i) {
+      spsc->push(i);
+      DoNotOptimize(spsc->pop());
+    }
+  });
+  runner.Add("spsc_ring/transfer_1p1c", 200000, 0, [spsc](size_t ops) {
+    Transfer(*spsc, ops, 1, 1);
+  });
+
+  auto mpmc = std::make_shared<MPMCRingQueue<uint64_t>>(kQueueCapacity);
+  runner.Add("mpmc_ring/push_pop", 100000, 0, [mpmc](size_t ops) {
+    for (size_t i = 0; i < ops; ++i) {
+      mpmc->push(i);
+      DoNotOptimize(mpmc->pop());
+    }
+  });
+  runner.Add("mpmc_ring/transfer_2p2c", 200000, 0, [mpmc](size_t ops) {
+    Transfer(*mpmc, ops, 2, 2);
+  });
+}
+
+void AddLruBenchmarks(Runner& runner) {
+  constexpr size_t kCapacity = 1024;
+  auto cache = std::make_shared<LRUCache<uint64_t, std::string>>(kCapacity);
+  for (uint64_t key = 0; key < kCapacity; ++key) {
+    cache->put(key, "value-" + std::to_string(key));
+  }
+  runner.Add("lru_cache/get_hit", 100000, 0, [cache](size_t ops) {
+    for (size_t i = 0; i < ops; ++i) {
+      DoNotOptimize(cache->get(i % kCapacity));
+    }
+  });
+
+  auto evicting = std::make_shared<LRUCache<uint64_t, uint64_t>>(kCapacity);
+  auto next_key = std::make_shared<uint64_t>(0);
+  runner.Add("lru_cache/put_evict", 100000, 0, [evicting, next_key](size_t ops) {
+    for (size_t i = 0; i < ops; ++i) {
+      evicting->put((*next_key)++, i);
+    }
+  });
+}
+
+void AddPoolBenchmarks(Runner& runner) {
+  struct Context {
+    uint8_t data[256];
+    size_t used = 0;
+  };
+  auto pool = std::make_shared<ObjectPool<Context>>(
+      64, [] { return std::make_unique<Context>(); }, [](Context& ctx) { ctx.used = 0; });
+  runner.Add("object_pool/acquire_release", 100000, 0, [pool](size_t ops) {
+    for (size_t i = 0; i < ops; ++i) {
+      auto ctx = pool->acquire();
+      DoNotOptimize(ctx.get());
+    }
+  });
+
+  for (size_t size : {16, 64, 128}) {
+    runner.Add("memory_pool/alloc_free/" + std::to_string(size), 100000, 0, [size](size_t ops) {
+      for (size_t i = 0; i < ops; ++i) {
+        void* p = darwincore::memory::MemoryPool::allocate(size);
+        DoNotOptimize(p);
+        darwincore::memory::MemoryPool::deallocate(p, size);
+      }
+    });
+    runner.Add("malloc/alloc_free/" + std::to_string(size), 100000, 0, [size](size_t ops) {
+      for (size_t i = 0; i < ops; ++i) {
+        void* p = std::malloc(size);
+        DoNotOptimize(p);
+        std::free(p);
+      }
+    });
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Runner runner(argc, argv);
+  AddRingQueueBenchmarks(runner);
+  AddLruBenchmarks(runner);
+  AddPoolBenchmarks(runner);
+  return runner.Run();
+}
@@ -0,0 +1,81 @@
+//
+// DarwinCore Foundation - 异步日志微基准
+//
+// 覆盖组件：
+//   - AsyncLogger：调用线程的 log() 开销（单线程、4 线程并发），
+//     后台线程写入空 Sink，只衡量入队与交接成本
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <darwincore/foundation/logger/AsyncLogger.h>
+
+#include "benchmark.h"
+
+using darwincore::bench::Runner;
+using namespace darwincore::log;
+
+namespace {
+
+/// 丢弃所有日志的 Sink，只计数
+class NullSink : public LogSink {
+ public:
+  void write(const LogEntry&) override { written_.fetch_add(1, std::memory_order_relaxed); }
+  void flush() override {}
+
+ private:
+  std::atomic<uint64_t> written_{0};
+};
+
+// 便捷方法 info() 等依赖的 logWithLevel 没有实现，直接构造日志条目
+LogEntry MakeEntry(const std::string& message) {
+  LogEntry entry;
+  entry.level = LogLevel::Info;
+  entry.message = message;
+  return entry;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Runner runner(argc, argv);
+
+  auto logger = std::make_shared<AsyncLogger>(std::make_shared<NullSink>(), 65536);
+  logger->setBlockWhenFull(true);
+  logger->start();
+
+  const std::string message = "connection 42 closed: peer reset, 1024 bytes pending";
+
+  runner.Add("async_logger/log/1_thread", 20000, 0, [logger, message](size_t ops) {
+    for (size_t i = 0; i < ops; ++i) {
+      logger->log(MakeEntry(message));
+    }
+    logger->flush();
+  });
+
+  runner.Add("async_logger/log/4_threads", 20000, 0, [logger, message](size_t ops) {
+    constexpr size_t kThreads = 4;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&, t] {
+        for (size_t i = t; i < ops; i += kThreads) {
+          logger->log(MakeEntry(message));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    logger->flush();
+  });
+
+  int result = runner.Run();
+  logger->stop();
+  return result;
+}
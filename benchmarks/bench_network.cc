@@ -0,0 +1,163 @@
+//
+// DarwinCore Network - 核心组件微基准
+//
+// 覆盖组件：
+//   - SendBuffer：小块写入 + 消费（模拟部分写出后的缓冲路径）
+//   - ConcurrentQueue：单线程入队/出队、跨线程生产者/消费者
+//   - proto::Encoder / proto::Decoder：小消息与 4KB 消息的编解码
+//   - CalculateCRC32：64B / 4KB / 64KB 数据
+//   - NW_LOG_*：未启用级别的开销、启用后调用线程的开销（空回调）
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <darwincore/network/logger.h>
+#include <darwincore/network/protocol.h>
+
+#include "benchmark.h"
+#include "concurrent_queue.h"
+#include "send_buffer.h"
+
+using namespace darwincore::network;
+using darwincore::bench::DoNotOptimize;
+using darwincore::bench::PinCurrentThread;
+using darwincore::bench::Runner;
+
+namespace {
+
+std::vector<uint8_t> MakePayload(size_t size) {
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>(i * 131 + 7);
+  }
+  return data;
+}
+
+void AddSendBufferBenchmarks(Runner& runner) {
+  for (size_t chunk : {64, 1024, 16 * 1024}) {
+    auto buffer = std::make_shared<SendBuffer>();
+    std::vector<uint8_t> data = MakePayload(chunk);
+    runner.Add("send_buffer/write_consume/" + std::to_string(chunk), 10000, chunk,
+               [buffer, data](size_t ops) {
+      for (size_t i = 0; i < ops; ++i) {
+        buffer->Write(data.data(), data.size());
+        // 模拟 socket 每次写出约 64KB
+        if (buffer->Size() >= 64 * 1024) {
+          buffer->Consume(buffer->Size());
+        }
+      }
+      DoNotOptimize(buffer->Size());
+    });
+  }
+}
+
+void AddConcurrentQueueBenchmarks(Runner& runner) {
+  runner.Add("concurrent_queue/enqueue_dequeue", 100000, 0, [](size_t ops) {
+    ConcurrentQueue<uint64_t> queue;
+    uint64_t value = 0;
+    for (size_t i = 0; i < ops; ++i) {
+      queue.Enqueue(i);
+      queue.TryDequeue(value);
+    }
+    DoNotOptimize(value);
+  });
+
+  runner.Add("concurrent_queue/producer_consumer", 100000, 0, [](size_t ops) {
+    ConcurrentQueue<uint64_t> queue(4096);
+    std::thread consumer([&] {
+      PinCurrentThread(1);
+      uint64_t value = 0;
+      for (size_t received = 0; received < ops;) {
+        if (queue.WaitDequeue(value, std::chrono::milliseconds(100))) {
+          ++received;
+        }
+      }
+      DoNotOptimize(value);
+    });
+    for (size_t i = 0; i < ops; ++i) {
+      queue.Enqueue(i);
+    }
+    consumer.join();
+  });
+}
+
+void AddProtocolBenchmarks(Runner& runner) {
+  for (size_t size : {64, 4096}) {
+    std::vector<uint8_t> payload = MakePayload(size);
+
+    runner.Add("proto/encode/" + std::to_string(size), 10000, size, [payload](size_t ops) {
+      for (size_t i = 0; i < ops; ++i) {
+        auto frames = proto::Encoder::EncodeMessage(i, payload.data(), payload.size());
+        auto packets = proto::Encoder::SerializeFrames(frames);
+        DoNotOptimize(packets.data());
+      }
+    });
+
+    // 预先编码一批消息，基准中只测 Feed + GetMessage
+    std::vector<uint8_t> wire;
+    constexpr size_t kMessages = 1000;
+    for (size_t i = 0; i < kMessages; ++i) {
+      auto frames = proto::Encoder::EncodeMessage(i, payload.data(), payload.size());
+      for (const auto& packet : proto::Encoder::SerializeFrames(frames)) {
+        wire.insert(wire.end(), packet.begin(), packet.end());
+      }
+    }
+    runner.Add("proto/decode/" + std::to_string(size), kMessages, size, [wire](size_t ops) {
+      proto::Decoder decoder;
+      proto::MessageComplete message;
+      size_t decoded = 0;
+      decoder.Feed(wire.data(), wire.size());
+      while (decoded < ops && decoder.GetMessage(message)) {
+        ++decoded;
+      }
+      DoNotOptimize(decoded);
+    });
+  }
+}
+
+void AddCrcBenchmarks(Runner& runner) {
+  for (size_t size : {64, 4096, 64 * 1024}) {
+    std::vector<uint8_t> data = MakePayload(size);
+    runner.Add("crc32/" + std::to_string(size), 256 * 1024 / size + 16, size,
+               [data](size_t ops) {
+      for (size_t i = 0; i < ops; ++i) {
+        DoNotOptimize(proto::CalculateCRC32(data.data(), data.size()));
+      }
+    });
+  }
+}
+
+void AddLoggerBenchmarks(Runner& runner) {
+  runner.Add("nw_log/disabled_trace", 1000000, 0, [](size_t ops) {
+    NetworkLogger::Instance().SetLogLevel(LogLevel::kInfo);
+    for (size_t i = 0; i < ops; ++i) {
+      NW_LOG_TRACE("[Reactor0] 读事件 conn_id=" << i << " bytes=" << 1024);
+    }
+  });
+
+  runner.Add("nw_log/enabled_info", 20000, 0, [](size_t ops) {
+    NetworkLogger::Instance().SetLogCallback([](LogLevel, const std::string&, const char*, int) {});
+    NetworkLogger::Instance().SetLogLevel(LogLevel::kInfo);
+    for (size_t i = 0; i < ops; ++i) {
+      NW_LOG_INFO("[Reactor0] 新连接 conn_id=" << i);
+    }
+    NetworkLogger::Instance().Flush();
+  });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Runner runner(argc, argv);
+  AddSendBufferBenchmarks(runner);
+  AddConcurrentQueueBenchmarks(runner);
+  AddProtocolBenchmarks(runner);
+  AddCrcBenchmarks(runner);
+  AddLoggerBenchmarks(runner);
+  return runner.Run();
+}
@@ -0,0 +1,300 @@
+//
+// DarwinCore - 微基准测试框架
+//
+// 功能说明：
+//   无第三方依赖的轻量基准测试框架，供 benchmarks/ 下各组件基准使用。
+//   - 预热：正式采样前先运行若干轮，让缓存、分支预测器和内存池进入稳态
+//   - 采样：每个样本运行 ops_per_sample 次操作，统计每次操作耗时（ns/op）
+//   - 输出：平均值、最小/最大值、p50/p90/p99、ops/s、MB/s，文本或 JSON
+//   - 绑核：--cpu=N 将主线程绑定到指定 CPU；多线程基准可调用 PinCurrentThread
+//
+// 命令行参数：
+//   --filter=<子串>    只运行名称包含该子串的基准
+//   --samples=<N>      采样次数（默认 30）
+//   --warmup=<N>       预热样本数（默认 3）
+//   --cpu=<N>          主线程绑定的 CPU 编号（默认不绑定）
+//   --json[=<文件>]    以 JSON 输出结果（不指定文件时输出到 stdout）
+//
+// 使用示例：
+//   int main(int argc, char** argv) {
+//     darwincore::bench::Runner runner(argc, argv);
+//     runner.Add("crc32/4k", 1000, 4096, [&](size_t ops) {
+//       for (size_t i = 0; i < ops; ++i) {
+//         darwincore::bench::DoNotOptimize(CalculateCRC32(data, 4096));
+//       }
+//     });
+//     return runner.Run();
+//   }
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_BENCHMARKS_BENCHMARK_H
+#define DARWINCORE_BENCHMARKS_BENCHMARK_H
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#include <mach/thread_policy.h>
+#endif
+
+namespace darwincore {
+namespace bench {
+
+/// 阻止编译器把基准中的计算结果当作死代码消除
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// 强制编译器认为内存已被修改
+inline void ClobberMemory() { asm volatile("" : : : "memory"); }
+
+/**
+ * @brief 将当前线程绑定到指定 CPU
+ *
+ * Linux 使用 pthread_setaffinity_np 严格绑定；macOS 不支持硬绑定，
+ * 使用 THREAD_AFFINITY_POLICY 为线程设置亲和性标签（同标签的线程
+ * 尽量共享 L2，不同标签的线程尽量分开），属于调度提示。
+ *
+ * @return 绑定（或设置提示）成功返回 true
+ */
+inline bool PinCurrentThread(int cpu) {
+  if (cpu < 0) {
+    return false;
+  }
+#if defined(__APPLE__)
+  thread_affinity_policy_data_t policy = {cpu + 1};  // 0 表示无亲和性
+  kern_return_t result = thread_policy_set(pthread_mach_thread_np(pthread_self()),
+                                           THREAD_AFFINITY_POLICY,
+                                           reinterpret_cast<thread_policy_t>(&policy),
+                                           THREAD_AFFINITY_POLICY_COUNT);
+  return result == KERN_SUCCESS;
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(static_cast<unsigned>(cpu) % std::max(1u, std::thread::hardware_concurrency()), &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+/// 单个基准的统计结果（单位：纳秒/操作）
+struct Result {
+  std::string name;
+  size_t samples = 0;
+  size_t ops_per_sample = 0;
+  size_t bytes_per_op = 0;
+  double mean_ns = 0;
+  double min_ns = 0;
+  double max_ns = 0;
+  double p50_ns = 0;
+  double p90_ns = 0;
+  double p99_ns = 0;
+  double ops_per_second = 0;
+  double mb_per_second = 0;  ///< bytes_per_op 为 0 时不输出
+};
+
+class Runner {
+ public:
+  /// 基准主体：执行 ops 次被测操作
+  using Body = std::function<void(size_t ops)>;
+
+  Runner(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (ParseFlag(arg, "--filter=", &filter_) ||
+          ParseNumber(arg, "--samples=", &samples_) ||
+          ParseNumber(arg, "--warmup=", &warmup_)) {
+        continue;
+      }
+      size_t cpu = 0;
+      if (ParseNumber(arg, "--cpu=", &cpu)) {
+        cpu_ = static_cast<int>(cpu);
+      } else if (arg == "--json") {
+        json_ = true;
+      } else if (ParseFlag(arg, "--json=", &json_path_)) {
+        json_ = true;
+      } else {
+        std::cerr << "未知参数: " << arg << std::endl;
+      }
+    }
+    samples_ = std::max<size_t>(samples_, 1);
+  }
+
+  /**
+   * @brief 注册基准
+   * @param name 名称（建议 "组件/场景"）
+   * @param ops_per_sample 每个样本执行的操作数
+   * @param bytes_per_op 每次操作处理的字节数（用于计算 MB/s，可为 0）
+   * @param body 基准主体
+   */
+  void Add(std::string name, size_t ops_per_sample, size_t bytes_per_op, Body body) {
+    cases_.push_back({std::move(name), std::max<size_t>(ops_per_sample, 1), bytes_per_op,
+                      std::move(body)});
+  }
+
+  /// 运行所有匹配的基准并输出结果，返回进程退出码
+  int Run() {
+    if (cpu_ >= 0 && !PinCurrentThread(cpu_)) {
+      std::cerr << "绑定 CPU " << cpu_ << " 失败，继续运行" << std::endl;
+    }
+
+    std::vector<Result> results;
+    for (const Case& c : cases_) {
+      if (!filter_.empty() && c.name.find(filter_) == std::string::npos) {
+        continue;
+      }
+      results.push_back(Measure(c));
+      if (!json_ || !json_path_.empty()) {
+        PrintText(results.back());
+      }
+    }
+
+    if (json_) {
+      std::string json = ToJson(results);
+      if (json_path_.empty()) {
+        std::cout << json;
+      } else {
+        std::ofstream out(json_path_);
+        if (!out) {
+          std::cerr << "无法写入 " << json_path_ << std::endl;
+          return 1;
+        }
+        out << json;
+      }
+    }
+    return 0;
+  }
+
+ private:
+  struct Case {
+    std::string name;
+    size_t ops_per_sample;
+    size_t bytes_per_op;
+    Body body;
+  };
+
+  Result Measure(const Case& c) const {
+    for (size_t i = 0; i < warmup_; ++i) {
+      c.body(c.ops_per_sample);
+    }
+
+    std::vector<double> per_op(samples_);
+    double total_ns = 0;
+    for (size_t i = 0; i < samples_; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      c.body(c.ops_per_sample);
+      ClobberMemory();
+      auto elapsed = std::chrono::duration<double, std::nano>(
+                         std::chrono::steady_clock::now() - start).count();
+      total_ns += elapsed;
+      per_op[i] = elapsed / static_cast<double>(c.ops_per_sample);
+    }
+
+    Result result;
+    result.name = c.name;
+    result.samples = samples_;
+    result.ops_per_sample = c.ops_per_sample;
+    result.bytes_per_op = c.bytes_per_op;
+
+    std::sort(per_op.begin(), per_op.end());
+    double total_ops = static_cast<double>(c.ops_per_sample) * samples_;
+    result.mean_ns = total_ns / total_ops;
+    result.min_ns = per_op.front();
+    result.max_ns = per_op.back();
+    result.p50_ns = Percentile(per_op, 0.50);
+    result.p90_ns = Percentile(per_op, 0.90);
+    result.p99_ns = Percentile(per_op, 0.99);
+    result.ops_per_second = total_ns > 0 ? total_ops * 1e9 / total_ns : 0;
+    result.mb_per_second = result.ops_per_second * c.bytes_per_op / (1024.0 * 1024.0);
+    return result;
+  }
+
+  /// 已排序样本的最近秩百分位数
+  static double Percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+  }
+
+  static void PrintText(const Result& r) {
+    char line[256];
+    std::snprintf(line, sizeof(line),
+                  "%-36s %10.1f ns/op  p50 %9.1f  p90 %9.1f  p99 %9.1f  %12.0f ops/s",
+                  r.name.c_str(), r.mean_ns, r.p50_ns, r.p90_ns, r.p99_ns, r.ops_per_second);
+    std::cout << line;
+    if (r.bytes_per_op > 0) {
+      std::snprintf(line, sizeof(line), "  %9.1f MB/s", r.mb_per_second);
+      std::cout << line;
+    }
+    std::cout << std::endl;
+  }
+
+  static std::string ToJson(const std::vector<Result>& results) {
+    std::ostringstream out;
+    out << "{\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+      const Result& r = results[i];
+      out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << r.name << "\""
+          << ", \"samples\": " << r.samples << ", \"ops_per_sample\": " << r.ops_per_sample
+          << ", \"ns_per_op\": " << r.mean_ns << ", \"min_ns\": " << r.min_ns
+          << ", \"max_ns\": " << r.max_ns << ", \"p50_ns\": " << r.p50_ns
+          << ", \"p90_ns\": " << r.p90_ns << ", \"p99_ns\": " << r.p99_ns
+          << ", \"ops_per_second\": " << r.ops_per_second;
+      if (r.bytes_per_op > 0) {
+        out << ", \"bytes_per_op\": " << r.bytes_per_op
+            << ", \"mb_per_second\": " << r.mb_per_second;
+      }
+      out << "}";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+  }
+
+  static bool ParseFlag(const std::string& arg, const char* prefix, std::string* value) {
+    size_t length = std::strlen(prefix);
+    if (arg.compare(0, length, prefix) != 0) {
+      return false;
+    }
+    *value = arg.substr(length);
+    return true;
+  }
+
+  static bool ParseNumber(const std::string& arg, const char* prefix, size_t* value) {
+    std::string text;
+    if (!ParseFlag(arg, prefix, &text)) {
+      return false;
+    }
+    *value = static_cast<size_t>(std::strtoull(text.c_str(), nullptr, 10));
+    return true;
+  }
+
+  std::vector<Case> cases_;
+  std::string filter_;
+  std::string json_path_;
+  size_t samples_ = 30;
+  size_t warmup_ = 3;
+  int cpu_ = -1;
+  bool json_ = false;
+};
+
+}  // namespace bench
+}  // namespace darwincore
+
+#endif  // DARWINCORE_BENCHMARKS_BENCHMARK_H
@@ -0,0 +1,626 @@
+//
+// DarwinCore Network - 回环负载生成与延迟测量工具
+//
+// 功能说明：
+//   在同一进程内启动 Server，并通过回环 TCP 或 Unix Domain Socket 建立
+//   多个 Client 连接施加负载，输出延迟分布（HDR 风格直方图）、吞吐量
+//   和每连接内存占用，用于发现性能回退和容量规划。
+//
+// 负载模式（--mode）：
+//   echo      服务端原样回显收到的字节（不解析帧），衡量纯传输路径
+//   pingpong  每连接同时只有 1 个请求在途，响应与请求等长
+//   rpc       请求/响应，响应大小由 --response-size 指定
+//   stream    客户端持续推送大块数据，服务端对每条消息回复仅含帧头的确认
+//
+// 到达模型：
+//   闭环（--rate=0，默认）：每连接保持 --depth 个在途请求，收到响应后立即补发
+//   开环（--rate=N）：按总速率 N 条/秒均匀调度发送，与响应无关；
+//                    延迟从计划发送时刻算起（修正协调遗漏）
+//
+// 命令行参数：
+//   --transport=tcp|uds  --mode=echo|pingpong|rpc|stream
+//   --connections=N      连接数（默认 16）
+//   --size=N             请求负载字节数（默认 64，stream 默认 65536）
+//   --response-size=N    rpc 模式响应负载字节数（默认 1024）
+//   --depth=N            闭环模式每连接在途请求数（默认 1）
+//   --rate=N             开环模式总发送速率（条/秒，默认 0 = 闭环）
+//   --duration=N         测量时长（秒，默认 5）
+//   --warmup=N           预热时长（秒，默认 1，不计入统计）
+//   --client-loops=N     客户端事件循环线程数（默认 2）
+//   --json               以 JSON 输出结果
+//
+// 示例：
+//   loadgen --mode=rpc --connections=64 --depth=4 --size=128 --response-size=4096
+//   loadgen --transport=uds --mode=pingpong --rate=20000 --duration=10 --json
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/client_loop_group.h>
+#include <darwincore/network/server.h>
+
+using namespace darwincore::network;
+
+namespace {
+
+constexpr uint16_t kPort = 9990;
+constexpr const char* kSocketPath = "/tmp/darwincore_loadgen.sock";
+
+// ==================== 配置 ====================
+
+enum class Mode { kEcho, kPingPong, kRpc, kStream };
+
+struct Config {
+  bool unix_domain = false;
+  Mode mode = Mode::kEcho;
+  std::string mode_name = "echo";
+  size_t connections = 16;
+  size_t size = 0;  // 0 = 按模式取默认值
+  size_t response_size = 1024;
+  size_t depth = 1;
+  uint64_t rate = 0;
+  double duration = 5;
+  double warmup = 1;
+  size_t client_loops = 2;
+  bool json = false;
+};
+
+bool ParseArgs(int argc, char** argv, Config* config) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    size_t eq = arg.find('=');
+    std::string key = arg.substr(0, eq);
+    std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+    uint64_t number = std::strtoull(value.c_str(), nullptr, 10);
+
+    if (key == "--transport") {
+      config->unix_domain = value == "uds";
+    } else if (key == "--mode") {
+      config->mode_name = value;
+      if (value == "echo") {
+        config->mode = Mode::kEcho;
+      } else if (value == "pingpong") {
+        config->mode = Mode::kPingPong;
+      } else if (value == "rpc") {
+        config->mode = Mode::kRpc;
+      } else if (value == "stream") {
+        config->mode = Mode::kStream;
+      } else {
+        std::cerr << "未知模式: " << value << std::endl;
+        return false;
+      }
+    } else if (key == "--connections") {
+      config->connections = std::max<uint64_t>(number, 1);
+    } else if (key == "--size") {
+      config->size = number;
+    } else if (key == "--response-size") {
+      config->response_size = number;
+    } else if (key == "--depth") {
+      config->depth = std::max<uint64_t>(number, 1);
+    } else if (key == "--rate") {
+      config->rate = number;
+    } else if (key == "--duration") {
+      config->duration = std::strtod(value.c_str(), nullptr);
+    } else if (key == "--warmup") {
+      config->warmup = std::strtod(value.c_str(), nullptr);
+    } else if (key == "--client-loops") {
+      config->client_loops = std::max<uint64_t>(number, 1);
+    } else if (key == "--json") {
+      config->json = true;
+    } else {
+      std::cerr << "未知参数: " << arg << std::endl;
+      return false;
+    }
+  }
+
+  if (config->size == 0) {
+    config->size = config->mode == Mode::kStream ? 64 * 1024 : 64;
+  }
+  if (config->mode == Mode::kPingPong) {
+    config->depth = 1;
+  }
+  return true;
+}
+
+// ==================== 延迟直方图 ====================
+
+/**
+ * @brief HDR 风格的对数-线性直方图（纳秒）
+ *
+ * 每个 2 的幂区间分为 64 个子桶，相对误差 < 1.6%；小于 128ns 的值精确记录。
+ * 上限约 18 分钟（2^40 ns），超出部分记入最后一个桶，最大值单独精确记录。
+ */
+class LatencyHistogram {
+ public:
+  LatencyHistogram() : counts_(kBucketCount, 0) {}
+
+  void Record(uint64_t ns) {
+    ++counts_[IndexOf(ns)];
+    ++total_;
+    max_ = std::max(max_, ns);
+  }
+
+  void Merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBucketCount; ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    total_ += other.total_;
+    max_ = std::max(max_, other.max_);
+  }
+
+  /// 返回百分位对应的桶上界（与 HdrHistogram 的 highest equivalent value 一致）
+  uint64_t Percentile(double p) const {
+    if (total_ == 0) {
+      return 0;
+    }
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(p * total_ + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+      seen += counts_[i];
+      if (seen >= target) {
+        return std::min(UpperBoundOf(i), max_);
+      }
+    }
+    return max_;
+  }
+
+  uint64_t Count() const { return total_; }
+  uint64_t Max() const { return max_; }
+
+ private:
+  static constexpr int kSubBucketBits = 7;
+  static constexpr uint64_t kSubBucketHalf = 1ULL << (kSubBucketBits - 1);
+  static constexpr int kMaxShift = 40 - kSubBucketBits;
+  static constexpr size_t kBucketCount = (kMaxShift + 2) * kSubBucketHalf;
+
+  static size_t IndexOf(uint64_t value) {
+    if (value < 2 * kSubBucketHalf) {
+      return static_cast<size_t>(value);
+    }
+    int msb = 63 - __builtin_clzll(value);
+    int shift = std::min(msb - (kSubBucketBits - 1), kMaxShift);
+    uint64_t sub = std::min<uint64_t>(value >> shift, 2 * kSubBucketHalf - 1);
+    return static_cast<size_t>(shift * kSubBucketHalf + sub);
+  }
+
+  static uint64_t UpperBoundOf(size_t index) {
+    if (index < 2 * kSubBucketHalf) {
+      return index;
+    }
+    int shift = static_cast<int>(index / kSubBucketHalf) - 1;
+    uint64_t sub = index - shift * kSubBucketHalf;
+    return ((sub + 1) << shift) - 1;
+  }
+
+  std::vector<uint64_t> counts_;
+  uint64_t total_ = 0;
+  uint64_t max_ = 0;
+};
+
+/// 每个回调线程一个直方图，记录时无锁；测量结束、客户端停止后再合并
+class HistogramRegistry {
+ public:
+  LatencyHistogram& Local() {
+    thread_local LatencyHistogram* local = nullptr;
+    if (local == nullptr) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      histograms_.push_back(std::make_unique<LatencyHistogram>());
+      local = histograms_.back().get();
+    }
+    return *local;
+  }
+
+  LatencyHistogram Merge() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LatencyHistogram merged;
+    for (const auto& histogram : histograms_) {
+      merged.Merge(*histogram);
+    }
+    return merged;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<LatencyHistogram>> histograms_;
+};
+
+// ==================== 帧格式 ====================
+
+/// 请求与响应共用的帧头；echo 模式下服务端原样回显，帧头自然随之返回
+struct FrameHeader {
+  uint32_t length;         ///< 帧头之后的负载长度
+  uint32_t response_size;  ///< 期望的响应负载长度（服务端使用）
+  uint64_t timestamp_ns;   ///< 客户端（计划）发送时刻
+};
+
+uint64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/// 进程常驻内存（字节）
+size_t ResidentBytes() {
+#if defined(__APPLE__)
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+    return info.resident_size;
+  }
+  return 0;
+#else
+  std::ifstream statm("/proc/self/statm");
+  size_t pages = 0;
+  size_t resident = 0;
+  statm >> pages >> resident;
+  return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// ==================== 服务端 ====================
+
+/// 按帧解析请求并生成响应；同一连接的回调由同一 Worker 串行执行
+class LoadServer {
+ public:
+  LoadServer(const Config& config, Server& server) : config_(config), server_(server) {}
+
+  void OnMessage(uint64_t conn_id, const std::vector<uint8_t>& data) {
+    if (config_.mode == Mode::kEcho) {
+      server_.SendData(conn_id, data.data(), data.size());
+      return;
+    }
+
+    Shard& shard = shards_[conn_id % kShards];
+    std::vector<uint8_t>* pending;
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      pending = &shard.buffers[conn_id];
+    }
+
+    pending->insert(pending->end(), data.begin(), data.end());
+    std::vector<uint8_t> responses;
+    size_t offset = 0;
+    while (pending->size() - offset >= sizeof(FrameHeader)) {
+      FrameHeader header;
+      std::memcpy(&header, pending->data() + offset, sizeof(header));
+      if (pending->size() - offset < sizeof(header) + header.length) {
+        break;
+      }
+      offset += sizeof(header) + header.length;
+
+      FrameHeader response = header;
+      response.length = header.response_size;
+      const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&response);
+      responses.insert(responses.end(), bytes, bytes + sizeof(response));
+      responses.resize(responses.size() + response.length, 'r');
+    }
+    pending->erase(pending->begin(), pending->begin() + offset);
+
+    if (!responses.empty()) {
+      server_.SendData(conn_id, responses.data(), responses.size());
+    }
+  }
+
+  void OnDisconnected(uint64_t conn_id) {
+    Shard& shard = shards_[conn_id % kShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.buffers.erase(conn_id);
+  }
+
+ private:
+  static constexpr size_t kShards = 64;
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<uint64_t, std::vector<uint8_t>> buffers;
+  };
+
+  const Config& config_;
+  Server& server_;
+  Shard shards_[kShards];
+};
+
+// ==================== 客户端 ====================
+
+struct Shared {
+  const Config* config = nullptr;
+  HistogramRegistry histograms;
+  std::atomic<bool> recording{false};
+  std::atomic<bool> stopping{false};
+  std::atomic<uint64_t> send_failures{0};
+  std::vector<uint8_t> payload;
+};
+
+class LoadConnection {
+ public:
+  explicit LoadConnection(Shared& shared, std::shared_ptr<ClientLoopGroup> group)
+      : shared_(shared), client_(group) {
+    client_.SetOnMessage([this](const std::vector<uint8_t>& data) { OnMessage(data); });
+  }
+
+  bool Connect() {
+    if (shared_.config->unix_domain) {
+      return client_.ConnectUnixDomain(kSocketPath);
+    }
+    return client_.ConnectIPv4("127.0.0.1", kPort);
+  }
+
+  bool IsConnected() const { return client_.IsConnected(); }
+
+  void Disconnect() { client_.Disconnect(); }
+
+  /// 发送一个请求，timestamp_ns 为（计划）发送时刻
+  void SendRequest(uint64_t timestamp_ns) {
+    const Config& config = *shared_.config;
+    FrameHeader header{static_cast<uint32_t>(config.size),
+                       static_cast<uint32_t>(ResponsePayloadSize()), timestamp_ns};
+    // 帧头与负载拼成一次发送，避免拆成两个小报文；使用异步发送，
+    // 开环调度线程和闭环回调线程都不等待数据写出
+    std::vector<uint8_t> frame(sizeof(header) + config.size);
+    std::memcpy(frame.data(), &header, sizeof(header));
+    std::memcpy(frame.data() + sizeof(header), shared_.payload.data(), config.size);
+    if (!client_.SendAsync(frame.data(), frame.size(), nullptr)) {
+      shared_.send_failures.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /// 闭环模式：发出初始的 depth 个请求
+  void Prime() {
+    for (size_t i = 0; i < shared_.config->depth; ++i) {
+      SendRequest(NowNs());
+    }
+  }
+
+ private:
+  size_t ResponsePayloadSize() const {
+    const Config& config = *shared_.config;
+    switch (config.mode) {
+      case Mode::kRpc:
+        return config.response_size;
+      case Mode::kStream:
+        return 0;
+      default:
+        return config.size;
+    }
+  }
+
+  void OnMessage(const std::vector<uint8_t>& data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.insert(pending_.end(), data.begin(), data.end());
+
+    size_t offset = 0;
+    size_t completed = 0;
+    uint64_t now = NowNs();
+    bool recording = shared_.recording.load(std::memory_order_relaxed);
+    while (pending_.size() - offset >= sizeof(FrameHeader)) {
+      FrameHeader header;
+      std::memcpy(&header, pending_.data() + offset, sizeof(header));
+      if (pending_.size() - offset < sizeof(header) + header.length) {
+        break;
+      }
+      offset += sizeof(header) + header.length;
+      ++completed;
+      if (recording) {
+        shared_.histograms.Local().Record(now > header.timestamp_ns ? now - header.timestamp_ns : 0);
+      }
+    }
+    pending_.erase(pending_.begin(), pending_.begin() + offset);
+
+    if (shared_.config->rate == 0 && !shared_.stopping.load(std::memory_order_relaxed)) {
+      for (size_t i = 0; i < completed; ++i) {
+        SendRequest(NowNs());
+      }
+    }
+  }
+
+  Shared& shared_;
+  Client client_;
+  std::mutex mutex_;
+  std::vector<uint8_t> pending_;
+};
+
+/// 开环模式：按总速率均匀调度所有连接的发送
+void RunOpenLoop(std::vector<std::unique_ptr<LoadConnection>>& connections, const Config& config,
+                 const std::atomic<bool>& stopping) {
+  const double interval_ns = 1e9 / static_cast<double>(config.rate);
+  const uint64_t start = NowNs();
+  uint64_t sent = 0;
+  while (!stopping.load(std::memory_order_relaxed)) {
+    uint64_t now = NowNs();
+    // 补发所有已到计划时刻的请求，计划时刻作为时间戳
+    while (start + static_cast<uint64_t>(sent * interval_ns) <= now) {
+      uint64_t scheduled = start + static_cast<uint64_t>(sent * interval_ns);
+      connections[sent % connections.size()]->SendRequest(scheduled);
+      ++sent;
+    }
+    uint64_t next = start + static_cast<uint64_t>(sent * interval_ns);
+    if (next > now + 50000) {
+      std::this_thread::sleep_for(std::chrono::nanoseconds(next - now - 50000));
+    }
+  }
+}
+
+// ==================== 报告 ====================
+
+struct Report {
+  uint64_t messages = 0;
+  double seconds = 0;
+  LatencyHistogram histogram;
+  size_t rss_idle_per_connection = 0;
+  size_t rss_loaded = 0;
+  uint64_t send_failures = 0;
+  ServerStatistics server_stats;
+};
+
+void PrintReport(const Config& config, const Report& report, size_t response_size) {
+  double rate = report.seconds > 0 ? report.messages / report.seconds : 0;
+  double bytes_per_message = 2.0 * sizeof(FrameHeader) + config.size + response_size;
+  double mb_per_second = rate * bytes_per_message / (1024.0 * 1024.0);
+  auto us = [&](double p) { return report.histogram.Percentile(p) / 1000.0; };
+
+  if (config.json) {
+    std::cout << "{\"transport\": \"" << (config.unix_domain ? "uds" : "tcp") << "\""
+              << ", \"mode\": \"" << config.mode_name << "\""
+              << ", \"connections\": " << config.connections << ", \"size\": " << config.size
+              << ", \"response_size\": " << response_size << ", \"depth\": " << config.depth
+              << ", \"rate\": " << config.rate << ", \"seconds\": " << report.seconds
+              << ", \"messages\": " << report.messages << ", \"messages_per_second\": " << rate
+              << ", \"mb_per_second\": " << mb_per_second << ", \"p50_us\": " << us(0.50)
+              << ", \"p90_us\": " << us(0.90) << ", \"p99_us\": " << us(0.99)
+              << ", \"p999_us\": " << us(0.999)
+              << ", \"max_us\": " << report.histogram.Max() / 1000.0
+              << ", \"rss_per_connection\": " << report.rss_idle_per_connection
+              << ", \"rss_loaded\": " << report.rss_loaded
+              << ", \"send_failures\": " << report.send_failures
+              << ", \"server_bytes_received\": " << report.server_stats.total_bytes_received
+              << ", \"server_bytes_sent\": " << report.server_stats.total_bytes_sent << "}"
+              << std::endl;
+    return;
+  }
+
+  char line[256];
+  std::cout << "========================================" << std::endl;
+  std::snprintf(line, sizeof(line), "%s / %s  连接 %zu  请求 %zuB  响应 %zuB  %s",
+                config.unix_domain ? "uds" : "tcp", config.mode_name.c_str(), config.connections,
+                config.size, response_size,
+                config.rate > 0 ? ("开环 " + std::to_string(config.rate) + "/s").c_str()
+                                : ("闭环 depth=" + std::to_string(config.depth)).c_str());
+  std::cout << line << std::endl;
+  std::cout << "----------------------------------------" << std::endl;
+  std::snprintf(line, sizeof(line), "吞吐量:   %.0f msg/s  %.1f MB/s（%llu 条 / %.1fs）", rate,
+                mb_per_second, static_cast<unsigned long long>(report.messages), report.seconds);
+  std::cout << line << std::endl;
+  std::snprintf(line, sizeof(line), "延迟(us): p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f",
+                us(0.50), us(0.90), us(0.99), us(0.999), report.histogram.Max() / 1000.0);
+  std::cout << line << std::endl;
+  std::snprintf(line, sizeof(line), "内存:     空闲每连接 %.1f KB（含两端）  负载时 RSS %.1f MB",
+                report.rss_idle_per_connection / 1024.0, report.rss_loaded / (1024.0 * 1024.0));
+  std::cout << line << std::endl;
+  if (report.send_failures > 0) {
+    std::cout << "发送失败: " << report.send_failures << std::endl;
+  }
+  std::cout << "========================================" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  signal(SIGPIPE, SIG_IGN);
+
+  Config config;
+  if (!ParseArgs(argc, argv, &config)) {
+    return 2;
+  }
+
+  Server server;
+  LoadServer handler(config, server);
+  server.SetOnMessage([&](uint64_t conn_id, const std::vector<uint8_t>& data) {
+    handler.OnMessage(conn_id, data);
+  });
+  server.SetOnClientDisconnected([&](uint64_t conn_id) { handler.OnDisconnected(conn_id); });
+
+  bool started = false;
+  if (config.unix_domain) {
+    unlink(kSocketPath);
+    started = server.StartUnixDomain(kSocketPath);
+  } else {
+    started = server.StartIPv4("127.0.0.1", kPort);
+  }
+  if (!started) {
+    std::cerr << "服务端启动失败" << std::endl;
+    return 1;
+  }
+
+  Shared shared;
+  shared.config = &config;
+  shared.payload.assign(config.size, 'q');
+
+  auto group = std::make_shared<ClientLoopGroup>(config.client_loops);
+  size_t rss_before = ResidentBytes();
+  std::vector<std::unique_ptr<LoadConnection>> connections;
+  for (size_t i = 0; i < config.connections; ++i) {
+    auto connection = std::make_unique<LoadConnection>(shared, group);
+    if (!connection->Connect()) {
+      std::cerr << "第 " << i << " 个连接失败" << std::endl;
+      return 1;
+    }
+    connections.push_back(std::move(connection));
+  }
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (server.GetStatistics().active_connections < config.connections &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  Report report;
+  report.rss_idle_per_connection =
+      (ResidentBytes() - std::min(rss_before, ResidentBytes())) / config.connections;
+
+  std::thread pacer;
+  if (config.rate > 0) {
+    pacer = std::thread([&] { RunOpenLoop(connections, config, shared.stopping); });
+  } else {
+    for (auto& connection : connections) {
+      connection->Prime();
+    }
+  }
+
+  std::this_thread::sleep_for(std::chrono::duration<double>(config.warmup));
+  shared.recording.store(true);
+  auto measure_start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::duration<double>(config.duration));
+  shared.recording.store(false);
+  report.seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - measure_start).count();
+
+  shared.stopping.store(true);
+  if (pacer.joinable()) {
+    pacer.join();
+  }
+  report.rss_loaded = ResidentBytes();
+  report.server_stats = server.GetStatistics();
+
+  for (auto& connection : connections) {
+    connection->Disconnect();
+  }
+  group->Stop();
+  server.Stop();
+  if (config.unix_domain) {
+    unlink(kSocketPath);
+  }
+
+  report.histogram = shared.histograms.Merge();
+  report.messages = report.histogram.Count();
+  report.send_failures = shared.send_failures.load();
+
+  size_t response_size = config.mode == Mode::kRpc      ? config.response_size
+                         : config.mode == Mode::kStream ? 0
+                                                        : config.size;
+  PrintReport(config, report, response_size);
+  return 0;
+}
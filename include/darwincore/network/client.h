@@ -47,6 +47,7 @@
 #include <memory>
 #include <string>
 
+#include <darwincore/network/client_loop_group.h>
 #include <darwincore/network/event.h>
 
 namespace darwincore
@@ -68,6 +69,8 @@ namespace darwincore
      * 线程模型：
      * - 1 个 Reactor 线程：负责 I/O 操作
      * - 1 个 Worker 线程：负责业务逻辑和回调处理
+     * - 使用 EventLoopGroup 构造时不创建任何线程，连接复用组内的
+     *   Reactor/Worker 线程（适合持有大量出站连接、或与 Server 共享线程的场景）
      *
      * 注意事项：
      * - Client 一次只能保持一个连接
@@ -93,6 +96,9 @@ namespace darwincore
       using OnErrorCallback = std::function<void(NetworkError error,
                                                  const std::string &message)>;
 
+      /// 共享内存通道默认的单向环容量（1MB）
+      static constexpr size_t kDefaultSharedMemoryRingSize = 1024 * 1024;
+
       /**
        * @brief 构造 Client 对象
        *
@@ -100,6 +106,15 @@ namespace darwincore
        */
       Client();
 
+      /**
+       * @brief 构造挂在共享事件循环组上的 Client
+       * @param loop_group 共享事件循环组（nullptr 等价于默认构造）
+       *
+       * 连接的 I/O 和回调由 loop_group 的线程负责，Client 本身不创建线程。
+       * 其余 API 和回调语义与默认构造的 Client 相同。
+       */
+      explicit Client(std::shared_ptr<EventLoopGroup> loop_group);
+
       /**
        * @brief 析构函数
        *
@@ -143,6 +158,25 @@ namespace darwincore
        */
       bool ConnectUnixDomain(const std::string &path);
 
+      /**
+       * @brief 开启同机共享内存快速通道（在 ConnectUnixDomain 之前调用）
+       * @param enabled 是否开启
+       * @param ring_size 每个方向的环容量（向上取整为 2 的幂，最小 64KB）
+       *
+       * 开启后，ConnectUnixDomain 建立连接时立即发送升级握手（通过
+       * SCM_RIGHTS 传递共享内存和门铃 fd），服务端确认后双向数据经共享内存环
+       * 传递，不再经过内核 socket 缓冲区；确认之前的数据仍经 socket 发送。
+       * 回调与发送接口的语义不变。
+       *
+       * 注意：
+       * - 服务端必须以 ServerOptions::shared_memory_transport 启动；未开启时
+       *   握手会被当作普通数据交给服务端，之后的数据继续经 socket 发送
+       * - 创建共享内存失败时自动退回普通 socket
+       * - 对 IPv4/IPv6 连接无效
+       */
+      void SetSharedMemoryTransport(bool enabled,
+                                    size_t ring_size = kDefaultSharedMemoryRingSize);
+
       /**
        * @brief 优雅关闭连接（等待发送缓冲区清空）
        * @param timeout_ms 超时时间（毫秒），0表示无限等待
@@ -232,6 +266,19 @@ namespace darwincore
        */
       size_t GetSendBufferSize() const;
 
+      // ==================== 线程任务 ====================
+
+      /**
+       * @brief 在执行本客户端回调的 Worker 线程中执行任务
+       * @param task 要执行的任务
+       * @return 已入队返回 true；未连接或 Worker 队列满返回 false（任务被丢弃）
+       *
+       * 任务与连接的网络事件进入同一个 Worker 队列，与 OnMessage、OnDisconnected
+       * 串行执行，适合把其他线程（如定时器线程）的结果交回回调线程处理。
+       * 此方法可以从任何线程调用，不会阻塞。
+       */
+      bool Post(std::function<void()> task);
+
       // ==================== 状态查询 ====================
 
       /**
@@ -0,0 +1,28 @@
+//
+// DarwinCore Network 模块
+// 客户端共享事件循环组（兼容头文件）
+//
+// 功能说明：
+//   ClientLoopGroup 已推广为 EventLoopGroup，可同时被 Server 和 Client 共享。
+//   保留此头文件和类型别名，已有代码无需修改。
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_NETWORK_CLIENT_LOOP_GROUP_H
+#define DARWINCORE_NETWORK_CLIENT_LOOP_GROUP_H
+
+#include <darwincore/network/event_loop_group.h>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    /// 兼容旧名称，见 EventLoopGroup
+    using ClientLoopGroup = EventLoopGroup;
+
+  } // namespace network
+} // namespace darwincore
+
+#endif // DARWINCORE_NETWORK_CLIENT_LOOP_GROUP_H
@@ -46,6 +46,40 @@ inline const char* ToString(SocketProtocol proto)
     }
 }
 
+/**
+ * @brief 令牌桶限速配置（字节数与消息数各一个桶）
+ *
+ * 速率为 0 表示不限制该项；突发容量为 0 时取 1 秒的速率。
+ * 一次读取或一次发送称为一条“消息”（Reactor 不解析应用层帧）。
+ */
+struct RateLimit {
+  /// 每秒允许的字节数（0 = 不限制）
+  uint64_t bytes_per_second = 0;
+
+  /// 每秒允许的消息数（0 = 不限制）
+  uint64_t messages_per_second = 0;
+
+  /// 字节桶的突发容量（0 = bytes_per_second）
+  uint64_t burst_bytes = 0;
+
+  /// 消息桶的突发容量（0 = messages_per_second）
+  uint64_t burst_messages = 0;
+
+  bool IsEnabled() const { return bytes_per_second > 0 || messages_per_second > 0; }
+};
+
+/**
+ * @brief 发送优先级
+ *
+ * 同一连接上，控制数据排在已积压的批量数据之前写出。插队只发生在两次
+ * SendData 之间的边界处，不会拆开任何一次发送；同一优先级内保持提交顺序。
+ * 第一条控制数据之前积压的批量数据没有记录边界，会整体先写完。
+ */
+enum class SendPriority {
+  kBulk,     ///< 批量数据（默认）
+  kControl,  ///< 延迟敏感的控制消息（心跳、取消、小请求）
+};
+
 /**
  * @brief Socket 连接配置
  *
@@ -102,6 +102,7 @@ struct NetworkEvent {
   std::optional<ConnectionInformation> connection_info; ///< 连接信息（kConnected 有效）
   std::optional<NetworkError> error;                    ///< 错误码（kError 有效）
   std::string error_message;                            ///< 错误消息（用于日志）
+  std::optional<uint64_t> routing_key;                  ///< 按 key 路由时的 key（kData 有效）
 
   /**
    * @brief 构造函数
@@ -0,0 +1,127 @@
+//
+// DarwinCore Network 模块
+// 共享事件循环组
+//
+// 功能说明：
+//   默认情况下每个 Server 独占 CPU 核数个 Reactor 线程和 4 个 Worker 线程，
+//   每个 Client 独占一个 Reactor 线程和一个 Worker 线程；同时监听 TCP 端口和
+//   UDS 路径的进程就有两整套线程，持有上万个出站连接时线程数随连接数线性增长。
+//   EventLoopGroup 持有固定数量的 Reactor 线程和一个共享的 WorkerPool，
+//   任意多个 Server 和 Client 的连接复用到这些线程上，线程数只与核数相关。
+//
+// 使用示例：
+//   @code
+//   auto group = std::make_shared<darwincore::network::EventLoopGroup>();
+//
+//   darwincore::network::Server tcp_server(group);
+//   darwincore::network::Server uds_server(group);
+//   tcp_server.StartIPv4("0.0.0.0", 8080);
+//   uds_server.StartUnixDomain("/tmp/app.sock");
+//
+//   std::vector<std::unique_ptr<darwincore::network::Client>> clients;
+//   for (int i = 0; i < 20000; ++i) {
+//     auto client = std::make_unique<darwincore::network::Client>(group);
+//     client->SetOnMessage([](const auto& data) { /* ... */ });
+//     client->ConnectIPv4("10.0.0.1", 8080);
+//     clients.push_back(std::move(client));
+//   }
+//   @endcode
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_NETWORK_EVENT_LOOP_GROUP_H
+#define DARWINCORE_NETWORK_EVENT_LOOP_GROUP_H
+
+#include <cstddef>
+#include <memory>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    /**
+     * @brief 共享事件循环组
+     *
+     * 线程模型：
+     *   - N 个 Reactor 线程：负责所有成员 Server/Client 连接的 I/O（默认 N = CPU 核数）
+     *   - M 个 Worker 线程：负责回调（默认 M = 4）
+     *   - 同一连接的事件始终在同一个 Worker 线程中按序回调
+     *   - Server 连接沿用 60 秒空闲超时，Client 连接不做空闲超时检测
+     *
+     * 生命周期：
+     *   - 第一个 Server 启动或 Client 连接时自动启动，也可以显式调用 Start()
+     *   - Server/Client 持有 EventLoopGroup 的 shared_ptr，组会活到最后一个成员销毁
+     *   - 成员 Server 停止时只关闭自己的连接，组内线程继续服务其他成员
+     *   - Stop() 会关闭组内所有连接，之后成员的发送都会失败；这些连接的
+     *     断开回调在 Stop() 的调用线程中执行，成员 Client 的 IsConnected() 变为 false
+     */
+    class EventLoopGroup
+    {
+    public:
+      /**
+       * @brief 构造事件循环组
+       * @param loop_count Reactor 线程数（0 = CPU 核数）
+       * @param worker_count Worker 线程数（0 = SocketConfiguration::kDefaultWorkerCount）
+       */
+      explicit EventLoopGroup(size_t loop_count = 0, size_t worker_count = 0);
+
+      /**
+       * @brief 析构函数
+       *
+       * 停止所有 Reactor 和 Worker 线程。
+       */
+      ~EventLoopGroup();
+
+      // 禁止拷贝和移动
+      EventLoopGroup(const EventLoopGroup &) = delete;
+      EventLoopGroup &operator=(const EventLoopGroup &) = delete;
+
+      /**
+       * @brief 启动 Reactor 和 Worker 线程
+       * @return 成功（或已在运行）返回 true
+       */
+      bool Start();
+
+      /**
+       * @brief 停止所有线程并关闭组内所有连接
+       *
+       * 线程停止后，在调用线程中为每个仍打开的连接触发一次断开回调。
+       */
+      void Stop();
+
+      /**
+       * @brief 检查是否正在运行
+       */
+      bool IsRunning() const;
+
+      /**
+       * @brief 获取 Reactor 线程数
+       */
+      size_t GetLoopCount() const;
+
+      /**
+       * @brief 获取 Worker 线程数
+       */
+      size_t GetWorkerCount() const;
+
+      /**
+       * @brief 获取当前挂在组上的连接数（所有成员 Server/Client 合计）
+       */
+      size_t GetConnectionCount() const;
+
+      class Impl;
+
+    private:
+      friend class Client;
+      friend class Server;
+
+      /// Pimpl 实现（成员 Server/Client 持有 shared_ptr 以延长生命周期）
+      std::shared_ptr<Impl> impl_;
+    };
+
+  } // namespace network
+} // namespace darwincore
+
+#endif // DARWINCORE_NETWORK_EVENT_LOOP_GROUP_H
@@ -12,6 +12,8 @@
 //   - 全局日志级别控制
 //   - 可设置自定义日志回调函数
 //   - 线程安全
+//   - 级别检查先于格式化，支持编译期移除低级别日志（NW_LOG_MIN_LEVEL）
+//   - 异步输出：调用线程只入队，后台线程格式化并输出
 //
 // 作者: DarwinCore Network 团队
 // 日期: 2026
@@ -19,13 +21,28 @@
 #ifndef DARWINCORE_NETWORK_LOGGER_H
 #define DARWINCORE_NETWORK_LOGGER_H
 
-#include <string>
-#include <functional>
-#include <sstream>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <iomanip>
-#include <mutex>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/**
+ * @brief 编译期最低日志级别（与 LogLevel 数值一致，默认 0 = Trace）
+ *
+ * 低于此级别的 NW_LOG_* 调用在编译期被整体移除（参数表达式也不会求值），
+ * 例如 -DNW_LOG_MIN_LEVEL=2 去掉全部 Trace/Debug 日志。
+ */
+#ifndef NW_LOG_MIN_LEVEL
+#define NW_LOG_MIN_LEVEL 0
+#endif
 
 namespace darwincore {
 namespace network {
@@ -54,12 +71,103 @@ using LogCallback = std::function<void(LogLevel level,
                                         const char* file,
                                         int line)>;
 
+namespace detail {
+
+/// 一条待输出的日志（时间戳在调用点采集，格式化在后台线程完成）
+struct LogRecord {
+  LogLevel level = LogLevel::kInfo;
+  const char* file = "";
+  int line = 0;
+  std::chrono::system_clock::time_point time;
+  std::string message;
+};
+
+/**
+ * @brief 有界无锁多生产者队列（Vyukov 算法），单消费者（持有输出锁的线程）
+ *
+ * 与 foundation 的 MPMCRingQueue 相同的算法，这里支持移动语义，
+ * 避免日志消息在入队时再复制一次。
+ */
+class LogRecordQueue {
+public:
+  explicit LogRecordQueue(size_t capacity)
+      : mask_(capacity - 1), cells_(new Cell[capacity]) {
+    for (size_t i = 0; i < capacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  bool Push(LogRecord&& record) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // 队列满
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->record = std::move(record);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool Pop(LogRecord& record) {
+    Cell* cell = &cells_[head_ & mask_];
+    if (cell->sequence.load(std::memory_order_acquire) != head_ + 1) {
+      return false;
+    }
+    record = std::move(cell->record);
+    cell->sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    ++head_;
+    return true;
+  }
+
+  /**
+   * @brief 已被生产者占用的位置数（含正在写入、尚未发布的元素）
+   *
+   * 消费者 Pop 到该位置为止，即取出了调用前已入队的全部元素。
+   */
+  size_t Claimed() const { return tail_.load(std::memory_order_relaxed); }
+
+  /// 已取出的位置数（只由消费者调用）
+  size_t Consumed() const { return head_; }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    LogRecord record;
+  };
+
+  const size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+  alignas(64) std::atomic<size_t> tail_{0};
+  alignas(64) size_t head_ = 0;  ///< 只由消费者访问
+};
+
+}  // namespace detail
+
 /**
  * @brief 网络日志系统
  *
  * 提供网络模块的日志记录功能。
  * 这是一个单例类，全局唯一。
  *
+ * 性能说明：
+ *   - NW_LOG_* 宏先检查级别（一次原子读），未启用的日志不构造字符串
+ *   - 已启用的日志在调用线程只生成消息文本并放入无锁队列，时间格式化、
+ *     回调和控制台输出由后台写线程完成；队列满时退化为同步输出，不丢日志
+ *   - 同步输出前，调用线程先写完队列中已有的日志，输出顺序与入队顺序一致
+ *   - Fatal 日志入队后等待队列写完再返回
+ *   - 自定义回调通常在后台写线程中调用；队列满时在产生日志的线程中调用
+ *
  * 使用示例：
  *   @code
  *   // 设置日志回调
@@ -85,6 +193,17 @@ public:
     return instance;
   }
 
+  ~NetworkLogger() {
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      stopping_.store(true);
+    }
+    wake_.notify_one();
+    if (writer_.joinable()) {
+      writer_.join();
+    }
+  }
+
   // 删除拷贝和移动
   NetworkLogger(const NetworkLogger&) = delete;
   NetworkLogger& operator=(const NetworkLogger&) = delete;
@@ -93,7 +212,8 @@ public:
    * @brief 设置日志回调函数
    * @param callback 日志回调函数
    *
-   * 如果不设置回调，默认输出到控制台。
+   * 如果不设置回调，默认输出到控制台。回调通常在后台写线程中调用，队列满时
+   * 在产生日志的线程中调用；任一时刻只有一个线程在调用回调。
    */
   void SetLogCallback(LogCallback callback) {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -107,15 +227,21 @@ public:
    * 只有大于等于此级别的日志才会被输出。
    */
   void SetLogLevel(LogLevel level) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    log_level_ = level;
+    log_level_.store(level, std::memory_order_relaxed);
   }
 
   /**
    * @brief 获取当前日志级别
    */
   LogLevel GetLogLevel() const {
-    return log_level_;
+    return log_level_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 指定级别的日志是否会被输出（NW_LOG_* 宏在格式化前调用）
+   */
+  bool IsEnabled(LogLevel level) const {
+    return level >= log_level_.load(std::memory_order_relaxed);
   }
 
   /**
@@ -125,42 +251,142 @@ public:
    * @param file 源文件名
    * @param line 源代码行号
    */
-  void Log(LogLevel level, const std::string& message, const char* file, int line) {
-    if (level < log_level_) {
+  void Log(LogLevel level, std::string message, const char* file, int line) {
+    if (!IsEnabled(level)) {
       return;
     }
 
-    std::string formatted = FormatMessage(level, message, file, line);
+    detail::LogRecord record;
+    record.level = level;
+    record.file = file;
+    record.line = line;
+    record.time = std::chrono::system_clock::now();
+    record.message = std::move(message);
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_.load(std::memory_order_relaxed) || !queue_.Push(std::move(record))) {
+      // 队列满或正在退出：同步输出（Push 失败时 record 未被移走）。
+      // 先写完已入队的日志，否则这条日志会排到更早的日志前面
+      std::lock_guard<std::mutex> lock(mutex_);
+      DrainQueue(queue_.Claimed());
+      Write(record);
+      return;
+    }
+    enqueued_.fetch_add(1);
+
+    if (writer_idle_.load()) {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      wake_.notify_one();
+    }
+    if (level >= LogLevel::kFatal) {
+      Flush();
+    }
+  }
+
+  /**
+   * @brief 等待调用前已入队的日志全部输出
+   */
+  void Flush() {
+    uint64_t target = enqueued_.load();
+    while (written_.load() < target && !stopping_.load()) {
+      {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_.notify_one();
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+private:
+  static constexpr size_t kQueueCapacity = 8192;
+
+  NetworkLogger()
+      : log_level_(LogLevel::kInfo),
+        callback_(nullptr),
+        queue_(kQueueCapacity),
+        writer_([this] { WriterLoop(); }) {}
+
+  /**
+   * @brief 后台写线程：批量取出日志，格式化后输出
+   */
+  void WriterLoop() {
+    for (;;) {
+      uint64_t count = 0;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        count = DrainQueue();
+      }
+      if (count > 0) {
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      if (stopping_.load() && written_.load() >= enqueued_.load()) {
+        return;
+      }
+      // 先声明空闲再复查计数，与 Log 中"先入队计数、再检查空闲"配对，不会丢失唤醒
+      writer_idle_.store(true);
+      wake_.wait_for(lock, std::chrono::milliseconds(50), [this] {
+        return stopping_.load() || written_.load() < enqueued_.load();
+      });
+      writer_idle_.store(false);
+    }
+  }
+
+  /**
+   * @brief 输出队列中的日志（调用方持有 mutex_，队列的消费者因此唯一）
+   * @param until 至少输出到该位置：其他线程已占用但尚未写完的位置会等它写完，
+   *        0 表示只输出已发布的日志
+   * @return 输出的条数
+   */
+  uint64_t DrainQueue(size_t until = 0) {
+    detail::LogRecord record;
+    uint64_t count = 0;
+    for (;;) {
+      if (queue_.Pop(record)) {
+        Write(record);
+        ++count;
+      } else if (queue_.Consumed() < until) {
+        std::this_thread::yield();  // 生产者只差一次移动赋值即可发布
+      } else {
+        break;
+      }
+    }
+    if (count > 0) {
+      written_.fetch_add(count);
+    }
+    return count;
+  }
+
+  /**
+   * @brief 格式化并输出一条日志（调用方持有 mutex_）
+   */
+  void Write(const detail::LogRecord& record) {
+    std::string formatted = FormatMessage(record);
     if (callback_) {
-      callback_(level, formatted, file, line);
+      callback_(record.level, formatted, record.file, record.line);
     } else {
       // 默认输出到控制台
-      DefaultOutput(level, formatted);
+      DefaultOutput(record.level, formatted);
     }
   }
 
-private:
-  NetworkLogger() : log_level_(LogLevel::kInfo), callback_(nullptr) {}
-
   /**
    * @brief 格式化日志消息
    */
-  std::string FormatMessage(LogLevel level, const std::string& message,
-                             const char* file, int line) {
-    // 获取当前时间
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
+  std::string FormatMessage(const detail::LogRecord& record) {
+    auto time_t = std::chrono::system_clock::to_time_t(record.time);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
+        record.time.time_since_epoch()) % 1000;
+
+    std::tm local_time{};
+    localtime_r(&time_t, &local_time);
 
     std::stringstream ss;
-    ss << "[" << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S")
+    ss << "[" << std::put_time(&local_time, "%Y-%m-%d %H:%M:%S")
        << "." << std::setfill('0') << std::setw(3) << ms.count() << "] "
-       << "[" << LevelToString(level) << "] "
-       << "[" << GetFileName(file) << ":" << line << "] "
-       << message;
+       << "[" << LevelToString(record.level) << "] "
+       << "[" << GetFileName(record.file) << ":" << record.line << "] "
+       << record.message;
 
     return ss.str();
   }
@@ -212,66 +438,68 @@ private:
     }
   }
 
-  LogLevel log_level_;              ///< 当前日志级别
-  LogCallback callback_;            ///< 自定义日志回调
-  std::mutex mutex_;                ///< 互斥锁，保证线程安全
+  std::atomic<LogLevel> log_level_;       ///< 当前日志级别
+  LogCallback callback_;                  ///< 自定义日志回调
+  std::mutex mutex_;                      ///< 保护回调与输出
+  detail::LogRecordQueue queue_;          ///< 待输出的日志
+  std::atomic<uint64_t> enqueued_{0};     ///< 已入队的日志数
+  std::atomic<uint64_t> written_{0};      ///< 后台线程已输出的日志数
+  std::atomic<bool> writer_idle_{false};  ///< 写线程是否在等待唤醒
+  std::atomic<bool> stopping_{false};     ///< 单例析构中
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::thread writer_;                    ///< 后台写线程（最后初始化）
 };
 
 // ==================== 便捷宏定义 ====================
 
+/**
+ * @brief 日志宏的公共实现
+ *
+ * 编译期低于 NW_LOG_MIN_LEVEL 的调用被 if constexpr 丢弃；运行期先检查级别，
+ * 只有启用的日志才构造字符串。
+ */
+#define NW_LOG_IMPL(level, stream) \
+  do { \
+    if constexpr (static_cast<int>(level) >= NW_LOG_MIN_LEVEL) { \
+      auto& nw_logger_ = darwincore::network::NetworkLogger::Instance(); \
+      if (nw_logger_.IsEnabled(level)) { \
+        std::ostringstream nw_log_stream_; \
+        nw_log_stream_ << stream; \
+        nw_logger_.Log(level, nw_log_stream_.str(), __FILE__, __LINE__); \
+      } \
+    } \
+  } while (0)
+
 /**
  * @brief 记录 Trace 级别日志
  */
-#define NW_LOG_TRACE(stream) \
-  darwincore::network::NetworkLogger::Instance().Log( \
-    darwincore::network::LogLevel::kTrace, \
-    [&]() -> std::string { std::stringstream ss; ss << stream; return ss.str(); }(), \
-    __FILE__, __LINE__)
+#define NW_LOG_TRACE(stream) NW_LOG_IMPL(darwincore::network::LogLevel::kTrace, stream)
 
 /**
  * @brief 记录 Debug 级别日志
  */
-#define NW_LOG_DEBUG(stream) \
-  darwincore::network::NetworkLogger::Instance().Log( \
-    darwincore::network::LogLevel::kDebug, \
-    [&]() -> std::string { std::stringstream ss; ss << stream; return ss.str(); }(), \
-    __FILE__, __LINE__)
+#define NW_LOG_DEBUG(stream) NW_LOG_IMPL(darwincore::network::LogLevel::kDebug, stream)
 
 /**
  * @brief 记录 Info 级别日志
  */
-#define NW_LOG_INFO(stream) \
-  darwincore::network::NetworkLogger::Instance().Log( \
-    darwincore::network::LogLevel::kInfo, \
-    [&]() -> std::string { std::stringstream ss; ss << stream; return ss.str(); }(), \
-    __FILE__, __LINE__)
+#define NW_LOG_INFO(stream) NW_LOG_IMPL(darwincore::network::LogLevel::kInfo, stream)
 
 /**
  * @brief 记录 Warning 级别日志
  */
-#define NW_LOG_WARNING(stream) \
-  darwincore::network::NetworkLogger::Instance().Log( \
-    darwincore::network::LogLevel::kWarning, \
-    [&]() -> std::string { std::stringstream ss; ss << stream; return ss.str(); }(), \
-    __FILE__, __LINE__)
+#define NW_LOG_WARNING(stream) NW_LOG_IMPL(darwincore::network::LogLevel::kWarning, stream)
 
 /**
  * @brief 记录 Error 级别日志
  */
-#define NW_LOG_ERROR(stream) \
-  darwincore::network::NetworkLogger::Instance().Log( \
-    darwincore::network::LogLevel::kError, \
-    [&]() -> std::string { std::stringstream ss; ss << stream; return ss.str(); }(), \
-    __FILE__, __LINE__)
+#define NW_LOG_ERROR(stream) NW_LOG_IMPL(darwincore::network::LogLevel::kError, stream)
 
 /**
  * @brief 记录 Fatal 级别日志
  */
-#define NW_LOG_FATAL(stream) \
-  darwincore::network::NetworkLogger::Instance().Log( \
-    darwincore::network::LogLevel::kFatal, \
-    [&]() -> std::string { std::stringstream ss; ss << stream; return ss.str(); }(), \
-    __FILE__, __LINE__)
+#define NW_LOG_FATAL(stream) NW_LOG_IMPL(darwincore::network::LogLevel::kFatal, stream)
 
 }  // namespace network
 }  // namespace darwincore
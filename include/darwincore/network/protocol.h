@@ -2,6 +2,7 @@
 #define DARWINCORE_NETWORK_PROTOCOL_H
 
 #include <cstdint>
+#include <deque>
 #include <vector>
 #include <unordered_map>
 #include <stdexcept>
@@ -9,6 +10,8 @@
 #include <chrono>
 #include <functional>
 
+#include <darwincore/network/configuration.h>
+
 /**
  * @file protocol.h
  * @brief 网络协议编解码器 - 提供消息分片、流式传输和 CRC32 校验功能
@@ -19,6 +22,8 @@
  * - 流式传输：支持大数据的流式传输（StreamStart/Chunk/End）
  * - CRC32 校验：可选的数据完整性校验
  * - 超时清理：自动清理未完成的消息碎片
+ * - 流控：接收方按 stream_id 授予字节额度（StreamWindow 帧），StreamSender 不超额发送
+ * - 紧凑帧：小消息使用 6 字节帧头（VERSION_COMPACT），多条小消息可打包成一个 Batch 帧
  *
  * @par 使用示例
  *
@@ -83,6 +88,8 @@ namespace darwincore
             constexpr uint8_t MAGIC2 = 0x5C;
             /** @brief 协议版本号 */
             constexpr uint8_t VERSION = 0x01;
+            /** @brief 紧凑帧版本号（6 字节帧头，无标志位，不支持分片） */
+            constexpr uint8_t VERSION_COMPACT = 0x02;
 
             /** @brief 单个 Frame 的最大 Payload 大小（256KB） */
             constexpr uint32_t MAX_FRAME_PAYLOAD = 256 * 1024;
@@ -90,6 +97,10 @@ namespace darwincore
             constexpr uint16_t MAX_MESSAGE_SLICES = 65535;
             /** @brief 消息组装超时时间（30秒） */
             constexpr uint32_t DEFAULT_MESSAGE_TIMEOUT_MS = 30000;
+            /** @brief 紧凑帧的最大 Payload 大小（帧头中的长度为 16 位） */
+            constexpr uint32_t MAX_COMPACT_PAYLOAD = 65535;
+            /** @brief 流控初始窗口（1MB，收发双方需使用相同的值） */
+            constexpr uint32_t DEFAULT_STREAM_WINDOW = 1024 * 1024;
 
             // ========== 帧标志位 ==========
 
@@ -109,6 +120,10 @@ namespace darwincore
                 StreamChunk = 0x03,
                 /** @brief 流式传输结束帧 */
                 StreamEnd = 0x04,
+                /** @brief 流窗口更新帧（接收方授予发送方额外的字节额度） */
+                StreamWindow = 0x05,
+                /** @brief 批量消息帧（仅紧凑帧，Payload 为若干条 [id][长度][数据]） */
+                Batch = 0x06,
             };
 
             // ========== 帧头结构（16 字节，紧凑布局） ==========
@@ -130,6 +145,26 @@ namespace darwincore
 
             static_assert(sizeof(FrameHeader) == 16);
 
+#pragma pack(push, 1)
+            /**
+             * @brief 紧凑帧头（6 字节，VERSION_COMPACT）
+             *
+             * 只用于单分片的小消息（Message）与批量消息（Batch）。Message 的 Payload 为
+             * varint 编码的 message_id 加消息数据；Batch 的每一条为 varint message_id、
+             * varint 数据长度加数据。
+             */
+            struct CompactFrameHeader
+            {
+                uint8_t magic1;          /**< 魔数第1字节 (0x5A) */
+                uint8_t magic2;          /**< 魔数第2字节 (0x5C) */
+                uint8_t version;         /**< VERSION_COMPACT */
+                uint8_t type;            /**< 帧类型（Message 或 Batch） */
+                uint16_t payload_len;    /**< Payload 长度（字节数） */
+            };
+#pragma pack(pop)
+
+            static_assert(sizeof(CompactFrameHeader) == 6);
+
             // ========== 消息帧专用结构 ==========
 
 #pragma pack(push, 1)
@@ -172,14 +207,28 @@ namespace darwincore
             };
 #pragma pack(pop)
 
+#pragma pack(push, 1)
+            /** @brief 流窗口更新帧的 Payload */
+            struct StreamWindowPayload
+            {
+                uint64_t stream_id;      /**< 流唯一标识符 */
+                uint32_t credit;         /**< 新增的字节额度 */
+            };
+#pragma pack(pop)
+
             // ========== Frame 基础结构 ==========
 
             /** @brief 帧结构（Header + Payload） */
             struct Frame
             {
-                FrameHeader header;                /**< 帧头 */
+                FrameHeader header;                /**< 帧头（紧凑帧只使用 magic/version/type/payload_len） */
                 std::vector<uint8_t> payload;      /**< 载荷数据 */
 
+                /**
+                 * @brief 序列化后的帧头大小（紧凑帧为 6 字节，否则为 16 字节）
+                 */
+                size_t HeaderSize() const;
+
                 /**
                  * @brief 序列化为字节流（用于网络发送）
                  * @return 序列化后的字节数组
@@ -289,6 +338,16 @@ namespace darwincore
                     uint64_t stream_id,
                     uint32_t crc32 = 0);
 
+                /**
+                 * @brief 编码流窗口更新帧（接收方发出）
+                 * @param stream_id 流唯一标识符
+                 * @param credit 新增的字节额度（数据块的数据部分字节数）
+                 * @return 流窗口更新帧
+                 */
+                static Frame EncodeStreamWindow(
+                    uint64_t stream_id,
+                    uint32_t credit);
+
                 // ========== 工具方法 ==========
 
                 /**
@@ -299,6 +358,21 @@ namespace darwincore
                 static std::vector<std::vector<uint8_t>> SerializeFrames(
                     const std::vector<Frame> &frames);
 
+                // ========== 紧凑帧编码 ==========
+
+                /**
+                 * @brief 编码单分片的小消息（紧凑帧头 + varint message_id）
+                 * @param message_id 消息唯一标识符
+                 * @param data 消息数据
+                 * @param length 数据长度
+                 * @return 紧凑消息帧
+                 * @throw ProtocolError 超出 MAX_COMPACT_PAYLOAD 时抛出异常
+                 */
+                static Frame EncodeCompactMessage(
+                    uint64_t message_id,
+                    const uint8_t *data,
+                    size_t length);
+
             private:
                 /**
                  * @brief 创建一个帧的内部方法
@@ -311,6 +385,139 @@ namespace darwincore
                 static Frame MakeFrame(FrameType type, const void *payload, size_t len, bool crc = false);
             };
 
+            /**
+             * @brief 批量消息编码器：把多条小消息打包进一个紧凑 Batch 帧
+             *
+             * 解码端把 Batch 帧拆成多个 MessageComplete，与逐条发送时相同。
+             *
+             * @par 使用示例
+             * @code
+             * BatchEncoder batch;
+             * for (const auto &sample : samples) {
+             *   if (!batch.Add(next_id++, sample.data(), sample.size())) {
+             *     Send(batch.Finish());
+             *     batch.Add(next_id - 1, sample.data(), sample.size());
+             *   }
+             * }
+             * if (!batch.Empty()) Send(batch.Finish());
+             * @endcode
+             */
+            class BatchEncoder
+            {
+            public:
+                /**
+                 * @brief 追加一条消息
+                 * @return 放不下（超出 MAX_COMPACT_PAYLOAD）返回 false，批内容不变
+                 */
+                bool Add(uint64_t message_id, const uint8_t *data, size_t length);
+
+                /** @brief 生成 Batch 帧并清空编码器 */
+                Frame Finish();
+
+                /** @brief 已追加的消息数 */
+                size_t Count() const { return count_; }
+
+                /** @brief 是否没有消息 */
+                bool Empty() const { return count_ == 0; }
+
+            private:
+                std::vector<uint8_t> payload_;
+                size_t count_ = 0;
+            };
+
+            // ========== 帧调度器 ==========
+
+            /**
+             * @brief 帧发送调度器（非线程安全）
+             *
+             * 按“流”（同一 message_id 的分片，或同一 stream_id 的流帧）排队，
+             * 轮流取出各流的下一帧，使一条大消息不会独占连接：多条消息的分片
+             * 交错发送，Decoder 按 message_id 重组。kControl 的流总是先于 kBulk
+             * 的流取出；同一流内帧的顺序不变。
+             *
+             * @par 使用示例
+             * @code
+             * scheduler.Enqueue(Encoder::EncodeMessage(id, data, len));
+             * scheduler.Enqueue(Encoder::EncodeMessage(ping_id, ping, 4),
+             *                   SendPriority::kControl);
+             *
+             * Frame frame;
+             * SendPriority priority;
+             * while (scheduler.Next(frame, &priority)) {
+             *   auto bytes = frame.Serialize();
+             *   server.SendData(conn_id, bytes.data(), bytes.size(), priority);
+             * }
+             * @endcode
+             */
+            class FrameScheduler
+            {
+            public:
+                /**
+                 * @brief 加入一条消息（或一段流）的全部帧
+                 * @param frames 帧数组（同一流的帧按顺序排列）
+                 * @param priority 优先级；流已在排队时沿用首次加入时的优先级
+                 */
+                void Enqueue(std::vector<Frame> frames,
+                             SendPriority priority = SendPriority::kBulk);
+
+                /**
+                 * @brief 加入单个帧
+                 */
+                void Enqueue(Frame frame, SendPriority priority = SendPriority::kBulk);
+
+                /**
+                 * @brief 取出下一个应发送的帧
+                 * @param out 输出帧
+                 * @param priority 可选，输出该帧所属流的优先级
+                 * @return 有帧返回 true，队列为空返回 false
+                 */
+                bool Next(Frame &out, SendPriority *priority = nullptr);
+
+                /** @brief 是否没有待发送的帧 */
+                bool Empty() const { return pending_frames_ == 0; }
+
+                /** @brief 待发送的帧数 */
+                size_t PendingFrames() const { return pending_frames_; }
+
+                /** @brief 待发送的字节数（含帧头） */
+                size_t PendingBytes() const { return pending_bytes_; }
+
+            private:
+                /** @brief 流标识：消息与流的 ID 空间各自独立 */
+                struct FlowKey
+                {
+                    bool is_stream = false;
+                    uint64_t id = 0;
+
+                    bool operator==(const FlowKey &other) const
+                    {
+                        return is_stream == other.is_stream && id == other.id;
+                    }
+                };
+
+                struct FlowKeyHash
+                {
+                    size_t operator()(const FlowKey &key) const
+                    {
+                        return std::hash<uint64_t>()(key.id) ^ (key.is_stream ? 0x9e3779b97f4a7c15ULL : 0);
+                    }
+                };
+
+                /** @brief 单个流的待发送帧 */
+                struct Flow
+                {
+                    std::deque<Frame> frames;
+                    SendPriority priority = SendPriority::kBulk;
+                };
+
+                static FlowKey KeyOf(const Frame &frame);
+
+                std::unordered_map<FlowKey, Flow, FlowKeyHash> flows_;  /**< 有待发送帧的流 */
+                std::deque<FlowKey> ready_[2];                          /**< 按优先级的轮转队列（0=kBulk, 1=kControl） */
+                size_t pending_frames_ = 0;
+                size_t pending_bytes_ = 0;
+            };
+
         } // namespace proto
 
         namespace proto
@@ -332,6 +539,7 @@ namespace darwincore
                 uint64_t offset = 0;           /**< 数据偏移量（仅 StreamChunk 有效） */
                 uint64_t total_size = 0;       /**< 流的总大小（仅 StreamStart 有效） */
                 uint32_t crc32 = 0;            /**< CRC32 校验值（仅 StreamEnd 有效） */
+                uint32_t credit = 0;           /**< 新增字节额度（仅 StreamWindow 有效） */
                 std::vector<uint8_t> data;     /**< 数据块（仅 StreamChunk 有效） */
             };
 
@@ -423,6 +631,148 @@ namespace darwincore
                  * @throw ProtocolError 协议错误时抛出异常
                  */
                 void TryDecode();
+
+                /**
+                 * @brief 解码缓冲区开头的紧凑帧
+                 * @return 帧不完整返回 false
+                 * @throw ProtocolError 协议错误时抛出异常
+                 */
+                bool DecodeCompactFrame();
+            };
+
+            // ========== 流控 ==========
+
+            /**
+             * @brief 流发送方（按接收方授予的额度发送，非线程安全）
+             *
+             * 每个流开始时拥有 initial_window 字节的额度，Write() 最多编码额度内的
+             * 数据并返回实际消耗的字节数，剩余部分由调用方保留，收到 StreamWindow
+             * 后再写。发送方积压的数据因此不超过窗口大小，与流的总长度无关。
+             *
+             * @par 使用示例
+             * @code
+             * std::vector<Frame> frames;
+             * size_t n = sender.Write(id, data + pos, len - pos, frames);
+             * pos += n;  // n < len - pos 时等待窗口更新
+             *
+             * // 收到对端的帧
+             * StreamEvent event;
+             * while (decoder.GetStreamEvent(event)) {
+             *   if (sender.HandleEvent(event)) {
+             *     // 额度增加，继续 Write
+             *   }
+             * }
+             * @endcode
+             */
+            class StreamSender
+            {
+            public:
+                /**
+                 * @brief 构造发送方
+                 * @param initial_window 每个流的初始额度（需与接收方一致）
+                 */
+                explicit StreamSender(uint32_t initial_window = DEFAULT_STREAM_WINDOW);
+
+                /**
+                 * @brief 开始一个流
+                 * @param stream_id 流唯一标识符
+                 * @param total_size 流的总大小（0 表示未知）
+                 * @return 流开始帧
+                 * @throw ProtocolError 流已存在时抛出异常
+                 */
+                Frame Start(uint64_t stream_id, uint64_t total_size = 0);
+
+                /**
+                 * @brief 在额度内编码数据块
+                 * @param stream_id 流唯一标识符
+                 * @param data 数据
+                 * @param length 数据长度
+                 * @param out 追加编码后的数据块帧
+                 * @return 实际编码的字节数（额度用尽时小于 length，可能为 0）
+                 * @throw ProtocolError 流不存在时抛出异常
+                 */
+                size_t Write(uint64_t stream_id,
+                             const uint8_t *data,
+                             size_t length,
+                             std::vector<Frame> &out);
+
+                /**
+                 * @brief 结束一个流
+                 * @param stream_id 流唯一标识符
+                 * @param crc32 整个流的 CRC32 校验值（0 表示不校验）
+                 * @return 流结束帧
+                 */
+                Frame End(uint64_t stream_id, uint32_t crc32 = 0);
+
+                /**
+                 * @brief 处理对端的流事件
+                 * @return 是 StreamWindow 事件返回 true（已增加额度）
+                 */
+                bool HandleEvent(const StreamEvent &event);
+
+                /**
+                 * @brief 增加某个流的额度（已结束的流忽略）
+                 */
+                void AddCredit(uint64_t stream_id, uint32_t credit);
+
+                /**
+                 * @brief 某个流当前可发送的字节数（流不存在时为 0）
+                 */
+                uint64_t Available(uint64_t stream_id) const;
+
+            private:
+                /** @brief 单个流的发送状态 */
+                struct State
+                {
+                    uint64_t offset = 0;     /**< 下一个数据块的偏移量 */
+                    uint64_t credit = 0;     /**< 剩余额度 */
+                };
+
+                uint32_t initial_window_;
+                std::unordered_map<uint64_t, State> streams_;
+            };
+
+            /**
+             * @brief 流接收方的额度记账（非线程安全）
+             *
+             * OnEvent() 检查对端没有超额发送；应用处理完数据后调用 Consume()，
+             * 累计处理量达到半个窗口时生成一个 StreamWindow 帧交还额度，
+             * 避免每个数据块都回一个窗口更新。
+             */
+            class StreamReceiver
+            {
+            public:
+                /**
+                 * @brief 构造接收方
+                 * @param window 每个流的窗口大小（需与发送方的初始额度一致）
+                 */
+                explicit StreamReceiver(uint32_t window = DEFAULT_STREAM_WINDOW);
+
+                /**
+                 * @brief 记录收到的流事件（StreamStart 登记，StreamChunk 扣减额度，StreamEnd 注销）
+                 * @throw ProtocolError 对端超出窗口发送，或向未开始（或已结束）的流发送数据块时抛出异常
+                 */
+                void OnEvent(const StreamEvent &event);
+
+                /**
+                 * @brief 记录应用已处理完的数据
+                 * @param stream_id 流唯一标识符
+                 * @param bytes 已处理的字节数
+                 * @param update 需要交还额度时输出 StreamWindow 帧
+                 * @return 生成了窗口更新帧返回 true（调用方负责发给对端）
+                 */
+                bool Consume(uint64_t stream_id, size_t bytes, Frame &update);
+
+            private:
+                /** @brief 单个流的接收状态 */
+                struct State
+                {
+                    uint64_t outstanding = 0;  /**< 已收到、尚未交还额度的字节数 */
+                    uint64_t consumed = 0;     /**< 已处理、尚未交还额度的字节数 */
+                };
+
+                uint32_t window_;
+                std::unordered_map<uint64_t, State> streams_;
             };
 
             // ========== CRC32 工具函数 ==========
@@ -0,0 +1,239 @@
+//
+// DarwinCore Network 模块
+// 请求/响应 RPC - 基于 proto 帧格式的流水线调用
+//
+// 功能说明：
+//   在 proto 帧格式之上提供请求/响应语义：
+//   - 请求与响应通过 proto::MessageHeader::message_id 关联
+//   - 同一连接上可以同时存在任意多个未完成请求（流水线）
+//   - 完成通知通过回调或 std::future 返回，不阻塞调用线程
+//   - 每个请求的截止时间由共享的时间轮统一处理，不为单个请求占用线程
+//
+// 使用示例：
+//   @code
+//   // 服务端
+//   darwincore::network::Server server;
+//   darwincore::network::RpcServer rpc_server(server);
+//   rpc_server.SetRequestHandler([&](uint64_t conn_id, uint64_t request_id,
+//                                    const std::vector<uint8_t>& request) {
+//     rpc_server.Respond(conn_id, request_id, request.data(), request.size());
+//   });
+//   server.StartIPv4("0.0.0.0", 8080);
+//
+//   // 客户端
+//   darwincore::network::Client client;
+//   darwincore::network::RpcClient rpc(client);
+//   client.ConnectIPv4("127.0.0.1", 8080);
+//
+//   rpc.Call(data, size, [](RpcStatus status, const std::vector<uint8_t>& response) {
+//     if (status == RpcStatus::kOk) { /* ... */ }
+//   }, 1000);
+//
+//   auto future = rpc.CallFuture(data, size, 1000);
+//   RpcResponse response = future.get();
+//   @endcode
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_NETWORK_RPC_H
+#define DARWINCORE_NETWORK_RPC_H
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/server.h>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    /**
+     * @brief RPC 调用结果状态
+     */
+    enum class RpcStatus
+    {
+      kOk,             ///< 收到响应
+      kTimeout,        ///< 截止时间前未收到响应
+      kDisconnected,   ///< 连接断开，请求被放弃
+      kSendFailed,     ///< 请求发送失败
+      kProtocolError,  ///< 接收到无法解析的数据，连接上的请求全部失败
+      kCancelled       ///< 调用方取消或 RpcClient 被销毁
+    };
+
+    /**
+     * @brief RPC 调用结果（CallFuture 使用）
+     */
+    struct RpcResponse
+    {
+      RpcStatus status = RpcStatus::kOk;   ///< 调用结果状态
+      std::vector<uint8_t> data;           ///< 响应数据（仅 kOk 有效）
+    };
+
+    /**
+     * @brief RPC 客户端
+     *
+     * 挂载到一个 Client 上，接管其 OnMessage/OnDisconnected 回调。
+     * 断开通知请改用 RpcClient::SetOnDisconnected。
+     *
+     * 线程模型：
+     * - Call/CallFuture/Cancel 可以从任何线程调用
+     * - 响应回调在 Client 的 Worker 线程中执行
+     * - 超时回调同样在 Client 的 Worker 线程中执行，与响应回调串行
+     *   （截止时间由共享定时线程计时，连接已断开时在定时线程中回调）
+     * - 发送失败回调（kSendFailed）同样交给 Worker 线程执行；
+     *   连接已断开时在发现失败的线程中回调
+     * - 每个请求的回调保证恰好执行一次
+     *
+     * 注意事项：
+     * - RpcClient 必须在 Client 之前销毁
+     * - 请求 ID 由 RpcClient 分配，单调递增
+     */
+    class RpcClient
+    {
+    public:
+      /// 响应回调函数类型
+      using ResponseCallback =
+          std::function<void(RpcStatus status, const std::vector<uint8_t> &response)>;
+
+      /// 默认截止时间（毫秒）
+      static constexpr int kDefaultTimeoutMs = 5000;
+
+      /**
+       * @brief 构造 RpcClient 并接管 Client 的接收回调
+       * @param client 承载请求的客户端（生命周期必须长于 RpcClient）
+       */
+      explicit RpcClient(Client &client);
+
+      /**
+       * @brief 析构函数
+       *
+       * 所有未完成的请求以 kCancelled 结束，之后 Client 收到的数据被丢弃。
+       */
+      ~RpcClient();
+
+      // 禁止拷贝和移动
+      RpcClient(const RpcClient &) = delete;
+      RpcClient &operator=(const RpcClient &) = delete;
+
+      /**
+       * @brief 发起请求（回调方式）
+       * @param data 请求数据
+       * @param size 请求大小
+       * @param callback 完成回调（恰好调用一次）
+       * @param timeout_ms 截止时间（毫秒），0 表示不设截止时间
+       * @return 请求 ID；发送失败返回 0（回调以 kSendFailed 交给 Worker 执行，
+       *         连接已断开时在返回前调用）
+       */
+      uint64_t Call(const uint8_t *data, size_t size, ResponseCallback callback,
+                    int timeout_ms = kDefaultTimeoutMs);
+
+      /**
+       * @brief 发起请求（future 方式）
+       * @param data 请求数据
+       * @param size 请求大小
+       * @param timeout_ms 截止时间（毫秒），0 表示不设截止时间
+       * @return 结果 future
+       *
+       * 注意：不要在 Worker 线程中等待该 future，否则响应无法被处理。
+       */
+      std::future<RpcResponse> CallFuture(const uint8_t *data, size_t size,
+                                          int timeout_ms = kDefaultTimeoutMs);
+
+      /**
+       * @brief 取消未完成的请求
+       * @return 请求仍未完成并被取消返回 true（回调以 kCancelled 调用）
+       */
+      bool Cancel(uint64_t request_id);
+
+      /**
+       * @brief 获取未完成的请求数
+       */
+      size_t GetPendingCount() const;
+
+      /**
+       * @brief 设置断开回调（替代 Client::SetOnDisconnected）
+       */
+      void SetOnDisconnected(Client::OnDisconnectedCallback callback);
+
+      class Impl;
+
+    private:
+      std::shared_ptr<Impl> impl_;
+    };
+
+    /**
+     * @brief RPC 服务端
+     *
+     * 挂载到一个 Server 上，接管其 OnMessage/OnClientDisconnected 回调，
+     * 为每个连接维护独立的 proto::Decoder。
+     *
+     * 线程模型：
+     * - 请求处理回调在 Server 的 Worker 线程中执行（同一连接按序）
+     * - Respond 可以从任何线程调用，支持异步响应
+     *
+     * 注意事项：
+     * - 与 Server 的回调设置一样，必须在 Server 启动之前构造
+     */
+    class RpcServer
+    {
+    public:
+      /// 请求处理回调函数类型
+      /// @param connection_id 连接 ID
+      /// @param request_id 请求 ID（Respond 时原样传回）
+      /// @param request 请求数据
+      using RequestHandler =
+          std::function<void(uint64_t connection_id, uint64_t request_id,
+                             const std::vector<uint8_t> &request)>;
+
+      /**
+       * @brief 构造 RpcServer 并接管 Server 的接收回调
+       * @param server 服务器（生命周期必须长于 RpcServer）
+       */
+      explicit RpcServer(Server &server);
+
+      /**
+       * @brief 析构函数（之后 Server 收到的数据被丢弃）
+       */
+      ~RpcServer();
+
+      // 禁止拷贝和移动
+      RpcServer(const RpcServer &) = delete;
+      RpcServer &operator=(const RpcServer &) = delete;
+
+      /**
+       * @brief 设置请求处理回调
+       */
+      void SetRequestHandler(RequestHandler handler);
+
+      /**
+       * @brief 发送响应
+       * @param connection_id 连接 ID
+       * @param request_id 请求 ID
+       * @param data 响应数据
+       * @param size 响应大小
+       * @return 放入发送缓冲区成功返回 true
+       */
+      bool Respond(uint64_t connection_id, uint64_t request_id,
+                   const uint8_t *data, size_t size);
+
+      /**
+       * @brief 设置断开回调（替代 Server::SetOnClientDisconnected）
+       */
+      void SetOnClientDisconnected(Server::OnClientDisconnectedCallback callback);
+
+      class Impl;
+
+    private:
+      std::shared_ptr<Impl> impl_;
+    };
+
+  } // namespace network
+} // namespace darwincore
+
+#endif // DARWINCORE_NETWORK_RPC_H
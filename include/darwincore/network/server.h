@@ -38,16 +38,152 @@
 #ifndef DARWINCORE_NETWORK_SERVER_H
 #define DARWINCORE_NETWORK_SERVER_H
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
 
+#include <darwincore/network/configuration.h>
 #include <darwincore/network/event.h>
+#include <darwincore/network/event_loop_group.h>
 
 namespace darwincore {
 namespace network {
 
+/**
+ * @brief 服务器可选配置
+ *
+ * 默认构造的 ServerOptions 与 Server() 的行为完全一致。
+ *
+ * 使用示例：
+ *   @code
+ *   ServerOptions options;
+ *   options.write_coalescing = true;
+ *   Server server(options);
+ *   @endcode
+ */
+struct ServerOptions {
+  /// 写合并：同一轮事件循环中发往同一连接的多次 SendData 合并为一次
+  /// 聚集写（sendmsg + iovec），每轮结束前保证全部写入 socket 或发送缓冲区。
+  /// 适合大量小响应的场景，可显著减少系统调用和小报文数量。
+  bool write_coalescing = false;
+
+  /// 忙轮询混合模式：Reactor 在最近一次有工作后继续零超时轮询的时长，
+  /// 超过后才阻塞等待；同时按操作队列积压自适应调整批量。0 表示关闭。
+  /// 以 CPU 占用换取更低的尾延迟，适合延迟敏感的部署。
+  std::chrono::microseconds busy_poll_spin{0};
+
+  /// 同机共享内存快速通道：接受 Unix Domain Socket 客户端的升级握手，
+  /// 升级后的连接通过共享内存环收发数据，不再经过内核 socket 缓冲区。
+  /// 客户端需调用 Client::SetSharedMemoryTransport；回调语义不变。
+  bool shared_memory_transport = false;
+
+  /// 每个连接的入站限速（按读取字节数/读取次数）。超出预算的连接暂停读取，
+  /// 数据留在内核缓冲区中，令牌恢复后由 Reactor 自动恢复，不占用 CPU 和 Worker 队列。
+  /// 共享内存通道的入站数据同样计入，暂停期间数据留在环中。
+  RateLimit connection_ingress_limit;
+
+  /// 每个连接的出站限速（按 SendData 字节数/次数）。超出时同样暂停读取该连接，
+  /// 让产生响应的请求方放慢速度；已提交的数据不会被丢弃或延迟。
+  RateLimit connection_egress_limit;
+
+  /// 每个监听 socket 的入站限速，由该监听接受的所有连接共享。
+  RateLimit listener_ingress_limit;
+
+  /// 全服务端发送缓冲内存预算（字节，0 = 不限制）。所有连接尚未写出的
+  /// 数据之和超过预算的各级比例时依次：暂停积压连接的读取、SendData 返回
+  /// false、断开积压最多的连接，使慢速读取方再多内存占用也有上界。
+  size_t send_buffer_budget = 0;
+
+  /// 用量达到预算的该比例后，正在积压数据的连接暂停读取
+  double send_budget_pause_ratio = 0.7;
+
+  /// 用量达到预算的该比例后，SendData 直接返回 false
+  double send_budget_reject_ratio = 0.9;
+
+  /// 读公平性：每次读就绪事件最多从一个连接读取的字节数 / recv 次数
+  /// （0 = 不限制，读到 EAGAIN）。用尽后先处理同批次的其他连接，
+  /// 剩余数据在下一轮事件循环中继续读取，避免单个高速连接饿死其他连接。
+  /// 共享内存通道每次读取接收环同样受此预算约束。
+  size_t read_budget_bytes = 0;
+  size_t read_budget_reads = 0;
+
+  /// 自适应接收大小：单次 recv 的上限（字节）。批量传输的连接逐步增大到该值，
+  /// 小消息连接保持默认的 8KB。不大于 8KB 时关闭。
+  size_t max_receive_size = 0;
+
+  /// 发送缓冲区空闲回收：发送缓冲区在第一次需要缓存数据时才分配，写空后
+  /// 持续该时长没有新的发送活动即释放（初始大小的缓冲区留在 Reactor 中复用）。
+  /// 0 表示保留到连接关闭。大量空闲长连接的部署建议设为秒级。
+  std::chrono::milliseconds send_buffer_idle_release{0};
+
+  /// 弹性 Worker：Worker 线程数上限（0 = 关闭，固定 4 个 Worker）。开启后线程数
+  /// 在 [min_workers, max_workers] 之间伸缩：事件排队超过 worker_grow_latency 时
+  /// 增加一个线程，空闲超过 worker_idle_shrink 的线程退出。连接所在的槽每处理
+  /// 一批（最多 64 个）事件后可能换到另一个线程，同一连接的回调仍按序、串行执行。
+  size_t max_workers = 0;
+  size_t min_workers = 1;
+  std::chrono::microseconds worker_grow_latency{2000};
+  std::chrono::milliseconds worker_idle_shrink{2000};
+
+  /// Reactor 负载均衡评估间隔（0 = 关闭）。连接在 accept 时轮询分配到 Reactor，
+  /// 开启后按该间隔比较各 Reactor 的收发字节速率，最忙的 Reactor 超过平均值的
+  /// rebalance_threshold 倍时，把其中的热点连接在两轮 I/O 之间迁移到最空闲的
+  /// Reactor。connection_id、发送顺序、连接上下文与定时器都不受迁移影响；
+  /// 迁移期间发往该连接的数据最多延迟一轮事件循环。需要至少 2 个 Reactor。
+  /// 间隔最小 100ms（连接流量至少统计这么久才参与采样），更小的值按 100ms 处理。
+  std::chrono::milliseconds rebalance_interval{0};
+  double rebalance_threshold = 1.5;
+
+  /// 阻塞任务池线程数（0 = 不创建，RunBlocking 返回 false）。数据库、文件等
+  /// 会阻塞的操作放到该池中执行，不占用处理网络事件的 Worker。
+  size_t blocking_threads = 0;
+
+  /// 慢回调阈值（0 = 不检测）。连接的事件回调、Post 任务、定时器回调或
+  /// RunBlocking 的后续回调执行超过该时长时计数并触发 OnSlowCallback。
+  std::chrono::milliseconds slow_callback_threshold{0};
+
+  /// SetMessageRouter 分帧时单条消息的长度上限（字节，0 = 不限制）。连接上
+  /// 未凑满一条消息的数据超过该值时以 EMSGSIZE 断开连接，防止对端声明超长
+  /// 消息后让服务端无限缓存。
+  size_t max_message_size = 16 * 1024 * 1024;
+};
+
+/**
+ * @brief 服务器运行统计（所有 Reactor 汇总）
+ */
+struct ServerStatistics {
+  uint64_t total_connections = 0;      ///< 累计连接数
+  uint64_t active_connections = 0;     ///< 当前活跃连接数
+  uint64_t total_bytes_sent = 0;       ///< 累计发送字节数
+  uint64_t total_bytes_received = 0;   ///< 累计接收字节数
+  uint64_t total_coalesced_sends = 0;  ///< 写合并：被合并的发送次数
+  uint64_t total_shm_connections = 0;  ///< 升级到共享内存通道的连接数
+  uint64_t total_rate_limit_pauses = 0; ///< 因限速暂停读取的次数
+  uint64_t send_buffer_bytes = 0;      ///< 当前所有连接尚未写出的发送数据量
+  uint64_t send_budget_usage = 0;      ///< 当前计入内存预算的用量（含排队中的发送）
+  uint64_t send_budget_rejects = 0;    ///< 因内存预算被拒绝的 SendData 次数
+  uint64_t send_budget_disconnects = 0; ///< 因内存预算被断开的连接数
+  uint64_t busy_poll_spin_us = 0;      ///< 忙轮询：空转时间（微秒）
+  uint64_t busy_poll_parked_us = 0;    ///< 忙轮询：阻塞等待时间（微秒）
+  uint64_t total_read_yields = 0;      ///< 读预算用尽、留待下一轮继续读取的次数
+  uint64_t connection_memory_bytes = 0; ///< 库为所有连接持有的内存（除以 active_connections 即每连接开销）
+  uint64_t send_buffer_capacity_bytes = 0; ///< 其中发送缓冲区已分配的容量
+  uint64_t send_buffer_releases = 0;   ///< 空闲回收的发送缓冲区数
+  uint64_t total_priority_bypasses = 0; ///< 排在积压批量数据之前写出的控制发送次数
+  uint64_t connection_migrations = 0;   ///< 负载均衡在 Reactor 间迁移的连接数
+  size_t worker_threads = 0;            ///< 当前 Worker 线程数
+  uint64_t worker_scale_ups = 0;        ///< 弹性 Worker 扩容次数
+  uint64_t worker_scale_downs = 0;      ///< 弹性 Worker 缩容次数
+  uint64_t slow_callbacks = 0;          ///< 执行超过 slow_callback_threshold 的回调次数
+  size_t blocking_queue_size = 0;       ///< 阻塞任务池中排队（尚未开始执行）的任务数
+  uint64_t message_batches = 0;         ///< OnMessageBatch 调用次数
+  uint64_t batched_messages = 0;        ///< 经 OnMessageBatch 交付的数据事件数
+  uint64_t keyed_messages = 0;          ///< 经 MessageRouter 按 key 分发的数据事件数
+  uint64_t dropped_keyed_messages = 0;  ///< 目标 Worker 队列满而丢弃的按 key 消息数（来源连接被断开）
+};
+
 /**
  * @brief 网络服务器类
  *
@@ -83,6 +219,34 @@ public:
       std::function<void(uint64_t connection_id,
                          const std::vector<uint8_t>& data)>;
 
+  /// 一批中属于同一连接的数据（按到达顺序）
+  struct ConnectionMessages {
+    uint64_t connection_id = 0;
+    void* context = nullptr;                     ///< 连接上下文（未设置工厂时为 nullptr）
+    std::vector<std::vector<uint8_t>> messages;  ///< 每个元素对应一次读取
+  };
+
+  /// 批量消息回调函数类型
+  /// @param batch 一个 Worker 一次取出的全部数据事件，按连接分组
+  ///              （连接按首次出现的顺序排列）
+  using OnMessageBatchCallback =
+      std::function<void(const std::vector<ConnectionMessages>& batch)>;
+
+  /// 消息分帧函数（在连接的 Worker 线程中调用）
+  /// @param data 连接上尚未切分的数据
+  /// @param size 数据长度
+  /// @return data 开头第一条完整消息的长度；不足一条消息时返回 0
+  using MessageFramer = std::function<size_t(const uint8_t* data, size_t size)>;
+
+  /// 消息路由函数（在连接的 Worker 线程中、对分帧后的每条消息调用）
+  /// @param data 一条完整消息
+  /// @param key 输出：路由 key（租户、分区等）
+  /// @return true 表示按 key 分发；false 表示按连接分发（默认行为）
+  using MessageRouter =
+      std::function<bool(uint64_t connection_id,
+                         const std::vector<uint8_t>& data,
+                         uint64_t& key)>;
+
   /// 客户端断开回调函数类型
   /// @param connection_id 连接 ID
   using OnClientDisconnectedCallback = std::function<void(uint64_t connection_id)>;
@@ -96,6 +260,49 @@ public:
                          NetworkError error,
                          const std::string& message)>;
 
+  /// 连接上下文：由库持有的每连接用户状态（类型擦除，删除器随 shared_ptr 保存）
+  using ConnectionContext = std::shared_ptr<void>;
+
+  /// 连接上下文工厂：连接建立时在该连接的 Worker 线程中调用
+  /// @param info 连接信息
+  /// @return 该连接的上下文（可为空）
+  using ConnectionContextFactory =
+      std::function<ConnectionContext(const ConnectionInformation& info)>;
+
+  /// 带上下文的消息接收回调函数类型
+  /// @param context 连接上下文（工厂返回值的 get()，未设置工厂时为 nullptr）
+  using OnContextMessageCallback =
+      std::function<void(uint64_t connection_id,
+                         const std::vector<uint8_t>& data,
+                         void* context)>;
+
+  /// 带上下文的客户端断开回调函数类型（回调返回后上下文被销毁）
+  using OnContextDisconnectedCallback =
+      std::function<void(uint64_t connection_id, void* context)>;
+
+  /// 带上下文的连接错误回调函数类型
+  using OnContextConnectionErrorCallback =
+      std::function<void(uint64_t connection_id,
+                         NetworkError error,
+                         const std::string& message,
+                         void* context)>;
+
+  /// 投递到连接所在 Worker 线程执行的任务
+  /// @param context 该连接的上下文（未设置工厂或连接已断开时为 nullptr）
+  using ConnectionTask = std::function<void(void* context)>;
+
+  /// 连接定时器 ID（0 表示无效）
+  using TimerId = uint64_t;
+
+  /// 在阻塞任务池中执行的操作
+  using BlockingTask = std::function<void()>;
+
+  /// 慢回调通知（在该连接的 Worker 线程中、回调返回后调用）
+  /// @param connection_id 连接 ID
+  /// @param elapsed 回调执行时长
+  using OnSlowCallbackCallback =
+      std::function<void(uint64_t connection_id, std::chrono::microseconds elapsed)>;
+
   /**
    * @brief 构造 Server 对象
    *
@@ -103,6 +310,33 @@ public:
    */
   Server();
 
+  /**
+   * @brief 使用自定义配置构造 Server 对象
+   * @param options 服务器配置
+   */
+  explicit Server(const ServerOptions& options);
+
+  /**
+   * @brief 构造挂在共享事件循环组上的 Server
+   * @param loop_group 共享事件循环组（nullptr 等价于 Server(options)）
+   * @param options 服务器配置
+   *
+   * 连接的 I/O 和回调由 loop_group 的线程负责，Server 自己只创建 Acceptor
+   * 线程（以及 blocking_threads 个阻塞任务线程）。同一进程中监听多个端口或
+   * 路径的 Server 共用一个组时，线程数只与组的大小相关。
+   *
+   * 与独立模式的差异：
+   * - 组内线程按默认配置运行，Reactor/Worker 级选项（写合并、忙轮询、读预算、
+   *   自适应接收、缓冲区回收、弹性 Worker）不生效，设置时启动日志给出警告
+   * - 不支持 SetOnMessageBatch / SetMessageRouter（它们作用于整个 WorkerPool），
+   *   也不支持保护性选项（connection_ingress_limit、connection_egress_limit、
+   *   send_buffer_budget、shared_memory_transport），设置后启动失败
+   * - Stop() 只关闭本 Server 的连接（与独立模式相同，不触发断开回调），组继续运行
+   * - GetStatistics() 的连接数为本 Server 的连接，字节数等 Reactor 统计为整个组的汇总
+   */
+  explicit Server(std::shared_ptr<EventLoopGroup> loop_group,
+                  const ServerOptions& options = ServerOptions());
+
   /**
    * @brief 析构函数
    *
@@ -190,6 +424,29 @@ public:
                 const uint8_t* data,
                 size_t size);
 
+  /**
+   * @brief 按优先级向指定连接发送数据
+   * @param priority kControl 的数据排在该连接已积压的 kBulk 数据之前写出
+   *
+   * 插队发生在两次 SendData 之间的边界处：正在写出的那次批量发送会先写完，
+   * 因此对端看到的每次发送仍是连续的字节流。没有积压时与 SendData 相同。
+   * 控制缓冲区只在有控制数据积压时分配：此前积压的批量数据整体先写完，
+   * 之后的批量发送才记录边界供插队。控制缓冲区到达高水位同样暂停读取。
+   */
+  bool SendData(uint64_t connection_id,
+                const uint8_t* data,
+                size_t size,
+                SendPriority priority);
+
+  // ==================== 统计 ====================
+
+  /**
+   * @brief 获取运行统计（所有 Reactor 汇总）
+   *
+   * 服务器未运行时返回全零。
+   */
+  ServerStatistics GetStatistics() const;
+
   // ==================== 设置回调 ====================
 
   /**
@@ -227,6 +484,256 @@ public:
    */
   void SetOnConnectionError(OnConnectionErrorCallback callback);
 
+  /**
+   * @brief 设置慢回调通知
+   * @param callback 回调执行超过 ServerOptions::slow_callback_threshold 时调用
+   *
+   * 用于找出在 Worker 中做了阻塞操作的连接：同一 Worker 上的其他连接
+   * 会被它拖慢，这类操作应改用 RunBlocking。
+   */
+  void SetOnSlowCallback(OnSlowCallbackCallback callback);
+
+  // ==================== 连接上下文 ====================
+
+  /**
+   * @brief 设置连接上下文工厂
+   * @param factory 连接建立时创建上下文的函数
+   *
+   * 同一连接的所有事件由同一个 Worker 线程按序处理，上下文保存在该 Worker
+   * 独占的表中：工厂在 OnClientConnected 之前调用，之后的每个带上下文回调
+   * 都直接拿到该指针，业务层无需自行维护加锁的 connection_id → 状态映射。
+   * 上下文在断开回调（含 OnClientDisconnected）全部返回后销毁；
+   * Stop() 时尚未断开的连接的上下文在 Worker 停止后统一销毁。
+   *
+   * 必须在启动服务器之前设置。
+   *
+   * 使用示例：
+   *   @code
+   *   server.SetConnectionContextFactory([](const ConnectionInformation& info) {
+   *     return std::make_shared<Session>(info.connection_id);
+   *   });
+   *   server.SetOnContextMessage([](uint64_t id, const std::vector<uint8_t>& data,
+   *                                 void* context) {
+   *     static_cast<Session*>(context)->Feed(data);  // 无锁，无查找
+   *   });
+   *   @endcode
+   */
+  void SetConnectionContextFactory(ConnectionContextFactory factory);
+
+  /**
+   * @brief 设置带上下文的消息接收回调
+   *
+   * 与 SetOnMessage 相互独立，两者都设置时先调用 OnMessage。
+   */
+  void SetOnContextMessage(OnContextMessageCallback callback);
+
+  /**
+   * @brief 设置带上下文的客户端断开回调
+   *
+   * 在 OnClientDisconnected 之后调用，返回后上下文被销毁。
+   */
+  void SetOnContextDisconnected(OnContextDisconnectedCallback callback);
+
+  /**
+   * @brief 设置带上下文的连接错误回调
+   *
+   * 在 OnConnectionError 之后调用。
+   */
+  void SetOnContextConnectionError(OnContextConnectionErrorCallback callback);
+
+  /**
+   * @brief 设置批量消息回调（必须在 Start 之前设置）
+   * @param callback Worker 一次取出的数据事件按连接分组后一次交付
+   *
+   * 设置后数据不再经过 OnMessage / OnContextMessage。Worker 取出一个数据事件后
+   * 继续取出队列中已排队的数据事件（最多 64 个）合成一批，遇到连接、断开事件
+   * 或 Post/定时器任务时先交付已有的一批，所以它们与数据的相对顺序不变。
+   * 适合把逐条消息的开销（数据库写入、日志追加、响应刷新）摊到一批上。
+   *
+   * 使用示例：
+   *   @code
+   *   server.SetOnMessageBatch([&](const std::vector<Server::ConnectionMessages>& batch) {
+   *     Transaction txn = db.Begin();  // 一批只提交一次
+   *     for (const auto& conn : batch) {
+   *       for (const auto& data : conn.messages) {
+   *         txn.Append(conn.connection_id, data);
+   *       }
+   *     }
+   *     txn.Commit();
+   *   });
+   *   @endcode
+   */
+  void SetOnMessageBatch(OnMessageBatchCallback callback);
+
+  /**
+   * @brief 设置消息分帧与路由函数（必须在 Start 之前设置）
+   * @param framer 从连接的字节流中切出完整消息
+   * @param router 从一条完整消息中取出路由 key
+   *
+   * 默认按 connection_id 把数据分发给 Worker，访问同一个热点 key 的多个连接
+   * 会落在不同 Worker 上，key 的状态只能加锁共享。设置路由函数后，连接的数据
+   * 先在该连接的 Worker 上按 framer 切成完整消息（跨读取的半条消息留到下次拼接），
+   * 再对每条消息调用 router：返回 true 的消息转给 key 的散列对应的 Worker，
+   * 同一 key 的消息不论来自哪个连接都由同一个 Worker 串行处理，按 key 分片的
+   * 状态（例如 thread_local 的表）无需加锁；返回 false 的消息留在连接的 Worker。
+   *
+   * 注意：
+   * - framer/router 在连接的 Worker 线程中执行，须快速返回
+   * - 每次回调交付的 data 是一条完整消息；连接断开时未凑满一条消息的数据被丢弃
+   * - 未凑满的半条消息超过 ServerOptions::max_message_size 时连接以 EMSGSIZE 断开
+   * - 按 key 分发的消息只与同一连接、同一 key 的消息保持顺序，可能在
+   *   OnClientDisconnected 之后才被处理
+   * - 按 key 分发的消息不在连接的 Worker 上处理，OnContextMessage 的 context
+   *   和 ConnectionMessages::context 为 nullptr（批量回调中单独成组）
+   * - Worker 之间转发不等待队列空间；转发失败（WorkerPool 正在停止）时消息被丢弃，
+   *   计入 ServerStatistics::dropped_keyed_messages，来源连接以 ENOBUFS 断开
+   *   （OnError 后 OnClientDisconnected），之后的数据不再交付，不会留下缺口
+   *
+   * 使用示例：
+   *   @code
+   *   // 消息格式：[len:u32][tenant:u32][body]
+   *   server.SetMessageRouter(
+   *       [](const uint8_t* data, size_t size) -> size_t {
+   *         uint32_t len;
+   *         if (size < sizeof(len)) {
+   *           return 0;
+   *         }
+   *         std::memcpy(&len, data, sizeof(len));
+   *         return size >= sizeof(len) + len ? sizeof(len) + len : 0;
+   *       },
+   *       [](uint64_t, const std::vector<uint8_t>& data, uint64_t& key) {
+   *         if (data.size() < 2 * sizeof(uint32_t)) {
+   *           return false;
+   *         }
+   *         uint32_t tenant;
+   *         std::memcpy(&tenant, data.data() + sizeof(uint32_t), sizeof(tenant));
+   *         key = tenant;
+   *         return true;
+   *       });
+   *   @endcode
+   */
+  void SetMessageRouter(MessageFramer framer, MessageRouter router);
+
+  // ==================== 连接线程任务 ====================
+
+  /**
+   * @brief 在指定连接的 Worker 线程中执行任务
+   * @param connection_id 连接 ID（决定由哪个 Worker 执行）
+   * @param task 要执行的任务
+   * @return 已入队返回 true；服务器未运行、WorkerPool 已停止或 Worker 队列满返回 false
+   *
+   * 任务与该连接的网络事件进入同一个 Worker 队列，按提交顺序执行：
+   * 在 Post 之前已分发的事件先处理，之后的事件后处理。配合连接上下文，
+   * 其他线程对连接状态的修改也无需加锁。
+   *
+   * 此方法可以从任何线程调用（包括回调函数），不会阻塞：Worker 队列已满或
+   * WorkerPool 已停止时立即返回 false，任务被丢弃、不会执行，由调用方决定重试或放弃。
+   * 连接已断开时任务仍会执行，此时 context 为 nullptr。
+   *
+   * 使用示例：
+   *   @code
+   *   server.Post(conn_id, [](void* context) {
+   *     if (auto* session = static_cast<Session*>(context)) {
+   *       session->Kick();  // 与 OnContextMessage 在同一线程，无需加锁
+   *     }
+   *   });
+   *   @endcode
+   */
+  bool Post(uint64_t connection_id, ConnectionTask task);
+
+  /**
+   * @brief 延迟后在指定连接的 Worker 线程中执行任务
+   * @param connection_id 连接 ID
+   * @param delay 延迟时间（由 Worker 的时间轮驱动，精度约 10ms，只会晚不会早）
+   * @param task 到期后执行的任务
+   * @return 已入队返回 true；服务器未运行、WorkerPool 已停止或 Worker 队列满返回 false
+   *
+   * 与 Post 一样不会阻塞：返回 false 时任务被丢弃、不会执行。
+   * 到期时连接已断开则 context 为 nullptr。Stop() 时尚未到期的任务被丢弃。
+   */
+  bool PostAfter(uint64_t connection_id,
+                 std::chrono::milliseconds delay,
+                 ConnectionTask task);
+
+  // ==================== 阻塞任务 ====================
+
+  /**
+   * @brief 在阻塞任务池中执行操作，完成后回到连接的 Worker 继续处理
+   * @param connection_id 连接 ID（决定 resume 在哪个 Worker 执行）
+   * @param work 会阻塞的操作（在阻塞任务池线程中执行）
+   * @param resume work 返回后在该连接的 Worker 线程中执行（可为空）
+   * @return 已入队返回 true；服务器未运行或未配置 blocking_threads 返回 false
+   *
+   * work 执行期间 Worker 继续处理其他连接的事件；同一连接后续到达的事件
+   * 也照常分发，需要等待结果的请求由调用方在连接上下文中排队。
+   * work 抛出的异常被记录，resume 仍会执行。resume 执行时连接已断开则
+   * context 为 nullptr。Stop() 会等待已提交的 work 全部执行完。
+   *
+   * 使用示例：
+   *   @code
+   *   server.SetOnContextMessage([&](uint64_t id, const std::vector<uint8_t>& data, void*) {
+   *     auto row = std::make_shared<std::string>();
+   *     server.RunBlocking(id,
+   *         [row, key = ParseKey(data)] { *row = db.Query(key); },  // 阻塞任务池
+   *         [&, id, row](void* context) {                          // 回到 Worker
+   *           server.SendData(id, reinterpret_cast<const uint8_t*>(row->data()), row->size());
+   *         });
+   *   });
+   *   @endcode
+   */
+  bool RunBlocking(uint64_t connection_id, BlockingTask work, ConnectionTask resume);
+
+  // ==================== 连接定时器 ====================
+
+  /**
+   * @brief 添加归属于连接的一次性定时器
+   * @param connection_id 连接 ID
+   * @param delay 延迟时间（精度约 10ms，只会晚不会早）
+   * @param task 到期回调
+   * @return 定时器 ID；服务器未运行返回 0
+   *
+   * 定时器由该连接所在 Worker 线程的时间轮驱动，回调与该连接的
+   * 网络事件在同一线程执行，适合请求超时、重传等逐连接的截止时间。
+   * 连接断开（OnClientDisconnected 返回）后，其未触发的定时器自动取消；
+   * 对未知或已断开的连接添加的定时器会被丢弃，回调不会执行。
+   */
+  TimerId RunAfter(uint64_t connection_id,
+                   std::chrono::milliseconds delay,
+                   ConnectionTask task);
+
+  /**
+   * @brief 添加归属于连接的周期定时器
+   * @param connection_id 连接 ID
+   * @param interval 触发间隔（从上次回调返回时重新计时）
+   * @param task 每次到期的回调
+   * @return 定时器 ID；服务器未运行返回 0
+   *
+   * 首次在 interval 后触发。直到 CancelTimer 或连接断开为止。
+   *
+   * 使用示例：
+   *   @code
+   *   server.SetOnClientConnected([&](const ConnectionInformation& info) {
+   *     server.RunEvery(info.connection_id, std::chrono::seconds(15),
+   *                     [&, id = info.connection_id](void* context) {
+   *       server.SendData(id, kPing, sizeof(kPing));  // 心跳
+   *     });
+   *   });
+   *   @endcode
+   */
+  TimerId RunEvery(uint64_t connection_id,
+                   std::chrono::milliseconds interval,
+                   ConnectionTask task);
+
+  /**
+   * @brief 取消连接定时器，O(1)
+   * @param timer_id RunAfter / RunEvery 返回的 ID
+   * @return 定时器被取消（或取消请求已提交）返回 true
+   *
+   * 在该连接的回调或定时器回调中调用时立即生效（包括在周期回调中取消自身）；
+   * 从其他线程调用时异步生效，请求送达 Worker 之前已到期的回调仍会执行一次。
+   */
+  bool CancelTimer(TimerId timer_id);
+
 private:
   /// Pimpl 实现（隐藏内部细节）
   class Impl;
@@ -0,0 +1,252 @@
+//
+// DarwinCore Network 模块
+// UDP 数据报服务器/客户端
+//
+// 功能说明：
+//   在 Reactor-Worker 架构上提供无连接的数据报收发，面向遥测采集等
+//   高包量场景：
+//   - Reactor 线程每次可读事件中批量接收数据报（每批 batch_size 个）
+//   - 接收缓冲区来自预分配的缓冲池，整批交给 Worker 后在回调结束时归还
+//   - 每个数据报连同对端地址一起交给回调，不做字符串转换
+//   - 发送直接在调用线程中完成（UDP 不需要发送缓冲），支持批量发送
+//
+// 使用示例：
+//   @code
+//   darwincore::network::UdpServer server;
+//   server.SetOnDatagram([&](const DatagramPeer &peer, const uint8_t *data, size_t size) {
+//     server.SendTo(peer, data, size);  // 回显
+//   });
+//   server.StartIPv4("0.0.0.0", 9000);
+//
+//   darwincore::network::UdpClient client;
+//   client.SetOnDatagram([](const uint8_t *data, size_t size) { /* ... */ });
+//   client.ConnectIPv4("127.0.0.1", 9000);
+//   client.Send(data, size);
+//   @endcode
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_NETWORK_UDP_H
+#define DARWINCORE_NETWORK_UDP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <sys/socket.h>
+#include <vector>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    /**
+     * @brief 数据报对端地址
+     *
+     * 直接保存 sockaddr，回调路径上不做任何转换；
+     * 需要可读形式时再调用 GetAddress/GetPort。
+     */
+    struct DatagramPeer
+    {
+      sockaddr_storage address{};   ///< 对端地址
+      socklen_t length = 0;         ///< 地址长度
+
+      /// 获取对端 IP 地址字符串
+      std::string GetAddress() const;
+
+      /// 获取对端端口号
+      uint16_t GetPort() const;
+    };
+
+    /**
+     * @brief 待发送的数据报（SendBatch 使用）
+     */
+    struct OutgoingDatagram
+    {
+      DatagramPeer peer;            ///< 目标地址（UdpClient 忽略）
+      const uint8_t *data = nullptr;
+      size_t size = 0;
+    };
+
+    /**
+     * @brief UDP 可选配置
+     */
+    struct UdpOptions
+    {
+      /// Worker（回调）线程数
+      size_t worker_count = 1;
+
+      /// 每批最多接收的数据报数（整批一次交给 Worker）
+      size_t batch_size = 64;
+
+      /// 单个数据报的最大长度，超过的数据报被截断并丢弃
+      size_t max_datagram_size = 2048;
+
+      /// 预分配的接收缓冲区个数；耗尽时新数据报被读出并丢弃
+      size_t buffer_pool_size = 8192;
+
+      /// socket 接收缓冲区大小（SO_RCVBUF），0 表示使用系统默认值
+      int socket_receive_buffer = 4 * 1024 * 1024;
+    };
+
+    /**
+     * @brief UDP 运行统计
+     */
+    struct UdpStatistics
+    {
+      uint64_t datagrams_received = 0;   ///< 交给回调的数据报数
+      uint64_t bytes_received = 0;       ///< 交给回调的字节数
+      uint64_t datagrams_sent = 0;       ///< 发送成功的数据报数
+      uint64_t bytes_sent = 0;           ///< 发送成功的字节数
+      uint64_t batches_dispatched = 0;   ///< 分发给 Worker 的批次数
+      uint64_t dropped_datagrams = 0;    ///< 缓冲池耗尽或 Worker 队列满而丢弃的数据报数
+      uint64_t truncated_datagrams = 0;  ///< 超过 max_datagram_size 被丢弃的数据报数
+      uint64_t send_failures = 0;        ///< 发送失败（含 socket 缓冲区满）的次数
+    };
+
+    /**
+     * @brief UDP 数据报服务器
+     *
+     * 线程模型：
+     * - 1 个 Reactor 线程：批量接收数据报
+     * - worker_count 个 Worker 线程：执行 OnDatagram 回调
+     * - SendTo/SendBatch 可以从任何线程调用（包括回调中），
+     *   但回调之外的线程不应与 Stop 并发调用
+     *
+     * 注意事项：
+     * - 回调中的 data 指向缓冲池，回调返回后即失效
+     * - UDP 不保证送达与顺序；批次按轮询分配给 Worker，
+     *   worker_count > 1 时不同批次之间的回调顺序不确定
+     */
+    class UdpServer
+    {
+    public:
+      /// 数据报接收回调函数类型
+      using OnDatagramCallback =
+          std::function<void(const DatagramPeer &peer, const uint8_t *data, size_t size)>;
+
+      UdpServer();
+      explicit UdpServer(const UdpOptions &options);
+      ~UdpServer();
+
+      // 禁止拷贝和移动
+      UdpServer(const UdpServer &) = delete;
+      UdpServer &operator=(const UdpServer &) = delete;
+
+      /**
+       * @brief 绑定 IPv4 地址并开始接收
+       * @param host 绑定地址
+       * @param port 端口号（0 表示由系统分配，可通过 GetLocalPort 获取）
+       */
+      bool StartIPv4(const std::string &host, uint16_t port);
+
+      /**
+       * @brief 绑定 IPv6 地址并开始接收
+       */
+      bool StartIPv6(const std::string &host, uint16_t port);
+
+      /**
+       * @brief 停止接收并等待所有回调结束
+       */
+      void Stop();
+
+      /**
+       * @brief 发送一个数据报
+       * @return 完整发送返回 true；socket 缓冲区满或出错返回 false（不重试，errno 给出原因）
+       */
+      bool SendTo(const DatagramPeer &peer, const uint8_t *data, size_t size);
+
+      /**
+       * @brief 批量发送数据报
+       * @return 成功发送的个数（遇到缓冲区满时停止）
+       */
+      size_t SendBatch(const std::vector<OutgoingDatagram> &datagrams);
+
+      /**
+       * @brief 设置数据报接收回调（必须在 Start 之前调用）
+       */
+      void SetOnDatagram(OnDatagramCallback callback);
+
+      /**
+       * @brief 获取实际绑定的端口号（未启动返回 0）
+       */
+      uint16_t GetLocalPort() const;
+
+      /**
+       * @brief 获取运行统计
+       */
+      UdpStatistics GetStatistics() const;
+
+    private:
+      class Impl;
+      std::unique_ptr<Impl> impl_;
+    };
+
+    /**
+     * @brief UDP 数据报客户端（已连接的 UDP socket）
+     *
+     * 只接收来自所连接地址的数据报；线程模型与 UdpServer 相同。
+     */
+    class UdpClient
+    {
+    public:
+      /// 数据报接收回调函数类型
+      using OnDatagramCallback = std::function<void(const uint8_t *data, size_t size)>;
+
+      UdpClient();
+      explicit UdpClient(const UdpOptions &options);
+      ~UdpClient();
+
+      // 禁止拷贝和移动
+      UdpClient(const UdpClient &) = delete;
+      UdpClient &operator=(const UdpClient &) = delete;
+
+      /**
+       * @brief 连接到 IPv4 地址（UDP connect，只设置默认对端）
+       */
+      bool ConnectIPv4(const std::string &host, uint16_t port);
+
+      /**
+       * @brief 连接到 IPv6 地址
+       */
+      bool ConnectIPv6(const std::string &host, uint16_t port);
+
+      /**
+       * @brief 关闭 socket 并等待所有回调结束
+       */
+      void Close();
+
+      /**
+       * @brief 发送一个数据报
+       * @return 完整发送返回 true；socket 缓冲区满或出错返回 false（不重试，errno 给出原因）
+       */
+      bool Send(const uint8_t *data, size_t size);
+
+      /**
+       * @brief 批量发送数据报（忽略 OutgoingDatagram::peer）
+       * @return 成功发送的个数
+       */
+      size_t SendBatch(const std::vector<OutgoingDatagram> &datagrams);
+
+      /**
+       * @brief 设置数据报接收回调（必须在 Connect 之前调用）
+       */
+      void SetOnDatagram(OnDatagramCallback callback);
+
+      /**
+       * @brief 获取运行统计
+       */
+      UdpStatistics GetStatistics() const;
+
+    private:
+      class Impl;
+      std::unique_ptr<Impl> impl_;
+    };
+
+  } // namespace network
+} // namespace darwincore
+
+#endif // DARWINCORE_NETWORK_UDP_H
@@ -80,6 +80,18 @@ namespace darwincore
       reactors_ = reactors;
     }
 
+    void Acceptor::SetRateLimiter(std::shared_ptr<SharedRateLimiter> limiter)
+    {
+      rate_limiter_ = std::move(limiter);
+    }
+
+    void Acceptor::SetConnectionRegistrar(ConnectionRegistrar on_assign,
+                                          ConnectionRegistrar on_reject)
+    {
+      on_assign_ = std::move(on_assign);
+      on_reject_ = std::move(on_reject);
+    }
+
     void Acceptor::Stop()
     {
       // 使用 compare_exchange 确保只执行一次停止逻辑
@@ -409,9 +421,23 @@ namespace darwincore
 
       // 将 fd 添加到 Reactor（Reactor 内部会提交 kConnected 事件）
       // 注意：AddConnection 现在是异步的，connection_id 将在 Reactor 线程中生成
-      bool success = reactor->AddConnection(fd, peer);
+      Reactor::ConnectionOptions options;
+      options.listener_limiter = rate_limiter_;
+
+      // 需要登记时预分配 connection_id，保证 kConnected 事件能找到登记方
+      if (on_assign_)
+      {
+        options.connection_id = reactor->AllocateConnectionId(fd);
+        on_assign_(options.connection_id);
+      }
+
+      bool success = reactor->AddConnection(fd, peer, options);
       if (!success)
       {
+        if (on_reject_ && options.connection_id != 0)
+        {
+          on_reject_(options.connection_id);
+        }
         NW_LOG_ERROR(
             "[Acceptor::AssignToReactor] Reactor::AddConnection 失败，关闭 fd="
             << fd);
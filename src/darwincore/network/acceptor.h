@@ -31,6 +31,7 @@ namespace network {
 // 前向声明
 class Reactor;
 class IOMonitor;
+class SharedRateLimiter;
 
 /**
  * @brief Acceptor - 服务器监听器
@@ -55,6 +56,9 @@ class IOMonitor;
  */
 class Acceptor {
 public:
+  /// 连接登记回调（参数为预分配的 connection_id）
+  using ConnectionRegistrar = std::function<void(uint64_t connection_id)>;
+
   /**
    * @brief 构造 Acceptor 对象
    */
@@ -124,6 +128,22 @@ public:
    */
   void SetReactors(const std::vector<std::weak_ptr<Reactor>> &reactors);
 
+  /**
+   * @brief 设置监听级入站限速器（可选，需在监听前调用）
+   * @param limiter 由本监听接受的所有连接共享，Reactor 线程中扣减
+   */
+  void SetRateLimiter(std::shared_ptr<SharedRateLimiter> limiter);
+
+  /**
+   * @brief 设置连接登记回调（可选，需在监听前调用）
+   * @param on_assign 连接交给 Reactor 之前调用，此时 kConnected 事件尚未产生
+   * @param on_reject Reactor 拒绝该连接时调用，撤销 on_assign 的登记
+   *
+   * 共享事件循环组中多个 Server 共用 Reactor 和 Worker，Server 借此在事件
+   * 到达 Worker 之前建立 connection_id 到自身的路由。
+   */
+  void SetConnectionRegistrar(ConnectionRegistrar on_assign, ConnectionRegistrar on_reject);
+
   // ==================== 停止监听 ====================
 
   /**
@@ -178,6 +198,9 @@ private:
 
   std::vector<std::weak_ptr<Reactor>> reactors_; ///< Reactor 线程池（weak_ptr，非 owning）
   std::atomic<size_t> next_reactor_index_; ///< 下一个分配的 Reactor 索引（轮询）
+  std::shared_ptr<SharedRateLimiter> rate_limiter_; ///< 监听级入站限速器（可为空）
+  ConnectionRegistrar on_assign_;         ///< 连接登记回调（可为空）
+  ConnectionRegistrar on_reject_;         ///< 撤销登记回调（可为空）
 };
 
 } // namespace network
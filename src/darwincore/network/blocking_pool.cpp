@@ -0,0 +1,109 @@
+//
+// DarwinCore Network 模块
+// BlockingPool 实现
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include "blocking_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include <darwincore/network/logger.h>
+#include <pthread.h>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    BlockingPool::BlockingPool(size_t thread_count)
+        : thread_count_(std::max<size_t>(thread_count, 1)) {}
+
+    BlockingPool::~BlockingPool() { Stop(); }
+
+    bool BlockingPool::Start()
+    {
+      if (is_running_)
+      {
+        return false;
+      }
+
+      is_running_ = true;
+      queue_.Reset();
+      for (size_t i = 0; i < thread_count_; ++i)
+      {
+        threads_.emplace_back(&BlockingPool::ThreadLoop, this, i);
+      }
+
+      NW_LOG_INFO("[BlockingPool] 启动: " << thread_count_ << " 个线程");
+      return true;
+    }
+
+    void BlockingPool::Stop()
+    {
+      if (!is_running_.exchange(false))
+      {
+        return;
+      }
+
+      queue_.NotifyStop();
+      for (auto &thread : threads_)
+      {
+        if (thread.joinable())
+        {
+          thread.join();
+        }
+      }
+      threads_.clear();
+
+      NW_LOG_INFO("[BlockingPool] 停止");
+    }
+
+    bool BlockingPool::Submit(Task task)
+    {
+      if (!task || !is_running_)
+      {
+        return false;
+      }
+      return queue_.TryEnqueue(std::move(task));
+    }
+
+    void BlockingPool::ThreadLoop(size_t index)
+    {
+      pthread_setname_np(("darwincore.network.blocking." + std::to_string(index)).c_str());
+
+      Task task;
+      while (is_running_)
+      {
+        if (queue_.WaitDequeue(task, std::chrono::milliseconds(100)))
+        {
+          RunTask(task);
+          task = nullptr;
+        }
+      }
+
+      // 已接受的任务都要执行，完成回调才能投递回 Worker
+      while (queue_.TryDequeue(task))
+      {
+        RunTask(task);
+        task = nullptr;
+      }
+    }
+
+    void BlockingPool::RunTask(const Task &task)
+    {
+      try
+      {
+        task();
+      }
+      catch (const std::exception &e)
+      {
+        NW_LOG_ERROR("[BlockingPool] 任务异常: " << e.what());
+      }
+    }
+
+  } // namespace network
+} // namespace darwincore
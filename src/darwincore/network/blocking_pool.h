@@ -0,0 +1,85 @@
+//
+// DarwinCore Network 模块
+// BlockingPool - 阻塞任务线程池
+//
+// 功能说明：
+//   执行会阻塞的业务操作（数据库、文件、外部服务调用），避免占住 Worker。
+//   所有线程共享一个任务队列，谁空闲谁执行，不保证任务之间的顺序；
+//   需要回到连接线程的后续处理由调用方（Server::RunBlocking）投递回 WorkerPool。
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_NETWORK_BLOCKING_POOL_H
+#define DARWINCORE_NETWORK_BLOCKING_POOL_H
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "concurrent_queue.h"
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    /**
+     * @brief 阻塞任务线程池
+     *
+     * 线程安全：Submit 可以从任何线程调用。
+     * Stop() 等待正在执行的任务结束，并在线程退出前执行完已入队的任务。
+     */
+    class BlockingPool
+    {
+    public:
+      using Task = std::function<void()>;
+
+      /**
+       * @brief 构造阻塞任务线程池
+       * @param thread_count 线程数（0 按 1 计）
+       */
+      explicit BlockingPool(size_t thread_count);
+
+      /// 析构函数 - 停止所有线程
+      ~BlockingPool();
+
+      BlockingPool(const BlockingPool &) = delete;
+      BlockingPool &operator=(const BlockingPool &) = delete;
+
+      /// 启动线程，已启动返回 false
+      bool Start();
+
+      /// 停止线程（执行完已入队的任务）
+      void Stop();
+
+      /**
+       * @brief 提交任务
+       * @return 入队成功返回 true；未运行返回 false
+       */
+      bool Submit(Task task);
+
+      /// 排队中（尚未开始执行）的任务数
+      size_t GetQueueSize() const { return queue_.Size(); }
+
+      /// 线程数
+      size_t GetThreadCount() const { return thread_count_; }
+
+    private:
+      /// 线程主循环
+      void ThreadLoop(size_t index);
+
+      /// 执行任务并捕获异常
+      void RunTask(const Task &task);
+
+      size_t thread_count_;              ///< 线程数
+      ConcurrentQueue<Task> queue_;      ///< 共享任务队列
+      std::vector<std::thread> threads_; ///< 线程列表
+      std::atomic<bool> is_running_{false};
+    };
+
+  } // namespace network
+} // namespace darwincore
+
+#endif // DARWINCORE_NETWORK_BLOCKING_POOL_H
@@ -10,11 +10,15 @@
 #include <atomic>
 #include <chrono>
 #include <thread>
+#include <future>
 
 #include <darwincore/network/client.h>
 #include <darwincore/network/logger.h>
 #include "socket_helper.h"
+#include "event_loop_group_impl.h"
 #include "client_reactor.h"
+#include "reactor.h"
+#include "shm_channel.h"
 #include "worker_pool.h"
 
 
@@ -24,7 +28,7 @@ namespace darwincore::network
   class Client::Impl
   {
   public:
-    Impl();
+    explicit Impl(std::shared_ptr<EventLoopGroup> loop_group = nullptr);
     ~Impl();
 
     bool ConnectIPv4(const std::string &, uint16_t);
@@ -36,6 +40,7 @@ namespace darwincore::network
     bool SendData(const uint8_t *, size_t, int timeout_ms);
     bool SendAsync(const uint8_t *, size_t, Client::SendAsyncCallback);
     size_t GetSendBufferSize() const;
+    bool Post(std::function<void()> task);
     bool IsConnected() const;
 
     void SetOnConnected(OnConnectedCallback cb) { on_connected_ = cb;}
@@ -43,6 +48,12 @@ namespace darwincore::network
     void SetOnDisconnected(OnDisconnectedCallback cb) { on_disconnected_ = cb;}
     void SetOnError(OnErrorCallback cb) { on_error_ = cb;}
 
+    void SetSharedMemoryTransport(bool enabled, size_t ring_size)
+    {
+      shm_enabled_ = enabled;
+      shm_ring_size_ = ring_size;
+    }
+
   private:
     enum class State
     {
@@ -57,19 +68,35 @@ namespace darwincore::network
 
     bool ConnectInternal(int fd, const sockaddr *, socklen_t, bool is_tcp);
     bool InitReactor();
+    bool AttachToLoopGroup(int fd, std::shared_ptr<ShmChannel> shm_channel);
+    void DetachFromLoopGroup();
+    bool HasTransport() const;
+    size_t GetBufferedBytes() const;
 
     void Cleanup();
     void OnNetworkEvent(const NetworkEvent &);
 
   private:
+    // 独占模式：每个 Client 一个 ClientReactor + 单线程 WorkerPool
     std::shared_ptr<WorkerPool> worker_pool_;
     std::unique_ptr<ClientReactor> reactor_;
 
+    // 共享模式：连接挂在 EventLoopGroup 的某个 Reactor 上
+    std::shared_ptr<EventLoopGroup> loop_group_;
+    EventLoopGroup::Impl *group_{nullptr};
+    std::shared_ptr<EventLoopGroup::Impl::Endpoint> endpoint_;
+    std::shared_ptr<Reactor> group_reactor_;
+    std::shared_ptr<std::atomic<size_t>> send_buffer_size_;
+
     std::atomic<uint64_t> connection_id_{0};
     std::atomic<State> state_{State::kDisconnected};
 
     sockaddr_storage peer_{};
 
+    // 共享内存快速通道（仅 Unix Domain Socket 连接生效）
+    bool shm_enabled_{false};
+    size_t shm_ring_size_{Client::kDefaultSharedMemoryRingSize};
+
     std::mutex cb_mutex_;
     OnConnectedCallback on_connected_;
     OnMessageCallback on_message_;
@@ -79,35 +106,58 @@ namespace darwincore::network
 
   /* ================= Impl ================= */
 
-  Client::Impl::Impl()
+  Client::Impl::Impl(std::shared_ptr<EventLoopGroup> loop_group)
+      : loop_group_(std::move(loop_group))
   {
     static std::once_flag f;
     std::call_once(f, []
                    { signal(SIGPIPE, SIG_IGN); });
+
+    if (loop_group_)
+    {
+      group_ = loop_group_->impl_.get();
+      endpoint_ = std::make_shared<EventLoopGroup::Impl::Endpoint>();
+      endpoint_->sink = [this](const NetworkEvent &ev)
+      { OnNetworkEvent(ev); };
+      send_buffer_size_ = std::make_shared<std::atomic<size_t>>(0);
+    }
   }
 
   Client::Impl::~Impl()
   {
     Disconnect();
+
+    if (endpoint_)
+    {
+      // 清空 sink 之后 Worker 不会再回调到已销毁的 Impl
+      std::lock_guard<std::recursive_mutex> lk(endpoint_->mutex);
+      endpoint_->sink = nullptr;
+    }
+    DetachFromLoopGroup();
   }
 
   bool Client::Impl::InitReactor()
   {
+    if (group_)
+      return group_->Start();
+
     if (reactor_)
       return true;
 
-    worker_pool_ = std::make_shared<WorkerPool>(1);
-    if (!worker_pool_->Start())
+    auto worker_pool = std::make_shared<WorkerPool>(1);
+    if (!worker_pool->Start())
     {
       return false;
     }
 
-    worker_pool_->SetEventCallback(
+    worker_pool->SetEventCallback(
         [this](const NetworkEvent &ev) {
           OnNetworkEvent(ev);
         });
 
-    reactor_ = std::make_unique<ClientReactor>(worker_pool_);
+    // Post 可能在其他线程读取 worker_pool_
+    std::atomic_store(&worker_pool_, worker_pool);
+    reactor_ = std::make_unique<ClientReactor>(worker_pool);
     return reactor_->Start();
   }
 
@@ -138,7 +188,8 @@ namespace darwincore::network
       SocketHelper::SetSocketOption(fd, SOL_SOCKET, SO_RCVBUF, &buf_size, sizeof(buf_size));
     }
 
-    if (connect(fd, addr, len) < 0 && errno != EINPROGRESS)
+    int ret = connect(fd, addr, len);
+    if (ret < 0 && errno != EINPROGRESS)
     {
       close(fd);
       state_.store(State::kDisconnected);
@@ -147,6 +198,25 @@ namespace darwincore::network
 
     memcpy(&peer_, addr, len);
 
+    // 共享内存升级握手必须是连接上的第一段数据，失败时退回普通 socket；
+    // 服务端确认之前数据仍走 socket，服务端不支持时 Reactor 放弃通道
+    std::shared_ptr<ShmChannel> shm_channel;
+    if (shm_enabled_ && addr->sa_family == AF_UNIX)
+    {
+      if (ret == 0)
+      {
+        shm_channel = ShmChannel::Create(shm_ring_size_);
+      }
+      if (shm_channel && !shm_channel->SendHandshake(fd))
+      {
+        shm_channel.reset();
+      }
+      if (!shm_channel)
+      {
+        NW_LOG_WARNING("[Client] 共享内存通道不可用，使用普通 socket");
+      }
+    }
+
     if (!InitReactor())
     {
       close(fd);
@@ -154,7 +224,8 @@ namespace darwincore::network
       return false;
     }
 
-    bool success = reactor_->SetConnection(fd, peer_);
+    bool success = group_ ? AttachToLoopGroup(fd, std::move(shm_channel))
+                          : reactor_->SetConnection(fd, peer_, std::move(shm_channel));
     if (!success)
     {
       close(fd);
@@ -165,6 +236,64 @@ namespace darwincore::network
     return true;
   }
 
+  bool Client::Impl::AttachToLoopGroup(int fd, std::shared_ptr<ShmChannel> shm_channel)
+  {
+    auto reactor = group_->SelectReactor();
+    if (!reactor)
+    {
+      NW_LOG_ERROR("[Client] EventLoopGroup 未运行");
+      return false;
+    }
+
+    // 先注册路由再交给 Reactor，保证 kConnected 事件能找到本 Client
+    uint64_t connection_id = reactor->AllocateConnectionId(fd);
+    send_buffer_size_->store(0, std::memory_order_relaxed);
+    group_->Register(connection_id, endpoint_);
+
+    std::atomic_store(&group_reactor_, reactor);
+    connection_id_.store(connection_id);
+
+    Reactor::ConnectionOptions options;
+    options.connection_id = connection_id;
+    options.send_buffer_size = send_buffer_size_;
+    options.shm_channel = std::move(shm_channel);
+    options.idle_timeout = false;
+
+    if (!reactor->AddConnection(fd, peer_, options))
+    {
+      group_->Unregister(connection_id);
+      std::atomic_store(&group_reactor_, std::shared_ptr<Reactor>());
+      connection_id_.store(0);
+      return false;
+    }
+
+    return true;
+  }
+
+  void Client::Impl::DetachFromLoopGroup()
+  {
+    auto reactor = std::atomic_exchange(&group_reactor_, std::shared_ptr<Reactor>());
+    if (!reactor)
+      return;
+
+    uint64_t connection_id = connection_id_.load();
+    group_->Unregister(connection_id);
+    reactor->RemoveConnection(connection_id);
+  }
+
+  bool Client::Impl::HasTransport() const
+  {
+    return group_ ? std::atomic_load(&group_reactor_) != nullptr : reactor_ != nullptr;
+  }
+
+  size_t Client::Impl::GetBufferedBytes() const
+  {
+    if (group_)
+      return send_buffer_size_->load(std::memory_order_relaxed);
+
+    return reactor_ ? reactor_->GetSendBufferSize() : 0;
+  }
+
   bool Client::Impl::ConnectIPv4(const std::string &host, uint16_t port)
   {
     sockaddr_in addr{};
@@ -212,9 +341,9 @@ namespace darwincore::network
     // 等待SendBuffer清空
     auto start = std::chrono::steady_clock::now();
 
-    while (reactor_)
+    while (HasTransport())
     {
-      size_t buffer_size = reactor_->GetSendBufferSize();
+      size_t buffer_size = GetBufferedBytes();
       if (buffer_size == 0)
       {
         NW_LOG_INFO("[Client] SendBuffer已清空，准备关闭连接");
@@ -255,35 +384,60 @@ namespace darwincore::network
 
   void Client::Impl::Cleanup()
   {
+    DetachFromLoopGroup();
+
     if (reactor_)
     {
       reactor_->Stop();
       reactor_.reset();
     }
-    if (worker_pool_)
+    if (auto worker_pool = std::atomic_exchange(&worker_pool_, std::shared_ptr<WorkerPool>()))
     {
-      worker_pool_->Stop();
-      worker_pool_.reset();
+      worker_pool->Stop();
     }
     connection_id_.store(0);
   }
 
   bool Client::Impl::SendData(const uint8_t *data, size_t size, int timeout_ms)
   {
-    if (state_.load() != State::kConnected || !reactor_)
+    if (state_.load() != State::kConnected || !HasTransport())
       return false;
 
+    if (group_)
+    {
+      auto reactor = std::atomic_load(&group_reactor_);
+      if (!reactor)
+        return false;
+
+      // 与 ClientReactor::SendSync 语义一致：等待数据写入 socket 或发送缓冲区
+      auto promise = std::make_shared<std::promise<bool>>();
+      auto future = promise->get_future();
+
+      if (!reactor->SendData(connection_id_.load(), data, size,
+                             [promise](bool success, size_t)
+                             { promise->set_value(success); }))
+        return false;
+
+      if (timeout_ms > 0 &&
+          future.wait_for(std::chrono::milliseconds(timeout_ms)) != std::future_status::ready)
+      {
+        NW_LOG_WARNING("[Client] SendData 超时");
+        return false;
+      }
+      return future.get();
+    }
+
     // ClientReactor 的 SendSync 会等待数据实际发送
     return reactor_->SendSync(data, size, timeout_ms);
   }
 
   bool Client::Impl::SendAsync(const uint8_t *data, size_t size, Client::SendAsyncCallback callback)
   {
-    if (state_.load() != State::kConnected || !reactor_)
+    if (state_.load() != State::kConnected || !HasTransport())
       return false;
 
     // 发送背压检查：如果发送缓冲区超过高水位，拒绝发送
-    size_t buffer_size = reactor_->GetSendBufferSize();
+    size_t buffer_size = GetBufferedBytes();
     if (buffer_size > SEND_HIGH_WATER_MARK)
     {
       NW_LOG_WARNING("[Client] 发送背压触发: buffer_size=" << buffer_size
@@ -291,6 +445,17 @@ namespace darwincore::network
       return false;
     }
 
+    if (group_)
+    {
+      auto reactor = std::atomic_load(&group_reactor_);
+      return reactor && reactor->SendData(connection_id_.load(), data, size,
+                                          [callback](bool success, size_t sent)
+                                          {
+                                            if (callback)
+                                              callback(success, sent);
+                                          });
+    }
+
     // 使用 ClientReactor 的异步发送（带回调）
     return reactor_->SendAsyncWithCallback(data, size,
       [callback](bool success, size_t sent) {
@@ -302,10 +467,19 @@ namespace darwincore::network
 
   size_t Client::Impl::GetSendBufferSize() const
   {
-    if (state_.load() != State::kConnected || !reactor_)
+    if (state_.load() != State::kConnected || !HasTransport())
       return 0;
 
-    return reactor_->GetSendBufferSize();
+    return GetBufferedBytes();
+  }
+
+  bool Client::Impl::Post(std::function<void()> task)
+  {
+    if (!task || state_.load() != State::kConnected)
+      return false;
+
+    auto worker_pool = group_ ? group_->GetWorkerPool() : std::atomic_load(&worker_pool_);
+    return worker_pool && worker_pool->SubmitTask(connection_id_.load(), std::move(task));
   }
 
   bool Client::Impl::IsConnected() const
@@ -343,21 +517,38 @@ namespace darwincore::network
       break;
     }
 
-    case NetworkEventType::kDisconnected:
     case NetworkEventType::kError:
     {
-      state_.store(State::kDisconnected);
-      connection_id_.store(0);
-      OnDisconnectedCallback dcb;
+      // Reactor 在 kError 之后总会紧跟 kDisconnected，断开回调留给后者
       OnErrorCallback ecb;
       {
         std::lock_guard lk(cb_mutex_);
-        dcb = on_disconnected_;
         ecb = on_error_;
       }
-      if (ev.type == NetworkEventType::kError && ecb && ev.error) {
+      if (ecb && ev.error) {
         ecb(*ev.error, ev.error_message);
       }
+      if (!group_) {
+        state_.store(State::kDisconnected);
+        connection_id_.store(0);
+      }
+      break;
+    }
+
+    case NetworkEventType::kDisconnected:
+    {
+      if (group_) {
+        // 连接已由 Reactor 移除，只需解除路由
+        group_->Unregister(ev.connection_id);
+        std::atomic_store(&group_reactor_, std::shared_ptr<Reactor>());
+      }
+      state_.store(State::kDisconnected);
+      connection_id_.store(0);
+      OnDisconnectedCallback dcb;
+      {
+        std::lock_guard lk(cb_mutex_);
+        dcb = on_disconnected_;
+      }
       if (dcb) {
         dcb();
       }
@@ -371,6 +562,8 @@ namespace darwincore::network
   /* ================= Client API ================= */
 
   Client::Client() : impl_(std::make_unique<Impl>()) {}
+  Client::Client(std::shared_ptr<EventLoopGroup> loop_group)
+      : impl_(std::make_unique<Impl>(std::move(loop_group))) {}
   Client::~Client() = default;
 
   bool Client::ConnectIPv4(const std::string &h, uint16_t p)
@@ -402,6 +595,10 @@ namespace darwincore::network
   {
     return impl_->GetSendBufferSize();
   }
+  bool Client::Post(std::function<void()> task)
+  {
+    return impl_->Post(std::move(task));
+  }
   bool Client::IsConnected() const { return impl_->IsConnected(); }
   void Client::SetOnConnected(OnConnectedCallback cb)
   {
@@ -419,5 +616,9 @@ namespace darwincore::network
   {
     impl_->SetOnError(std::move(cb));
   }
+  void Client::SetSharedMemoryTransport(bool enabled, size_t ring_size)
+  {
+    impl_->SetSharedMemoryTransport(enabled, ring_size);
+  }
 
 } // namespace darwincore::network
@@ -17,6 +17,7 @@
 #include "io_monitor.h"
 #include "client_reactor.h"
 #include "send_buffer.h"
+#include "shm_channel.h"
 #include "socket_helper.h"
 #include "worker_pool.h"
 #include "connection_id_generator.h"
@@ -107,13 +108,15 @@ namespace darwincore
       {
         close(connection_.file_descriptor);
         connection_.file_descriptor = -1;
+        connection_.shm.reset();
         has_connection_.store(false);
       }
 
       NW_LOG_INFO("[ClientReactor] 已停止");
     }
 
-    bool ClientReactor::SetConnection(int fd, const sockaddr_storage &peer)
+    bool ClientReactor::SetConnection(int fd, const sockaddr_storage &peer,
+                                      std::shared_ptr<ShmChannel> shm_channel)
     {
       if (fd < 0)
       {
@@ -142,10 +145,20 @@ namespace darwincore
         return false;
       }
 
+      // 共享内存通道的门铃
+      if (shm_channel && !io_monitor_->StartReadMonitor(shm_channel->GetDoorbellFd()))
+      {
+        NW_LOG_ERROR("[ClientReactor] 监控门铃失败: " << strerror(errno));
+        io_monitor_->StopMonitor(fd);
+        close(fd);
+        return false;
+      }
+
       // 设置连接
       connection_.file_descriptor = fd;
       connection_.peer_address = peer;
       connection_.connection_id = ConnectionIdGenerator::Generate(255, static_cast<uint16_t>(fd), 1);
+      connection_.shm = std::move(shm_channel);
       connection_.UpdateActivity();
 
       has_connection_.store(true);
@@ -171,10 +184,15 @@ namespace darwincore
       if (io_monitor_)
       {
         io_monitor_->StopMonitor(fd);
+        if (connection_.shm)
+        {
+          io_monitor_->StopMonitor(connection_.shm->GetDoorbellFd());
+        }
       }
 
       close(fd);
       connection_.file_descriptor = -1;
+      connection_.shm.reset();
       has_connection_.store(false);
 
       NW_LOG_INFO("[ClientReactor] 移除连接: fd=" << fd);
@@ -284,7 +302,9 @@ namespace darwincore
       {
         return 0;
       }
-      return connection_.send_buffer.Size();
+
+      return connection_.send_buffer.Size() +
+             (connection_.shm ? connection_.shm->GetPendingBytes() : 0);
     }
 
     bool ClientReactor::IsConnected() const
@@ -392,6 +412,19 @@ namespace darwincore
         return false;
       }
 
+      // 共享内存通道：服务端确认升级、socket 待发数据写完后直接写入环（放不下的部分由通道暂存）
+      if (connection_.shm && connection_.shm->IsEstablished() &&
+          connection_.send_buffer.IsEmpty())
+      {
+        if (!connection_.shm->Send(data, size))
+        {
+          NW_LOG_ERROR("[ClientReactor] 共享内存暂存区已满");
+          return false;
+        }
+        total_bytes_sent_.fetch_add(size, std::memory_order_relaxed);
+        return true;
+      }
+
       // 写入发送缓冲区
       if (!connection_.send_buffer.Write(data, size))
       {
@@ -454,7 +487,19 @@ namespace darwincore
       uint16_t flags = event.flags;
       int16_t filter = event.filter;
 
-      if (!has_connection_.load() || fd != connection_.file_descriptor)
+      if (!has_connection_.load())
+      {
+        return;
+      }
+
+      // 共享内存门铃
+      if (connection_.shm && fd == connection_.shm->GetDoorbellFd())
+      {
+        HandleDoorbellEvent();
+        return;
+      }
+
+      if (fd != connection_.file_descriptor)
       {
         return;
       }
@@ -463,6 +508,7 @@ namespace darwincore
       if (flags & EV_EOF)
       {
         NW_LOG_INFO("[ClientReactor] 对端关闭连接");
+        ReceiveSharedMemory();
         RemoveConnection();
         return;
       }
@@ -509,8 +555,9 @@ namespace darwincore
         }
         else if (ret == 0)
         {
-          // 对端关闭
+          // 对端关闭（关闭前写入环的数据仍然要交付）
           NW_LOG_INFO("[ClientReactor] 对端关闭连接");
+          ReceiveSharedMemory();
           RemoveConnection();
           return;
         }
@@ -540,6 +587,71 @@ namespace darwincore
       TrySendDirect();
     }
 
+    void ClientReactor::HandleDoorbellEvent()
+    {
+      bool peer_alive = connection_.shm->DrainDoorbell();
+
+      // 尚未收到确认：门铃关闭说明服务端没有接受升级，继续使用普通 socket
+      if (!connection_.shm->IsEstablished())
+      {
+        if (!peer_alive)
+        {
+          NW_LOG_WARNING("[ClientReactor] 服务端未接受共享内存升级，使用普通 socket");
+          io_monitor_->StopMonitor(connection_.shm->GetDoorbellFd());
+          connection_.shm.reset();
+        }
+        return;
+      }
+
+      // 服务端升级前写入 socket 的数据必须先于环中数据交付
+      HandleReadEvent();
+      if (!has_connection_.load() || !connection_.shm)
+      {
+        return;
+      }
+
+      if (!ReceiveSharedMemory() || !peer_alive)
+      {
+        NW_LOG_INFO("[ClientReactor] 共享内存通道关闭");
+        RemoveConnection();
+        return;
+      }
+
+      // 服务端可能腾出了空间
+      connection_.shm->FlushPending();
+    }
+
+    bool ClientReactor::ReceiveSharedMemory()
+    {
+      if (!connection_.shm)
+      {
+        return true;
+      }
+
+      // 单次分发的数据上限，避免一次回调拿到整个环
+      constexpr size_t kMaxChunkSize = 256 * 1024;
+
+      while (true)
+      {
+        ssize_t ret = connection_.shm->Receive(
+            [this](const uint8_t *data, size_t size)
+            { DispatchDataEvent(data, size); },
+            kMaxChunkSize);
+
+        if (ret < 0)
+        {
+          return false;
+        }
+        if (ret == 0)
+        {
+          return true;
+        }
+
+        connection_.UpdateActivity();
+        total_bytes_received_.fetch_add(ret, std::memory_order_relaxed);
+      }
+    }
+
     // ============ 事件分发 ============
 
     void ClientReactor::DispatchEvent(const NetworkEvent &event)
@@ -48,6 +48,7 @@ namespace darwincore
     // 前向声明
     class WorkerPool;
     class IOMonitor;
+    class ShmChannel;
 
     /**
      * @brief ClientReactor - 客户端专用 Reactor
@@ -115,11 +116,13 @@ namespace darwincore
        * @brief 设置连接（ClientReactor 只管理一个连接）
        * @param fd 文件描述符
        * @param peer 对端地址
+       * @param shm_channel 已完成握手的共享内存通道（可选）
        * @return 成功返回 true，失败返回 false
        *
        * 注意：此方法需要在 Start() 之后调用。
        */
-      bool SetConnection(int fd, const sockaddr_storage &peer);
+      bool SetConnection(int fd, const sockaddr_storage &peer,
+                         std::shared_ptr<ShmChannel> shm_channel = nullptr);
 
       /**
        * @brief 移除连接
@@ -204,6 +207,7 @@ namespace darwincore
         uint64_t connection_id{0};
         SendBuffer send_buffer;
         bool write_pending{false};
+        std::shared_ptr<ShmChannel> shm;  ///< 共享内存通道（升级后数据改走环）
 
         std::chrono::steady_clock::time_point last_active;
 
@@ -246,6 +250,9 @@ namespace darwincore
       void ProcessKqueueEvent(const struct kevent &event);
       void HandleReadEvent();
 
+      void HandleDoorbellEvent();
+      bool ReceiveSharedMemory();
+
       void DispatchEvent(const NetworkEvent &event);
       void DispatchDataEvent(const uint8_t *data, size_t size);
       void DispatchConnectedEvent();
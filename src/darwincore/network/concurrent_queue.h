@@ -134,6 +134,32 @@ namespace darwincore
         return true;
       }
 
+      /**
+       * @brief Try to enqueue an element by move (non-blocking)
+       * @param value Value to enqueue (left untouched on failure, so callers may retry)
+       * @return true if enqueued successfully, false if queue is full or stopped
+       */
+      bool TryEnqueue(T &&value)
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+
+          if (max_size_ > 0 && queue_.size() >= max_size_)
+          {
+            return false;
+          }
+
+          if (is_stopped_)
+          {
+            return false;
+          }
+
+          queue_.push(std::move(value));
+        }
+        not_empty_.notify_one();
+        return true;
+      }
+
       /**
        * @brief Try to dequeue an element from the queue (non-blocking)
        * @param result Reference to store the dequeued value
@@ -0,0 +1,410 @@
+//
+// DarwinCore Network 模块
+// DatagramReactor 实现
+//
+// 批量接收说明：
+//   macOS 没有 recvmmsg/sendmmsg，也没有 UDP GSO/GRO。这里在一次可读事件中
+//   连续调用非阻塞 recvmsg，直到填满一批或 socket 读空，整批只做一次
+//   缓冲池借还和一次队列投递，系统调用之外的开销按批摊薄。
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "datagram_reactor.h"
+#include "io_monitor.h"
+#include <darwincore/network/logger.h>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    // ========== DatagramBufferPool ==========
+
+    DatagramBufferPool::DatagramBufferPool(size_t buffer_size, size_t buffer_count)
+        : buffer_size_(buffer_size), storage_(buffer_size * buffer_count)
+    {
+      free_list_.reserve(buffer_count);
+      for (size_t i = 0; i < buffer_count; ++i)
+      {
+        free_list_.push_back(storage_.data() + i * buffer_size);
+      }
+    }
+
+    size_t DatagramBufferPool::Acquire(std::vector<uint8_t *> &buffers, size_t count)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      size_t taken = std::min(count, free_list_.size());
+      buffers.insert(buffers.end(), free_list_.end() - taken, free_list_.end());
+      free_list_.resize(free_list_.size() - taken);
+      return taken;
+    }
+
+    void DatagramBufferPool::Release(const std::vector<uint8_t *> &buffers)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      free_list_.insert(free_list_.end(), buffers.begin(), buffers.end());
+    }
+
+    size_t DatagramBufferPool::GetAvailableCount() const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return free_list_.size();
+    }
+
+    // ========== DatagramReactor ==========
+
+    DatagramReactor::DatagramReactor(int fd, const UdpOptions &options,
+                                     DatagramCallback callback)
+        : fd_(fd),
+          options_(options),
+          callback_(std::move(callback)),
+          io_monitor_(std::make_unique<IOMonitor>())
+    {
+      options_.worker_count = std::max<size_t>(1, options_.worker_count);
+      options_.batch_size = std::max<size_t>(1, options_.batch_size);
+      options_.max_datagram_size = std::max<size_t>(1, options_.max_datagram_size);
+      options_.buffer_pool_size = std::max(options_.batch_size, options_.buffer_pool_size);
+
+      pool_ = std::make_shared<DatagramBufferPool>(options_.max_datagram_size,
+                                                   options_.buffer_pool_size);
+    }
+
+    DatagramReactor::~DatagramReactor()
+    {
+      Stop();
+      if (fd_ >= 0)
+      {
+        close(fd_);
+        fd_ = -1;
+      }
+    }
+
+    bool DatagramReactor::Start()
+    {
+      bool expected = false;
+      if (!is_running_.compare_exchange_strong(expected, true))
+      {
+        return false;
+      }
+
+      if (!io_monitor_->Initialize() || !io_monitor_->StartReadMonitor(fd_))
+      {
+        NW_LOG_ERROR("[DatagramReactor] 初始化 kqueue 失败: " << strerror(errno));
+        io_monitor_->Close();
+        is_running_.store(false);
+        return false;
+      }
+
+      for (size_t i = 0; i < options_.worker_count; ++i)
+      {
+        queues_.push_back(
+            std::make_unique<ConcurrentQueue<std::shared_ptr<DatagramBatch>>>(kMaxQueuedBatches));
+      }
+      for (size_t i = 0; i < options_.worker_count; ++i)
+      {
+        worker_threads_.emplace_back(&DatagramReactor::WorkerLoop, this, i);
+      }
+      event_loop_thread_ = std::thread(&DatagramReactor::RunEventLoop, this);
+
+      NW_LOG_INFO("[DatagramReactor] 启动, fd=" << fd_ << ", workers=" << options_.worker_count
+                                                << ", batch=" << options_.batch_size);
+      return true;
+    }
+
+    void DatagramReactor::Stop()
+    {
+      bool expected = true;
+      if (!is_running_.compare_exchange_strong(expected, false))
+      {
+        return;
+      }
+
+      if (event_loop_thread_.joinable())
+      {
+        event_loop_thread_.join();
+      }
+
+      for (auto &queue : queues_)
+      {
+        queue->NotifyStop();
+      }
+      for (auto &thread : worker_threads_)
+      {
+        if (thread.joinable())
+        {
+          thread.join();
+        }
+      }
+      worker_threads_.clear();
+      queues_.clear();
+
+      io_monitor_->Close();
+      NW_LOG_INFO("[DatagramReactor] 已停止, fd=" << fd_);
+    }
+
+    void DatagramReactor::RunEventLoop()
+    {
+      pthread_setname_np("darwincore.network.datagram");
+
+      while (is_running_.load(std::memory_order_acquire))
+      {
+        struct kevent events[4];
+        int timeout_ms = 100;
+        int count = io_monitor_->WaitEvents(events, 4, &timeout_ms);
+
+        if (count < 0)
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          }
+          NW_LOG_ERROR("[DatagramReactor] WaitEvents 失败: " << strerror(errno));
+          break;
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+          if (static_cast<int>(events[i].ident) != fd_ || events[i].filter != EVFILT_READ)
+          {
+            continue;
+          }
+
+          // kqueue 为水平触发：每次事件最多处理 kMaxBatchesPerEvent 批，
+          // 剩余数据由下一次 WaitEvents 继续处理
+          for (size_t batch = 0; batch < kMaxBatchesPerEvent; ++batch)
+          {
+            if (!ReceiveBatch())
+            {
+              break;
+            }
+          }
+        }
+      }
+    }
+
+    bool DatagramReactor::ReceiveBatch()
+    {
+      auto batch = std::make_shared<DatagramBatch>(pool_);
+      size_t capacity = pool_->Acquire(batch->buffers, options_.batch_size);
+      if (capacity == 0)
+      {
+        // Worker 跟不上，缓冲池耗尽：读出并丢弃，避免内核缓冲区积压旧数据
+        DropPending();
+        return false;
+      }
+
+      batch->datagrams.reserve(capacity);
+      bool drained = false;
+      uint64_t bytes = 0;
+
+      while (batch->datagrams.size() < capacity)
+      {
+        DatagramBatch::Datagram datagram;
+        uint8_t *buffer = batch->buffers[batch->datagrams.size()];
+
+        struct iovec iov;
+        iov.iov_base = buffer;
+        iov.iov_len = options_.max_datagram_size;
+
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_name = &datagram.peer.address;
+        msg.msg_namelen = sizeof(datagram.peer.address);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+
+        ssize_t n = recvmsg(fd_, &msg, 0);
+        if (n < 0)
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          }
+          if (errno != EAGAIN && errno != EWOULDBLOCK)
+          {
+            // UDP 上的错误（如 ICMP 端口不可达）不影响后续收包
+            NW_LOG_DEBUG("[DatagramReactor] recvmsg 失败: " << strerror(errno));
+          }
+          drained = true;
+          break;
+        }
+
+        if (msg.msg_flags & MSG_TRUNC)
+        {
+          // 缓冲区原样留给下一个数据报
+          truncated_datagrams_.fetch_add(1, std::memory_order_relaxed);
+          continue;
+        }
+
+        datagram.peer.length = msg.msg_namelen;
+        datagram.data = buffer;
+        datagram.size = static_cast<size_t>(n);
+        batch->datagrams.push_back(datagram);
+        bytes += static_cast<uint64_t>(n);
+      }
+
+      // 未用到的缓冲区立即归还
+      if (batch->datagrams.size() < batch->buffers.size())
+      {
+        std::vector<uint8_t *> unused(batch->buffers.begin() + batch->datagrams.size(),
+                                      batch->buffers.end());
+        batch->buffers.resize(batch->datagrams.size());
+        pool_->Release(unused);
+      }
+
+      if (!batch->datagrams.empty())
+      {
+        datagrams_received_.fetch_add(batch->datagrams.size(), std::memory_order_relaxed);
+        bytes_received_.fetch_add(bytes, std::memory_order_relaxed);
+        Dispatch(std::move(batch));
+      }
+
+      return !drained;
+    }
+
+    void DatagramReactor::DropPending()
+    {
+      std::vector<uint8_t> scratch(options_.max_datagram_size);
+      size_t limit = options_.batch_size * kMaxBatchesPerEvent;
+
+      for (size_t i = 0; i < limit; ++i)
+      {
+        ssize_t n = recv(fd_, scratch.data(), scratch.size(), 0);
+        if (n < 0)
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          }
+          break;
+        }
+        dropped_datagrams_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    void DatagramReactor::Dispatch(std::shared_ptr<DatagramBatch> batch)
+    {
+      size_t index = next_worker_++ % queues_.size();
+      size_t count = batch->datagrams.size();
+
+      if (!queues_[index]->TryEnqueue(batch))
+      {
+        dropped_datagrams_.fetch_add(count, std::memory_order_relaxed);
+        return;
+      }
+      batches_dispatched_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void DatagramReactor::WorkerLoop(size_t worker_index)
+    {
+      pthread_setname_np(("darwincore.network.datagram.worker." +
+                          std::to_string(worker_index))
+                             .c_str());
+
+      auto &queue = *queues_[worker_index];
+      std::shared_ptr<DatagramBatch> batch;
+
+      while (queue.WaitDequeue(batch, std::chrono::milliseconds(100)) ||
+             is_running_.load(std::memory_order_acquire))
+      {
+        if (!batch)
+        {
+          continue;
+        }
+
+        if (callback_)
+        {
+          for (const auto &datagram : batch->datagrams)
+          {
+            callback_(datagram.peer, datagram.data, datagram.size);
+          }
+        }
+
+        // 整批回调结束后一次性归还缓冲区
+        batch.reset();
+      }
+    }
+
+    bool DatagramReactor::SendTo(const DatagramPeer *peer, const uint8_t *data, size_t size)
+    {
+      if (fd_ < 0)
+      {
+        errno = EBADF;
+        return false;
+      }
+
+      ssize_t n;
+      do
+      {
+        if (peer)
+        {
+          n = sendto(fd_, data, size, 0,
+                     reinterpret_cast<const sockaddr *>(&peer->address), peer->length);
+        }
+        else
+        {
+          n = send(fd_, data, size, 0);
+        }
+      } while (n < 0 && errno == EINTR);
+
+      if (n < 0 || static_cast<size_t>(n) != size)
+      {
+        if (n >= 0)
+        {
+          // 数据报只写出一部分等同于过大，不能让调用方读到之前残留的 errno
+          errno = EMSGSIZE;
+        }
+        send_failures_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+
+      datagrams_sent_.fetch_add(1, std::memory_order_relaxed);
+      bytes_sent_.fetch_add(size, std::memory_order_relaxed);
+      return true;
+    }
+
+    size_t DatagramReactor::SendBatch(const std::vector<OutgoingDatagram> &datagrams,
+                                      bool use_peer)
+    {
+      size_t sent = 0;
+      for (const auto &datagram : datagrams)
+      {
+        if (!SendTo(use_peer ? &datagram.peer : nullptr, datagram.data, datagram.size))
+        {
+          // socket 缓冲区已满时后续数据报同样会失败，直接停止
+          if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+          {
+            break;
+          }
+          continue;
+        }
+        ++sent;
+      }
+      return sent;
+    }
+
+    UdpStatistics DatagramReactor::GetStatistics() const
+    {
+      UdpStatistics stats;
+      stats.datagrams_received = datagrams_received_.load(std::memory_order_relaxed);
+      stats.bytes_received = bytes_received_.load(std::memory_order_relaxed);
+      stats.datagrams_sent = datagrams_sent_.load(std::memory_order_relaxed);
+      stats.bytes_sent = bytes_sent_.load(std::memory_order_relaxed);
+      stats.batches_dispatched = batches_dispatched_.load(std::memory_order_relaxed);
+      stats.dropped_datagrams = dropped_datagrams_.load(std::memory_order_relaxed);
+      stats.truncated_datagrams = truncated_datagrams_.load(std::memory_order_relaxed);
+      stats.send_failures = send_failures_.load(std::memory_order_relaxed);
+      return stats;
+    }
+
+  } // namespace network
+} // namespace darwincore
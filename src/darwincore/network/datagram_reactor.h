@@ -0,0 +1,203 @@
+//
+// DarwinCore Network 模块
+// DatagramReactor - 数据报 I/O 事件循环
+//
+// 功能说明：
+//   UdpServer/UdpClient 的内部实现，一个实例管理一个 UDP socket：
+//   - Reactor 线程：可读时批量 recvmsg，数据报写入缓冲池中的缓冲区
+//   - Worker 线程：按批次取出数据报并调用回调
+//   - 缓冲区随批次一起流转，整批回调结束后一次性归还缓冲池
+//
+// 设计原则：
+//   - 接收路径上不做内存分配（批次对象除外，每批一次）
+//   - 过载时丢弃而不是阻塞：缓冲池耗尽或 Worker 队列满时丢弃并计数，
+//     避免内核 socket 缓冲区长时间积压
+//   - 发送直接在调用线程中执行（UDP socket 的 sendto 是线程安全的）
+//
+// 与 TCP 线程模型的差异：
+//   不复用 Reactor/WorkerPool，只复用 IOMonitor 与 ConcurrentQueue。Reactor 以
+//   连接为单位管理 fd 与发送缓冲区，WorkerPool 以 NetworkEvent（自带 payload
+//   vector）为单位排队，用于数据报会在接收路径上逐个分配；这里按批次排队并
+//   借用缓冲池中的缓冲区。
+//   UDP socket 没有连接：Reactor 的连接状态、发送缓冲区与高/低水位背压对它都
+//   不适用（数据报不能部分写出，也不应排队重发），WorkerPool 按 connection_id
+//   固定 Worker 的保序也没有对象。因此一个 socket 只用一个事件线程和一个 Worker
+//   队列，过载时丢弃计数，代替 TCP 路径上的暂停读取。
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_NETWORK_DATAGRAM_REACTOR_H
+#define DARWINCORE_NETWORK_DATAGRAM_REACTOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "concurrent_queue.h"
+#include <darwincore/network/udp.h>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    class IOMonitor;
+
+    /**
+     * @brief 定长接收缓冲池（线程安全，批量借还）
+     *
+     * 所有缓冲区位于一块连续内存中，构造后不再分配。
+     */
+    class DatagramBufferPool
+    {
+    public:
+      DatagramBufferPool(size_t buffer_size, size_t buffer_count);
+
+      DatagramBufferPool(const DatagramBufferPool &) = delete;
+      DatagramBufferPool &operator=(const DatagramBufferPool &) = delete;
+
+      /**
+       * @brief 借出最多 count 个缓冲区（追加到 buffers）
+       * @return 实际借出的个数（池耗尽时可能为 0）
+       */
+      size_t Acquire(std::vector<uint8_t *> &buffers, size_t count);
+
+      /**
+       * @brief 归还缓冲区
+       */
+      void Release(const std::vector<uint8_t *> &buffers);
+
+      size_t GetBufferSize() const { return buffer_size_; }
+      size_t GetAvailableCount() const;
+
+    private:
+      size_t buffer_size_;
+      std::vector<uint8_t> storage_;
+
+      mutable std::mutex mutex_;
+      std::vector<uint8_t *> free_list_;
+    };
+
+    /**
+     * @brief 一批数据报（Reactor 线程填充，Worker 线程消费）
+     *
+     * 析构时把全部缓冲区归还缓冲池。
+     */
+    struct DatagramBatch
+    {
+      struct Datagram
+      {
+        DatagramPeer peer;
+        const uint8_t *data = nullptr;
+        size_t size = 0;
+      };
+
+      explicit DatagramBatch(std::shared_ptr<DatagramBufferPool> pool)
+          : pool(std::move(pool)) {}
+
+      ~DatagramBatch()
+      {
+        if (!buffers.empty())
+        {
+          pool->Release(buffers);
+        }
+      }
+
+      DatagramBatch(const DatagramBatch &) = delete;
+      DatagramBatch &operator=(const DatagramBatch &) = delete;
+
+      std::shared_ptr<DatagramBufferPool> pool;
+      std::vector<uint8_t *> buffers;      ///< 借出的缓冲区（datagrams[i] 使用 buffers[i]）
+      std::vector<Datagram> datagrams;
+    };
+
+    /**
+     * @brief 数据报 Reactor（一个 UDP socket + 接收线程 + Worker 线程）
+     */
+    class DatagramReactor
+    {
+    public:
+      using DatagramCallback =
+          std::function<void(const DatagramPeer &peer, const uint8_t *data, size_t size)>;
+
+      /// 每次可读事件最多接收的批次数（避免单个 socket 长时间占用循环）
+      static constexpr size_t kMaxBatchesPerEvent = 16;
+
+      /// 每个 Worker 队列最多积压的批次数
+      static constexpr size_t kMaxQueuedBatches = 1024;
+
+      /**
+       * @brief 构造 DatagramReactor
+       * @param fd 已绑定/连接的非阻塞 UDP socket（所有权转移给 DatagramReactor）
+       * @param options 配置
+       * @param callback 数据报回调（在 Worker 线程中调用）
+       */
+      DatagramReactor(int fd, const UdpOptions &options, DatagramCallback callback);
+      ~DatagramReactor();
+
+      DatagramReactor(const DatagramReactor &) = delete;
+      DatagramReactor &operator=(const DatagramReactor &) = delete;
+
+      bool Start();
+      void Stop();
+
+      /**
+       * @brief 发送一个数据报（线程安全）
+       * @param peer 目标地址；nullptr 表示已连接 socket 的默认对端
+       * @return 失败时返回 false 并设置 errno（未启动为 EBADF，只写出部分为 EMSGSIZE）
+       */
+      bool SendTo(const DatagramPeer *peer, const uint8_t *data, size_t size);
+
+      /**
+       * @brief 批量发送（线程安全）
+       * @param use_peer 是否使用每个数据报的 peer（已连接 socket 传 false）
+       * @return 成功发送的个数
+       */
+      size_t SendBatch(const std::vector<OutgoingDatagram> &datagrams, bool use_peer);
+
+      UdpStatistics GetStatistics() const;
+
+      int GetFd() const { return fd_; }
+
+    private:
+      void RunEventLoop();
+      void WorkerLoop(size_t worker_index);
+
+      /// 接收一批；返回 false 表示 socket 已读空
+      bool ReceiveBatch();
+      void DropPending();
+      void Dispatch(std::shared_ptr<DatagramBatch> batch);
+
+      int fd_;
+      UdpOptions options_;
+      DatagramCallback callback_;
+
+      std::shared_ptr<DatagramBufferPool> pool_;
+      std::unique_ptr<IOMonitor> io_monitor_;
+
+      std::thread event_loop_thread_;
+      std::vector<std::thread> worker_threads_;
+      std::vector<std::unique_ptr<ConcurrentQueue<std::shared_ptr<DatagramBatch>>>> queues_;
+      size_t next_worker_{0};
+      std::atomic<bool> is_running_{false};
+
+      // 统计
+      std::atomic<uint64_t> datagrams_received_{0};
+      std::atomic<uint64_t> bytes_received_{0};
+      std::atomic<uint64_t> datagrams_sent_{0};
+      std::atomic<uint64_t> bytes_sent_{0};
+      std::atomic<uint64_t> batches_dispatched_{0};
+      std::atomic<uint64_t> dropped_datagrams_{0};
+      std::atomic<uint64_t> truncated_datagrams_{0};
+      std::atomic<uint64_t> send_failures_{0};
+    };
+
+  } // namespace network
+} // namespace darwincore
+
+#endif // DARWINCORE_NETWORK_DATAGRAM_REACTOR_H
@@ -0,0 +1,293 @@
+//
+// DarwinCore Network 模块
+// EventLoopGroup 实现
+//
+// 功能说明：
+//   多个 Server/Client 共享 N 个 Reactor 线程和一个 WorkerPool。
+//   组内 Reactor 保留 Server 默认的空闲超时，Client 连接添加时单独关闭
+//   （客户端连接由业务层决定何时断开）。
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <algorithm>
+#include <thread>
+
+#include "event_loop_group_impl.h"
+#include <darwincore/network/configuration.h>
+#include <darwincore/network/logger.h>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    // ============ EventLoopGroup::Impl 实现 ============
+
+    EventLoopGroup::Impl::Impl(size_t loop_count, size_t worker_count)
+        : loop_count_(loop_count), worker_count_(worker_count)
+    {
+      if (loop_count_ == 0)
+      {
+        loop_count_ = std::max(1u, std::thread::hardware_concurrency());
+      }
+
+      if (worker_count_ == 0)
+      {
+        worker_count_ = SocketConfiguration::kDefaultWorkerCount;
+      }
+
+      shards_ = std::vector<EndpointShard>(worker_count_);
+    }
+
+    EventLoopGroup::Impl::~Impl()
+    {
+      Stop();
+    }
+
+    bool EventLoopGroup::Impl::Start()
+    {
+      std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+
+      if (is_running_.load(std::memory_order_acquire))
+      {
+        return true;
+      }
+
+      worker_pool_ = std::make_shared<WorkerPool>(worker_count_);
+      worker_pool_->SetEventCallback([this](const NetworkEvent &event)
+                                     { OnNetworkEvent(event); });
+
+      if (!worker_pool_->Start())
+      {
+        NW_LOG_ERROR("[EventLoopGroup] WorkerPool 启动失败");
+        worker_pool_.reset();
+        return false;
+      }
+
+      for (size_t i = 0; i < loop_count_; ++i)
+      {
+        auto reactor = std::make_shared<Reactor>(static_cast<int>(i), worker_pool_);
+
+        if (!reactor->Start())
+        {
+          NW_LOG_ERROR("[EventLoopGroup] Reactor " << i << " 启动失败");
+
+          for (auto &r : reactors_)
+          {
+            r->Stop();
+          }
+          reactors_.clear();
+          worker_pool_->Stop();
+          worker_pool_.reset();
+          return false;
+        }
+
+        reactors_.push_back(reactor);
+      }
+
+      is_running_.store(true, std::memory_order_release);
+      NW_LOG_INFO("[EventLoopGroup] 启动成功: loops=" << loop_count_
+                                                   << ", workers=" << worker_count_);
+      return true;
+    }
+
+    void EventLoopGroup::Impl::Stop()
+    {
+      std::vector<std::shared_ptr<Reactor>> reactors;
+      std::shared_ptr<WorkerPool> worker_pool;
+      {
+        // 先在锁内摘下组件，再在锁外停止，避免回调中重连时与 Stop 互相等待
+        std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+
+        if (!is_running_.exchange(false))
+        {
+          return;
+        }
+
+        reactors.swap(reactors_);
+        worker_pool.swap(worker_pool_);
+      }
+
+      NW_LOG_INFO("[EventLoopGroup] 开始停止");
+
+      for (auto &reactor : reactors)
+      {
+        reactor->Stop();
+      }
+
+      if (worker_pool)
+      {
+        worker_pool->Stop();
+      }
+
+      // 连接已随 Reactor 关闭，但没有经过 Worker 交付 kDisconnected：在这里补发，
+      // 成员 Client 变为未连接，成员 Server 触发断开回调并释放连接上下文
+      std::unordered_map<uint64_t, std::shared_ptr<Endpoint>> endpoints;
+      for (auto &shard : shards_)
+      {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        endpoints.insert(shard.endpoints.begin(), shard.endpoints.end());
+        shard.endpoints.clear();
+      }
+      for (const auto &[connection_id, endpoint] : endpoints)
+      {
+        Deliver(*endpoint, NetworkEvent(NetworkEventType::kDisconnected, connection_id));
+      }
+
+      NW_LOG_INFO("[EventLoopGroup] 已停止，通知断开 " << endpoints.size() << " 个连接");
+    }
+
+    size_t EventLoopGroup::Impl::GetConnectionCount() const
+    {
+      size_t count = 0;
+      for (const auto &shard : shards_)
+      {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.endpoints.size();
+      }
+      return count;
+    }
+
+    std::shared_ptr<Reactor> EventLoopGroup::Impl::SelectReactor()
+    {
+      std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+
+      if (!is_running_.load(std::memory_order_acquire) || reactors_.empty())
+      {
+        return nullptr;
+      }
+
+      size_t index = next_reactor_index_.fetch_add(1, std::memory_order_relaxed) % reactors_.size();
+      return reactors_[index];
+    }
+
+    std::vector<std::shared_ptr<Reactor>> EventLoopGroup::Impl::GetReactors() const
+    {
+      std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+      return reactors_;
+    }
+
+    std::shared_ptr<WorkerPool> EventLoopGroup::Impl::GetWorkerPool() const
+    {
+      std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+      return worker_pool_;
+    }
+
+    void EventLoopGroup::Impl::Register(uint64_t connection_id,
+                                         const std::shared_ptr<Endpoint> &endpoint)
+    {
+      EndpointShard &shard = ShardFor(connection_id);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.endpoints[connection_id] = endpoint;
+    }
+
+    void EventLoopGroup::Impl::Unregister(uint64_t connection_id)
+    {
+      EndpointShard &shard = ShardFor(connection_id);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.endpoints.erase(connection_id);
+    }
+
+    bool EventLoopGroup::Impl::IsRegistered(uint64_t connection_id,
+                                             const std::shared_ptr<Endpoint> &endpoint) const
+    {
+      EndpointShard &shard = ShardFor(connection_id);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto it = shard.endpoints.find(connection_id);
+      return it != shard.endpoints.end() && it->second == endpoint;
+    }
+
+    std::vector<uint64_t> EventLoopGroup::Impl::DetachEndpoint(
+        const std::shared_ptr<Endpoint> &endpoint)
+    {
+      std::vector<uint64_t> detached;
+      for (auto &shard : shards_)
+      {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.endpoints.begin(); it != shard.endpoints.end();)
+        {
+          if (it->second == endpoint)
+          {
+            detached.push_back(it->first);
+            it = shard.endpoints.erase(it);
+          }
+          else
+          {
+            ++it;
+          }
+        }
+      }
+      return detached;
+    }
+
+    void EventLoopGroup::Impl::Deliver(Endpoint &endpoint, const NetworkEvent &event)
+    {
+      if (endpoint.concurrent)
+      {
+        endpoint.sink(event);
+        return;
+      }
+
+      std::lock_guard<std::recursive_mutex> lock(endpoint.mutex);
+      if (endpoint.sink)
+      {
+        endpoint.sink(event);
+      }
+    }
+
+    void EventLoopGroup::Impl::OnNetworkEvent(const NetworkEvent &event)
+    {
+      // 连接的事件都由同一个 Worker 处理，分片锁只与该分片上的登记/解除竞争
+      EndpointShard &shard = ShardFor(event.connection_id);
+      std::shared_ptr<Endpoint> endpoint;
+      {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.endpoints.find(event.connection_id);
+        if (it == shard.endpoints.end())
+        {
+          NW_LOG_TRACE("[EventLoopGroup] 丢弃未注册连接的事件: conn_id="
+                       << event.connection_id);
+          return;
+        }
+        endpoint = it->second;
+      }
+
+      Deliver(*endpoint, event);
+
+      // 断开事件之后该连接不会再有事件，解除路由（Client 重连会使用新的 connection_id）
+      if (event.type == NetworkEventType::kDisconnected)
+      {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.endpoints.find(event.connection_id);
+        if (it != shard.endpoints.end() && it->second == endpoint)
+        {
+          shard.endpoints.erase(it);
+        }
+      }
+    }
+
+    // ============ EventLoopGroup 公共接口 ============
+
+    EventLoopGroup::EventLoopGroup(size_t loop_count, size_t worker_count)
+        : impl_(std::make_shared<Impl>(loop_count, worker_count)) {}
+
+    EventLoopGroup::~EventLoopGroup()
+    {
+      impl_->Stop();
+    }
+
+    bool EventLoopGroup::Start() { return impl_->Start(); }
+
+    void EventLoopGroup::Stop() { impl_->Stop(); }
+
+    bool EventLoopGroup::IsRunning() const { return impl_->IsRunning(); }
+
+    size_t EventLoopGroup::GetLoopCount() const { return impl_->GetLoopCount(); }
+
+    size_t EventLoopGroup::GetWorkerCount() const { return impl_->GetWorkerCount(); }
+
+    size_t EventLoopGroup::GetConnectionCount() const { return impl_->GetConnectionCount(); }
+
+  } // namespace network
+} // namespace darwincore
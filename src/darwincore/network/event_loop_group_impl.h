@@ -0,0 +1,146 @@
+//
+// DarwinCore Network 模块
+// EventLoopGroup::Impl - 共享事件循环组内部实现
+//
+// 功能说明：
+//   持有 N 个 Reactor 和一个 WorkerPool，并维护 connection_id -> 成员
+//   （Server 或 Client）的路由表。Worker 线程取出事件后按 connection_id
+//   找到对应成员回调。路由表按 Worker 分片，与 WorkerPool 的连接分配一致，
+//   各 Worker 查表时只锁自己的分片。
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_NETWORK_EVENT_LOOP_GROUP_IMPL_H
+#define DARWINCORE_NETWORK_EVENT_LOOP_GROUP_IMPL_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "reactor.h"
+#include "worker_pool.h"
+#include <darwincore/network/event.h>
+#include <darwincore/network/event_loop_group.h>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    /**
+     * @brief EventLoopGroup 内部实现（成员 Server/Client 与 EventLoopGroup 共享）
+     *
+     * 线程安全：
+     *   - Register/Unregister/DetachEndpoint 可以从任何线程调用
+     *   - 事件回调在 Worker 线程中执行，持有 Endpoint 的锁，
+     *     成员清空 sink 后不会再收到任何回调（Client）
+     *   - concurrent 接收端的回调不加锁，可以在多个 Worker 上并发执行，
+     *     sink 注册后不再修改，由成员自己保证解绑后不再访问自身（Server）
+     *   - kDisconnected 事件交付后自动解除该连接的路由
+     *   - Stop() 在调用线程中向仍登记的连接补发 kDisconnected
+     */
+    class EventLoopGroup::Impl
+    {
+    public:
+      /// 单个成员的事件接收端（一个 Client 或一个 Server 的所有连接共用）
+      struct Endpoint
+      {
+        std::recursive_mutex mutex;                       ///< 回调与解绑互斥（允许回调内重入）
+        std::function<void(const NetworkEvent &)> sink;   ///< 事件回调（解绑后为空）
+        bool concurrent{false};                           ///< 回调不加锁（见类注释）
+      };
+
+      Impl(size_t loop_count, size_t worker_count);
+      ~Impl();
+
+      Impl(const Impl &) = delete;
+      Impl &operator=(const Impl &) = delete;
+
+      bool Start();
+      void Stop();
+      bool IsRunning() const { return is_running_.load(std::memory_order_acquire); }
+
+      size_t GetLoopCount() const { return loop_count_; }
+      size_t GetWorkerCount() const { return worker_count_; }
+      size_t GetConnectionCount() const;
+
+      /**
+       * @brief 轮询选择一个 Reactor 承载新连接
+       * @return Reactor（未运行时返回 nullptr）
+       */
+      std::shared_ptr<Reactor> SelectReactor();
+
+      /**
+       * @brief 获取全部 Reactor（下标即 Reactor ID，未运行时为空）
+       *
+       * Server 用它把新连接分配到各 Reactor，并按 connection_id 中的
+       * Reactor ID 找到连接所在的 Reactor。
+       */
+      std::vector<std::shared_ptr<Reactor>> GetReactors() const;
+
+      /// 获取共享的 WorkerPool（未运行时为 nullptr）
+      std::shared_ptr<WorkerPool> GetWorkerPool() const;
+
+      /**
+       * @brief 注册连接的事件接收端
+       *
+       * 必须在 Reactor::AddConnection 之前调用，保证 kConnected 事件不会丢失。
+       */
+      void Register(uint64_t connection_id, const std::shared_ptr<Endpoint> &endpoint);
+
+      /**
+       * @brief 解除连接的事件接收端
+       */
+      void Unregister(uint64_t connection_id);
+
+      /**
+       * @brief 判断连接当前是否登记在指定接收端下
+       *
+       * 组内各成员共用 Reactor，connection_id 可以定位到任意成员的连接，
+       * 成员对连接发起操作前用它确认连接属于自己。
+       */
+      bool IsRegistered(uint64_t connection_id, const std::shared_ptr<Endpoint> &endpoint) const;
+
+      /**
+       * @brief 解除某个接收端的全部连接
+       * @return 被解除的 connection_id（之后这些连接的事件被丢弃）
+       */
+      std::vector<uint64_t> DetachEndpoint(const std::shared_ptr<Endpoint> &endpoint);
+
+    private:
+      /// 路由表分片（connection_id % worker_count，与 WorkerPool 分配连接的方式一致）
+      struct EndpointShard
+      {
+        mutable std::mutex mutex;
+        std::unordered_map<uint64_t, std::shared_ptr<Endpoint>> endpoints;
+      };
+
+      void OnNetworkEvent(const NetworkEvent &event);
+      static void Deliver(Endpoint &endpoint, const NetworkEvent &event);
+      EndpointShard &ShardFor(uint64_t connection_id) const
+      {
+        return shards_[connection_id % shards_.size()];
+      }
+
+      size_t loop_count_;
+      size_t worker_count_;
+
+      std::shared_ptr<WorkerPool> worker_pool_;
+      std::vector<std::shared_ptr<Reactor>> reactors_;
+      std::atomic<size_t> next_reactor_index_{0};
+
+      mutable std::mutex lifecycle_mutex_;
+      std::atomic<bool> is_running_{false};
+
+      mutable std::vector<EndpointShard> shards_;  ///< 构造后大小不变
+    };
+
+  } // namespace network
+} // namespace darwincore
+
+#endif // DARWINCORE_NETWORK_EVENT_LOOP_GROUP_IMPL_H
@@ -9,24 +9,97 @@ namespace darwincore
 
         namespace proto
         {
+            namespace
+            {
+                /** @brief 追加 varint（LEB128）编码的无符号整数 */
+                void AppendVarint(std::vector<uint8_t> &out, uint64_t value)
+                {
+                    while (value >= 0x80)
+                    {
+                        out.push_back(static_cast<uint8_t>(value | 0x80));
+                        value >>= 7;
+                    }
+                    out.push_back(static_cast<uint8_t>(value));
+                }
+
+                /** @brief varint 编码后的字节数 */
+                size_t VarintSize(uint64_t value)
+                {
+                    size_t size = 1;
+                    while (value >= 0x80)
+                    {
+                        value >>= 7;
+                        ++size;
+                    }
+                    return size;
+                }
+
+                /**
+                 * @brief 读取 varint，pos 前进到其后
+                 * @return 数据不足或超过 64 位返回 false
+                 */
+                bool ReadVarint(const uint8_t *data, size_t len, size_t &pos, uint64_t &value)
+                {
+                    value = 0;
+                    for (int shift = 0; shift < 64 && pos < len; shift += 7)
+                    {
+                        uint8_t byte = data[pos++];
+                        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                        if ((byte & 0x80) == 0)
+                            return true;
+                    }
+                    return false;
+                }
+
+                Frame MakeCompactFrame(FrameType type, std::vector<uint8_t> payload)
+                {
+                    if (payload.size() > MAX_COMPACT_PAYLOAD)
+                        throw ProtocolError("compact payload too large");
+
+                    Frame f{};
+                    f.header.magic1 = MAGIC1;
+                    f.header.magic2 = MAGIC2;
+                    f.header.version = VERSION_COMPACT;
+                    f.header.type = static_cast<uint8_t>(type);
+                    f.header.payload_len = static_cast<uint32_t>(payload.size());
+                    f.payload = std::move(payload);
+                    return f;
+                }
+            } // namespace
 
             // ========== Frame 序列化实现 ==========
 
+            size_t Frame::HeaderSize() const
+            {
+                return header.version == VERSION_COMPACT ? sizeof(CompactFrameHeader)
+                                                         : sizeof(FrameHeader);
+            }
+
             /**
              * @brief 将帧序列化为字节流
              * @return 序列化后的字节数组（Header + Payload）
              */
             std::vector<uint8_t> Frame::Serialize() const
             {
-                std::vector<uint8_t> buffer(sizeof(FrameHeader) + payload.size());
+                const size_t header_size = HeaderSize();
+                std::vector<uint8_t> buffer(header_size + payload.size());
 
                 // 复制头部
-                std::memcpy(buffer.data(), &header, sizeof(FrameHeader));
+                if (header.version == VERSION_COMPACT)
+                {
+                    CompactFrameHeader compact{header.magic1, header.magic2, header.version,
+                                               header.type, static_cast<uint16_t>(payload.size())};
+                    std::memcpy(buffer.data(), &compact, sizeof(compact));
+                }
+                else
+                {
+                    std::memcpy(buffer.data(), &header, sizeof(FrameHeader));
+                }
 
                 // 复制 payload
                 if (!payload.empty())
                 {
-                    std::memcpy(buffer.data() + sizeof(FrameHeader), payload.data(), payload.size());
+                    std::memcpy(buffer.data() + header_size, payload.data(), payload.size());
                 }
 
                 return buffer;
@@ -41,6 +114,28 @@ namespace darwincore
              */
             bool Frame::Deserialize(const uint8_t *data, size_t len, Frame &out)
             {
+                // 紧凑帧：展开为普通帧头，只保留 magic/version/type/payload_len
+                if (len >= sizeof(CompactFrameHeader) && data[2] == VERSION_COMPACT)
+                {
+                    CompactFrameHeader compact;
+                    std::memcpy(&compact, data, sizeof(compact));
+                    if (compact.magic1 != MAGIC1 || compact.magic2 != MAGIC2)
+                        return false;
+
+                    size_t expected_size = sizeof(CompactFrameHeader) + compact.payload_len;
+                    if (len < expected_size)
+                        return false;
+
+                    out.header = FrameHeader{};
+                    out.header.magic1 = compact.magic1;
+                    out.header.magic2 = compact.magic2;
+                    out.header.version = compact.version;
+                    out.header.type = compact.type;
+                    out.header.payload_len = compact.payload_len;
+                    out.payload.assign(data + sizeof(CompactFrameHeader), data + expected_size);
+                    return true;
+                }
+
                 if (len < sizeof(FrameHeader))
                     return false;
 
@@ -221,6 +316,18 @@ namespace darwincore
                 return MakeFrame(FrameType::StreamEnd, &p, sizeof(p));
             }
 
+            /**
+             * @brief 编码流窗口更新帧
+             * @param stream_id 流唯一标识符
+             * @param credit 新增的字节额度
+             * @return 流窗口更新帧
+             */
+            Frame Encoder::EncodeStreamWindow(uint64_t stream_id, uint32_t credit)
+            {
+                StreamWindowPayload p{stream_id, credit};
+                return MakeFrame(FrameType::StreamWindow, &p, sizeof(p));
+            }
+
             /**
              * @brief 将 Frame 数组序列化为字节流数组
              * @param frames 帧数组
@@ -240,6 +347,130 @@ namespace darwincore
                 return result;
             }
 
+            /**
+             * @brief 编码单分片的小消息（紧凑帧）
+             * @param message_id 消息唯一标识符
+             * @param data 消息数据
+             * @param length 数据长度
+             * @return 紧凑消息帧
+             * @throw ProtocolError 超出 MAX_COMPACT_PAYLOAD 时抛出异常
+             */
+            Frame Encoder::EncodeCompactMessage(uint64_t message_id, const uint8_t *data, size_t length)
+            {
+                if (VarintSize(message_id) + length > MAX_COMPACT_PAYLOAD)
+                    throw ProtocolError("compact message too large");
+
+                std::vector<uint8_t> payload;
+                payload.reserve(VarintSize(message_id) + length);
+                AppendVarint(payload, message_id);
+                payload.insert(payload.end(), data, data + length);
+                return MakeCompactFrame(FrameType::Message, std::move(payload));
+            }
+
+            // ========== BatchEncoder 实现 ==========
+
+            bool BatchEncoder::Add(uint64_t message_id, const uint8_t *data, size_t length)
+            {
+                size_t entry = VarintSize(message_id) + VarintSize(length) + length;
+                if (payload_.size() + entry > MAX_COMPACT_PAYLOAD)
+                    return false;
+
+                AppendVarint(payload_, message_id);
+                AppendVarint(payload_, length);
+                payload_.insert(payload_.end(), data, data + length);
+                ++count_;
+                return true;
+            }
+
+            Frame BatchEncoder::Finish()
+            {
+                std::vector<uint8_t> payload;
+                payload.swap(payload_);
+                count_ = 0;
+                return MakeCompactFrame(FrameType::Batch, std::move(payload));
+            }
+
+            // ========== FrameScheduler 实现 ==========
+
+            FrameScheduler::FlowKey FrameScheduler::KeyOf(const Frame &frame)
+            {
+                // Message 帧以 message_id 开头，流帧以 stream_id 开头；紧凑帧以 varint 开头
+                FlowKey key;
+                key.is_stream = static_cast<FrameType>(frame.header.type) != FrameType::Message &&
+                                static_cast<FrameType>(frame.header.type) != FrameType::Batch;
+                if (frame.header.version == VERSION_COMPACT)
+                {
+                    size_t pos = 0;
+                    ReadVarint(frame.payload.data(), frame.payload.size(), pos, key.id);
+                }
+                else if (frame.payload.size() >= sizeof(uint64_t))
+                {
+                    std::memcpy(&key.id, frame.payload.data(), sizeof(uint64_t));
+                }
+                return key;
+            }
+
+            void FrameScheduler::Enqueue(std::vector<Frame> frames, SendPriority priority)
+            {
+                for (auto &frame : frames)
+                {
+                    Enqueue(std::move(frame), priority);
+                }
+            }
+
+            void FrameScheduler::Enqueue(Frame frame, SendPriority priority)
+            {
+                FlowKey key = KeyOf(frame);
+                auto [it, inserted] = flows_.try_emplace(key);
+                Flow &flow = it->second;
+                if (inserted)
+                {
+                    flow.priority = priority;
+                    ready_[static_cast<size_t>(priority)].push_back(key);
+                }
+
+                pending_bytes_ += frame.HeaderSize() + frame.payload.size();
+                ++pending_frames_;
+                flow.frames.push_back(std::move(frame));
+            }
+
+            bool FrameScheduler::Next(Frame &out, SendPriority *priority)
+            {
+                auto &lane = ready_[static_cast<size_t>(SendPriority::kControl)].empty()
+                                 ? ready_[static_cast<size_t>(SendPriority::kBulk)]
+                                 : ready_[static_cast<size_t>(SendPriority::kControl)];
+                if (lane.empty())
+                {
+                    return false;
+                }
+
+                FlowKey key = lane.front();
+                lane.pop_front();
+
+                auto it = flows_.find(key);
+                Flow &flow = it->second;
+                out = std::move(flow.frames.front());
+                flow.frames.pop_front();
+                if (priority)
+                {
+                    *priority = flow.priority;
+                }
+
+                pending_bytes_ -= out.HeaderSize() + out.payload.size();
+                --pending_frames_;
+
+                // 还有帧的流排到本优先级队尾，实现轮转
+                if (flow.frames.empty())
+                {
+                    flows_.erase(it);
+                }
+                else
+                {
+                    lane.push_back(key);
+                }
+                return true;
+            }
+
             // ========== Decoder 实现 ==========
 
             /**
@@ -273,15 +504,25 @@ namespace darwincore
                 {
                     stats_.buffer_size = buffer_.size();
 
-                    if (buffer_.size() < sizeof(FrameHeader))
+                    if (buffer_.size() < sizeof(CompactFrameHeader))
                         return;
 
-                    auto *hdr = reinterpret_cast<FrameHeader *>(buffer_.data());
-
                     // 验证魔数
-                    if (hdr->magic1 != MAGIC1 || hdr->magic2 != MAGIC2)
+                    if (buffer_[0] != MAGIC1 || buffer_[1] != MAGIC2)
                         throw ProtocolError("bad magic");
 
+                    if (buffer_[2] == VERSION_COMPACT)
+                    {
+                        if (!DecodeCompactFrame())
+                            return;
+                        continue;
+                    }
+
+                    if (buffer_.size() < sizeof(FrameHeader))
+                        return;
+
+                    auto *hdr = reinterpret_cast<FrameHeader *>(buffer_.data());
+
                     // 验证版本
                     if (hdr->version != VERSION)
                         throw ProtocolError("unsupported version");
@@ -386,6 +627,13 @@ namespace darwincore
                             ev.stream_id = se->stream_id;
                             ev.crc32 = se->crc32;
                         }
+                        else if (type == FrameType::StreamWindow)
+                        {
+                            auto *sw =
+                                reinterpret_cast<const StreamWindowPayload *>(payload);
+                            ev.stream_id = sw->stream_id;
+                            ev.credit = sw->credit;
+                        }
                         stream_events_.push_back(std::move(ev));
                     }
 
@@ -393,6 +641,56 @@ namespace darwincore
                 }
             }
 
+            bool Decoder::DecodeCompactFrame()
+            {
+                CompactFrameHeader hdr;
+                std::memcpy(&hdr, buffer_.data(), sizeof(hdr));
+
+                size_t frame_size = sizeof(CompactFrameHeader) + hdr.payload_len;
+                if (buffer_.size() < frame_size)
+                    return false;
+
+                const uint8_t *payload = buffer_.data() + sizeof(CompactFrameHeader);
+                const size_t len = hdr.payload_len;
+                size_t pos = 0;
+                stats_.frames_received++;
+
+                FrameType type = static_cast<FrameType>(hdr.type);
+                if (type == FrameType::Message)
+                {
+                    MessageComplete msg;
+                    if (!ReadVarint(payload, len, pos, msg.message_id))
+                        throw ProtocolError("bad compact message");
+
+                    msg.data.assign(payload + pos, payload + len);
+                    completed_messages_.push_back(std::move(msg));
+                    stats_.messages_completed++;
+                }
+                else if (type == FrameType::Batch)
+                {
+                    while (pos < len)
+                    {
+                        MessageComplete msg;
+                        uint64_t size = 0;
+                        if (!ReadVarint(payload, len, pos, msg.message_id) ||
+                            !ReadVarint(payload, len, pos, size) || size > len - pos)
+                            throw ProtocolError("bad batch entry");
+
+                        msg.data.assign(payload + pos, payload + pos + size);
+                        pos += size;
+                        completed_messages_.push_back(std::move(msg));
+                        stats_.messages_completed++;
+                    }
+                }
+                else
+                {
+                    throw ProtocolError("unsupported compact frame type");
+                }
+
+                buffer_.erase(buffer_.begin(), buffer_.begin() + frame_size);
+                return true;
+            }
+
             /**
              * @brief 获取完整的消息
              * @param out 输出消息
@@ -476,6 +774,129 @@ namespace darwincore
                 stats_ = DecoderStats{};
             }
 
+            // ========== 流控实现 ==========
+
+            StreamSender::StreamSender(uint32_t initial_window)
+                : initial_window_(initial_window)
+            {
+            }
+
+            Frame StreamSender::Start(uint64_t stream_id, uint64_t total_size)
+            {
+                State state;
+                state.credit = initial_window_;
+                if (!streams_.emplace(stream_id, state).second)
+                    throw ProtocolError("stream already started");
+
+                return Encoder::EncodeStreamStart(stream_id, total_size);
+            }
+
+            size_t StreamSender::Write(uint64_t stream_id,
+                                       const uint8_t *data,
+                                       size_t length,
+                                       std::vector<Frame> &out)
+            {
+                auto it = streams_.find(stream_id);
+                if (it == streams_.end())
+                    throw ProtocolError("unknown stream");
+
+                State &state = it->second;
+                const size_t max_chunk = MAX_FRAME_PAYLOAD - sizeof(StreamChunkPayload);
+                size_t budget = static_cast<size_t>(std::min<uint64_t>(length, state.credit));
+
+                size_t written = 0;
+                while (written < budget)
+                {
+                    size_t chunk = std::min(max_chunk, budget - written);
+                    out.push_back(Encoder::EncodeStreamChunk(stream_id, state.offset,
+                                                             data + written, chunk));
+                    state.offset += chunk;
+                    written += chunk;
+                }
+
+                state.credit -= written;
+                return written;
+            }
+
+            Frame StreamSender::End(uint64_t stream_id, uint32_t crc32)
+            {
+                streams_.erase(stream_id);
+                return Encoder::EncodeStreamEnd(stream_id, crc32);
+            }
+
+            bool StreamSender::HandleEvent(const StreamEvent &event)
+            {
+                if (event.type != FrameType::StreamWindow)
+                    return false;
+
+                AddCredit(event.stream_id, event.credit);
+                return true;
+            }
+
+            void StreamSender::AddCredit(uint64_t stream_id, uint32_t credit)
+            {
+                // 流结束后对端可能仍在交还额度
+                auto it = streams_.find(stream_id);
+                if (it != streams_.end())
+                    it->second.credit += credit;
+            }
+
+            uint64_t StreamSender::Available(uint64_t stream_id) const
+            {
+                auto it = streams_.find(stream_id);
+                return it == streams_.end() ? 0 : it->second.credit;
+            }
+
+            StreamReceiver::StreamReceiver(uint32_t window)
+                : window_(window)
+            {
+            }
+
+            void StreamReceiver::OnEvent(const StreamEvent &event)
+            {
+                switch (event.type)
+                {
+                case FrameType::StreamStart:
+                    streams_[event.stream_id] = State{};
+                    break;
+                case FrameType::StreamChunk:
+                {
+                    // 未开始或已结束的流：不为其建立状态，否则对端可以借此无限占用内存
+                    auto it = streams_.find(event.stream_id);
+                    if (it == streams_.end())
+                        throw ProtocolError("unknown stream");
+
+                    State &state = it->second;
+                    state.outstanding += event.data.size();
+                    if (state.outstanding > window_)
+                        throw ProtocolError("stream window exceeded");
+                    break;
+                }
+                case FrameType::StreamEnd:
+                    streams_.erase(event.stream_id);
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            bool StreamReceiver::Consume(uint64_t stream_id, size_t bytes, Frame &update)
+            {
+                auto it = streams_.find(stream_id);
+                if (it == streams_.end())
+                    return false;
+
+                State &state = it->second;
+                state.consumed = std::min(state.consumed + bytes, state.outstanding);
+                if (state.consumed < window_ / 2)
+                    return false;
+
+                update = Encoder::EncodeStreamWindow(stream_id, static_cast<uint32_t>(state.consumed));
+                state.outstanding -= state.consumed;
+                state.consumed = 0;
+                return true;
+            }
+
             // ========== CRC32 工具函数实现 ==========
 
             /**
@@ -0,0 +1,172 @@
+//
+// DarwinCore Network 模块
+// RateLimiter - 连接/监听级令牌桶限速
+//
+// 功能说明：
+//   Reactor 在读取或发送后按实际字节数和消息数扣减令牌，允许透支；
+//   透支时返回需要等待的时长，由 Reactor 暂停该连接的读监控，
+//   到期后再恢复。透支而不是预检，使 Reactor 不需要在读取前
+//   知道这次能读到多少数据。
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_NETWORK_RATE_LIMITER_H
+#define DARWINCORE_NETWORK_RATE_LIMITER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#include <darwincore/network/configuration.h>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    /**
+     * @brief 单个令牌桶（非线程安全）
+     */
+    class TokenBucket
+    {
+    public:
+      using Clock = std::chrono::steady_clock;
+
+      TokenBucket() = default;
+
+      /**
+       * @param rate 每秒补充的令牌数（0 表示不限制）
+       * @param burst 桶容量（0 表示等于 rate）
+       */
+      TokenBucket(uint64_t rate, uint64_t burst)
+          : rate_(static_cast<double>(rate)),
+            capacity_(static_cast<double>(burst > 0 ? burst : rate)),
+            tokens_(capacity_),
+            last_refill_(Clock::now()) {}
+
+      bool IsLimited() const { return rate_ > 0; }
+
+      /**
+       * @brief 扣减令牌（允许透支）
+       * @return 令牌恢复为非负还需等待的时长（未透支返回 0）
+       */
+      Clock::duration Consume(uint64_t amount, Clock::time_point now)
+      {
+        if (!IsLimited())
+        {
+          return Clock::duration::zero();
+        }
+        Refill(now);
+        tokens_ -= static_cast<double>(amount);
+        return Delay();
+      }
+
+      /**
+       * @brief 补充令牌后返回仍需等待的时长
+       */
+      Clock::duration GetDelay(Clock::time_point now)
+      {
+        if (!IsLimited())
+        {
+          return Clock::duration::zero();
+        }
+        Refill(now);
+        return Delay();
+      }
+
+    private:
+      void Refill(Clock::time_point now)
+      {
+        if (now <= last_refill_)
+        {
+          return;
+        }
+        double elapsed = std::chrono::duration<double>(now - last_refill_).count();
+        tokens_ = std::min(capacity_, tokens_ + elapsed * rate_);
+        last_refill_ = now;
+      }
+
+      Clock::duration Delay() const
+      {
+        if (tokens_ >= 0)
+        {
+          return Clock::duration::zero();
+        }
+        return std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(-tokens_ / rate_));
+      }
+
+      double rate_{0};
+      double capacity_{0};
+      double tokens_{0};
+      Clock::time_point last_refill_{};
+    };
+
+    /**
+     * @brief 字节 + 消息双桶限速器（非线程安全，连接级使用）
+     */
+    class RateLimiter
+    {
+    public:
+      using Clock = TokenBucket::Clock;
+
+      RateLimiter() = default;
+
+      explicit RateLimiter(const RateLimit &limit)
+          : bytes_(limit.bytes_per_second, limit.burst_bytes),
+            messages_(limit.messages_per_second, limit.burst_messages) {}
+
+      bool IsLimited() const { return bytes_.IsLimited() || messages_.IsLimited(); }
+
+      /**
+       * @brief 记录一次读取/发送
+       * @return 需要等待的时长（两个桶中较长者）
+       */
+      Clock::duration Consume(uint64_t bytes, uint64_t messages, Clock::time_point now)
+      {
+        return std::max(bytes_.Consume(bytes, now), messages_.Consume(messages, now));
+      }
+
+      Clock::duration GetDelay(Clock::time_point now)
+      {
+        return std::max(bytes_.GetDelay(now), messages_.GetDelay(now));
+      }
+
+    private:
+      TokenBucket bytes_;
+      TokenBucket messages_;
+    };
+
+    /**
+     * @brief 线程安全的限速器（监听级使用，同一监听的连接分布在多个 Reactor 上）
+     */
+    class SharedRateLimiter
+    {
+    public:
+      using Clock = RateLimiter::Clock;
+
+      explicit SharedRateLimiter(const RateLimit &limit) : limiter_(limit) {}
+
+      Clock::duration Consume(uint64_t bytes, uint64_t messages, Clock::time_point now)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return limiter_.Consume(bytes, messages, now);
+      }
+
+      Clock::duration GetDelay(Clock::time_point now)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return limiter_.GetDelay(now);
+      }
+
+    private:
+      std::mutex mutex_;
+      RateLimiter limiter_;
+    };
+
+  } // namespace network
+} // namespace darwincore
+
+#endif // DARWINCORE_NETWORK_RATE_LIMITER_H
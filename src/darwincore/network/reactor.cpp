@@ -13,18 +13,23 @@
 // 作者: DarwinCore Network 团队
 // 日期: 2026
 
+#include <algorithm>
 #include <arpa/inet.h>
 #include <chrono>
+#include <climits>
 #include <cstring>
 #include <ctime>
 #include <errno.h>
 #include <unistd.h>
 #include <pthread.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 
 #include "io_monitor.h"
 #include "reactor.h"
 #include "send_buffer.h"
+#include "send_memory_budget.h"
+#include "shm_channel.h"
 #include "socket_helper.h"
 #include "worker_pool.h"
 #include <darwincore/network/configuration.h>
@@ -37,9 +42,9 @@ namespace darwincore
 
     // ============ ReactorConnection 增强 ============
     Reactor::ReactorConnection::ReactorConnection(int fd, const sockaddr_storage &peer, uint64_t conn_id)
-        : file_descriptor(fd),
-          peer_address(peer),
-          connection_id(conn_id),
+        : connection_id(conn_id),
+          file_descriptor(fd),
+          peer_address(SocketHelper::CompactPeerAddress(peer)),
           last_active(std::chrono::steady_clock::now()) {}
 
     void Reactor::ReactorConnection::UpdateActivity()
@@ -89,6 +94,9 @@ namespace darwincore
         return false;
       }
 
+      receive_buffer_.resize(std::max(max_receive_size_,
+                                      SocketConfiguration::kDefaultReceiveBufferSize));
+
       try
       {
         event_loop_thread_ = std::thread(&Reactor::RunEventLoop, this);
@@ -115,23 +123,17 @@ namespace darwincore
       NW_LOG_INFO("[Reactor" << reactor_id_ << "] 开始停止");
 
       // 先通知停止，这样事件循环会退出
+      // 注意：connections_ 只能在事件循环线程访问，必须等线程退出后再关闭连接
       pending_operations_.NotifyStop();
 
-      // 立即关闭所有连接的fd，加速断开
-      for (auto &[conn_id, conn] : connections_)
-      {
-        int fd = conn.file_descriptor;
-        if (fd >= 0)
-        {
-          shutdown(fd, SHUT_RDWR);
-        }
-      }
-
       if (event_loop_thread_.joinable())
       {
         event_loop_thread_.join();
       }
 
+      // 事件循环已退出，队列中剩余的发送不会再执行，退回其占用的预算
+      DropPendingSends();
+
       // 先关闭 kqueue，移除所有监控
       if (io_monitor_) {
         io_monitor_->Close();
@@ -146,6 +148,12 @@ namespace darwincore
     // ============ 公共方法（线程安全）============
 
     bool Reactor::AddConnection(int fd, const sockaddr_storage &peer)
+    {
+      return AddConnection(fd, peer, ConnectionOptions{});
+    }
+
+    bool Reactor::AddConnection(int fd, const sockaddr_storage &peer,
+                                const ConnectionOptions &options)
     {
       if (fd < 0)
       {
@@ -167,6 +175,11 @@ namespace darwincore
       op.type = Operation::kAdd;
       op.fd = fd;
       op.peer = peer;
+      op.connection_id = options.connection_id;
+      op.send_buffer_size = options.send_buffer_size;
+      op.shm_channel = options.shm_channel;
+      op.listener_limiter = options.listener_limiter;
+      op.idle_timeout = options.idle_timeout;
       op.promise = promise;
 
       if (!pending_operations_.Enqueue(op))
@@ -188,7 +201,21 @@ namespace darwincore
       }
     }
 
-    bool Reactor::RemoveConnection(uint64_t connection_id)
+    uint64_t Reactor::AllocateConnectionId(int fd)
+    {
+      uint16_t seq = connection_seq_.fetch_add(1, std::memory_order_relaxed);
+      if (seq == 0)
+      {
+        seq = connection_seq_.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      return ConnectionIdGenerator::Generate(
+          static_cast<uint8_t>(reactor_id_),
+          static_cast<uint16_t>(fd),
+          seq);
+    }
+
+    bool Reactor::RemoveConnection(uint64_t connection_id, int error_code)
     {
       if (!is_running_.load(std::memory_order_acquire))
       {
@@ -198,10 +225,89 @@ namespace darwincore
       Operation op;
       op.type = Operation::kRemove;
       op.connection_id = connection_id;
+      op.error_code = error_code;
+      return pending_operations_.Enqueue(op);
+    }
+
+    bool Reactor::ExpectConnection(uint64_t connection_id)
+    {
+      if (!is_running_.load(std::memory_order_acquire))
+      {
+        return false;
+      }
+
+      Operation op;
+      op.type = Operation::kExpect;
+      op.connection_id = connection_id;
       return pending_operations_.Enqueue(op);
     }
 
-    bool Reactor::SendData(uint64_t connection_id, const uint8_t *data, size_t size)
+    std::future<uint64_t> Reactor::MigrateConnection(uint64_t connection_id,
+                                                     std::shared_ptr<Reactor> target)
+    {
+      auto promise = std::make_shared<std::promise<uint64_t>>();
+      auto future = promise->get_future();
+
+      Operation op;
+      op.type = Operation::kMigrate;
+      op.connection_id = connection_id;
+      op.promise = promise;
+      op.handoff = std::make_shared<Handoff>();
+      op.handoff->target = std::move(target);
+
+      if (!is_running_.load(std::memory_order_acquire) || !op.handoff->target ||
+          !pending_operations_.Enqueue(op))
+      {
+        // 目标已登记等待迁入：交给它一个空的迁入操作，移除登记并执行暂存的操作
+        if (op.handoff->target)
+        {
+          Operation cancel;
+          cancel.type = Operation::kAdopt;
+          cancel.connection_id = connection_id;
+          cancel.handoff = op.handoff;
+          op.handoff->target->pending_operations_.Enqueue(cancel);
+        }
+        promise->set_value(0);
+      }
+      return future;
+    }
+
+    std::vector<Reactor::TrafficSample> Reactor::SampleHotConnections(size_t limit)
+    {
+      if (!traffic_sampling_ || limit == 0 || !is_running_.load(std::memory_order_acquire))
+      {
+        return {};
+      }
+
+      auto promise = std::make_shared<std::promise<uint64_t>>();
+      auto future = promise->get_future();
+
+      Operation op;
+      op.type = Operation::kSample;
+      op.promise = promise;
+      op.handoff = std::make_shared<Handoff>();
+      op.handoff->sample_limit = limit;
+      std::shared_ptr<Handoff> handoff = op.handoff;
+
+      if (!pending_operations_.Enqueue(op))
+      {
+        return {};
+      }
+
+      try
+      {
+        future.get();
+      }
+      catch (const std::exception &e)
+      {
+        NW_LOG_WARNING("[Reactor" << reactor_id_ << "] SampleHotConnections 异常: " << e.what());
+        return {};
+      }
+      return std::move(handoff->samples);
+    }
+
+    bool Reactor::SendData(uint64_t connection_id, const uint8_t *data, size_t size,
+                           SendPriority priority)
     {
       if (!data || size == 0)
       {
@@ -213,11 +319,53 @@ namespace darwincore
         return false;
       }
 
+      if (!ChargeQueuedSend(size))
+      {
+        return false;
+      }
+
       Operation op;
       op.type = Operation::kSend;
       op.connection_id = connection_id;
       op.data.assign(data, data + size);
-      return pending_operations_.Enqueue(op);
+      op.priority = priority;
+      if (!pending_operations_.Enqueue(op))
+      {
+        ReleaseQueuedSend(size); // 入队失败（已停止）：退回预算
+        return false;
+      }
+      return true;
+    }
+
+    bool Reactor::SendData(uint64_t connection_id, const uint8_t *data, size_t size,
+                           SendCompleteCallback on_complete)
+    {
+      if (!data || size == 0)
+      {
+        return false;
+      }
+
+      if (!is_running_.load(std::memory_order_acquire))
+      {
+        return false;
+      }
+
+      if (!ChargeQueuedSend(size))
+      {
+        return false;
+      }
+
+      Operation op;
+      op.type = Operation::kSend;
+      op.connection_id = connection_id;
+      op.data.assign(data, data + size);
+      op.on_complete = std::move(on_complete);
+      if (!pending_operations_.Enqueue(op))
+      {
+        ReleaseQueuedSend(size); // 入队失败（已停止）：退回预算
+        return false;
+      }
+      return true;
     }
 
     size_t Reactor::GetSendBufferSize(uint64_t connection_id) const
@@ -227,7 +375,10 @@ namespace darwincore
       {
         return 0;
       }
-      return it->second.send_buffer.Size();
+
+      const ReactorConnection &conn = it->second;
+      size_t control = conn.lanes ? conn.lanes->control.Size() : 0;
+      return conn.send_buffer.Size() + control + (conn.shm ? conn.shm->GetPendingBytes() : 0);
     }
 
     void Reactor::SetEventCallback(EventCallback callback)
@@ -240,170 +391,689 @@ namespace darwincore
       connection_timeout_ = timeout;
     }
 
+    void Reactor::SetWriteCoalescing(bool enabled)
+    {
+      write_coalescing_ = enabled;
+    }
+
+    void Reactor::SetBusyPoll(std::chrono::microseconds spin_duration)
+    {
+      busy_poll_spin_ = std::max(spin_duration, std::chrono::microseconds(0));
+    }
+
+    void Reactor::SetSharedMemoryTransport(bool enabled)
+    {
+      shm_transport_ = enabled;
+    }
+
+    void Reactor::SetRateLimits(const RateLimit &ingress, const RateLimit &egress)
+    {
+      ingress_limit_ = ingress;
+      egress_limit_ = egress;
+    }
+
+    void Reactor::SetSendMemoryBudget(std::shared_ptr<SendMemoryBudget> budget)
+    {
+      send_budget_ = std::move(budget);
+    }
+
+    void Reactor::SetReadBudget(size_t max_bytes, size_t max_reads)
+    {
+      read_budget_bytes_ = max_bytes;
+      read_budget_reads_ = max_reads;
+    }
+
+    void Reactor::SetAdaptiveReceive(size_t max_receive_size)
+    {
+      max_receive_size_ = max_receive_size > SocketConfiguration::kDefaultReceiveBufferSize
+                              ? std::min<size_t>(max_receive_size, UINT32_MAX)
+                              : 0;
+    }
+
+    void Reactor::SetSendBufferIdleRelease(std::chrono::milliseconds idle)
+    {
+      send_buffer_idle_release_ = std::max(idle, std::chrono::milliseconds(0));
+    }
+
+    void Reactor::SetTrafficSampling(bool enabled)
+    {
+      traffic_sampling_ = enabled;
+      traffic_window_start_ = std::chrono::steady_clock::now();
+    }
+
     // ============ 私有方法（仅在 Reactor 线程执行）============
 
-    void Reactor::ProcessPendingOperations()
+    size_t Reactor::ProcessPendingOperations()
     {
       Operation op;
-      int processed = 0;
-      const int kMaxBatchSize = 100;
+      size_t processed = 0;
+      const size_t batch_size = op_batch_size_.load(std::memory_order_relaxed);
 
-      while (processed < kMaxBatchSize && pending_operations_.TryDequeue(op))
+      while (processed < batch_size && pending_operations_.TryDequeue(op))
       {
         ++processed;
 
-        switch (op.type)
-        {
-        case Operation::kAdd:
+        // 等待迁入的连接：发送/移除先暂存，迁入后按原顺序执行
+        if (!expected_connections_.empty() &&
+            (op.type == Operation::kSend || op.type == Operation::kRemove))
         {
-          uint64_t conn_id = DoAddConnection(op.fd, op.peer);
-          if (op.promise)
+          auto expected = expected_connections_.find(op.connection_id);
+          if (expected != expected_connections_.end())
           {
-            op.promise->set_value(conn_id);
+            expected->second.push_back(std::move(op));
+            continue;
           }
-          break;
-        }
-        case Operation::kRemove:
-          DoRemoveConnection(op.connection_id);
-          break;
-        case Operation::kSend:
-          DoSendData(op.connection_id, op.data);
-          break;
         }
+
+        ExecuteOperation(op);
+      }
+
+      // 本轮结束前必须把暂存数据全部交给 socket / 发送缓冲区
+      if (!staged_writes_.empty())
+      {
+        FlushStagedWrites();
       }
 
       if (processed > 0)
       {
         total_ops_processed_.fetch_add(processed, std::memory_order_relaxed);
       }
+
+      return processed;
     }
 
-    uint64_t Reactor::DoAddConnection(int fd, const sockaddr_storage &peer)
+    void Reactor::ExecuteOperation(Operation &op)
     {
-      if (fd < 0 || !is_running_.load())
+      switch (op.type)
       {
-        NW_LOG_ERROR("[Reactor" << reactor_id_ << "] DoAddConnection: 参数无效");
-        return 0;
+      case Operation::kAdd:
+      {
+        uint64_t conn_id = DoAddConnection(op.fd, op.peer, op.connection_id,
+                                           std::move(op.send_buffer_size),
+                                           std::move(op.shm_channel),
+                                           std::move(op.listener_limiter),
+                                           op.idle_timeout);
+        if (op.promise)
+        {
+          op.promise->set_value(conn_id);
+        }
+        break;
       }
+      case Operation::kRemove:
+      {
+        // 先发出已暂存的数据，保持“发送后关闭”的顺序语义
+        auto staged = staged_writes_.find(op.connection_id);
+        if (staged != staged_writes_.end())
+        {
+          std::vector<StagedWrite> writes = std::move(staged->second);
+          staged_writes_.erase(staged);
+          FlushConnectionWrites(op.connection_id, writes);
+        }
 
-      // 生成 connection_id
-      uint16_t seq = connection_seq_.fetch_add(1, std::memory_order_relaxed);
-      if (seq == 0)
+        auto it = connections_.find(op.connection_id);
+        if (op.error_code != 0 && it != connections_.end())
+        {
+          HandleConnectionError(it->second, op.error_code);
+          break;
+        }
+        DoRemoveConnection(op.connection_id);
+        break;
+      }
+      case Operation::kSend:
       {
-        seq = connection_seq_.fetch_add(1, std::memory_order_relaxed);
+        // 入队时计入预算的数据离开队列，之后按发送缓冲区实际积压计算
+        ReleaseQueuedSend(op.data.size());
+
+        // 控制数据不参与合并：暂存到本轮结束会让它排到同轮的批量数据之后
+        if (write_coalescing_ && op.priority == SendPriority::kBulk)
+        {
+          StageSendData(op);
+          break;
+        }
+
+        bool success = DoSendData(op.connection_id, op.data, op.priority);
+        if (op.on_complete)
+        {
+          op.on_complete(success, success ? op.data.size() : 0);
+        }
+        break;
+      }
+      case Operation::kExpect:
+        expected_connections_.emplace(op.connection_id, std::vector<Operation>());
+        break;
+      case Operation::kMigrate:
+        DoMigrateConnection(op);
+        break;
+      case Operation::kAdopt:
+        DoAdoptConnection(op);
+        break;
+      case Operation::kSample:
+        DoSampleTraffic(op);
+        break;
       }
+    }
 
-      uint64_t connection_id = ConnectionIdGenerator::Generate(
-          static_cast<uint8_t>(reactor_id_),
-          static_cast<uint16_t>(fd),
-          seq);
+    void Reactor::AdaptOpBatchSize(size_t processed)
+    {
+      size_t batch_size = op_batch_size_.load(std::memory_order_relaxed);
 
-      // 检查连接是否已存在
-      if (connections_.find(connection_id) != connections_.end())
+      // 批量打满且队列仍有积压：加倍，减少积压时的轮次
+      if (processed >= batch_size && !pending_operations_.IsEmpty())
       {
-        NW_LOG_ERROR("[Reactor" << reactor_id_ << "] connection_id 冲突: " << connection_id);
-        close(fd);
-        return 0;
+        batch_size = std::min(batch_size * 2, kMaxOpBatchSize);
       }
-
-      // 开始监控 fd
-      if (!io_monitor_->StartReadMonitor(fd))
+      // 负载回落：减半，避免单轮处理过久推迟 I/O 事件
+      else if (processed < batch_size / 4)
       {
-        NW_LOG_ERROR("[Reactor" << reactor_id_ << "] 启动监控失败: " << strerror(errno));
-        close(fd);
-        return 0;
+        batch_size = std::max(batch_size / 2, kDefaultOpBatchSize);
       }
 
-      // 创建连接对象
-      connections_.try_emplace(connection_id, fd, peer, connection_id);
-      fd_to_connection_id_[fd] = connection_id;
-
-      // 统计
-      total_connections_.fetch_add(1, std::memory_order_relaxed);
-      active_connections_.fetch_add(1, std::memory_order_relaxed);
-
-      // 分发 kConnected 事件
-      DispatchConnectionEvent(connection_id, peer);
-
-      NW_LOG_INFO("[Reactor" << reactor_id_ << "] 添加连接: conn_id=" << connection_id
-                             << ", fd=" << fd << ", active=" << active_connections_.load());
-
-      return connection_id;
+      op_batch_size_.store(batch_size, std::memory_order_relaxed);
     }
 
-    bool Reactor::DoRemoveConnection(uint64_t connection_id)
+    void Reactor::StageSendData(Operation &op)
     {
-      auto it = connections_.find(connection_id);
-      if (it == connections_.end())
+      if (connections_.find(op.connection_id) == connections_.end())
       {
-        return false;
+        NW_LOG_WARNING("[Reactor" << reactor_id_ << "] StageSendData: conn_id 不存在");
+        if (op.on_complete)
+        {
+          op.on_complete(false, 0);
+        }
+        return;
       }
 
-      int fd = it->second.file_descriptor;
-
-      // 停止监控
-      if (io_monitor_)
+      auto &writes = staged_writes_[op.connection_id];
+      if (!writes.empty())
       {
-        io_monitor_->StopMonitor(fd);
+        total_coalesced_sends_.fetch_add(1, std::memory_order_relaxed);
       }
+      writes.push_back(StagedWrite{std::move(op.data), std::move(op.on_complete)});
+    }
 
-      close(fd);
-
-      fd_to_connection_id_.erase(fd);
-      connections_.erase(it);
-
-      // 统计
-      active_connections_.fetch_sub(1, std::memory_order_relaxed);
-
-      NW_LOG_DEBUG("[Reactor" << reactor_id_ << "] 移除连接: conn_id=" << connection_id
-                              << ", active=" << active_connections_.load());
+    void Reactor::FlushStagedWrites()
+    {
+      std::unordered_map<uint64_t, std::vector<StagedWrite>> staged;
+      staged.swap(staged_writes_);
 
-      return true;
+      for (auto &[connection_id, writes] : staged)
+      {
+        FlushConnectionWrites(connection_id, writes);
+      }
     }
 
-    bool Reactor::DoSendData(uint64_t connection_id, const std::vector<uint8_t> &data)
+    void Reactor::FlushConnectionWrites(uint64_t connection_id,
+                                        std::vector<StagedWrite> &writes)
     {
+      auto complete_all = [&writes](bool success)
+      {
+        for (auto &write : writes)
+        {
+          if (write.on_complete)
+          {
+            write.on_complete(success, success ? write.data.size() : 0);
+          }
+        }
+      };
+
       auto it = connections_.find(connection_id);
       if (it == connections_.end())
       {
-        NW_LOG_WARNING("[Reactor" << reactor_id_ << "] DoSendData: conn_id 不存在");
-        return false;
+        complete_all(false);
+        return;
       }
 
       ReactorConnection &conn = it->second;
       int fd = conn.file_descriptor;
-
-      // 更新活跃时间(收到消息才算活跃)
-      // conn.UpdateActivity();
-
-      // 如果缓冲区非空，直接追加（避免乱序）
-      if (!conn.send_buffer.IsEmpty())
-      {
-        return BufferAndMonitorWrite(conn, data.data(), data.size());
-      }
-
-      // 尝试直接发送
       size_t sent = 0;
-      bool send_error = false;
 
-      if (!TrySendDirect(fd, data.data(), data.size(), sent, send_error))
+      if (conn.limiters)
       {
-        if (send_error)
+        size_t total = 0;
+        for (const auto &write : writes)
         {
-          HandleConnectionError(conn, errno);
-          return false;
+          total += write.data.size();
         }
-        // EAGAIN，需要缓冲
+        ChargeEgress(conn, total, writes.size());
       }
 
-      // 如果有剩余数据，加入缓冲区
-      if (sent < data.size())
+      // 共享内存通道：逐条写入环，不再需要聚集写
+      if (conn.shm && conn.shm->IsEstablished() && !HasPendingWrites(conn))
       {
-        return BufferAndMonitorWrite(conn, data.data() + sent, data.size() - sent);
-      }
-
+        for (auto &write : writes)
+        {
+          // 失败时连接已被移除，conn 不可再用
+          if (!SendSharedMemory(conn, write.data.data(), write.data.size()))
+          {
+            complete_all(false);
+            return;
+          }
+        }
+        complete_all(true);
+        return;
+      }
+
+      // 缓冲区非空时必须排在已有数据之后，只能追加
+      if (!HasPendingWrites(conn))
+      {
+        const size_t iov_count = std::min<size_t>(writes.size(), IOV_MAX);
+        std::vector<struct iovec> iov(iov_count);
+        for (size_t i = 0; i < iov_count; ++i)
+        {
+          iov[i].iov_base = writes[i].data.data();
+          iov[i].iov_len = writes[i].data.size();
+        }
+
+        struct msghdr msg{};
+        msg.msg_iov = iov.data();
+        msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(iov_count);
+
+        ssize_t ret = sendmsg(fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (ret > 0)
+        {
+          sent = static_cast<size_t>(ret);
+          total_bytes_sent_.fetch_add(sent, std::memory_order_relaxed);
+          CountTraffic(conn, sent);
+        }
+        else if (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+          HandleConnectionError(conn, errno);
+          complete_all(false);
+          return;
+        }
+      }
+
+      // 未写出的部分按顺序进入发送缓冲区
+      for (auto &write : writes)
+      {
+        size_t size = write.data.size();
+        if (sent >= size)
+        {
+          sent -= size;
+          continue;
+        }
+
+        // BufferAndMonitorWrite 失败时连接已被移除，conn 不可再用
+        if (!BufferAndMonitorWrite(conn, write.data.data() + sent, size - sent, sent))
+        {
+          complete_all(false);
+          return;
+        }
+        sent = 0;
+      }
+
+      complete_all(true);
+    }
+
+    uint64_t Reactor::DoAddConnection(int fd, const sockaddr_storage &peer,
+                                      uint64_t connection_id,
+                                      std::shared_ptr<std::atomic<size_t>> send_buffer_size,
+                                      std::shared_ptr<ShmChannel> shm_channel,
+                                      std::shared_ptr<SharedRateLimiter> listener_limiter,
+                                      bool idle_timeout)
+    {
+      if (fd < 0 || !is_running_.load())
+      {
+        NW_LOG_ERROR("[Reactor" << reactor_id_ << "] DoAddConnection: 参数无效");
+        return 0;
+      }
+
+      // 生成 connection_id（调用方可能已预分配）
+      if (connection_id == 0)
+      {
+        connection_id = AllocateConnectionId(fd);
+      }
+
+      // 检查连接是否已存在
+      if (connections_.find(connection_id) != connections_.end())
+      {
+        NW_LOG_ERROR("[Reactor" << reactor_id_ << "] connection_id 冲突: " << connection_id);
+        close(fd);
+        return 0;
+      }
+
+      // 开始监控 fd
+      if (!io_monitor_->StartReadMonitor(fd))
+      {
+        NW_LOG_ERROR("[Reactor" << reactor_id_ << "] 启动监控失败: " << strerror(errno));
+        close(fd);
+        return 0;
+      }
+
+      // 创建连接对象
+      auto conn_it = connections_.try_emplace(connection_id, fd, peer, connection_id).first;
+      conn_it->second.send_buffer_size = std::move(send_buffer_size);
+      conn_it->second.idle_timeout = idle_timeout;
+      fd_to_connection_id_[fd] = connection_id;
+
+      // 共享内存通道：客户端一侧握手已在连接前完成；服务端等待第一段数据
+      if (shm_channel)
+      {
+        if (!AttachSharedMemory(conn_it->second, std::move(shm_channel)))
+        {
+          NW_LOG_ERROR("[Reactor" << reactor_id_ << "] 监控门铃失败: " << strerror(errno));
+          io_monitor_->StopMonitor(fd);
+          fd_to_connection_id_.erase(fd);
+          connections_.erase(conn_it);
+          close(fd);
+          return 0;
+        }
+      }
+      else if (shm_transport_ && SocketHelper::GetAddressFamily(peer) == AF_UNIX)
+      {
+        conn_it->second.shm_handshake_pending = true;
+      }
+
+      // 限速状态只为需要的连接分配
+      if (ingress_limit_.IsEnabled() || egress_limit_.IsEnabled() || listener_limiter)
+      {
+        auto limiters = std::make_unique<ConnectionLimiters>();
+        limiters->ingress = RateLimiter(ingress_limit_);
+        limiters->egress = RateLimiter(egress_limit_);
+        limiters->listener = std::move(listener_limiter);
+        conn_it->second.limiters = std::move(limiters);
+      }
+
+      // 统计
+      if (traffic_sampling_)
+      {
+        traffic_[connection_id] = TrafficCounter{0, std::chrono::steady_clock::now()};
+      }
+      connection_memory_bytes_.fetch_add(ConnectionFootprint(conn_it->second),
+                                         std::memory_order_relaxed);
+      total_connections_.fetch_add(1, std::memory_order_relaxed);
+      active_connections_.fetch_add(1, std::memory_order_relaxed);
+
+      // 分发 kConnected 事件
+      DispatchConnectionEvent(connection_id, peer);
+
+      NW_LOG_INFO("[Reactor" << reactor_id_ << "] 添加连接: conn_id=" << connection_id
+                             << ", fd=" << fd << ", active=" << active_connections_.load());
+
+      return connection_id;
+    }
+
+    bool Reactor::DoRemoveConnection(uint64_t connection_id)
+    {
+      auto it = connections_.find(connection_id);
+      if (it == connections_.end())
+      {
+        return false;
+      }
+
+      int fd = it->second.file_descriptor;
+
+      // 停止监控
+      if (io_monitor_)
+      {
+        io_monitor_->StopMonitor(fd);
+      }
+
+      close(fd);
+
+      // 门铃 fd 随通道一起关闭
+      if (it->second.shm)
+      {
+        int doorbell_fd = it->second.shm->GetDoorbellFd();
+        if (io_monitor_)
+        {
+          io_monitor_->StopMonitor(doorbell_fd);
+        }
+        fd_to_connection_id_.erase(doorbell_fd);
+      }
+
+      ReleaseBudget(it->second);
+      connection_memory_bytes_.fetch_sub(ConnectionFootprint(it->second),
+                                         std::memory_order_relaxed);
+      send_buffer_capacity_bytes_.fetch_sub(SendBufferCapacity(it->second),
+                                            std::memory_order_relaxed);
+      fd_to_connection_id_.erase(fd);
+      connections_.erase(it);
+      if (traffic_sampling_)
+      {
+        traffic_.erase(connection_id);
+      }
+
+      // 统计
+      active_connections_.fetch_sub(1, std::memory_order_relaxed);
+
+      NW_LOG_DEBUG("[Reactor" << reactor_id_ << "] 移除连接: conn_id=" << connection_id
+                              << ", active=" << active_connections_.load());
+
+      return true;
+    }
+
+    void Reactor::DoMigrateConnection(Operation &op)
+    {
+      uint64_t connection_id = op.connection_id;
+      std::shared_ptr<Reactor> target = std::move(op.handoff->target);
+
+      // 先写出合并写暂存的数据：它们必须排在迁入后的新发送之前
+      auto staged = staged_writes_.find(connection_id);
+      if (staged != staged_writes_.end())
+      {
+        std::vector<StagedWrite> writes = std::move(staged->second);
+        staged_writes_.erase(staged);
+        FlushConnectionWrites(connection_id, writes);
+      }
+
+      // 连接已关闭时仍要通知目标，让它执行（并丢弃）暂存的操作；node 为空表示失败
+      auto it = connections_.find(connection_id);
+      if (it != connections_.end())
+      {
+        ReactorConnection &conn = it->second;
+        int fd = conn.file_descriptor;
+
+        io_monitor_->StopMonitor(fd);
+        fd_to_connection_id_.erase(fd);
+        if (conn.shm)
+        {
+          int doorbell_fd = conn.shm->GetDoorbellFd();
+          io_monitor_->StopMonitor(doorbell_fd);
+          fd_to_connection_id_.erase(doorbell_fd);
+        }
+
+        // 本 Reactor 上的计量全部扣除，由目标 Reactor 重新计入
+        ReleaseBudget(conn);
+        connection_memory_bytes_.fetch_sub(ConnectionFootprint(conn), std::memory_order_relaxed);
+        send_buffer_capacity_bytes_.fetch_sub(SendBufferCapacity(conn),
+                                              std::memory_order_relaxed);
+        conn.send_buffer_tracked = false;
+        conn.read_monitored = false;
+        if (traffic_sampling_)
+        {
+          traffic_.erase(connection_id);
+        }
+        active_connections_.fetch_sub(1, std::memory_order_relaxed);
+
+        op.handoff->node = connections_.extract(it);
+      }
+
+      Operation adopt;
+      adopt.type = Operation::kAdopt;
+      adopt.connection_id = connection_id;
+      adopt.promise = std::move(op.promise);
+      adopt.handoff = std::move(op.handoff);
+      if (target->pending_operations_.Enqueue(adopt))
+      {
+        return;
+      }
+
+      // 目标已停止：连接留在本 Reactor（目标暂存的操作随其停止一起丢弃）
+      NW_LOG_ERROR("[Reactor" << reactor_id_ << "] 迁移失败，目标 Reactor"
+                              << target->reactor_id_ << " 不可用: conn_id=" << connection_id);
+      if (adopt.handoff->node)
+      {
+        AttachConnectionNode(adopt.handoff->node);
+      }
+      adopt.promise->set_value(0);
+    }
+
+    void Reactor::DoAdoptConnection(Operation &op)
+    {
+      uint64_t connection_id = op.connection_id;
+      std::vector<Operation> parked;
+      auto expected = expected_connections_.find(connection_id);
+      if (expected != expected_connections_.end())
+      {
+        parked = std::move(expected->second);
+        expected_connections_.erase(expected);
+      }
+
+      bool adopted = op.handoff->node && AttachConnectionNode(op.handoff->node);
+      if (adopted)
+      {
+        total_migrations_in_.fetch_add(1, std::memory_order_relaxed);
+        NW_LOG_DEBUG("[Reactor" << reactor_id_ << "] 迁入连接: conn_id=" << connection_id
+                                << ", active=" << active_connections_.load());
+      }
+
+      // 路由切换后到达的操作按原顺序执行（迁移失败时连接已不存在，发送按失败处理）
+      for (Operation &parked_op : parked)
+      {
+        ExecuteOperation(parked_op);
+      }
+
+      if (op.promise)
+      {
+        op.promise->set_value(adopted ? connection_id : 0);
+      }
+    }
+
+    bool Reactor::AttachConnectionNode(ConnectionMap::node_type &node)
+    {
+      uint64_t connection_id = node.key();
+      int fd = node.mapped().file_descriptor;
+      auto result = connections_.insert(std::move(node));
+      if (!result.inserted)
+      {
+        NW_LOG_ERROR("[Reactor" << reactor_id_ << "] 迁入 connection_id 冲突: " << connection_id);
+        close(fd);
+        return false;
+      }
+
+      ReactorConnection &conn = result.position->second;
+      fd_to_connection_id_[fd] = connection_id;
+      if (conn.write_pending)
+      {
+        io_monitor_->StartWriteMonitor(fd);
+      }
+      if (conn.shm)
+      {
+        fd_to_connection_id_[conn.shm->GetDoorbellFd()] = connection_id;
+      }
+      UpdateReadInterest(conn);
+
+      // 限速暂停中的连接由本 Reactor 重新检查到期时间
+      if (conn.rate_paused)
+      {
+        rate_resumes_.push({std::chrono::steady_clock::now(), connection_id});
+      }
+
+      connection_memory_bytes_.fetch_add(ConnectionFootprint(conn), std::memory_order_relaxed);
+      send_buffer_capacity_bytes_.fetch_add(SendBufferCapacity(conn), std::memory_order_relaxed);
+      if (send_buffer_idle_release_.count() > 0 && SendBufferCapacity(conn) > 0)
+      {
+        conn.send_buffer_tracked = true;
+        tracked_send_buffers_.push_back(connection_id);
+      }
+      PublishSendBufferSize(conn);
+      if (traffic_sampling_)
+      {
+        traffic_[connection_id] = TrafficCounter{0, std::chrono::steady_clock::now()};
+      }
+      active_connections_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    void Reactor::DoSampleTraffic(Operation &op)
+    {
+      auto now = std::chrono::steady_clock::now();
+      std::vector<TrafficSample> &samples = op.handoff->samples;
+      samples.reserve(traffic_.size());
+      for (const auto &[connection_id, counter] : traffic_)
+      {
+        auto elapsed = now - counter.since;
+        if (counter.bytes == 0 || elapsed < kMinTrafficWindow)
+        {
+          continue;
+        }
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        samples.push_back(TrafficSample{connection_id,
+                                        static_cast<uint64_t>(counter.bytes / seconds)});
+      }
+      traffic_.clear();
+      traffic_window_start_ = now;
+
+      size_t limit = std::min(op.handoff->sample_limit, samples.size());
+      std::partial_sort(samples.begin(), samples.begin() + limit, samples.end(),
+                        [](const TrafficSample &a, const TrafficSample &b)
+                        { return a.bytes_per_second > b.bytes_per_second; });
+      samples.resize(limit);
+
+      op.promise->set_value(limit);
+    }
+
+    bool Reactor::DoSendData(uint64_t connection_id, const std::vector<uint8_t> &data,
+                             SendPriority priority)
+    {
+      auto it = connections_.find(connection_id);
+      if (it == connections_.end())
+      {
+        NW_LOG_WARNING("[Reactor" << reactor_id_ << "] DoSendData: conn_id 不存在");
+        return false;
+      }
+
+      ReactorConnection &conn = it->second;
+      int fd = conn.file_descriptor;
+
+      if (conn.limiters)
+      {
+        ChargeEgress(conn, data.size(), 1);
+      }
+
+      // 更新活跃时间(收到消息才算活跃)
+      // conn.UpdateActivity();
+
+      // 共享内存通道：升级确认、且升级前写入 socket 的数据发完之后，全部改走环
+      if (conn.shm && conn.shm->IsEstablished() && !HasPendingWrites(conn))
+      {
+        return SendSharedMemory(conn, data.data(), data.size());
+      }
+
+      // 如果缓冲区非空，按优先级追加到对应通道（同一通道内不乱序）
+      if (HasPendingWrites(conn))
+      {
+        if (priority == SendPriority::kControl)
+        {
+          return BufferControlWrite(conn, data.data(), data.size());
+        }
+        return BufferAndMonitorWrite(conn, data.data(), data.size());
+      }
+
+      // 尝试直接发送
+      size_t sent = 0;
+      bool send_error = false;
+
+      if (!TrySendDirect(fd, data.data(), data.size(), sent, send_error))
+      {
+        if (send_error)
+        {
+          HandleConnectionError(conn, errno);
+          return false;
+        }
+        // EAGAIN，需要缓冲
+      }
+
+      // 如果有剩余数据，加入缓冲区
+      if (sent < data.size())
+      {
+        return BufferAndMonitorWrite(conn, data.data() + sent, data.size() - sent, sent);
+      }
+
       // 统计
       total_bytes_sent_.fetch_add(sent, std::memory_order_relaxed);
+      CountTraffic(conn, sent);
       return true;
     }
 
@@ -436,281 +1106,1183 @@ namespace darwincore
         {
           return false; // 被信号中断，稍后重试
         }
-        else
+        else
+        {
+          error = true; // 真正的错误
+          return false;
+        }
+      }
+    }
+
+    bool Reactor::BufferAndMonitorWrite(ReactorConnection &conn,
+                                        const uint8_t *data, size_t size,
+                                        size_t already_sent)
+    {
+      int fd = conn.file_descriptor;
+
+      // 发送缓冲区延迟分配：优先复用空闲池中回收的缓冲区
+      size_t capacity_before = conn.send_buffer.Capacity();
+      if (capacity_before == 0 && !spare_send_buffers_.empty())
+      {
+        conn.send_buffer.AdoptStorage(std::move(spare_send_buffers_.back()));
+        spare_send_buffers_.pop_back();
+      }
+
+      // 写入缓冲区，并记录本次发送的边界供控制数据插队
+      bool written = conn.send_buffer.Write(data, size);
+      TrackSendBuffer(conn, conn.send_buffer, capacity_before);
+      if (!written)
+      {
+        NW_LOG_ERROR("[Reactor" << reactor_id_ << "] 写入缓冲区失败");
+        HandleConnectionError(conn, ENOMEM);
+        return false;
+      }
+      // 有控制数据在等待时才需要记录批量发送的边界
+      if (conn.lanes)
+      {
+        SendLanes &lanes = *conn.lanes;
+        if (lanes.bulk_units.empty() && lanes.unmarked_bulk == 0)
+        {
+          lanes.unit_sent = already_sent;
+        }
+        lanes.bulk_units.push_back(already_sent + size);
+      }
+
+      PublishSendBufferSize(conn);
+
+      // 检查高水位，触发背压
+      if (conn.send_buffer.IsHighWaterMark() && !conn.read_paused)
+      {
+        conn.read_paused = true;
+        UpdateReadInterest(conn);
+        NW_LOG_WARNING("[Reactor" << reactor_id_ << "] 缓冲区高水位，暂停读取: fd="
+                                  << fd << ", buffered=" << conn.send_buffer.Size());
+      }
+
+      // 注册写事件
+      if (!conn.write_pending)
+      {
+        io_monitor_->StartWriteMonitor(fd);
+        conn.write_pending = true;
+      }
+
+      return true;
+    }
+
+    bool Reactor::BufferControlWrite(ReactorConnection &conn,
+                                     const uint8_t *data, size_t size)
+    {
+      SendLanes &lanes = EnsureSendLanes(conn);
+      if (!conn.send_buffer.IsEmpty())
+      {
+        total_priority_bypasses_.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      size_t capacity_before = lanes.control.Capacity();
+      bool written = lanes.control.Write(data, size);
+      TrackSendBuffer(conn, lanes.control, capacity_before);
+      if (!written)
+      {
+        NW_LOG_ERROR("[Reactor" << reactor_id_ << "] 写入控制缓冲区失败");
+        HandleConnectionError(conn, ENOMEM);
+        return false;
+      }
+
+      PublishSendBufferSize(conn);
+
+      // 控制通道同样受高水位约束
+      if (lanes.control.IsHighWaterMark() && !conn.read_paused)
+      {
+        conn.read_paused = true;
+        UpdateReadInterest(conn);
+        NW_LOG_WARNING("[Reactor" << reactor_id_ << "] 控制缓冲区高水位，暂停读取: fd="
+                                  << conn.file_descriptor << ", buffered=" << lanes.control.Size());
+      }
+
+      if (!conn.write_pending)
+      {
+        io_monitor_->StartWriteMonitor(conn.file_descriptor);
+        conn.write_pending = true;
+      }
+
+      return true;
+    }
+
+    Reactor::SendLanes &Reactor::EnsureSendLanes(ReactorConnection &conn)
+    {
+      if (!conn.lanes)
+      {
+        conn.lanes = std::make_unique<SendLanes>();
+        conn.lanes->unmarked_bulk = conn.send_buffer.Size();
+        connection_memory_bytes_.fetch_add(sizeof(SendLanes), std::memory_order_relaxed);
+      }
+      return *conn.lanes;
+    }
+
+    void Reactor::ReleaseSendLanes(ReactorConnection &conn)
+    {
+      size_t control_capacity = conn.lanes->control.Capacity();
+      connection_memory_bytes_.fetch_sub(sizeof(SendLanes) + control_capacity,
+                                         std::memory_order_relaxed);
+      send_buffer_capacity_bytes_.fetch_sub(control_capacity, std::memory_order_relaxed);
+      conn.lanes.reset();
+    }
+
+    bool Reactor::HasPendingWrites(const ReactorConnection &conn) const
+    {
+      return !conn.send_buffer.IsEmpty() || (conn.lanes && !conn.lanes->control.IsEmpty());
+    }
+
+    size_t Reactor::SendBufferCapacity(const ReactorConnection &conn) const
+    {
+      return conn.send_buffer.Capacity() + (conn.lanes ? conn.lanes->control.Capacity() : 0);
+    }
+
+    void Reactor::SendLanes::ConsumeBulk(size_t bytes)
+    {
+      size_t unmarked = std::min(bytes, unmarked_bulk);
+      unmarked_bulk -= unmarked;
+      bytes -= unmarked;
+
+      unit_sent += bytes;
+      while (!bulk_units.empty() && unit_sent >= bulk_units.front())
+      {
+        unit_sent -= bulk_units.front();
+        bulk_units.pop_front();
+      }
+    }
+
+    ssize_t Reactor::WritePending(ReactorConnection &conn)
+    {
+      int fd = conn.file_descriptor;
+      SendLanes *lanes = conn.lanes.get();
+      if (!lanes)
+      {
+        return conn.send_buffer.SendToSocket(fd);
+      }
+
+      // 控制数据只在批量数据的发送边界处写出；未到边界时批量数据只写到边界为止
+      ssize_t total = 0;
+      while (HasPendingWrites(conn))
+      {
+        ssize_t ret = 0;
+        if (!lanes->control.IsEmpty() && lanes->AtBoundary())
+        {
+          ret = lanes->control.SendToSocket(fd);
+        }
+        else
+        {
+          size_t limit = SIZE_MAX;
+          if (!lanes->control.IsEmpty())
+          {
+            if (lanes->unmarked_bulk > 0)
+            {
+              limit = lanes->unmarked_bulk;
+            }
+            else if (!lanes->bulk_units.empty())
+            {
+              limit = lanes->bulk_units.front() - lanes->unit_sent;
+            }
+          }
+          ret = conn.send_buffer.SendToSocket(fd, limit);
+          if (ret > 0)
+          {
+            lanes->ConsumeBulk(static_cast<size_t>(ret));
+          }
+        }
+
+        if (ret < 0)
+        {
+          return ret;
+        }
+        if (ret == 0)
+        {
+          break;
+        }
+        total += ret;
+      }
+      return total;
+    }
+
+    void Reactor::RunEventLoop()
+    {
+      pthread_setname_np(("darwincore.network.reactor." + std::to_string(reactor_id_)).c_str());
+      const int kEventBatchSize = SocketConfiguration::kDefaultEventBatchSize;
+      auto last_timeout_check = std::chrono::steady_clock::now();
+      auto last_buffer_sweep = last_timeout_check;
+
+      const bool busy_poll = busy_poll_spin_.count() > 0;
+      auto last_work = std::chrono::steady_clock::now();
+
+      NW_LOG_INFO("[Reactor" << reactor_id_ << "] 事件循环开始"
+                             << (busy_poll ? "（忙轮询模式）" : ""));
+
+      while (is_running_.load(std::memory_order_acquire))
+      {
+        // 1. 处理待执行操作
+        size_t processed = ProcessPendingOperations();
+
+        // 共享内存接收环中上一轮没有读完的数据
+        DrainSharedMemoryBacklog();
+
+        // 全局发送缓冲预算：恢复暂停的连接或断开积压最多的连接
+        EnforceSendMemoryBudget();
+
+        // 2. 定期检查超时（每 5 秒）
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_timeout_check >= std::chrono::seconds(5))
+        {
+          CheckTimeouts();
+          last_timeout_check = now;
+        }
+
+        // 回收空闲连接的发送缓冲区
+        if (send_buffer_idle_release_.count() > 0 &&
+            now - last_buffer_sweep >= send_buffer_idle_release_)
+        {
+          ReleaseIdleSendBuffers();
+          last_buffer_sweep = now;
+        }
+
+        // 3. 等待 I/O 事件（忙轮询模式下，空转窗口内以零超时轮询）
+        struct kevent events[kEventBatchSize];
+        int timeout_ms = 100;
+        bool parked = true;
+
+        if (busy_poll)
+        {
+          AdaptOpBatchSize(processed);
+          if (processed > 0)
+          {
+            last_work = now;
+          }
+          if (now - last_work < busy_poll_spin_)
+          {
+            timeout_ms = 0;
+            parked = false;
+          }
+        }
+
+        // 限速到期的连接恢复读取；不让阻塞等待越过下一个到期时间
+        int resume_ms = ResumeRateLimited(now);
+        if (resume_ms >= 0 && resume_ms < timeout_ms)
+        {
+          timeout_ms = resume_ms;
+        }
+
+        // 环中仍有待读数据的连接不会再收到门铃，本轮不阻塞
+        if (!shm_backlog_.empty())
+        {
+          timeout_ms = 0;
+          parked = false;
+        }
+
+        int count = io_monitor_->WaitEvents(events, kEventBatchSize, &timeout_ms);
+
+        if (busy_poll)
+        {
+          auto end = std::chrono::steady_clock::now();
+          auto elapsed_ns = static_cast<uint64_t>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(end - now).count());
+
+          if (parked)
+          {
+            busy_poll_parked_ns_.fetch_add(elapsed_ns, std::memory_order_relaxed);
+          }
+          else if (processed == 0 && count <= 0)
+          {
+            busy_poll_spin_ns_.fetch_add(elapsed_ns, std::memory_order_relaxed);
+          }
+
+          if (count > 0)
+          {
+            last_work = end;
+          }
+        }
+
+        if (count < 0)
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          }
+          NW_LOG_ERROR("[Reactor" << reactor_id_ << "] WaitEvents 失败: "
+                                  << strerror(errno));
+          break;
+        }
+
+        if (count == 0)
+        {
+          continue;
+        }
+
+        // 4. 处理 I/O 事件
+        for (int i = 0; i < count; ++i)
+        {
+          ProcessKqueueEvent(events[i]);
+        }
+      }
+
+      NW_LOG_INFO("[Reactor" << reactor_id_ << "] 事件循环结束");
+    }
+
+    void Reactor::ProcessKqueueEvent(const struct kevent &event)
+    {
+      int fd = event.ident;
+      uint16_t flags = event.flags;
+      int16_t filter = event.filter;
+
+      auto it = fd_to_connection_id_.find(fd);
+      if (it == fd_to_connection_id_.end())
+      {
+        return;
+      }
+
+      auto conn_it = connections_.find(it->second);
+      if (conn_it == connections_.end())
+      {
+        return;
+      }
+
+      ReactorConnection &conn = conn_it->second;
+
+      // 共享内存门铃（EOF 也在其中处理：先读完环中剩余数据）
+      if (conn.shm && fd == conn.shm->GetDoorbellFd())
+      {
+        HandleDoorbellEvent(conn.connection_id);
+        return;
+      }
+
+      // 对端已关闭但接收缓冲区仍有数据（读过滤器 data 为可读字节数）：
+      // 先把数据读完交付，recv 返回 0 时再按正常关闭处理
+      if ((flags & EV_EOF) && filter == EVFILT_READ && event.data > 0)
+      {
+        HandleReadEvent(fd);
+        return;
+      }
+
+      // 检查 EOF 和错误
+      if (flags & EV_EOF)
+      {
+        HandleConnectionClose(conn);
+        return;
+      }
+
+      if (flags & EV_ERROR)
+      {
+        HandleConnectionError(conn, event.data);
+        return;
+      }
+
+      // 处理读写事件
+      if (filter == EVFILT_READ)
+      {
+        HandleReadEvent(fd);
+      }
+      else if (filter == EVFILT_WRITE)
+      {
+        HandleWriteEvent(fd);
+      }
+    }
+
+    bool Reactor::HandleReadEvent(int fd)
+    {
+      auto it = fd_to_connection_id_.find(fd);
+      if (it == fd_to_connection_id_.end())
+      {
+        return false;
+      }
+
+      uint64_t connection_id = it->second;
+      auto conn_it = connections_.find(connection_id);
+      if (conn_it == connections_.end())
+      {
+        return false;
+      }
+
+      ReactorConnection &conn = conn_it->second;
+      uint8_t *buffer = receive_buffer_.data();
+      size_t bytes_read = 0;
+      size_t reads = 0;
+
+      while (true)
+      {
+        // 读预算用尽：让出给本批次其他连接，剩余数据在下一轮 WaitEvents 中再次报告
+        if ((read_budget_bytes_ > 0 && bytes_read >= read_budget_bytes_) ||
+            (read_budget_reads_ > 0 && reads >= read_budget_reads_))
+        {
+          total_read_yields_.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+
+        size_t requested = conn.receive_size > 0 ? conn.receive_size
+                                                 : SocketConfiguration::kDefaultReceiveBufferSize;
+        ssize_t ret;
+
+        // 第一段数据可能是共享内存升级握手
+        if (conn.shm_handshake_pending)
+        {
+          std::shared_ptr<ShmChannel> channel;
+          ret = ShmChannel::ReceiveHandshake(fd, buffer,
+                                             SocketConfiguration::kDefaultReceiveBufferSize,
+                                             channel);
+          if (ret > 0)
+          {
+            conn.shm_handshake_pending = false;
+          }
+
+          if (channel)
+          {
+            conn.UpdateActivity();
+            if (!AttachSharedMemory(conn, std::move(channel)))
+            {
+              HandleConnectionError(conn, errno);
+              return false;
+            }
+            continue;
+          }
+        }
+        else
+        {
+          ret = recv(fd, buffer, requested, 0);
+        }
+        ++reads;
+
+        if (ret > 0)
+        {
+          // 更新活跃时间
+          conn.UpdateActivity();
+
+          // 统计
+          total_bytes_received_.fetch_add(ret, std::memory_order_relaxed);
+          CountTraffic(conn, static_cast<size_t>(ret));
+          bytes_read += static_cast<size_t>(ret);
+
+          if (max_receive_size_ > 0)
+          {
+            AdaptReceiveSize(conn, requested, static_cast<size_t>(ret), reads == 1);
+          }
+
+          // 分发数据事件
+          DispatchDataEvent(connection_id, buffer, ret);
+
+          // 超出入站预算：已暂停读取，剩余数据留在 socket 中
+          if (conn.limiters && ChargeIngress(conn, static_cast<size_t>(ret)))
+          {
+            return false;
+          }
+        }
+        else if (ret == 0)
+        {
+          // 对端关闭
+          HandleConnectionClose(conn);
+          return false;
+        }
+        else
+        {
+          // ret < 0
+          if (errno == EAGAIN || errno == EWOULDBLOCK)
+          {
+            return true; // 数据读完
+          }
+          else if (errno == EINTR)
+          {
+            continue; // 被信号中断，重试
+          }
+          else
+          {
+            HandleConnectionError(conn, errno);
+            return false;
+          }
+        }
+      }
+    }
+
+    void Reactor::AdaptReceiveSize(ReactorConnection &conn, size_t requested,
+                                   size_t received, bool first_read)
+    {
+      const size_t default_size = SocketConfiguration::kDefaultReceiveBufferSize;
+
+      if (received == requested && requested < max_receive_size_)
+      {
+        // 读满：批量传输，下次读更多
+        conn.receive_size = static_cast<uint32_t>(std::min(requested * 2, max_receive_size_));
+      }
+      else if (first_read && received <= requested / 4 && requested > default_size)
+      {
+        // 就绪后第一次读取就很少：小消息连接，逐步回到默认大小
+        conn.receive_size = static_cast<uint32_t>(std::max(requested / 2, default_size));
+      }
+    }
+
+    bool Reactor::AttachSharedMemory(ReactorConnection &conn,
+                                     std::shared_ptr<ShmChannel> channel)
+    {
+      // 读取暂停中时门铃由 UpdateReadInterest 在恢复时一起注册
+      int doorbell_fd = channel->GetDoorbellFd();
+      if (conn.read_monitored && !io_monitor_->StartReadMonitor(doorbell_fd))
+      {
+        return false;
+      }
+
+      conn.shm = std::move(channel);
+      fd_to_connection_id_[doorbell_fd] = conn.connection_id;
+      total_shm_connections_.fetch_add(1, std::memory_order_relaxed);
+
+      NW_LOG_INFO("[Reactor" << reactor_id_ << "] 连接升级为共享内存通道: conn_id="
+                             << conn.connection_id << ", ring="
+                             << conn.shm->GetRingCapacity());
+      return true;
+    }
+
+    void Reactor::DetachSharedMemory(ReactorConnection &conn)
+    {
+      int doorbell_fd = conn.shm->GetDoorbellFd();
+      io_monitor_->StopMonitor(doorbell_fd);
+      fd_to_connection_id_.erase(doorbell_fd);
+      conn.shm.reset();
+      total_shm_connections_.fetch_sub(1, std::memory_order_relaxed);
+
+      NW_LOG_WARNING("[Reactor" << reactor_id_ << "] 对端未接受共享内存升级，使用普通 socket: conn_id="
+                                << conn.connection_id);
+    }
+
+    void Reactor::HandleDoorbellEvent(uint64_t connection_id)
+    {
+      auto it = connections_.find(connection_id);
+      if (it == connections_.end() || !it->second.shm)
+      {
+        return;
+      }
+
+      bool peer_alive = it->second.shm->DrainDoorbell();
+
+      // 客户端一侧（共享事件循环组）尚未收到确认：门铃关闭说明服务端没有接受升级
+      if (!it->second.shm->IsEstablished())
+      {
+        if (!peer_alive)
+        {
+          DetachSharedMemory(it->second);
+        }
+        return;
+      }
+
+      // 对端可能腾出了空间
+      if (peer_alive)
+      {
+        it->second.shm->FlushPending();
+        PublishSendBufferSize(it->second);
+      }
+
+      // 读取已暂停：恢复时 UpdateReadInterest 会把连接放回 shm_backlog_
+      if (!it->second.read_monitored)
+      {
+        return;
+      }
+
+      // 升级前对端写入 socket 的数据必须先于环中数据交付：socket 读到 EAGAIN 后才读环
+      if (!HandleReadEvent(it->second.file_descriptor))
+      {
+        it = connections_.find(connection_id);
+        if (it != connections_.end() && it->second.read_monitored)
+        {
+          shm_backlog_.push_back(connection_id);
+        }
+        return;
+      }
+
+      it = connections_.find(connection_id);
+      if (it == connections_.end())
+      {
+        return;
+      }
+
+      ReactorConnection &conn = it->second;
+      bool drained = false;
+      if (!ReceiveSharedMemory(conn, true, drained))
+      {
+        HandleConnectionError(conn, EPROTO);
+        return;
+      }
+
+      // 环中还有数据：门铃已被清空，不会再次触发
+      if (!drained)
+      {
+        if (conn.read_monitored)
+        {
+          shm_backlog_.push_back(connection_id);
+        }
+        return;
+      }
+
+      if (!peer_alive)
+      {
+        HandleConnectionClose(conn);
+      }
+    }
+
+    void Reactor::DrainSharedMemoryBacklog()
+    {
+      if (shm_backlog_.empty())
+      {
+        return;
+      }
+
+      std::vector<uint64_t> backlog;
+      backlog.swap(shm_backlog_);
+      for (uint64_t connection_id : backlog)
+      {
+        HandleDoorbellEvent(connection_id);
+      }
+    }
+
+    bool Reactor::ReceiveSharedMemory(ReactorConnection &conn, bool paced, bool &drained)
+    {
+      // 单次分发的数据上限，避免一次回调拿到整个环
+      constexpr size_t kMaxChunkSize = 256 * 1024;
+      uint64_t connection_id = conn.connection_id;
+      drained = false;
+
+      // 限速连接按 socket 单次读取的大小分段计费，超出预算的部分不会一次读出太多
+      size_t chunk_size = kMaxChunkSize;
+      if (paced && conn.limiters)
+      {
+        chunk_size = conn.receive_size > 0 ? conn.receive_size
+                                           : SocketConfiguration::kDefaultReceiveBufferSize;
+      }
+
+      size_t bytes_read = 0;
+      size_t reads = 0;
+
+      while (true)
+      {
+        // 读取暂停（背压、限速或内存预算）：剩余数据留在环中，对端写满后自然停下
+        if (paced && !conn.read_monitored)
+        {
+          return true;
+        }
+
+        // 环同样遵守读预算：用尽后让出，由调用方放入 shm_backlog_ 下一轮继续
+        size_t max_bytes = chunk_size;
+        if (paced && read_budget_bytes_ > 0)
+        {
+          if (bytes_read >= read_budget_bytes_)
+          {
+            total_read_yields_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+          }
+          max_bytes = std::min(max_bytes, read_budget_bytes_ - bytes_read);
+        }
+        if (paced && read_budget_reads_ > 0 && reads >= read_budget_reads_)
+        {
+          total_read_yields_.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+
+        ssize_t ret = conn.shm->Receive(
+            [this, connection_id](const uint8_t *data, size_t size)
+            { DispatchDataEvent(connection_id, data, size); },
+            max_bytes);
+
+        if (ret < 0)
+        {
+          return false;
+        }
+        if (ret == 0)
+        {
+          drained = true;
+          return true;
+        }
+
+        ++reads;
+        bytes_read += static_cast<size_t>(ret);
+        conn.UpdateActivity();
+        total_bytes_received_.fetch_add(ret, std::memory_order_relaxed);
+        CountTraffic(conn, static_cast<size_t>(ret));
+
+        // 环中数据与 socket 数据一样计入入站限速；超出时暂停读取，下一次循环停下
+        if (paced && conn.limiters)
+        {
+          ChargeIngress(conn, static_cast<size_t>(ret));
+        }
+      }
+    }
+
+    bool Reactor::SendSharedMemory(ReactorConnection &conn,
+                                   const uint8_t *data, size_t size)
+    {
+      if (!conn.shm->Send(data, size))
+      {
+        NW_LOG_ERROR("[Reactor" << reactor_id_ << "] 共享内存暂存区已满: conn_id="
+                                << conn.connection_id);
+        HandleConnectionError(conn, ENOMEM);
+        return false;
+      }
+
+      total_bytes_sent_.fetch_add(size, std::memory_order_relaxed);
+      CountTraffic(conn, size);
+      PublishSendBufferSize(conn);
+      return true;
+    }
+
+    void Reactor::HandleWriteEvent(int fd)
+    {
+      auto it = fd_to_connection_id_.find(fd);
+      if (it == fd_to_connection_id_.end())
+      {
+        return;
+      }
+
+      auto conn_it = connections_.find(it->second);
+      if (conn_it == connections_.end())
+      {
+        return;
+      }
+
+      ReactorConnection &conn = conn_it->second;
+
+      // 发送缓冲区数据（控制通道优先）
+      ssize_t sent = WritePending(conn);
+
+      if (sent > 0)
+      {
+        // 更新活跃时间
+        conn.UpdateActivity();
+        conn.send_buffer_touched = true;
+
+        // 统计
+        total_bytes_sent_.fetch_add(sent, std::memory_order_relaxed);
+        CountTraffic(conn, static_cast<size_t>(sent));
+        PublishSendBufferSize(conn);
+
+        // 检查低水位（两个通道都低于低水位），恢复读取
+        if (conn.read_paused && conn.send_buffer.IsLowWaterMark() &&
+            (!conn.lanes || conn.lanes->control.IsLowWaterMark()))
+        {
+          conn.read_paused = false;
+          UpdateReadInterest(conn);
+          NW_LOG_INFO("[Reactor" << reactor_id_ << "] 缓冲区低水位，恢复读取: fd=" << fd);
+        }
+      }
+      else if (sent < 0)
+      {
+        HandleConnectionError(conn, errno);
+        return;
+      }
+
+      // 发送完成，停止写监控；优先级通道在下次缓存控制数据时重新分配
+      if (!HasPendingWrites(conn))
+      {
+        if (conn.write_pending)
+        {
+          io_monitor_->StopWriteMonitor(fd);
+          conn.write_pending = false;
+        }
+        if (conn.lanes)
         {
-          error = true; // 真正的错误
-          return false;
+          ReleaseSendLanes(conn);
         }
       }
     }
 
-    bool Reactor::BufferAndMonitorWrite(ReactorConnection &conn,
-                                        const uint8_t *data, size_t size)
+    bool Reactor::ChargeIngress(ReactorConnection &conn, size_t bytes)
     {
-      int fd = conn.file_descriptor;
+      auto now = std::chrono::steady_clock::now();
+      auto delay = conn.limiters->ingress.Consume(bytes, 1, now);
+      if (conn.limiters->listener)
+      {
+        delay = std::max(delay, conn.limiters->listener->Consume(bytes, 1, now));
+      }
 
-      // 写入缓冲区
-      if (!conn.send_buffer.Write(data, size))
+      if (delay == std::chrono::steady_clock::duration::zero())
       {
-        NW_LOG_ERROR("[Reactor" << reactor_id_ << "] 写入缓冲区失败");
-        HandleConnectionError(conn, ENOMEM);
         return false;
       }
 
-      // 检查高水位，触发背压
-      if (conn.send_buffer.IsHighWaterMark() && !conn.read_paused)
+      PauseForRateLimit(conn, delay);
+      return true;
+    }
+
+    void Reactor::ChargeEgress(ReactorConnection &conn, size_t bytes, size_t messages)
+    {
+      // 共享内存通道的出站数据不经过 socket，不计入限速
+      if (conn.shm)
       {
-        io_monitor_->StopReadMonitor(fd);
-        conn.read_paused = true;
-        NW_LOG_WARNING("[Reactor" << reactor_id_ << "] 缓冲区高水位，暂停读取: fd="
-                                  << fd << ", buffered=" << conn.send_buffer.Size());
+        return;
       }
 
-      // 注册写事件
-      if (!conn.write_pending)
+      auto delay = conn.limiters->egress.Consume(bytes, messages,
+                                                 std::chrono::steady_clock::now());
+      if (delay > std::chrono::steady_clock::duration::zero())
       {
-        io_monitor_->StartWriteMonitor(fd);
-        conn.write_pending = true;
+        PauseForRateLimit(conn, delay);
       }
-
-      return true;
     }
 
-    void Reactor::RunEventLoop()
+    void Reactor::PauseForRateLimit(ReactorConnection &conn,
+                                    std::chrono::steady_clock::duration delay)
     {
-      pthread_setname_np(("darwincore.network.reactor." + std::to_string(reactor_id_)).c_str());
-      const int kEventBatchSize = SocketConfiguration::kDefaultEventBatchSize;
-      auto last_timeout_check = std::chrono::steady_clock::now();
+      if (conn.rate_paused)
+      {
+        return; // 已在等待恢复，到期时会重新检查全部预算
+      }
 
-      NW_LOG_INFO("[Reactor" << reactor_id_ << "] 事件循环开始");
+      conn.rate_paused = true;
+      UpdateReadInterest(conn);
+      rate_resumes_.push({std::chrono::steady_clock::now() + delay, conn.connection_id});
+      total_rate_limit_pauses_.fetch_add(1, std::memory_order_relaxed);
 
-      while (is_running_.load(std::memory_order_acquire))
+      NW_LOG_DEBUG("[Reactor" << reactor_id_ << "] 超出限速，暂停读取: conn_id="
+                              << conn.connection_id << ", delay_us="
+                              << std::chrono::duration_cast<std::chrono::microseconds>(delay).count());
+    }
+
+    int Reactor::ResumeRateLimited(std::chrono::steady_clock::time_point now)
+    {
+      while (!rate_resumes_.empty() && rate_resumes_.top().deadline <= now)
       {
-        // 1. 处理待执行操作
-        ProcessPendingOperations();
+        uint64_t connection_id = rate_resumes_.top().connection_id;
+        rate_resumes_.pop();
 
-        // 2. 定期检查超时（每 5 秒）
-        auto now = std::chrono::steady_clock::now();
-        if (now - last_timeout_check >= std::chrono::seconds(5))
+        auto it = connections_.find(connection_id);
+        if (it == connections_.end() || !it->second.rate_paused)
         {
-          CheckTimeouts();
-          last_timeout_check = now;
+          continue; // 连接已关闭
         }
 
-        // 3. 等待 I/O 事件
-        struct kevent events[kEventBatchSize];
-        int timeout_ms = 100;
-        int count = io_monitor_->WaitEvents(events, kEventBatchSize, &timeout_ms);
+        ReactorConnection &conn = it->second;
 
-        if (count < 0)
+        // 暂停期间可能又有出站数据扣减了预算
+        auto delay = std::max(conn.limiters->ingress.GetDelay(now),
+                              conn.limiters->egress.GetDelay(now));
+        if (conn.limiters->listener)
         {
-          if (errno == EINTR)
-          {
-            continue;
-          }
-          NW_LOG_ERROR("[Reactor" << reactor_id_ << "] WaitEvents 失败: "
-                                  << strerror(errno));
-          break;
+          delay = std::max(delay, conn.limiters->listener->GetDelay(now));
         }
-
-        if (count == 0)
+        if (delay > std::chrono::steady_clock::duration::zero())
         {
+          rate_resumes_.push({now + delay, connection_id});
           continue;
         }
 
-        // 4. 处理 I/O 事件
-        for (int i = 0; i < count; ++i)
-        {
-          ProcessKqueueEvent(events[i]);
-        }
+        conn.rate_paused = false;
+        UpdateReadInterest(conn);
       }
 
-      NW_LOG_INFO("[Reactor" << reactor_id_ << "] 事件循环结束");
+      if (rate_resumes_.empty())
+      {
+        return -1;
+      }
+
+      // 向上取整到毫秒，避免提前醒来后空转
+      auto wait = rate_resumes_.top().deadline - now;
+      return static_cast<int>(
+          (std::chrono::duration_cast<std::chrono::microseconds>(wait).count() + 999) / 1000);
     }
 
-    void Reactor::ProcessKqueueEvent(const struct kevent &event)
+    void Reactor::CheckTimeouts()
     {
-      int fd = event.ident;
-      uint16_t flags = event.flags;
-      int16_t filter = event.filter;
+      if (connection_timeout_.count() == 0)
+      {
+        return; // 超时检查已禁用
+      }
 
-      auto it = fd_to_connection_id_.find(fd);
-      if (it == fd_to_connection_id_.end())
+      std::vector<uint64_t> timeout_conns;
+
+      for (auto &[conn_id, conn] : connections_)
       {
-        return;
+        if (conn.idle_timeout && conn.IsTimeout(connection_timeout_))
+        {
+          timeout_conns.push_back(conn_id);
+        }
       }
 
-      auto conn_it = connections_.find(it->second);
-      if (conn_it == connections_.end())
+      if (!timeout_conns.empty())
       {
-        return;
+        NW_LOG_WARNING("[Reactor" << reactor_id_ << "] 检测到 "
+                                  << timeout_conns.size() << " 个超时连接");
+
+        for (uint64_t conn_id : timeout_conns)
+        {
+          auto it = connections_.find(conn_id);
+          if (it != connections_.end())
+          {
+            NW_LOG_INFO("[Reactor" << reactor_id_ << "] 关闭超时连接: " << conn_id);
+            HandleConnectionClose(it->second);
+          }
+        }
       }
+    }
 
-      ReactorConnection &conn = conn_it->second;
+    void Reactor::TrackSendBuffer(ReactorConnection &conn, const SendBuffer &buffer,
+                                  size_t capacity_before)
+    {
+      size_t capacity = buffer.Capacity();
+      if (capacity > capacity_before)
+      {
+        connection_memory_bytes_.fetch_add(capacity - capacity_before, std::memory_order_relaxed);
+        send_buffer_capacity_bytes_.fetch_add(capacity - capacity_before,
+                                              std::memory_order_relaxed);
+      }
 
-      // 检查 EOF 和错误
-      if (flags & EV_EOF)
+      conn.send_buffer_touched = true;
+      if (send_buffer_idle_release_.count() > 0 && !conn.send_buffer_tracked && capacity > 0)
       {
-        HandleConnectionClose(conn);
-        return;
+        conn.send_buffer_tracked = true;
+        tracked_send_buffers_.push_back(conn.connection_id);
       }
+    }
 
-      if (flags & EV_ERROR)
+    void Reactor::ReleaseIdleSendBuffers()
+    {
+      // 两次扫描之间没有写入、且已写空的缓冲区视为空闲（时钟算法，无需逐连接记录时间）
+      size_t kept = 0;
+      for (uint64_t connection_id : tracked_send_buffers_)
       {
-        HandleConnectionError(conn, event.data);
-        return;
+        auto it = connections_.find(connection_id);
+        if (it == connections_.end() || !it->second.send_buffer_tracked)
+        {
+          continue;
+        }
+
+        ReactorConnection &conn = it->second;
+        if (conn.send_buffer_touched || HasPendingWrites(conn))
+        {
+          conn.send_buffer_touched = false;
+          tracked_send_buffers_[kept++] = connection_id;
+          continue;
+        }
+
+        conn.send_buffer_tracked = false;
+        if (conn.lanes)
+        {
+          ReleaseSendLanes(conn);
+        }
+        std::vector<uint8_t> storage = conn.send_buffer.ReleaseStorage();
+        connection_memory_bytes_.fetch_sub(storage.size(), std::memory_order_relaxed);
+        send_buffer_capacity_bytes_.fetch_sub(storage.size(), std::memory_order_relaxed);
+        send_buffer_releases_.fetch_add(1, std::memory_order_relaxed);
+
+        // 初始大小的缓冲区留给下一个需要缓存数据的连接；突发扩容的大缓冲区直接释放
+        if (storage.size() == SendBuffer::INITIAL_CAPACITY &&
+            spare_send_buffers_.size() < kMaxSpareSendBuffers)
+        {
+          spare_send_buffers_.push_back(std::move(storage));
+        }
       }
+      tracked_send_buffers_.resize(kept);
+    }
 
-      // 处理读写事件
-      if (filter == EVFILT_READ)
+    size_t Reactor::ConnectionFootprint(const ReactorConnection &conn) const
+    {
+      // 连接表节点（键 + 值 + 链表指针 + 缓存的哈希值）与桶，fd 表同理
+      size_t bytes = sizeof(uint64_t) + sizeof(ReactorConnection) + 3 * sizeof(void *);
+      bytes += sizeof(int) + sizeof(uint64_t) + 3 * sizeof(void *);
+      bytes += SendBufferCapacity(conn);
+      if (conn.lanes)
       {
-        HandleReadEvent(fd);
+        bytes += sizeof(SendLanes);
       }
-      else if (filter == EVFILT_WRITE)
+      if (conn.limiters)
       {
-        HandleWriteEvent(fd);
+        bytes += sizeof(ConnectionLimiters);
       }
+      return bytes;
     }
 
-    void Reactor::HandleReadEvent(int fd)
+    void Reactor::CountTraffic(const ReactorConnection &conn, size_t bytes)
     {
-      auto it = fd_to_connection_id_.find(fd);
-      if (it == fd_to_connection_id_.end())
+      if (traffic_sampling_)
       {
-        return;
+        auto it = traffic_.try_emplace(conn.connection_id,
+                                       TrafficCounter{0, traffic_window_start_}).first;
+        it->second.bytes += bytes;
       }
+    }
 
-      uint64_t connection_id = it->second;
-      auto conn_it = connections_.find(connection_id);
-      if (conn_it == connections_.end())
+    void Reactor::PublishSendBufferSize(ReactorConnection &conn)
+    {
+      size_t size = conn.send_buffer.Size() + (conn.lanes ? conn.lanes->control.Size() : 0) +
+                    (conn.shm ? conn.shm->GetPendingBytes() : 0);
+
+      if (conn.send_buffer_size)
+      {
+        conn.send_buffer_size->store(size, std::memory_order_relaxed);
+      }
+
+      if (size == conn.budget_bytes)
       {
         return;
       }
 
-      ReactorConnection &conn = conn_it->second;
-      uint8_t buffer[SocketConfiguration::kDefaultReceiveBufferSize];
+      int64_t delta = static_cast<int64_t>(size) - static_cast<int64_t>(conn.budget_bytes);
+      conn.budget_bytes = size;
+      send_buffer_bytes_.fetch_add(delta, std::memory_order_relaxed);
 
-      while (true)
+      if (!send_budget_)
       {
-        ssize_t ret = recv(fd, buffer, sizeof(buffer), 0);
+        return;
+      }
+      send_budget_->Add(reactor_id_, delta);
 
-        if (ret > 0)
-        {
-          // 更新活跃时间
-          conn.UpdateActivity();
+      // 全局用量偏高：正在积压的连接暂停读取，不再产生新的响应
+      if (delta > 0 && !conn.memory_paused &&
+          send_budget_->GetTier() >= SendMemoryBudget::Tier::kPauseReads)
+      {
+        conn.memory_paused = true;
+        ++memory_paused_count_;
+        UpdateReadInterest(conn);
+      }
+    }
 
-          // 统计
-          total_bytes_received_.fetch_add(ret, std::memory_order_relaxed);
+    void Reactor::UpdateReadInterest(ReactorConnection &conn)
+    {
+      bool wanted = !conn.read_paused && !conn.rate_paused && !conn.memory_paused;
+      if (wanted == conn.read_monitored)
+      {
+        return;
+      }
 
-          // 分发数据事件
-          DispatchDataEvent(connection_id, buffer, ret);
-        }
-        else if (ret == 0)
+      // 门铃与 socket 一起暂停，否则共享内存通道绕过背压
+      if (wanted)
+      {
+        io_monitor_->StartReadMonitor(conn.file_descriptor);
+        if (conn.shm)
         {
-          // 对端关闭
-          HandleConnectionClose(conn);
-          return;
+          io_monitor_->StartReadMonitor(conn.shm->GetDoorbellFd());
+          // 暂停期间写入环的数据已经通知过，恢复后由下一轮主动读取
+          shm_backlog_.push_back(conn.connection_id);
         }
-        else
+      }
+      else
+      {
+        io_monitor_->StopReadMonitor(conn.file_descriptor);
+        if (conn.shm)
         {
-          // ret < 0
-          if (errno == EAGAIN || errno == EWOULDBLOCK)
-          {
-            return; // 数据读完
-          }
-          else if (errno == EINTR)
-          {
-            continue; // 被信号中断，重试
-          }
-          else
-          {
-            HandleConnectionError(conn, errno);
-            return;
-          }
+          io_monitor_->StopReadMonitor(conn.shm->GetDoorbellFd());
         }
       }
+      conn.read_monitored = wanted;
     }
 
-    void Reactor::HandleWriteEvent(int fd)
+    void Reactor::EnforceSendMemoryBudget()
     {
-      auto it = fd_to_connection_id_.find(fd);
-      if (it == fd_to_connection_id_.end())
+      if (!send_budget_)
       {
         return;
       }
 
-      auto conn_it = connections_.find(it->second);
-      if (conn_it == connections_.end())
+      SendMemoryBudget::Tier tier = send_budget_->GetTier();
+
+      // 回落到暂停线以下：恢复所有因预算暂停的连接
+      if (tier == SendMemoryBudget::Tier::kNormal && memory_paused_count_ > 0)
       {
+        for (auto &[conn_id, conn] : connections_)
+        {
+          if (conn.memory_paused)
+          {
+            conn.memory_paused = false;
+            UpdateReadInterest(conn);
+          }
+        }
+        memory_paused_count_ = 0;
         return;
       }
 
-      ReactorConnection &conn = conn_it->second;
-
-      // 发送缓冲区数据
-      ssize_t sent = conn.send_buffer.SendToSocket(fd);
-
-      if (sent > 0)
+      if (tier != SendMemoryBudget::Tier::kOverLimit)
       {
-        // 更新活跃时间
-        conn.UpdateActivity();
-
-        // 统计
-        total_bytes_sent_.fetch_add(sent, std::memory_order_relaxed);
+        return;
+      }
 
-        // 检查低水位，恢复读取
-        if (conn.read_paused && conn.send_buffer.IsLowWaterMark())
+      // 超出预算：每轮断开本 Reactor 中积压最多的一个连接，下一轮重新评估
+      ReactorConnection *largest = nullptr;
+      for (auto &[conn_id, conn] : connections_)
+      {
+        if (conn.budget_bytes > 0 && (!largest || conn.budget_bytes > largest->budget_bytes))
         {
-          io_monitor_->StartReadMonitor(fd);
-          conn.read_paused = false;
-          NW_LOG_INFO("[Reactor" << reactor_id_ << "] 缓冲区低水位，恢复读取: fd=" << fd);
+          largest = &conn;
         }
       }
-      else if (sent < 0)
+
+      if (largest)
       {
-        HandleConnectionError(conn, errno);
-        return;
+        NW_LOG_WARNING("[Reactor" << reactor_id_ << "] 发送缓冲超出内存预算，断开连接: conn_id="
+                                  << largest->connection_id << ", buffered="
+                                  << largest->budget_bytes << ", usage="
+                                  << send_budget_->GetUsage() << "/"
+                                  << send_budget_->GetLimit());
+        send_budget_disconnects_.fetch_add(1, std::memory_order_relaxed);
+        HandleConnectionError(*largest, ENOBUFS);
+      }
+    }
+
+    bool Reactor::ChargeQueuedSend(size_t size)
+    {
+      if (!send_budget_)
+      {
+        return true;
       }
 
-      // 发送完成，停止写监控
-      if (conn.send_buffer.IsEmpty() && conn.write_pending)
+      if (send_budget_->GetTier() >= SendMemoryBudget::Tier::kRejectSends)
       {
-        io_monitor_->StopWriteMonitor(fd);
-        conn.write_pending = false;
+        send_budget_rejects_.fetch_add(1, std::memory_order_relaxed);
+        return false;
       }
+
+      // 排队中的数据同样占用内存，入队即计入，避免队列积压绕过预算
+      send_budget_->Add(reactor_id_, static_cast<int64_t>(size));
+      return true;
     }
 
-    void Reactor::CheckTimeouts()
+    void Reactor::ReleaseQueuedSend(size_t size)
     {
-      if (connection_timeout_.count() == 0)
+      if (send_budget_)
       {
-        return; // 超时检查已禁用
+        send_budget_->Add(reactor_id_, -static_cast<int64_t>(size));
       }
+    }
 
-      std::vector<uint64_t> timeout_conns;
-
-      for (auto &[conn_id, conn] : connections_)
+    void Reactor::DropPendingSends()
+    {
+      size_t dropped = 0;
+      Operation op;
+      while (pending_operations_.TryDequeue(op))
       {
-        if (conn.IsTimeout(connection_timeout_))
+        if (op.type != Operation::kSend)
         {
-          timeout_conns.push_back(conn_id);
+          continue;
+        }
+        ReleaseQueuedSend(op.data.size());
+        if (op.on_complete)
+        {
+          op.on_complete(false, 0);
         }
+        ++dropped;
       }
 
-      if (!timeout_conns.empty())
+      if (dropped > 0)
       {
-        NW_LOG_WARNING("[Reactor" << reactor_id_ << "] 检测到 "
-                                  << timeout_conns.size() << " 个超时连接");
+        NW_LOG_DEBUG("[Reactor" << reactor_id_ << "] 停止时丢弃 " << dropped << " 个未执行的发送");
+      }
+    }
 
-        for (uint64_t conn_id : timeout_conns)
+    void Reactor::ReleaseBudget(ReactorConnection &conn)
+    {
+      if (conn.budget_bytes > 0)
+      {
+        int64_t delta = -static_cast<int64_t>(conn.budget_bytes);
+        send_buffer_bytes_.fetch_add(delta, std::memory_order_relaxed);
+        if (send_budget_)
         {
-          auto it = connections_.find(conn_id);
-          if (it != connections_.end())
-          {
-            NW_LOG_INFO("[Reactor" << reactor_id_ << "] 关闭超时连接: " << conn_id);
-            HandleConnectionClose(it->second);
-          }
+          send_budget_->Add(reactor_id_, delta);
         }
+        conn.budget_bytes = 0;
+      }
+
+      if (conn.memory_paused)
+      {
+        conn.memory_paused = false;
+        --memory_paused_count_;
       }
     }
 
@@ -718,6 +2290,14 @@ namespace darwincore
     {
       uint64_t connection_id = conn.connection_id;
 
+      // 对端关闭前写入环的数据仍然要交付
+      auto it = connections_.find(connection_id);
+      if (it != connections_.end() && it->second.shm)
+      {
+        bool drained = false;
+        ReceiveSharedMemory(it->second, false, drained);
+      }
+
       DispatchDisconnectEvent(connection_id);
       DoRemoveConnection(connection_id);
     }
@@ -795,10 +2375,17 @@ namespace darwincore
           io_monitor_->StopMonitor(fd);
         }
         close(fd);
+        ReleaseBudget(conn);
       }
 
       connections_.clear();
       fd_to_connection_id_.clear();
+      expected_connections_.clear();
+      traffic_.clear();
+      tracked_send_buffers_.clear();
+      spare_send_buffers_.clear();
+      connection_memory_bytes_.store(0, std::memory_order_relaxed);
+      send_buffer_capacity_bytes_.store(0, std::memory_order_relaxed);
     }
 
     NetworkError Reactor::MapErrnoToNetworkError(int errno_val)
@@ -833,6 +2420,22 @@ namespace darwincore
       stats.total_bytes_sent = total_bytes_sent_.load(std::memory_order_relaxed);
       stats.total_bytes_received = total_bytes_received_.load(std::memory_order_relaxed);
       stats.total_ops_processed = total_ops_processed_.load(std::memory_order_relaxed);
+      stats.total_coalesced_sends = total_coalesced_sends_.load(std::memory_order_relaxed);
+      stats.total_shm_connections = total_shm_connections_.load(std::memory_order_relaxed);
+      stats.total_rate_limit_pauses = total_rate_limit_pauses_.load(std::memory_order_relaxed);
+      stats.send_buffer_bytes = send_buffer_bytes_.load(std::memory_order_relaxed);
+      stats.send_budget_rejects = send_budget_rejects_.load(std::memory_order_relaxed);
+      stats.send_budget_disconnects = send_budget_disconnects_.load(std::memory_order_relaxed);
+      stats.busy_poll_spin_us = busy_poll_spin_ns_.load(std::memory_order_relaxed) / 1000;
+      stats.busy_poll_parked_us = busy_poll_parked_ns_.load(std::memory_order_relaxed) / 1000;
+      stats.total_read_yields = total_read_yields_.load(std::memory_order_relaxed);
+      stats.connection_memory_bytes = connection_memory_bytes_.load(std::memory_order_relaxed);
+      stats.send_buffer_capacity_bytes =
+          send_buffer_capacity_bytes_.load(std::memory_order_relaxed);
+      stats.send_buffer_releases = send_buffer_releases_.load(std::memory_order_relaxed);
+      stats.total_priority_bypasses = total_priority_bypasses_.load(std::memory_order_relaxed);
+      stats.total_migrations_in = total_migrations_in_.load(std::memory_order_relaxed);
+      stats.op_batch_size = op_batch_size_.load(std::memory_order_relaxed);
       return stats;
     }
 
@@ -12,9 +12,11 @@
 #include <atomic>
 #include <cstdint>
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <future>
 #include <memory>
+#include <queue>
 #include <sys/socket.h>
 #include <thread>
 #include <unordered_map>
@@ -23,6 +25,8 @@
 #include "concurrent_queue.h"
 #include "send_buffer.h"
 #include "connection_id_generator.h"
+#include "rate_limiter.h"
+#include "socket_helper.h"
 #include <darwincore/network/event.h>
 
 namespace darwincore
@@ -33,6 +37,8 @@ namespace darwincore
     // 前向声明
     class WorkerPool;
     class IOMonitor;
+    class ShmChannel;
+    class SendMemoryBudget;
 
     /**
      * @brief Reactor - IO 事件循环
@@ -52,6 +58,9 @@ namespace darwincore
     public:
       using EventCallback = std::function<void(const NetworkEvent &)>;
 
+      /// 发送完成回调（在 Reactor 线程中调用）
+      using SendCompleteCallback = std::function<void(bool success, size_t size)>;
+
       struct Statistics
       {
         int reactor_id{0};
@@ -60,6 +69,64 @@ namespace darwincore
         uint64_t total_bytes_sent{0};
         uint64_t total_bytes_received{0};
         uint64_t total_ops_processed{0};
+        uint64_t total_coalesced_sends{0};   ///< 被合并进同一次系统调用的发送操作数
+        uint64_t total_shm_connections{0};   ///< 升级到共享内存通道的连接数
+        uint64_t total_rate_limit_pauses{0}; ///< 因限速暂停读取的次数
+        uint64_t send_buffer_bytes{0};       ///< 当前尚未写出的发送数据量
+        uint64_t send_budget_rejects{0};     ///< 因内存预算被拒绝的 SendData 次数
+        uint64_t send_budget_disconnects{0}; ///< 因内存预算被断开的连接数
+        uint64_t busy_poll_spin_us{0};       ///< 忙轮询模式：空转（未取到任何工作）的时间
+        uint64_t busy_poll_parked_us{0};     ///< 忙轮询模式：阻塞在 WaitEvents 中的时间
+        uint64_t total_read_yields{0};       ///< 读预算用尽、留待下一轮继续读取的次数
+        uint64_t connection_memory_bytes{0}; ///< 所有连接占用的库内存（连接表 + 发送缓冲区）
+        uint64_t send_buffer_capacity_bytes{0}; ///< 其中发送缓冲区已分配的容量
+        uint64_t send_buffer_releases{0};    ///< 空闲回收的发送缓冲区数
+        uint64_t total_priority_bypasses{0}; ///< 排在积压批量数据之前写出的控制发送数
+        uint64_t total_migrations_in{0};     ///< 从其他 Reactor 迁入的连接数
+        size_t op_batch_size{0};             ///< 当前每轮最多处理的操作数
+      };
+
+      /// 连接流量采样（SampleHotConnections 的结果）
+      struct TrafficSample
+      {
+        uint64_t connection_id{0};
+        uint64_t bytes_per_second{0};   ///< 上次采样（或连接加入本 Reactor）以来的读写速率
+      };
+
+      /// 参与采样的最短统计时长：刚加入本 Reactor 的连接数据不足，留到下一次采样
+      static constexpr std::chrono::milliseconds kMinTrafficWindow{100};
+
+      /// 默认每轮最多处理的操作数（忙轮询模式下为自适应下限）
+      static constexpr size_t kDefaultOpBatchSize = 100;
+
+      /// 忙轮询模式下自适应操作批量的上限
+      static constexpr size_t kMaxOpBatchSize = 4096;
+
+      /// 空闲池最多保留的发送缓冲区数（每个 SendBuffer::INITIAL_CAPACITY 字节）
+      static constexpr size_t kMaxSpareSendBuffers = 64;
+
+      /**
+       * @brief 添加连接时的可选参数
+       *
+       * 主要供 EventLoopGroup 使用：调用方需要在 kConnected 事件到达
+       * Worker 之前就知道 connection_id，并且需要跨线程读取发送缓冲区大小。
+       */
+      struct ConnectionOptions
+      {
+        /// 预分配的 connection_id（0 表示由 Reactor 生成）
+        uint64_t connection_id{0};
+
+        /// 发送缓冲区大小镜像（可选），Reactor 线程写，其他线程只读
+        std::shared_ptr<std::atomic<size_t>> send_buffer_size;
+
+        /// 已完成握手的共享内存通道（可选，客户端一侧使用）
+        std::shared_ptr<ShmChannel> shm_channel;
+
+        /// 所属监听的入站限速器（可选，同一监听的所有连接共享）
+        std::shared_ptr<SharedRateLimiter> listener_limiter;
+
+        /// 是否参与空闲超时检测（客户端连接由业务层决定何时断开，传 false）
+        bool idle_timeout{true};
       };
 
       Reactor(int id, const std::shared_ptr<WorkerPool> &worker_pool);
@@ -82,11 +149,77 @@ namespace darwincore
        */
       bool AddConnection(int fd, const sockaddr_storage &peer);
 
-      bool RemoveConnection(uint64_t connection_id);
+      /**
+       * @brief 添加连接（带可选参数，线程安全，同步等待结果）
+       * @param options 预分配 connection_id / 发送缓冲区镜像等
+       */
+      bool AddConnection(int fd, const sockaddr_storage &peer,
+                         const ConnectionOptions &options);
+
+      /**
+       * @brief 预分配 connection_id（线程安全）
+       * @param fd 连接的文件描述符
+       * @return 新的 connection_id
+       *
+       * 配合 ConnectionOptions::connection_id 使用，使调用方可以先完成
+       * 自己的路由注册，再把连接交给 Reactor。
+       */
+      uint64_t AllocateConnectionId(int fd);
+
+      /**
+       * @brief 移除连接（线程安全）
+       * @param error_code 非 0 时按连接错误关闭：先分发 kError 和 kDisconnected 事件
+       */
+      bool RemoveConnection(uint64_t connection_id, int error_code = 0);
+
+      /**
+       * @brief 准备接收从其他 Reactor 迁入的连接（线程安全）
+       *
+       * 必须在把该连接的发送路由切换到本 Reactor 之前调用：之后到达的
+       * 发送/移除操作先暂存，连接迁入后按到达顺序执行。
+       */
+      bool ExpectConnection(uint64_t connection_id);
+
+      /**
+       * @brief 把连接迁移到另一个 Reactor（线程安全）
+       * @param target 目标 Reactor（需已对该连接调用 ExpectConnection）
+       * @return 迁入完成后就绪：成功为 connection_id，连接已不存在等失败为 0
+       *         （本 Reactor 已停止时立即为 0，并撤销目标上的 ExpectConnection）
+       *
+       * 本 Reactor 线程处理到该操作时（两轮 I/O 之间的静止点）执行：先写出
+       * 该连接暂存的合并写，停止监控 fd，把连接状态（发送缓冲区、限速、
+       * 空闲计时等）原样交给目标 Reactor。connection_id 不变；连接在 Worker
+       * 上的定时器和任务按 connection_id 分配，不受影响。
+       */
+      std::future<uint64_t> MigrateConnection(uint64_t connection_id,
+                                              std::shared_ptr<Reactor> target);
+
+      /**
+       * @brief 采样流量最大的连接（线程安全，同步等待结果）
+       * @param limit 最多返回的连接数
+       * @return 按上次采样以来的读写速率降序排列，采样后计数清零
+       *
+       * 需要先 SetTrafficSampling(true)，否则返回空。
+       */
+      std::vector<TrafficSample> SampleHotConnections(size_t limit);
 
+      /**
+       * @brief 发送数据
+       * @param priority 控制数据在该连接已积压的批量数据之前写出（SendData 边界处插队）
+       */
       bool SendData(uint64_t connection_id,
                     const uint8_t *data,
-                    size_t size);
+                    size_t size,
+                    SendPriority priority = SendPriority::kBulk);
+
+      /**
+       * @brief 发送数据（带完成回调）
+       * @param on_complete 数据写入 socket 或发送缓冲区后在 Reactor 线程中调用
+       */
+      bool SendData(uint64_t connection_id,
+                    const uint8_t *data,
+                    size_t size,
+                    SendCompleteCallback on_complete);
 
       /**
        * @brief 获取连接的发送缓冲区大小
@@ -99,6 +232,92 @@ namespace darwincore
 
       void SetConnectionTimeout(std::chrono::seconds timeout);
 
+      /**
+       * @brief 开启/关闭写合并（需在 Start 之前调用）
+       *
+       * 开启后，一轮操作队列处理中同一连接的所有 kSend 会暂存，
+       * 在本轮结束时用一次 sendmsg（iovec 聚集写）发出；
+       * 保证每轮循环结束前暂存数据都已写入 socket 或发送缓冲区。
+       */
+      void SetWriteCoalescing(bool enabled);
+
+      /**
+       * @brief 开启忙轮询混合模式（需在 Start 之前调用）
+       * @param spin_duration 空闲后继续空转的时长，0 表示关闭（默认）
+       *
+       * 开启后，事件循环在最近一次取到工作（操作或 I/O 事件）后的
+       * spin_duration 内以零超时轮询操作队列和 kqueue，超过后才阻塞等待；
+       * 同时根据操作队列积压情况自适应调整每轮处理的操作数。
+       * 以 CPU 占用换取更低的尾延迟，适合延迟敏感的部署。
+       */
+      void SetBusyPoll(std::chrono::microseconds spin_duration);
+
+      /**
+       * @brief 接受 Unix Domain Socket 连接的共享内存升级握手（需在 Start 之前调用）
+       *
+       * 开启后，UDS 连接上的第一段数据如果是 ShmChannel 握手，
+       * 该连接之后的数据改走共享内存环；否则按普通数据处理。
+       */
+      void SetSharedMemoryTransport(bool enabled);
+
+      /**
+       * @brief 设置连接级限速（需在 Start 之前调用）
+       * @param ingress 每个连接的入站限速（按读取字节数/读取次数计）
+       * @param egress 每个连接的出站限速（按发送字节数/发送次数计）
+       *
+       * 连接（或其所属监听）超出预算时暂停读监控，由 Reactor 线程在
+       * 令牌恢复后自动恢复读取；超出出站预算同样暂停读取，
+       * 让产生响应的请求方放慢速度。共享内存通道的入站数据同样计入，出站数据不计入。
+       */
+      void SetRateLimits(const RateLimit &ingress, const RateLimit &egress);
+
+      /**
+       * @brief 设置全服务端共享的发送缓冲内存预算（需在 Start 之前调用）
+       *
+       * Reactor 在每次发送缓冲区变化时更新自己的用量，并按预算等级：
+       * 暂停积压连接的读取、在 SendData 入口拒绝发送、
+       * 或断开本 Reactor 中积压最多的连接。
+       */
+      void SetSendMemoryBudget(std::shared_ptr<SendMemoryBudget> budget);
+
+      /**
+       * @brief 设置每次读就绪事件的读取预算（需在 Start 之前调用）
+       * @param max_bytes 最多读取的字节数（0 = 不限制）
+       * @param max_reads 最多调用 recv 的次数（0 = 不限制）
+       *
+       * 预算用尽时停止读取该连接，继续处理本批次的其他事件。kqueue 读过滤器
+       * 是水平触发的，socket 中剩余的数据会在下一次 WaitEvents 中再次报告，
+       * 因此单个高速连接不会独占 Reactor 线程。
+       */
+      void SetReadBudget(size_t max_bytes, size_t max_reads);
+
+      /**
+       * @brief 开启自适应接收大小（需在 Start 之前调用）
+       * @param max_receive_size 单次 recv 的上限（不大于默认接收大小时关闭）
+       *
+       * 每个连接从默认大小开始：一次 recv 读满时翻倍直到上限（批量传输用大块读取）；
+       * 读就绪后第一次读取不足当前大小的 1/4 时减半，最低回到默认大小（小消息连接）。
+       */
+      void SetAdaptiveReceive(size_t max_receive_size);
+
+      /**
+       * @brief 设置发送缓冲区空闲回收时长（需在 Start 之前调用）
+       * @param idle 写空后持续无新数据的时长（0 = 保留到连接关闭）
+       *
+       * 发送缓冲区在第一次需要缓存数据时才分配。写空后经过 idle 到 2 * idle
+       * 仍未再使用的缓冲区被释放：初始大小的缓冲区放回 Reactor 的空闲池复用，
+       * 突发写入后扩容的大缓冲区直接归还给分配器。
+       */
+      void SetSendBufferIdleRelease(std::chrono::milliseconds idle);
+
+      /**
+       * @brief 开启按连接统计流量（需在 Start 之前调用）
+       *
+       * 供负载均衡挑选热点连接：只记录上次采样以来有读写的连接，
+       * 不在每个连接上常驻额外字段。
+       */
+      void SetTrafficSampling(bool enabled);
+
       Statistics GetStatistics() const;
 
       int GetReactorId() const { return reactor_id_; }
@@ -106,15 +325,63 @@ namespace darwincore
     private:
       // ============ 内部结构 ============
 
+      /// 连接的限速状态（仅在配置了限速时分配）
+      struct ConnectionLimiters
+      {
+        RateLimiter ingress;
+        RateLimiter egress;
+        std::shared_ptr<SharedRateLimiter> listener;
+      };
+
+      /**
+       * @brief 发送优先级通道（只在有控制数据需要缓存时分配，写空后释放）
+       *
+       * 批量数据留在 ReactorConnection::send_buffer 中，通道存在期间记录其中每次
+       * SendData 的边界；控制数据单独缓存，在批量数据写到边界时优先写出。
+       * 通道建立前已缓存的批量数据没有边界记录，整体写完后控制数据才能插入。
+       */
+      struct SendLanes
+      {
+        SendBuffer control;             ///< 控制优先级数据
+        size_t unmarked_bulk{0};        ///< 通道建立前缓存的批量数据中尚未写出的字节数
+        std::deque<size_t> bulk_units;  ///< 之后每次缓存的批量发送字节数（按顺序）
+        size_t unit_sent{0};            ///< 队首单元已写出的字节数（> 0 表示正写到一半）
+
+        /// 批量数据已写到发送边界，可以插入控制数据
+        bool AtBoundary() const { return unmarked_bulk == 0 && unit_sent == 0; }
+        void ConsumeBulk(size_t bytes);
+      };
+
+      /**
+       * @brief 每个连接的 Reactor 侧状态
+       *
+       * 百万连接部署下每个字节都会放大一百万倍：字段按大小排列以减少填充，
+       * 对端地址使用紧凑格式，可选状态（限速器、共享内存通道）按需分配。
+       */
       struct ReactorConnection
       {
-        int file_descriptor{-1};
-        sockaddr_storage peer_address{};
         uint64_t connection_id{0};
+        int file_descriptor{-1};
+        uint32_t receive_size{0};                   ///< 自适应接收大小（0 = 默认大小）
+        CompactAddress peer_address;
 
-        SendBuffer send_buffer;
         bool read_paused{false};
         bool write_pending{false};
+        bool shm_handshake_pending{false};          ///< 尚未读取第一段数据，可能是升级握手
+        bool rate_paused{false};                    ///< 因限速暂停读取（与背压暂停相互独立）
+        bool memory_paused{false};                  ///< 因全局内存预算暂停读取
+        bool read_monitored{true};                  ///< 当前是否注册了读事件
+        bool send_buffer_tracked{false};            ///< 已加入空闲回收扫描列表
+        bool send_buffer_touched{false};            ///< 上次扫描后写入过发送缓冲区
+        bool idle_timeout{true};                    ///< 参与空闲超时检测
+
+        SendBuffer send_buffer;                     ///< 批量优先级数据
+        std::unique_ptr<SendLanes> lanes;           ///< 没有缓存控制数据时为空
+        std::shared_ptr<ShmChannel> shm;            ///< 升级后的共享内存通道
+        size_t budget_bytes{0};                     ///< 已计入内存预算的发送数据量
+        std::unique_ptr<ConnectionLimiters> limiters; ///< 未配置限速时为空
+
+        std::shared_ptr<std::atomic<size_t>> send_buffer_size; ///< 可选的缓冲区大小镜像
 
         std::chrono::steady_clock::time_point last_active;
 
@@ -129,13 +396,28 @@ namespace darwincore
         ReactorConnection &operator=(const ReactorConnection &) = delete;
       };
 
+      using ConnectionMap = std::unordered_map<uint64_t, ReactorConnection>;
+
+      /// 迁移/采样操作的附加参数
+      struct Handoff
+      {
+        std::shared_ptr<Reactor> target;      ///< kMigrate：目标 Reactor
+        ConnectionMap::node_type node;        ///< kAdopt：摘下的连接（为空表示迁移失败）
+        size_t sample_limit{0};               ///< kSample：最多返回的连接数
+        std::vector<TrafficSample> samples;   ///< kSample：采样结果
+      };
+
       struct Operation
       {
         enum Type
         {
           kAdd,
           kRemove,
-          kSend
+          kSend,
+          kExpect,
+          kMigrate,
+          kAdopt,
+          kSample
         };
 
         Type type{kAdd};
@@ -145,17 +427,58 @@ namespace darwincore
         std::vector<uint8_t> data;
 
         std::shared_ptr<std::promise<uint64_t>> promise;
+        std::shared_ptr<std::atomic<size_t>> send_buffer_size;
+        std::shared_ptr<ShmChannel> shm_channel;
+        std::shared_ptr<SharedRateLimiter> listener_limiter;
+        SendCompleteCallback on_complete;
+        SendPriority priority{SendPriority::kBulk};
+        bool idle_timeout{true};
+        int error_code{0};                    ///< kRemove：非 0 时分发错误与断开事件
+        std::shared_ptr<Handoff> handoff;     ///< 仅 kMigrate/kAdopt/kSample 使用
+      };
+
+      /// 等待恢复读取的限速连接（按到期时间排序的最小堆元素）
+      struct RateResume
+      {
+        std::chrono::steady_clock::time_point deadline;
+        uint64_t connection_id;
+
+        bool operator>(const RateResume &other) const { return deadline > other.deadline; }
+      };
+
+      /// 写合并模式下暂存的一次发送
+      struct StagedWrite
+      {
+        std::vector<uint8_t> data;
+        SendCompleteCallback on_complete;
       };
 
       // ============ Reactor 线程私有方法 ============
 
       void RunEventLoop();
-      void ProcessPendingOperations();
-
-      uint64_t DoAddConnection(int fd, const sockaddr_storage &peer);
+      size_t ProcessPendingOperations();
+      void ExecuteOperation(Operation &op);
+      void AdaptOpBatchSize(size_t processed);
+
+      uint64_t DoAddConnection(int fd, const sockaddr_storage &peer,
+                               uint64_t connection_id,
+                               std::shared_ptr<std::atomic<size_t>> send_buffer_size,
+                               std::shared_ptr<ShmChannel> shm_channel,
+                               std::shared_ptr<SharedRateLimiter> listener_limiter,
+                               bool idle_timeout);
       bool DoRemoveConnection(uint64_t connection_id);
+      void DoMigrateConnection(Operation &op);
+      void DoAdoptConnection(Operation &op);
+      void DoSampleTraffic(Operation &op);
+      bool AttachConnectionNode(ConnectionMap::node_type &node);
       bool DoSendData(uint64_t connection_id,
-                      const std::vector<uint8_t> &data);
+                      const std::vector<uint8_t> &data,
+                      SendPriority priority);
+
+      void StageSendData(Operation &op);
+      void FlushStagedWrites();
+      void FlushConnectionWrites(uint64_t connection_id,
+                                 std::vector<StagedWrite> &writes);
 
       bool TrySendDirect(int fd,
                          const uint8_t *data,
@@ -163,17 +486,62 @@ namespace darwincore
                          size_t &sent,
                          bool &error);
 
+      /// @param already_sent 本次发送已直接写出的字节数（剩余部分不能被控制数据插队）
       bool BufferAndMonitorWrite(ReactorConnection &conn,
                                  const uint8_t *data,
-                                 size_t size);
+                                 size_t size,
+                                 size_t already_sent = 0);
+      bool BufferControlWrite(ReactorConnection &conn,
+                              const uint8_t *data,
+                              size_t size);
+      SendLanes &EnsureSendLanes(ReactorConnection &conn);
+      void ReleaseSendLanes(ReactorConnection &conn);
+      bool HasPendingWrites(const ReactorConnection &conn) const;
+      size_t SendBufferCapacity(const ReactorConnection &conn) const;
+      ssize_t WritePending(ReactorConnection &conn);
 
       void ProcessKqueueEvent(const struct kevent &event);
 
-      void HandleReadEvent(int fd);
+      bool AttachSharedMemory(ReactorConnection &conn,
+                              std::shared_ptr<ShmChannel> channel);
+      void DetachSharedMemory(ReactorConnection &conn);
+      void HandleDoorbellEvent(uint64_t connection_id);
+      void DrainSharedMemoryBacklog();
+      /// @param paced 是否遵守读取暂停（连接关闭前的最后一次读取为 false）
+      /// @param drained 输出环是否已读空
+      /// @return 对端写坏了环返回 false
+      bool ReceiveSharedMemory(ReactorConnection &conn, bool paced, bool &drained);
+      bool SendSharedMemory(ReactorConnection &conn,
+                            const uint8_t *data,
+                            size_t size);
+
+      /// @return socket 已读到 EAGAIN 返回 true（预算用尽、暂停或连接关闭返回 false）
+      bool HandleReadEvent(int fd);
       void HandleWriteEvent(int fd);
+      void TrackSendBuffer(ReactorConnection &conn, const SendBuffer &buffer,
+                           size_t capacity_before);
+      void ReleaseIdleSendBuffers();
+      size_t ConnectionFootprint(const ReactorConnection &conn) const;
+      void AdaptReceiveSize(ReactorConnection &conn, size_t requested, size_t received,
+                            bool first_read);
 
       void CheckTimeouts();
 
+      bool ChargeIngress(ReactorConnection &conn, size_t bytes);
+      void ChargeEgress(ReactorConnection &conn, size_t bytes, size_t messages);
+      void PauseForRateLimit(ReactorConnection &conn,
+                             std::chrono::steady_clock::duration delay);
+      int ResumeRateLimited(std::chrono::steady_clock::time_point now);
+
+      void CountTraffic(const ReactorConnection &conn, size_t bytes);
+      void PublishSendBufferSize(ReactorConnection &conn);
+      void UpdateReadInterest(ReactorConnection &conn);
+      void EnforceSendMemoryBudget();
+      void ReleaseBudget(ReactorConnection &conn);
+      bool ChargeQueuedSend(size_t size);
+      void ReleaseQueuedSend(size_t size);
+      void DropPendingSends();
+
       void HandleConnectionClose(const ReactorConnection &conn);
       void HandleConnectionError(const ReactorConnection &conn,
                                  int error_code);
@@ -210,19 +578,71 @@ namespace darwincore
 
       std::atomic<uint16_t> connection_seq_{0};
 
-      std::unordered_map<uint64_t, ReactorConnection> connections_;
+      ConnectionMap connections_;
       std::unordered_map<int, uint64_t> fd_to_connection_id_;
 
+      /// 等待迁入的连接 -> 迁入前到达的操作（按到达顺序）
+      std::unordered_map<uint64_t, std::vector<Operation>> expected_connections_;
+
+      /// 连接在当前采样窗口内的流量（只为有读写或刚加入的连接建立）
+      struct TrafficCounter
+      {
+        uint64_t bytes{0};
+        std::chrono::steady_clock::time_point since;  ///< 窗口开始或连接加入的时间
+      };
+      bool traffic_sampling_{false};
+      std::chrono::steady_clock::time_point traffic_window_start_;
+      std::unordered_map<uint64_t, TrafficCounter> traffic_;
+
       ConcurrentQueue<Operation> pending_operations_;
 
       std::chrono::seconds connection_timeout_;
 
+      bool write_coalescing_{false};
+      bool shm_transport_{false};
+
+      std::chrono::microseconds busy_poll_spin_{0};
+      std::atomic<size_t> op_batch_size_{kDefaultOpBatchSize};
+      std::unordered_map<uint64_t, std::vector<StagedWrite>> staged_writes_;
+
+      std::shared_ptr<SendMemoryBudget> send_budget_;
+      size_t memory_paused_count_{0};
+
+      size_t read_budget_bytes_{0};
+      size_t read_budget_reads_{0};
+      size_t max_receive_size_{0};           ///< 0 = 关闭自适应接收大小
+      std::vector<uint8_t> receive_buffer_;  ///< 接收缓冲区（Reactor 线程私有）
+      std::vector<uint64_t> shm_backlog_;    ///< 接收环未读完、下一轮继续读取的连接
+
+      std::chrono::milliseconds send_buffer_idle_release_{0};  ///< 0 = 不回收
+      std::vector<uint64_t> tracked_send_buffers_;   ///< 已分配发送缓冲区、待空闲扫描的连接
+      std::vector<std::vector<uint8_t>> spare_send_buffers_; ///< 回收的初始大小缓冲区
+
+      RateLimit ingress_limit_;
+      RateLimit egress_limit_;
+      std::priority_queue<RateResume, std::vector<RateResume>, std::greater<RateResume>>
+          rate_resumes_;
+
       // 统计
       std::atomic<uint64_t> total_connections_{0};
       std::atomic<uint64_t> active_connections_{0};
       std::atomic<uint64_t> total_bytes_sent_{0};
       std::atomic<uint64_t> total_bytes_received_{0};
       std::atomic<uint64_t> total_ops_processed_{0};
+      std::atomic<uint64_t> total_coalesced_sends_{0};
+      std::atomic<uint64_t> total_shm_connections_{0};
+      std::atomic<uint64_t> total_rate_limit_pauses_{0};
+      std::atomic<uint64_t> send_buffer_bytes_{0};
+      std::atomic<uint64_t> send_budget_rejects_{0};
+      std::atomic<uint64_t> send_budget_disconnects_{0};
+      std::atomic<uint64_t> busy_poll_spin_ns_{0};
+      std::atomic<uint64_t> busy_poll_parked_ns_{0};
+      std::atomic<uint64_t> total_read_yields_{0};
+      std::atomic<uint64_t> connection_memory_bytes_{0};
+      std::atomic<uint64_t> send_buffer_capacity_bytes_{0};
+      std::atomic<uint64_t> send_buffer_releases_{0};
+      std::atomic<uint64_t> total_priority_bypasses_{0};
+      std::atomic<uint64_t> total_migrations_in_{0};
     };
 
   } // namespace network
@@ -0,0 +1,279 @@
+//
+// DarwinCore Network 模块
+// ReactorBalancer 实现
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include "reactor_balancer.h"
+
+#include <algorithm>
+#include <future>
+#include <iterator>
+
+#include "connection_id_generator.h"
+#include <darwincore/network/logger.h>
+#include <pthread.h>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    ReactorBalancer::ReactorBalancer(std::vector<std::shared_ptr<Reactor>> reactors,
+                                     std::chrono::milliseconds interval, double threshold)
+        : reactors_(std::move(reactors)),
+          interval_(std::max(interval, Reactor::kMinTrafficWindow)),
+          threshold_(std::max(threshold, 1.0)) {}
+
+    ReactorBalancer::~ReactorBalancer() { Stop(); }
+
+    bool ReactorBalancer::Start()
+    {
+      if (is_running_ || reactors_.size() < 2)
+      {
+        return false;
+      }
+
+      // 基线：累计字节与连接流量计数都从现在开始
+      auto now = std::chrono::steady_clock::now();
+      last_bytes_.assign(reactors_.size(), 0);
+      for (size_t i = 0; i < reactors_.size(); ++i)
+      {
+        Reactor::Statistics stats = reactors_[i]->GetStatistics();
+        last_bytes_[i] = stats.total_bytes_sent + stats.total_bytes_received;
+        reactors_[i]->SampleHotConnections(1);
+      }
+      last_round_ = now;
+
+      {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        stopping_ = false;
+      }
+      is_running_ = true;
+      thread_ = std::thread(&ReactorBalancer::ThreadLoop, this);
+
+      NW_LOG_INFO("[ReactorBalancer] 启动: interval_ms=" << interval_.count()
+                                                         << ", threshold=" << threshold_);
+      return true;
+    }
+
+    void ReactorBalancer::Stop()
+    {
+      if (!is_running_.exchange(false))
+      {
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        stopping_ = true;
+      }
+      wait_cv_.notify_all();
+      if (thread_.joinable())
+      {
+        thread_.join();
+      }
+
+      NW_LOG_INFO("[ReactorBalancer] 停止，累计迁移 " << migrations_.load() << " 个连接");
+    }
+
+    // ============ 路由 ============
+
+    size_t ReactorBalancer::RouteIndex(uint64_t connection_id) const
+    {
+      if (!routes_.empty())
+      {
+        auto it = routes_.find(connection_id);
+        if (it != routes_.end())
+        {
+          return it->second;
+        }
+      }
+      return ConnectionIdGenerator::GetReactorId(connection_id);
+    }
+
+    bool ReactorBalancer::SendData(uint64_t connection_id, const uint8_t *data, size_t size,
+                                   SendPriority priority)
+    {
+      // 读锁覆盖入队：迁移切换路由时，已查到旧 Reactor 的发送一定排在迁移操作之前
+      std::shared_lock<std::shared_mutex> lock(route_mutex_);
+      size_t index = RouteIndex(connection_id);
+      if (index >= reactors_.size())
+      {
+        NW_LOG_ERROR("[ReactorBalancer] reactor_id=" << index << " 超出范围（总数="
+                                                     << reactors_.size() << "）");
+        return false;
+      }
+      return reactors_[index]->SendData(connection_id, data, size, priority);
+    }
+
+    bool ReactorBalancer::RemoveConnection(uint64_t connection_id, int error_code)
+    {
+      std::shared_lock<std::shared_mutex> lock(route_mutex_);
+      size_t index = RouteIndex(connection_id);
+      return index < reactors_.size() &&
+             reactors_[index]->RemoveConnection(connection_id, error_code);
+    }
+
+    void ReactorBalancer::OnConnectionClosed(uint64_t connection_id)
+    {
+      std::unique_lock<std::shared_mutex> lock(route_mutex_);
+      routes_.erase(connection_id);
+    }
+
+    // ============ 迁移 ============
+
+    bool ReactorBalancer::Migrate(uint64_t connection_id, size_t target_index)
+    {
+      if (target_index >= reactors_.size())
+      {
+        return false;
+      }
+
+      size_t home_index = ConnectionIdGenerator::GetReactorId(connection_id);
+      size_t source_index = 0;
+      std::future<uint64_t> done;
+      {
+        std::unique_lock<std::shared_mutex> lock(route_mutex_);
+        source_index = RouteIndex(connection_id);
+        if (source_index == target_index || source_index >= reactors_.size() ||
+            !reactors_[target_index]->ExpectConnection(connection_id))
+        {
+          return false;
+        }
+
+        // 迁移期间即使目标是初始 Reactor 也显式登记，结束时据此判断连接是否已关闭
+        routes_[connection_id] = target_index;
+        done = reactors_[source_index]->MigrateConnection(connection_id, reactors_[target_index]);
+      }
+
+      uint64_t result = 0;
+      try
+      {
+        if (done.wait_for(kMigrationTimeout) != std::future_status::ready)
+        {
+          // 迁移操作已在源 Reactor 队列中，仍会完成，保留新路由
+          NW_LOG_WARNING("[ReactorBalancer] 等待迁移超时: conn_id=" << connection_id);
+          return false;
+        }
+        result = done.get();
+      }
+      catch (const std::exception &e)
+      {
+        NW_LOG_WARNING("[ReactorBalancer] 迁移中断: conn_id=" << connection_id << ", " << e.what());
+      }
+
+      {
+        std::unique_lock<std::shared_mutex> lock(route_mutex_);
+        auto route = routes_.find(connection_id);
+        // 路由已被 OnConnectionClosed 删除：连接已关闭，不能再登记
+        if (route != routes_.end() && route->second == target_index)
+        {
+          size_t index = result == 0 ? source_index : target_index;
+          if (index == home_index)
+          {
+            routes_.erase(route);
+          }
+          else
+          {
+            route->second = index;
+          }
+        }
+      }
+
+      if (result == 0)
+      {
+        return false;
+      }
+
+      migrations_.fetch_add(1, std::memory_order_relaxed);
+      NW_LOG_INFO("[ReactorBalancer] 迁移连接: conn_id=" << connection_id << ", Reactor"
+                                                         << source_index << " -> Reactor"
+                                                         << target_index);
+      return true;
+    }
+
+    // ============ 负载评估 ============
+
+    void ReactorBalancer::ThreadLoop()
+    {
+      pthread_setname_np("darwincore.network.balancer");
+
+      std::unique_lock<std::mutex> lock(wait_mutex_);
+      while (!wait_cv_.wait_for(lock, interval_, [this] { return stopping_; }))
+      {
+        lock.unlock();
+        Rebalance();
+        lock.lock();
+      }
+    }
+
+    void ReactorBalancer::Rebalance()
+    {
+      auto now = std::chrono::steady_clock::now();
+      double seconds = std::chrono::duration<double>(now - last_round_).count();
+      last_round_ = now;
+      if (seconds <= 0)
+      {
+        return;
+      }
+
+      ++round_;
+      for (auto it = cooldowns_.begin(); it != cooldowns_.end();)
+      {
+        it = (round_ - it->second > kMigrationCooldownRounds) ? cooldowns_.erase(it) : std::next(it);
+      }
+
+      const size_t count = reactors_.size();
+      std::vector<double> rates(count, 0);
+      double total = 0;
+      for (size_t i = 0; i < count; ++i)
+      {
+        Reactor::Statistics stats = reactors_[i]->GetStatistics();
+        uint64_t bytes = stats.total_bytes_sent + stats.total_bytes_received;
+        rates[i] = static_cast<double>(bytes - last_bytes_[i]) / seconds;
+        last_bytes_[i] = bytes;
+        total += rates[i];
+      }
+
+      const double mean = total / static_cast<double>(count);
+      size_t hot = std::max_element(rates.begin(), rates.end()) - rates.begin();
+      if (total <= 0 || rates[hot] <= mean * threshold_)
+      {
+        return;
+      }
+
+      std::vector<Reactor::TrafficSample> samples =
+          reactors_[hot]->SampleHotConnections(kMaxMigrationsPerRound * 4);
+
+      size_t migrated = 0;
+      for (const Reactor::TrafficSample &sample : samples)
+      {
+        if (migrated >= kMaxMigrationsPerRound || rates[hot] <= mean * threshold_)
+        {
+          break;
+        }
+
+        // 迁移后两个 Reactor 中较忙的一方至少要比原来低 1/4 差距：否则只是把过载
+        // 换到另一个 Reactor（独占一个 Reactor 的大连接会在 Reactor 之间来回迁移）
+        size_t cold = std::min_element(rates.begin(), rates.end()) - rates.begin();
+        double gap = rates[hot] - rates[cold];
+        double rate = static_cast<double>(sample.bytes_per_second);
+        if (rate <= 0 || rate > gap * 0.75 || cooldowns_.count(sample.connection_id) != 0)
+        {
+          continue;
+        }
+
+        if (Migrate(sample.connection_id, cold))
+        {
+          rates[hot] -= rate;
+          rates[cold] += rate;
+          cooldowns_[sample.connection_id] = round_;
+          ++migrated;
+        }
+      }
+    }
+
+  } // namespace network
+} // namespace darwincore
@@ -0,0 +1,134 @@
+//
+// DarwinCore Network 模块
+// ReactorBalancer - Reactor 间连接负载均衡
+//
+// 功能说明：
+//   连接在 accept 时按轮询固定到某个 Reactor，少数高流量连接碰巧落在同一个
+//   Reactor 上时，该线程饱和而其他 Reactor 空闲。ReactorBalancer 定期比较各
+//   Reactor 的收发字节速率，把过载 Reactor 上的热点连接迁移到最空闲的 Reactor。
+//
+//   connection_id 中编码的 Reactor ID 不随迁移改变，迁移过的连接记录在路由表
+//   中；Server 的发送/移除都经过 Route 查表，找到连接当前所在的 Reactor。
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_NETWORK_REACTOR_BALANCER_H
+#define DARWINCORE_NETWORK_REACTOR_BALANCER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "reactor.h"
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    /**
+     * @brief Reactor 间连接负载均衡与迁移路由
+     *
+     * 迁移协议（保证同一连接的发送顺序不变）：
+     *   1. 持路由表写锁：目标 Reactor ExpectConnection，切换路由，源 Reactor
+     *      MigrateConnection —— 切换前的发送都排在迁移操作之前，由源 Reactor 写出
+     *   2. 切换后的发送进入目标 Reactor，在连接迁入前暂存
+     *   3. 源 Reactor 在静止点摘下连接交给目标，目标注册 fd 后按序执行暂存的操作
+     *
+     * 线程安全：SendData/RemoveConnection/OnConnectionClosed/Migrate 可以从任何线程调用。
+     */
+    class ReactorBalancer
+    {
+    public:
+      /// 每轮最多迁移的连接数
+      static constexpr size_t kMaxMigrationsPerRound = 4;
+
+      /// 连接被迁移后，至少经过这么多轮评估才会再次被迁移（避免在 Reactor 间来回迁移）
+      static constexpr size_t kMigrationCooldownRounds = 10;
+
+      /// 等待单次迁移完成的上限
+      static constexpr std::chrono::milliseconds kMigrationTimeout{2000};
+
+      /**
+       * @brief 构造负载均衡器
+       * @param reactors 全部 Reactor（下标即 Reactor ID），需已开启 SetTrafficSampling
+       * @param interval 评估间隔（不小于 Reactor::kMinTrafficWindow，否则连接流量
+       *        统计时长不足、永远不会被采样迁移）
+       * @param threshold 最忙 Reactor 的字节速率超过平均值的该倍数时迁移
+       */
+      ReactorBalancer(std::vector<std::shared_ptr<Reactor>> reactors,
+                      std::chrono::milliseconds interval, double threshold);
+
+      /// 析构函数 - 停止评估线程
+      ~ReactorBalancer();
+
+      ReactorBalancer(const ReactorBalancer &) = delete;
+      ReactorBalancer &operator=(const ReactorBalancer &) = delete;
+
+      /// 启动评估线程，已启动返回 false
+      bool Start();
+
+      /// 停止评估线程（等待进行中的迁移完成）；路由表保留，SendData 仍可用
+      void Stop();
+
+      /// 按路由表发送数据
+      bool SendData(uint64_t connection_id, const uint8_t *data, size_t size,
+                    SendPriority priority);
+
+      /// 按路由表移除连接（error_code 见 Reactor::RemoveConnection）
+      bool RemoveConnection(uint64_t connection_id, int error_code = 0);
+
+      /// 连接已断开：清除路由
+      void OnConnectionClosed(uint64_t connection_id);
+
+      /**
+       * @brief 把连接迁移到指定 Reactor（同步等待完成）
+       * @return 迁移成功返回 true；连接已关闭、已在目标上或超时返回 false
+       */
+      bool Migrate(uint64_t connection_id, size_t target_index);
+
+      /// 已完成的迁移次数
+      uint64_t GetMigrationCount() const { return migrations_.load(std::memory_order_relaxed); }
+
+    private:
+      /// 连接当前所在的 Reactor 下标（调用方持有 route_mutex_）
+      size_t RouteIndex(uint64_t connection_id) const;
+
+      /// 评估线程主循环
+      void ThreadLoop();
+
+      /// 一轮评估：找出过载 Reactor，迁移其中的热点连接
+      void Rebalance();
+
+      std::vector<std::shared_ptr<Reactor>> reactors_;
+      std::chrono::milliseconds interval_;
+      double threshold_;
+
+      mutable std::shared_mutex route_mutex_;
+      std::unordered_map<uint64_t, size_t> routes_;  ///< 迁移过的连接 -> 当前 Reactor 下标
+
+      std::vector<uint64_t> last_bytes_;             ///< 上一轮各 Reactor 的累计收发字节
+      std::chrono::steady_clock::time_point last_round_;
+      uint64_t round_{0};
+      std::unordered_map<uint64_t, uint64_t> cooldowns_;  ///< 评估线程迁移过的连接 -> 迁移时的轮次
+
+      std::thread thread_;
+      std::mutex wait_mutex_;
+      std::condition_variable wait_cv_;
+      bool stopping_{false};
+      std::atomic<bool> is_running_{false};
+      std::atomic<uint64_t> migrations_{0};
+    };
+
+  } // namespace network
+} // namespace darwincore
+
+#endif // DARWINCORE_NETWORK_REACTOR_BALANCER_H
@@ -0,0 +1,518 @@
+//
+// DarwinCore Network 模块
+// 请求/响应 RPC 实现
+//
+// 功能说明：
+//   请求和响应都编码为 proto Message 帧，message_id 即请求 ID。
+//   客户端维护 request_id -> 回调 的未完成表，截止时间注册到共享 TimerService，
+//   到期后经 Client::Post 回到连接的 Worker 线程，与响应、断开回调串行执行。
+//   响应、超时、断开、取消四条路径竞争从表中摘除请求，先摘除者负责回调，
+//   从而保证每个请求的回调恰好执行一次。
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <darwincore/network/rpc.h>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "timer_wheel.h"
+#include <darwincore/network/logger.h>
+#include <darwincore/network/protocol.h>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    namespace
+    {
+      /**
+       * @brief 将一条消息编码为连续的字节流（多个分片帧首尾相接）
+       *
+       * 一次性交给发送层，避免多次系统调用。
+       */
+      bool EncodeMessage(uint64_t message_id, const uint8_t *data, size_t size,
+                         std::vector<uint8_t> &out)
+      {
+        try
+        {
+          auto frames = proto::Encoder::EncodeMessage(message_id, data, size);
+
+          size_t total = 0;
+          for (const auto &frame : frames)
+          {
+            total += sizeof(proto::FrameHeader) + frame.payload.size();
+          }
+
+          out.clear();
+          out.reserve(total);
+          for (const auto &frame : frames)
+          {
+            const auto *header = reinterpret_cast<const uint8_t *>(&frame.header);
+            out.insert(out.end(), header, header + sizeof(proto::FrameHeader));
+            out.insert(out.end(), frame.payload.begin(), frame.payload.end());
+          }
+          return true;
+        }
+        catch (const proto::ProtocolError &e)
+        {
+          NW_LOG_ERROR("[Rpc] 消息编码失败: " << e.what());
+          return false;
+        }
+      }
+    } // namespace
+
+    // ============ RpcClient::Impl ============
+
+    class RpcClient::Impl : public std::enable_shared_from_this<RpcClient::Impl>
+    {
+    public:
+      explicit Impl(Client &client)
+          : client_(client), timers_(TimerService::Shared()) {}
+
+      void Attach()
+      {
+        std::weak_ptr<Impl> weak = shared_from_this();
+
+        client_.SetOnMessage([weak](const std::vector<uint8_t> &data)
+                             {
+                               if (auto self = weak.lock())
+                                 self->OnMessage(data);
+                             });
+        client_.SetOnDisconnected([weak]()
+                                  {
+                                    if (auto self = weak.lock())
+                                      self->OnDisconnected();
+                                  });
+      }
+
+      uint64_t Call(const uint8_t *data, size_t size, ResponseCallback callback,
+                    int timeout_ms)
+      {
+        uint64_t request_id = next_request_id_.fetch_add(1, std::memory_order_relaxed);
+
+        std::vector<uint8_t> packet;
+        if (!EncodeMessage(request_id, data, size, packet))
+        {
+          if (callback)
+          {
+            // 与其他完成回调一样在 Worker 中执行，Post 失败时才在调用线程中回调
+            auto shared = std::make_shared<ResponseCallback>(std::move(callback));
+            if (!client_.Post([shared]()
+                              { (*shared)(RpcStatus::kSendFailed, {}); }))
+            {
+              (*shared)(RpcStatus::kSendFailed, {});
+            }
+          }
+          return 0;
+        }
+
+        // 先登记再发送，保证响应不会早于登记到达
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          pending_.emplace(request_id, PendingCall{std::move(callback), 0});
+        }
+
+        if (timeout_ms > 0)
+        {
+          std::weak_ptr<Impl> weak = shared_from_this();
+          auto timer_id = timers_->Schedule(
+              std::chrono::milliseconds(timeout_ms), [weak, request_id]()
+              {
+                if (auto self = weak.lock())
+                  self->OnDeadline(request_id);
+              });
+
+          std::lock_guard<std::mutex> lock(mutex_);
+          auto it = pending_.find(request_id);
+          if (it != pending_.end())
+          {
+            it->second.timer_id = timer_id;
+          }
+          else
+          {
+            timers_->Cancel(timer_id);
+          }
+        }
+
+        std::weak_ptr<Impl> weak = shared_from_this();
+        bool queued = client_.SendAsync(packet.data(), packet.size(),
+                                        [weak, request_id](bool success, size_t)
+                                        {
+                                          if (success)
+                                            return;
+                                          if (auto self = weak.lock())
+                                            self->CompleteOnWorker(request_id, RpcStatus::kSendFailed);
+                                        });
+        if (!queued)
+        {
+          CompleteOnWorker(request_id, RpcStatus::kSendFailed);
+          return 0;
+        }
+
+        return request_id;
+      }
+
+      /**
+       * @brief 结束一个请求
+       * @return 请求仍在未完成表中（本次负责回调）返回 true
+       */
+      bool Complete(uint64_t request_id, RpcStatus status, const std::vector<uint8_t> &data)
+      {
+        PendingCall call;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          auto it = pending_.find(request_id);
+          if (it == pending_.end())
+          {
+            return false;
+          }
+          call = std::move(it->second);
+          pending_.erase(it);
+        }
+
+        if (call.timer_id != 0 && status != RpcStatus::kTimeout)
+        {
+          timers_->Cancel(call.timer_id);
+        }
+
+        if (call.callback)
+        {
+          call.callback(status, data);
+        }
+        return true;
+      }
+
+      /**
+       * @brief 在连接的 Worker 中结束请求（无响应数据的完成：超时、发送失败）
+       *
+       * 与响应回调不会并发；连接已断开或队列满时在当前线程结束请求。
+       */
+      void CompleteOnWorker(uint64_t request_id, RpcStatus status)
+      {
+        std::weak_ptr<Impl> weak = shared_from_this();
+        bool posted = client_.Post([weak, request_id, status]()
+                                   {
+                                     if (auto self = weak.lock())
+                                       self->Complete(request_id, status, {});
+                                   });
+        if (!posted)
+        {
+          Complete(request_id, status, {});
+        }
+      }
+
+      /**
+       * @brief 截止时间到期（TimerService 线程）
+       */
+      void OnDeadline(uint64_t request_id)
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (pending_.find(request_id) == pending_.end())
+          {
+            return;
+          }
+        }
+
+        CompleteOnWorker(request_id, RpcStatus::kTimeout);
+      }
+
+      void FailAll(RpcStatus status)
+      {
+        std::unordered_map<uint64_t, PendingCall> pending;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          pending.swap(pending_);
+        }
+
+        for (auto &[request_id, call] : pending)
+        {
+          if (call.timer_id != 0)
+          {
+            timers_->Cancel(call.timer_id);
+          }
+          if (call.callback)
+          {
+            call.callback(status, {});
+          }
+        }
+      }
+
+      size_t GetPendingCount() const
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_.size();
+      }
+
+      void SetOnDisconnected(Client::OnDisconnectedCallback callback)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        on_disconnected_ = std::move(callback);
+      }
+
+    private:
+      struct PendingCall
+      {
+        ResponseCallback callback;
+        TimerService::TimerId timer_id = 0;
+      };
+
+      void OnMessage(const std::vector<uint8_t> &data)
+      {
+        std::vector<proto::MessageComplete> responses;
+        bool protocol_error = false;
+        {
+          std::lock_guard<std::mutex> lock(decoder_mutex_);
+          try
+          {
+            decoder_.Feed(data.data(), data.size());
+            proto::MessageComplete message;
+            while (decoder_.GetMessage(message))
+            {
+              responses.push_back(std::move(message));
+            }
+          }
+          catch (const proto::ProtocolError &e)
+          {
+            NW_LOG_ERROR("[RpcClient] 协议错误: " << e.what());
+            decoder_.Reset();
+            protocol_error = true;
+          }
+        }
+
+        for (const auto &response : responses)
+        {
+          if (!Complete(response.message_id, RpcStatus::kOk, response.data))
+          {
+            NW_LOG_DEBUG("[RpcClient] 丢弃迟到的响应: request_id=" << response.message_id);
+          }
+        }
+
+        if (protocol_error)
+        {
+          FailAll(RpcStatus::kProtocolError);
+        }
+      }
+
+      void OnDisconnected()
+      {
+        {
+          std::lock_guard<std::mutex> lock(decoder_mutex_);
+          decoder_.Reset();
+        }
+
+        FailAll(RpcStatus::kDisconnected);
+
+        Client::OnDisconnectedCallback callback;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          callback = on_disconnected_;
+        }
+        if (callback)
+        {
+          callback();
+        }
+      }
+
+      Client &client_;
+      std::shared_ptr<TimerService> timers_;
+      std::atomic<uint64_t> next_request_id_{1};
+
+      mutable std::mutex mutex_;
+      std::unordered_map<uint64_t, PendingCall> pending_;
+      Client::OnDisconnectedCallback on_disconnected_;
+
+      std::mutex decoder_mutex_;
+      proto::Decoder decoder_;
+    };
+
+    // ============ RpcClient ============
+
+    RpcClient::RpcClient(Client &client)
+        : impl_(std::make_shared<Impl>(client))
+    {
+      impl_->Attach();
+    }
+
+    RpcClient::~RpcClient()
+    {
+      impl_->FailAll(RpcStatus::kCancelled);
+    }
+
+    uint64_t RpcClient::Call(const uint8_t *data, size_t size, ResponseCallback callback,
+                             int timeout_ms)
+    {
+      return impl_->Call(data, size, std::move(callback), timeout_ms);
+    }
+
+    std::future<RpcResponse> RpcClient::CallFuture(const uint8_t *data, size_t size,
+                                                   int timeout_ms)
+    {
+      auto promise = std::make_shared<std::promise<RpcResponse>>();
+      auto future = promise->get_future();
+
+      impl_->Call(data, size,
+                  [promise](RpcStatus status, const std::vector<uint8_t> &response)
+                  {
+                    RpcResponse result;
+                    result.status = status;
+                    result.data = response;
+                    promise->set_value(std::move(result));
+                  },
+                  timeout_ms);
+
+      return future;
+    }
+
+    bool RpcClient::Cancel(uint64_t request_id)
+    {
+      return impl_->Complete(request_id, RpcStatus::kCancelled, {});
+    }
+
+    size_t RpcClient::GetPendingCount() const { return impl_->GetPendingCount(); }
+
+    void RpcClient::SetOnDisconnected(Client::OnDisconnectedCallback callback)
+    {
+      impl_->SetOnDisconnected(std::move(callback));
+    }
+
+    // ============ RpcServer::Impl ============
+
+    class RpcServer::Impl : public std::enable_shared_from_this<RpcServer::Impl>
+    {
+    public:
+      explicit Impl(Server &server) : server_(server) {}
+
+      void Attach()
+      {
+        std::weak_ptr<Impl> weak = shared_from_this();
+
+        server_.SetOnMessage([weak](uint64_t connection_id, const std::vector<uint8_t> &data)
+                             {
+                               if (auto self = weak.lock())
+                                 self->OnMessage(connection_id, data);
+                             });
+        server_.SetOnClientDisconnected([weak](uint64_t connection_id)
+                                        {
+                                          if (auto self = weak.lock())
+                                            self->OnDisconnected(connection_id);
+                                        });
+      }
+
+      void SetRequestHandler(RequestHandler handler)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        handler_ = std::move(handler);
+      }
+
+      void SetOnClientDisconnected(Server::OnClientDisconnectedCallback callback)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        on_disconnected_ = std::move(callback);
+      }
+
+      bool Respond(uint64_t connection_id, uint64_t request_id,
+                   const uint8_t *data, size_t size)
+      {
+        std::vector<uint8_t> packet;
+        if (!EncodeMessage(request_id, data, size, packet))
+        {
+          return false;
+        }
+        return server_.SendData(connection_id, packet.data(), packet.size());
+      }
+
+    private:
+      void OnMessage(uint64_t connection_id, const std::vector<uint8_t> &data)
+      {
+        // 同一连接的事件总在同一个 Worker 线程中按序到达，Decoder 无需额外加锁
+        proto::Decoder *decoder;
+        RequestHandler handler;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          decoder = &decoders_[connection_id];
+          handler = handler_;
+        }
+
+        std::vector<proto::MessageComplete> requests;
+        try
+        {
+          decoder->Feed(data.data(), data.size());
+          proto::MessageComplete message;
+          while (decoder->GetMessage(message))
+          {
+            requests.push_back(std::move(message));
+          }
+        }
+        catch (const proto::ProtocolError &e)
+        {
+          NW_LOG_ERROR("[RpcServer] 协议错误: conn_id=" << connection_id
+                                                        << ", " << e.what());
+          decoder->Reset();
+        }
+
+        if (!handler)
+        {
+          return;
+        }
+
+        for (const auto &request : requests)
+        {
+          handler(connection_id, request.message_id, request.data);
+        }
+      }
+
+      void OnDisconnected(uint64_t connection_id)
+      {
+        Server::OnClientDisconnectedCallback callback;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          decoders_.erase(connection_id);
+          callback = on_disconnected_;
+        }
+        if (callback)
+        {
+          callback(connection_id);
+        }
+      }
+
+      Server &server_;
+
+      std::mutex mutex_;
+      RequestHandler handler_;
+      Server::OnClientDisconnectedCallback on_disconnected_;
+      std::unordered_map<uint64_t, proto::Decoder> decoders_;  ///< 节点地址稳定，可在锁外使用
+    };
+
+    // ============ RpcServer ============
+
+    RpcServer::RpcServer(Server &server)
+        : impl_(std::make_shared<Impl>(server))
+    {
+      impl_->Attach();
+    }
+
+    RpcServer::~RpcServer() = default;
+
+    void RpcServer::SetRequestHandler(RequestHandler handler)
+    {
+      impl_->SetRequestHandler(std::move(handler));
+    }
+
+    bool RpcServer::Respond(uint64_t connection_id, uint64_t request_id,
+                            const uint8_t *data, size_t size)
+    {
+      return impl_->Respond(connection_id, request_id, data, size);
+    }
+
+    void RpcServer::SetOnClientDisconnected(Server::OnClientDisconnectedCallback callback)
+    {
+      impl_->SetOnClientDisconnected(std::move(callback));
+    }
+
+  } // namespace network
+} // namespace darwincore
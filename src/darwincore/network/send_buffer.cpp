@@ -20,9 +20,9 @@ namespace darwincore
   namespace network
   {
 
-    SendBuffer::SendBuffer() : buffer_(INITIAL_CAPACITY), read_pos_(0), write_pos_(0)
+    SendBuffer::SendBuffer() : read_pos_(0), write_pos_(0)
     {
-      buffer_.resize(INITIAL_CAPACITY);
+      // 延迟分配：从不发送数据的连接不占用缓冲区内存
     }
 
     bool SendBuffer::Write(const uint8_t *data, size_t size)
@@ -46,14 +46,14 @@ namespace darwincore
       return true;
     }
 
-    ssize_t SendBuffer::SendToSocket(int fd)
+    ssize_t SendBuffer::SendToSocket(int fd, size_t max_bytes)
     {
       if (fd < 0)
       {
         return -1;
       }
 
-      size_t readable = ContiguousReadableBytes();
+      size_t readable = std::min(ContiguousReadableBytes(), max_bytes);
       if (readable == 0)
       {
         return 0;
@@ -65,20 +65,7 @@ namespace darwincore
       if (sent > 0)
       {
         // 成功发送部分数据
-        read_pos_ += sent;
-
-        // 如果读完了，重置索引
-        if (read_pos_ == write_pos_)
-        {
-          read_pos_ = 0;
-          write_pos_ = 0;
-        }
-        else if (read_pos_ > buffer_.size() / 2)
-        {
-          // 如果读指针超过容量的一半，执行压缩
-          Compact();
-        }
-
+        Consume(static_cast<size_t>(sent));
         return sent;
       }
       else if (sent < 0)
@@ -105,6 +92,23 @@ namespace darwincore
       return 0;
     }
 
+    void SendBuffer::Consume(size_t size)
+    {
+      read_pos_ += std::min(size, Size());
+
+      // 如果读完了，重置索引
+      if (read_pos_ == write_pos_)
+      {
+        read_pos_ = 0;
+        write_pos_ = 0;
+      }
+      else if (read_pos_ > buffer_.size() / 2)
+      {
+        // 如果读指针超过容量的一半，执行压缩
+        Compact();
+      }
+    }
+
     void SendBuffer::Compact()
     {
       if (read_pos_ == 0)
@@ -139,6 +143,33 @@ namespace darwincore
       write_pos_ = 0;
     }
 
+    std::vector<uint8_t> SendBuffer::ReleaseStorage()
+    {
+      if (!IsEmpty())
+      {
+        return {};
+      }
+
+      std::vector<uint8_t> storage;
+      storage.swap(buffer_);
+      read_pos_ = 0;
+      write_pos_ = 0;
+      return storage;
+    }
+
+    bool SendBuffer::AdoptStorage(std::vector<uint8_t> &&storage)
+    {
+      if (!buffer_.empty() || storage.empty())
+      {
+        return false;
+      }
+
+      buffer_ = std::move(storage);
+      read_pos_ = 0;
+      write_pos_ = 0;
+      return true;
+    }
+
     bool SendBuffer::EnsureWritableSpace(size_t size)
     {
       size_t writable = buffer_.size() - write_pos_;
@@ -180,8 +211,8 @@ namespace darwincore
         }
       }
 
-      // 计算新的容量（2 倍增长）
-      size_t new_capacity = buffer_.size();
+      // 计算新的容量（2 倍增长，首次分配从初始容量开始）
+      size_t new_capacity = std::max(buffer_.size(), INITIAL_CAPACITY);
       while (new_capacity < required_size && new_capacity < MAX_CAPACITY)
       {
         new_capacity *= 2;
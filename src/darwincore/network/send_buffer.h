@@ -10,6 +10,7 @@
 //   - 使用读写指针而非环形缓冲区（简化设计）
 //   - 自动压缩以避免无限内存增长
 //   - 高水位检测用于背压控制
+//   - 首次写入时才分配存储，空闲连接不占用缓冲区内存
 //
 // 作者: DarwinCore Network 团队
 // 日期: 2026
@@ -32,6 +33,7 @@ namespace darwincore
      *
      * 使用线性缓冲区（而非环形）实现，通过读写指针管理数据。
      * 当读指针超过容量一半时自动压缩，将数据移动到缓冲区开头。
+     * 构造时不分配内存，第一次 Write 时才分配 INITIAL_CAPACITY。
      *
      * 性能特性：
      *   - Write(): O(1) append，可能触发扩容
@@ -88,6 +90,7 @@ namespace darwincore
       /**
        * @brief 将缓冲区数据发送到 socket
        * @param fd 文件描述符
+       * @param max_bytes 本次最多发送的字节数（用于在消息边界处停下）
        * @return 发送的字节数（> 0），0 表示 EAGAIN，-1 表示错误
        *
        * 此函数会尝试发送所有缓冲数据，直到：
@@ -95,7 +98,15 @@ namespace darwincore
        *   - 对端缓冲区满（返回 0，需要等待可写事件）
        *   - 发生错误（返回 -1）
        */
-      ssize_t SendToSocket(int fd);
+      ssize_t SendToSocket(int fd, size_t max_bytes = SIZE_MAX);
+
+      /**
+       * @brief 丢弃已被消费的数据（从 ReadPtr() 开始的 size 字节）
+       * @param size 已消费的字节数（超过 Size() 时按 Size() 处理）
+       *
+       * 供不经过 socket 的发送路径使用（例如共享内存通道）。
+       */
+      void Consume(size_t size);
 
       /**
        * @brief 压缩缓冲区（将剩余数据移动到开头）
@@ -149,10 +160,27 @@ namespace darwincore
 
       /**
        * @brief 获取当前容量
-       * @return 缓冲区总容量
+       * @return 缓冲区总容量（尚未写入过或已释放时为 0）
        */
       size_t Capacity() const { return buffer_.size(); }
 
+      /**
+       * @brief 交出底层存储（仅在缓冲区为空时有效）
+       * @return 原存储；缓冲区非空时返回空 vector，缓冲区保持不变
+       *
+       * 用于空闲连接归还内存，之后的写入会重新分配或通过 AdoptStorage 复用。
+       */
+      std::vector<uint8_t> ReleaseStorage();
+
+      /**
+       * @brief 复用外部存储（仅在缓冲区尚未分配时生效）
+       * @param storage 空闲存储（通常来自 ReleaseStorage）
+       * @return 被采用返回 true；缓冲区已有存储时返回 false，storage 保持不变
+       */
+      bool AdoptStorage(std::vector<uint8_t> &&storage);
+
+      static constexpr size_t INITIAL_CAPACITY = 4096; // 4KB 初始容量（首次写入时分配）
+
     private:
       /**
        * @brief 确保有足够的可写空间
@@ -166,7 +194,6 @@ namespace darwincore
       size_t write_pos_{0};         ///< 写位置
 
       // 常量配置
-      static constexpr size_t INITIAL_CAPACITY = 4096;            // 4KB 初始容量
       static constexpr size_t HIGH_WATER_MARK = 8 * 1024 * 1024;  // 8MB 高水位（提高背压阈值）
       static constexpr size_t LOW_WATER_MARK = 4 * 1024 * 1024;   // 4MB 低水位
       static constexpr size_t MAX_CAPACITY = 32 * 1024 * 1024;    // 32MB 最大容量
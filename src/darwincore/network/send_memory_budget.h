@@ -0,0 +1,122 @@
+//
+// DarwinCore Network 模块
+// SendMemoryBudget - 全服务端发送缓冲内存预算
+//
+// 功能说明：
+//   单个 SendBuffer 的上限只约束一条连接；大量慢速读取方叠加起来
+//   仍可占满内存。SendMemoryBudget 汇总所有 Reactor 中尚未写出的
+//   发送数据量（含操作队列中排队的数据），并按使用比例给出分级策略：
+//   - kPauseReads：正在积压数据的连接暂停读取（不再产生新的响应）
+//   - kRejectSends：SendData 直接返回 false
+//   - kOverLimit：各 Reactor 断开自己积压最多的连接，直到回到预算以内
+//
+// 设计原则：
+//   - 每个 Reactor 一个计数器（独占缓存行），读取时求和，
+//     避免所有 Reactor 竞争同一个原子变量
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_NETWORK_SEND_MEMORY_BUDGET_H
+#define DARWINCORE_NETWORK_SEND_MEMORY_BUDGET_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    class SendMemoryBudget
+    {
+    public:
+      /// 按使用比例划分的策略等级
+      enum class Tier
+      {
+        kNormal,
+        kPauseReads,
+        kRejectSends,
+        kOverLimit
+      };
+
+      /**
+       * @param limit 预算上限（字节）
+       * @param reactor_count Reactor 数量（每个 Reactor 一个计数器）
+       * @param pause_ratio 达到 limit * pause_ratio 后进入 kPauseReads
+       * @param reject_ratio 达到 limit * reject_ratio 后进入 kRejectSends
+       */
+      SendMemoryBudget(size_t limit, size_t reactor_count,
+                       double pause_ratio, double reject_ratio)
+          : limit_(limit),
+            pause_threshold_(static_cast<size_t>(limit * pause_ratio)),
+            reject_threshold_(static_cast<size_t>(limit * reject_ratio)),
+            counter_count_(reactor_count > 0 ? reactor_count : 1),
+            counters_(new Counter[counter_count_]) {}
+
+      SendMemoryBudget(const SendMemoryBudget &) = delete;
+      SendMemoryBudget &operator=(const SendMemoryBudget &) = delete;
+
+      /**
+       * @brief 调整某个 Reactor 的用量
+       *
+       * 主要由该 Reactor 线程调用；SendData 入队时调用线程也会计入
+       * 排队中的数据，计数器为原子变量，可以并发更新。
+       */
+      void Add(size_t reactor_id, int64_t delta)
+      {
+        counters_[reactor_id % counter_count_].bytes.fetch_add(delta, std::memory_order_relaxed);
+      }
+
+      /**
+       * @brief 获取全部 Reactor 的当前用量
+       */
+      size_t GetUsage() const
+      {
+        int64_t total = 0;
+        for (size_t i = 0; i < counter_count_; ++i)
+        {
+          total += counters_[i].bytes.load(std::memory_order_relaxed);
+        }
+        return total > 0 ? static_cast<size_t>(total) : 0;
+      }
+
+      Tier GetTier() const
+      {
+        size_t usage = GetUsage();
+        if (usage > limit_)
+        {
+          return Tier::kOverLimit;
+        }
+        if (usage >= reject_threshold_)
+        {
+          return Tier::kRejectSends;
+        }
+        if (usage >= pause_threshold_)
+        {
+          return Tier::kPauseReads;
+        }
+        return Tier::kNormal;
+      }
+
+      size_t GetLimit() const { return limit_; }
+
+    private:
+      struct alignas(64) Counter
+      {
+        std::atomic<int64_t> bytes{0};
+      };
+
+      size_t limit_;
+      size_t pause_threshold_;
+      size_t reject_threshold_;
+      size_t counter_count_;
+      std::unique_ptr<Counter[]> counters_;
+    };
+
+  } // namespace network
+} // namespace darwincore
+
+#endif // DARWINCORE_NETWORK_SEND_MEMORY_BUDGET_H
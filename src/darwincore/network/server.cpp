@@ -10,10 +10,17 @@
 #include <atomic>
 #include <csignal>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include <unistd.h>
 
 #include "acceptor.h"
+#include "blocking_pool.h"
 #include "connection_id_generator.h"
+#include "event_loop_group_impl.h"
+#include "reactor_balancer.h"
+#include "rate_limiter.h"
+#include "send_memory_budget.h"
 #include "reactor.h"
 #include "worker_pool.h"
 #include <darwincore/network/configuration.h>
@@ -38,7 +45,8 @@ namespace darwincore
     class Server::Impl
     {
     public:
-      Impl();
+      explicit Impl(const ServerOptions &options = ServerOptions(),
+                    std::shared_ptr<EventLoopGroup> loop_group = nullptr);
       ~Impl();
 
       // 启动接口
@@ -52,13 +60,37 @@ namespace darwincore
       bool IsRunning() const;
 
       // 数据发送
-      bool SendData(uint64_t connection_id, const uint8_t *data, size_t size);
+      bool SendData(uint64_t connection_id, const uint8_t *data, size_t size,
+                    SendPriority priority = SendPriority::kBulk);
+
+      // 统计
+      ServerStatistics GetStatistics() const;
 
       // 回调设置
       void SetOnClientConnected(Server::OnClientConnectedCallback callback);
       void SetOnMessage(Server::OnMessageCallback callback);
       void SetOnClientDisconnected(Server::OnClientDisconnectedCallback callback);
       void SetOnConnectionError(Server::OnConnectionErrorCallback callback);
+      void SetConnectionContextFactory(Server::ConnectionContextFactory factory);
+      void SetOnContextMessage(Server::OnContextMessageCallback callback);
+      void SetOnContextDisconnected(Server::OnContextDisconnectedCallback callback);
+      void SetOnContextConnectionError(Server::OnContextConnectionErrorCallback callback);
+      void SetOnSlowCallback(Server::OnSlowCallbackCallback callback);
+      void SetOnMessageBatch(Server::OnMessageBatchCallback callback);
+      void SetMessageRouter(Server::MessageFramer framer, Server::MessageRouter router);
+
+      // 连接线程任务
+      bool Post(uint64_t connection_id, Server::ConnectionTask task,
+                std::chrono::milliseconds delay);
+
+      // 阻塞任务
+      bool RunBlocking(uint64_t connection_id, Server::BlockingTask work,
+                       Server::ConnectionTask resume);
+
+      // 连接定时器
+      Server::TimerId RunTimer(uint64_t connection_id, std::chrono::milliseconds delay,
+                               std::chrono::milliseconds interval, Server::ConnectionTask task);
+      bool CancelTimer(Server::TimerId timer_id);
 
     private:
       // ============ 内部辅助方法 ============
@@ -70,7 +102,18 @@ namespace darwincore
       // 初始化组件
       bool InitializeComponents();
       bool InitializeWorkerPool();
+      bool InitializeBlockingPool();
       bool InitializeReactors();
+      bool InitializeFromGroup();
+
+      // 共享组模式：解除本 Server 的连接并等待已入队的回调执行完
+      void DetachFromGroup();
+
+      // 以错误关闭连接（分发 kError 与 kDisconnected），可从任意线程调用
+      void CloseConnection(uint64_t connection_id, int error_code);
+
+      // 共享组模式下包装投递到 WorkerPool 的任务：Server 停止后不再执行
+      WorkerPool::Task Guard(WorkerPool::Task task);
 
       // 创建 Acceptor 并启动
       bool CreateAndStartAcceptor(
@@ -79,6 +122,15 @@ namespace darwincore
 
       // 事件处理
       void OnNetworkEvent(const NetworkEvent &event);
+      void OnMessageBatch(std::vector<NetworkEvent> &events);
+
+      // 查找连接上下文（只在该连接的 Worker 线程调用）
+      void *FindContext(uint64_t connection_id);
+
+      // 执行连接的回调，超过 slow_callback_threshold 时上报
+      template <typename Fn>
+      void RunMeasured(uint64_t connection_id, Fn &&fn);
+      void ReportSlowCallback(uint64_t connection_id, std::chrono::microseconds elapsed);
 
       // 状态转换
       bool TransitionState(ServerState expected, ServerState desired);
@@ -89,12 +141,43 @@ namespace darwincore
       std::shared_ptr<WorkerPool> worker_pool_;
       std::vector<std::shared_ptr<Reactor>> reactors_;
       std::vector<std::unique_ptr<Acceptor>> acceptors_;
+      std::shared_ptr<SendMemoryBudget> send_budget_;
+      std::unique_ptr<BlockingPool> blocking_pool_;
+      std::unique_ptr<ReactorBalancer> balancer_;
+
+      // ============ 共享事件循环组 ============
+      // 组内事件回调与任务持共享锁执行（不同连接可并发），Stop 持独占锁解绑；
+      // 回调捕获 shared_ptr，Server 析构后残留在共享 WorkerPool 中的任务只会
+      // 看到 attached == false，不会再访问 Server
+      struct GroupAttachment
+      {
+        std::shared_mutex mutex;
+        bool attached = true;
+      };
+      std::shared_ptr<EventLoopGroup> loop_group_;
+      EventLoopGroup::Impl *group_{nullptr};
+      std::shared_ptr<EventLoopGroup::Impl::Endpoint> endpoint_;
+      std::shared_ptr<GroupAttachment> attachment_;
 
       // ============ 回调函数 ============
       Server::OnClientConnectedCallback on_client_connected_;
       Server::OnMessageCallback on_message_;
       Server::OnClientDisconnectedCallback on_client_disconnected_;
       Server::OnConnectionErrorCallback on_connection_error_;
+      Server::ConnectionContextFactory context_factory_;
+      Server::OnContextMessageCallback on_context_message_;
+      Server::OnContextDisconnectedCallback on_context_disconnected_;
+      Server::OnContextConnectionErrorCallback on_context_connection_error_;
+      Server::OnSlowCallbackCallback on_slow_callback_;
+      Server::OnMessageBatchCallback on_message_batch_;
+      Server::MessageFramer message_framer_;
+      Server::MessageRouter message_router_;
+
+      // ============ 连接上下文 ============
+      // 每个 Worker（弹性模式下为路由槽）一张表，下标为 WorkerPool::GetWorkerIndex(connection_id)；
+      // 同一连接的事件固定由同一 Worker 串行处理，表同一时刻只被一个线程访问，无需加锁
+      using ContextTable = std::unordered_map<uint64_t, Server::ConnectionContext>;
+      std::vector<ContextTable> worker_contexts_;
 
       // ============ 状态管理 ============
       std::atomic<ServerState> state_{ServerState::kStopped};
@@ -103,15 +186,25 @@ namespace darwincore
       // ============ 统计信息 ============
       std::atomic<uint64_t> total_connections_{0};
       std::atomic<uint64_t> active_connections_{0};
+      std::atomic<uint64_t> slow_callbacks_{0};
+      std::atomic<uint64_t> message_batches_{0};
+      std::atomic<uint64_t> batched_messages_{0};
 
       // ============ 配置 ============
+      ServerOptions options_;
       size_t reactor_count_{0};
     };
 
     // ============ 构造/析构 ============
 
-    Server::Impl::Impl()
+    Server::Impl::Impl(const ServerOptions &options, std::shared_ptr<EventLoopGroup> loop_group)
+        : loop_group_(std::move(loop_group)), options_(options)
     {
+      if (loop_group_)
+      {
+        group_ = loop_group_->impl_.get();
+      }
+
       // 全局忽略 SIGPIPE（只需设置一次）
       static std::once_flag sigpipe_flag;
       std::call_once(sigpipe_flag, []()
@@ -149,16 +242,34 @@ namespace darwincore
     {
       std::lock_guard<std::mutex> lock(state_mutex_);
 
+      if (group_)
+      {
+        return InitializeFromGroup() && InitializeBlockingPool();
+      }
+
       if (!InitializeWorkerPool())
       {
         return false;
       }
 
+      if (!InitializeBlockingPool())
+      {
+        return false;
+      }
+
       if (!InitializeReactors())
       {
         return false;
       }
 
+      // 连接迁移后 connection_id 中的 Reactor ID 不再可靠，发送改走路由表
+      if (options_.rebalance_interval.count() > 0 && reactors_.size() > 1)
+      {
+        balancer_ = std::make_unique<ReactorBalancer>(reactors_, options_.rebalance_interval,
+                                                      options_.rebalance_threshold);
+        balancer_->Start();
+      }
+
       // 设置事件回调（只设置一次）
       worker_pool_->SetEventCallback([this](const NetworkEvent &event)
                                      {
@@ -166,8 +277,24 @@ namespace darwincore
                                         << static_cast<int>(event.type)    
                                         << ", conn_id=" << event.connection_id);
         
-                                        OnNetworkEvent(event); 
+                                        RunMeasured(event.connection_id,
+                                                    [&]() { OnNetworkEvent(event); });
                                       });
+      if (on_message_batch_)
+      {
+        worker_pool_->SetBatchEventCallback([this](std::vector<NetworkEvent> &events)
+                                            { OnMessageBatch(events); });
+      }
+      if (message_router_)
+      {
+        worker_pool_->SetRouteCallback(message_framer_,
+                                       [this](const NetworkEvent &event, uint64_t &key)
+                                       { return message_router_(event.connection_id,
+                                                                event.payload, key); },
+                                       options_.max_message_size);
+        worker_pool_->SetCloseCallback([this](uint64_t connection_id, int error_code)
+                                       { CloseConnection(connection_id, error_code); });
+      }
 
       return true;
     }
@@ -182,6 +309,16 @@ namespace darwincore
       size_t worker_count = SocketConfiguration::kDefaultWorkerCount;
 
       worker_pool_ = std::make_shared<WorkerPool>(worker_count);
+      if (options_.max_workers > 0 &&
+          !worker_pool_->SetElastic(options_.min_workers, options_.max_workers,
+                                    options_.worker_grow_latency, options_.worker_idle_shrink))
+      {
+        NW_LOG_ERROR("[Server] 弹性 Worker 配置无效: max_workers=" << options_.max_workers);
+        worker_pool_.reset();
+        return false;
+      }
+      worker_count = worker_pool_->GetWorkerCount();
+      worker_contexts_.assign(worker_count, ContextTable());
 
       if (!worker_pool_->Start())
       {
@@ -194,6 +331,108 @@ namespace darwincore
       return true;
     }
 
+    bool Server::Impl::InitializeBlockingPool()
+    {
+      if (options_.blocking_threads == 0 || blocking_pool_ != nullptr)
+      {
+        return true; // 未启用或已初始化
+      }
+
+      blocking_pool_ = std::make_unique<BlockingPool>(options_.blocking_threads);
+      if (!blocking_pool_->Start())
+      {
+        NW_LOG_ERROR("[Server] BlockingPool 启动失败");
+        blocking_pool_.reset();
+        return false;
+      }
+      return true;
+    }
+
+    bool Server::Impl::InitializeFromGroup()
+    {
+      if (on_message_batch_ || message_router_)
+      {
+        NW_LOG_ERROR("[Server] 共享 EventLoopGroup 时不支持 SetOnMessageBatch/SetMessageRouter");
+        return false;
+      }
+
+      // 保护性选项不生效时调用方会误以为连接受到了限制，直接拒绝启动
+      const ServerOptions defaults;
+      if (options_.connection_ingress_limit.IsEnabled() ||
+          options_.connection_egress_limit.IsEnabled() ||
+          options_.send_buffer_budget > 0 ||
+          options_.shared_memory_transport != defaults.shared_memory_transport)
+      {
+        NW_LOG_ERROR("[Server] 共享 EventLoopGroup 时不支持连接限速、发送内存预算和共享内存传输");
+        return false;
+      }
+
+      // 其余 Reactor/Worker 级别的选项属于整个组，不随单个 Server 生效
+      if (options_.write_coalescing != defaults.write_coalescing ||
+          options_.busy_poll_spin != defaults.busy_poll_spin ||
+          options_.read_budget_bytes != defaults.read_budget_bytes ||
+          options_.read_budget_reads != defaults.read_budget_reads ||
+          options_.max_receive_size != defaults.max_receive_size ||
+          options_.send_buffer_idle_release != defaults.send_buffer_idle_release ||
+          options_.max_workers > 0 || options_.rebalance_interval.count() > 0)
+      {
+        NW_LOG_WARNING("[Server] 共享 EventLoopGroup 时 Reactor/Worker 级别的选项不生效");
+      }
+
+      if (!group_->Start())
+      {
+        NW_LOG_ERROR("[Server] EventLoopGroup 启动失败");
+        return false;
+      }
+
+      worker_pool_ = group_->GetWorkerPool();
+      reactors_ = group_->GetReactors();
+      if (!worker_pool_ || reactors_.empty())
+      {
+        NW_LOG_ERROR("[Server] EventLoopGroup 已停止");
+        worker_pool_.reset();
+        reactors_.clear();
+        return false;
+      }
+      reactor_count_ = reactors_.size();
+      worker_contexts_.assign(worker_pool_->GetWorkerCount(), ContextTable());
+
+      // 每次启动一个新的接收端：上次 Stop 解绑后残留的任务不会误入本次运行
+      attachment_ = std::make_shared<GroupAttachment>();
+      endpoint_ = std::make_shared<EventLoopGroup::Impl::Endpoint>();
+      endpoint_->concurrent = true;
+      endpoint_->sink = [this, attachment = attachment_](const NetworkEvent &event)
+      {
+        std::shared_lock<std::shared_mutex> lock(attachment->mutex);
+        if (!attachment->attached)
+        {
+          return;
+        }
+        RunMeasured(event.connection_id, [&]() { OnNetworkEvent(event); });
+      };
+
+      NW_LOG_INFO("[Server] 加入 EventLoopGroup，reactor_count=" << reactor_count_
+                                                                << ", worker_count="
+                                                                << worker_contexts_.size());
+      return true;
+    }
+
+    WorkerPool::Task Server::Impl::Guard(WorkerPool::Task task)
+    {
+      if (!attachment_)
+      {
+        return task;
+      }
+      return [attachment = attachment_, task = std::move(task)]()
+      {
+        std::shared_lock<std::shared_mutex> lock(attachment->mutex);
+        if (attachment->attached)
+        {
+          task();
+        }
+      };
+    }
+
     bool Server::Impl::InitializeReactors()
     {
       if (!reactors_.empty())
@@ -206,9 +445,26 @@ namespace darwincore
 
       NW_LOG_INFO("[Server] 准备创建 " << reactor_count_ << " 个 Reactor");
 
+      if (options_.send_buffer_budget > 0)
+      {
+        send_budget_ = std::make_shared<SendMemoryBudget>(
+            options_.send_buffer_budget, reactor_count_,
+            options_.send_budget_pause_ratio, options_.send_budget_reject_ratio);
+      }
+
       for (size_t i = 0; i < reactor_count_; ++i)
       {
         auto reactor = std::make_shared<Reactor>(i, worker_pool_);
+        reactor->SetWriteCoalescing(options_.write_coalescing);
+        reactor->SetBusyPoll(options_.busy_poll_spin);
+        reactor->SetSharedMemoryTransport(options_.shared_memory_transport);
+        reactor->SetRateLimits(options_.connection_ingress_limit,
+                               options_.connection_egress_limit);
+        reactor->SetSendMemoryBudget(send_budget_);
+        reactor->SetReadBudget(options_.read_budget_bytes, options_.read_budget_reads);
+        reactor->SetAdaptiveReceive(options_.max_receive_size);
+        reactor->SetSendBufferIdleRelease(options_.send_buffer_idle_release);
+        reactor->SetTrafficSampling(options_.rebalance_interval.count() > 0);
 
         if (!reactor->Start())
         {
@@ -251,6 +507,25 @@ namespace darwincore
 
       acceptor->SetReactors(reactor_weak_ptrs);
 
+      // 共享组：连接加入 Reactor 之前先登记路由，kConnected 事件才能交给本 Server
+      if (group_)
+      {
+        EventLoopGroup::Impl *group = group_;
+        std::shared_ptr<EventLoopGroup::Impl::Endpoint> endpoint = endpoint_;
+        acceptor->SetConnectionRegistrar(
+            [group, endpoint](uint64_t connection_id)
+            { group->Register(connection_id, endpoint); },
+            [group](uint64_t connection_id)
+            { group->Unregister(connection_id); });
+      }
+
+      // 每个监听 socket 一个共享的入站令牌桶
+      if (options_.listener_ingress_limit.IsEnabled())
+      {
+        acceptor->SetRateLimiter(
+            std::make_shared<SharedRateLimiter>(options_.listener_ingress_limit));
+      }
+
       // 执行监听
       if (!listen_func(*acceptor))
       {
@@ -391,6 +666,20 @@ namespace darwincore
       NW_LOG_DEBUG("[Server] 停止 Acceptor（" << acceptors_.size() << " 个）");
       acceptors_.clear();
 
+      if (group_)
+      {
+        DetachFromGroup();
+        state_.store(ServerState::kStopped);
+        NW_LOG_INFO("[Server] 已退出 EventLoopGroup，总连接数=" << total_connections_.load());
+        return;
+      }
+
+      // 停止负载均衡（等待进行中的迁移完成）；路由表保留到 Worker 停止，回调中仍可发送
+      if (balancer_)
+      {
+        balancer_->Stop();
+      }
+
       // 2. 停止所有 Reactor（会等待事件循环退出）
       NW_LOG_DEBUG("[Server] 停止 Reactor（" << reactors_.size() << " 个）");
       for (auto &reactor : reactors_)
@@ -401,8 +690,17 @@ namespace darwincore
         }
       }
       reactors_.clear();
+      send_budget_.reset();
+
+      // 3. 停止阻塞任务池：执行完已提交的任务，其后续回调投递给仍在运行的 WorkerPool
+      if (blocking_pool_)
+      {
+        NW_LOG_DEBUG("[Server] 停止 BlockingPool");
+        blocking_pool_->Stop();
+        blocking_pool_.reset();
+      }
 
-      // 3. 停止 WorkerPool（会等待所有任务完成）
+      // 4. 停止 WorkerPool（会等待所有任务完成）
       NW_LOG_DEBUG("[Server] 停止 WorkerPool");
       if (worker_pool_)
       {
@@ -410,16 +708,61 @@ namespace darwincore
         worker_pool_.reset();
       }
 
-      // 4. 更新状态
+      // Worker 已停止，销毁未收到断开事件的连接上下文
+      worker_contexts_.clear();
+      balancer_.reset();
+
+      // 5. 更新状态
       state_.store(ServerState::kStopped);
 
       NW_LOG_INFO("[Server] 服务器已停止，总连接数=" << total_connections_.load());
     }
 
+    void Server::Impl::DetachFromGroup()
+    {
+      // 1. 解除路由并关闭本 Server 的连接（之后这些连接的事件被组丢弃，不触发断开回调）
+      std::vector<uint64_t> connection_ids = group_->DetachEndpoint(endpoint_);
+      NW_LOG_DEBUG("[Server] 关闭组内连接（" << connection_ids.size() << " 个）");
+      for (uint64_t connection_id : connection_ids)
+      {
+        size_t reactor_id = ConnectionIdGenerator::GetReactorId(connection_id);
+        if (reactor_id < reactors_.size())
+        {
+          reactors_[reactor_id]->RemoveConnection(connection_id);
+        }
+        worker_pool_->DropConnectionTimers(connection_id);
+      }
+
+      // 2. 停止阻塞任务池，后续回调投递给组的 WorkerPool
+      if (blocking_pool_)
+      {
+        blocking_pool_->Stop();
+        blocking_pool_.reset();
+      }
+
+      // 3. 等待已入队的回调和任务执行完，再解绑（独占锁等待正在执行的回调返回）
+      if (!worker_pool_->Flush(std::chrono::seconds(5)))
+      {
+        NW_LOG_WARNING("[Server] 等待组内 Worker 超时，剩余任务将被丢弃");
+      }
+      {
+        std::unique_lock<std::shared_mutex> lock(attachment_->mutex);
+        attachment_->attached = false;
+      }
+
+      // 组内线程继续服务其他成员，只释放引用
+      endpoint_.reset();
+      attachment_.reset();
+      reactors_.clear();
+      worker_pool_.reset();
+      worker_contexts_.clear();
+      active_connections_.store(0, std::memory_order_relaxed);
+    }
+
     // ============ 数据发送 ============
 
     bool Server::Impl::SendData(uint64_t connection_id, const uint8_t *data,
-                                size_t size)
+                                size_t size, SendPriority priority)
     {
       if (!data || size == 0)
       {
@@ -439,6 +782,18 @@ namespace darwincore
         return false;
       }
 
+      // 共享组的 Reactor 上还有其他成员的连接，只向登记在本 Server 下的连接发送
+      if (group_ && !group_->IsRegistered(connection_id, endpoint_))
+      {
+        NW_LOG_WARNING("[Server::SendData] 连接不属于本服务器: conn_id=" << connection_id);
+        return false;
+      }
+
+      if (balancer_)
+      {
+        return balancer_->SendData(connection_id, data, size, priority);
+      }
+
       // 从 connection_id 中提取 reactor_id
       size_t reactor_id = ConnectionIdGenerator::GetReactorId(connection_id);
 
@@ -449,7 +804,84 @@ namespace darwincore
         return false;
       }
 
-      return reactors_[reactor_id]->SendData(connection_id, data, size);
+      return reactors_[reactor_id]->SendData(connection_id, data, size, priority);
+    }
+
+    void Server::Impl::CloseConnection(uint64_t connection_id, int error_code)
+    {
+      if (balancer_)
+      {
+        balancer_->RemoveConnection(connection_id, error_code);
+        return;
+      }
+
+      size_t reactor_id = ConnectionIdGenerator::GetReactorId(connection_id);
+      if (reactor_id < reactors_.size())
+      {
+        reactors_[reactor_id]->RemoveConnection(connection_id, error_code);
+      }
+    }
+
+    ServerStatistics Server::Impl::GetStatistics() const
+    {
+      ServerStatistics stats;
+      if (!IsRunning())
+      {
+        return stats;
+      }
+
+      for (const auto &reactor : reactors_)
+      {
+        Reactor::Statistics rs = reactor->GetStatistics();
+        stats.total_connections += rs.total_connections;
+        stats.active_connections += rs.active_connections;
+        stats.total_bytes_sent += rs.total_bytes_sent;
+        stats.total_bytes_received += rs.total_bytes_received;
+        stats.total_coalesced_sends += rs.total_coalesced_sends;
+        stats.total_shm_connections += rs.total_shm_connections;
+        stats.total_rate_limit_pauses += rs.total_rate_limit_pauses;
+        stats.send_buffer_bytes += rs.send_buffer_bytes;
+        stats.send_budget_rejects += rs.send_budget_rejects;
+        stats.send_budget_disconnects += rs.send_budget_disconnects;
+        stats.busy_poll_spin_us += rs.busy_poll_spin_us;
+        stats.busy_poll_parked_us += rs.busy_poll_parked_us;
+        stats.total_read_yields += rs.total_read_yields;
+        stats.connection_memory_bytes += rs.connection_memory_bytes;
+        stats.send_buffer_capacity_bytes += rs.send_buffer_capacity_bytes;
+        stats.send_buffer_releases += rs.send_buffer_releases;
+        stats.total_priority_bypasses += rs.total_priority_bypasses;
+      }
+      if (group_)
+      {
+        // Reactor 由组内成员共享，连接数只统计本 Server 的
+        stats.total_connections = total_connections_.load(std::memory_order_relaxed);
+        stats.active_connections = active_connections_.load(std::memory_order_relaxed);
+      }
+      if (send_budget_)
+      {
+        stats.send_budget_usage = send_budget_->GetUsage();
+      }
+      if (balancer_)
+      {
+        stats.connection_migrations = balancer_->GetMigrationCount();
+      }
+      if (worker_pool_)
+      {
+        WorkerPool::Statistics ws = worker_pool_->GetStatistics();
+        stats.worker_threads = ws.worker_threads;
+        stats.worker_scale_ups = ws.scale_ups;
+        stats.worker_scale_downs = ws.scale_downs;
+        stats.keyed_messages = ws.keyed_events;
+        stats.dropped_keyed_messages = ws.dropped_keyed_events;
+      }
+      if (blocking_pool_)
+      {
+        stats.blocking_queue_size = blocking_pool_->GetQueueSize();
+      }
+      stats.slow_callbacks = slow_callbacks_.load(std::memory_order_relaxed);
+      stats.message_batches = message_batches_.load(std::memory_order_relaxed);
+      stats.batched_messages = batched_messages_.load(std::memory_order_relaxed);
+      return stats;
     }
 
     // ============ 回调设置 ============
@@ -477,6 +909,229 @@ namespace darwincore
       on_connection_error_ = std::move(callback);
     }
 
+    void Server::Impl::SetConnectionContextFactory(
+        Server::ConnectionContextFactory factory)
+    {
+      context_factory_ = std::move(factory);
+    }
+
+    void Server::Impl::SetOnContextMessage(Server::OnContextMessageCallback callback)
+    {
+      on_context_message_ = std::move(callback);
+    }
+
+    void Server::Impl::SetOnContextDisconnected(
+        Server::OnContextDisconnectedCallback callback)
+    {
+      on_context_disconnected_ = std::move(callback);
+    }
+
+    void Server::Impl::SetOnContextConnectionError(
+        Server::OnContextConnectionErrorCallback callback)
+    {
+      on_context_connection_error_ = std::move(callback);
+    }
+
+    void Server::Impl::SetOnSlowCallback(Server::OnSlowCallbackCallback callback)
+    {
+      on_slow_callback_ = std::move(callback);
+    }
+
+    void Server::Impl::SetOnMessageBatch(Server::OnMessageBatchCallback callback)
+    {
+      if (IsRunning())
+      {
+        NW_LOG_WARNING("[Server] OnMessageBatch 必须在 Start 之前设置");
+        return;
+      }
+      on_message_batch_ = std::move(callback);
+    }
+
+    void Server::Impl::SetMessageRouter(Server::MessageFramer framer,
+                                        Server::MessageRouter router)
+    {
+      if (IsRunning())
+      {
+        NW_LOG_WARNING("[Server] MessageRouter 必须在 Start 之前设置");
+        return;
+      }
+      if (static_cast<bool>(framer) != static_cast<bool>(router))
+      {
+        NW_LOG_ERROR("[Server] MessageRouter 需要同时提供分帧函数与路由函数");
+        return;
+      }
+      message_framer_ = std::move(framer);
+      message_router_ = std::move(router);
+    }
+
+    // ============ 连接上下文 ============
+
+    void *Server::Impl::FindContext(uint64_t connection_id)
+    {
+      if (!context_factory_)
+      {
+        return nullptr;
+      }
+
+      ContextTable &contexts = worker_contexts_[worker_pool_->GetWorkerIndex(connection_id)];
+      auto it = contexts.find(connection_id);
+      return it != contexts.end() ? it->second.get() : nullptr;
+    }
+
+    // ============ 慢回调检测 ============
+
+    template <typename Fn>
+    void Server::Impl::RunMeasured(uint64_t connection_id, Fn &&fn)
+    {
+      if (options_.slow_callback_threshold.count() <= 0)
+      {
+        fn();
+        return;
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      fn();
+      auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+      if (elapsed >= options_.slow_callback_threshold)
+      {
+        ReportSlowCallback(connection_id, elapsed);
+      }
+    }
+
+    void Server::Impl::ReportSlowCallback(uint64_t connection_id,
+                                          std::chrono::microseconds elapsed)
+    {
+      slow_callbacks_.fetch_add(1, std::memory_order_relaxed);
+      NW_LOG_WARNING("[Server] 慢回调: conn_id=" << connection_id
+                     << ", elapsed_us=" << elapsed.count()
+                     << "，同一 Worker 上的其他连接被阻塞，阻塞操作应使用 RunBlocking");
+
+      if (on_slow_callback_)
+      {
+        try
+        {
+          on_slow_callback_(connection_id, elapsed);
+        }
+        catch (const std::exception &e)
+        {
+          NW_LOG_ERROR("[Server] on_slow_callback_ 异常: " << e.what());
+        }
+      }
+    }
+
+    // ============ 连接线程任务 ============
+
+    bool Server::Impl::Post(uint64_t connection_id, Server::ConnectionTask task,
+                            std::chrono::milliseconds delay)
+    {
+      if (!task)
+      {
+        NW_LOG_WARNING("[Server::Post] 无效参数");
+        return false;
+      }
+
+      if (!IsRunning() || !worker_pool_)
+      {
+        NW_LOG_WARNING("[Server::Post] 服务器未运行");
+        return false;
+      }
+
+      // 在 Worker 线程中执行时再查上下文，保证与该连接的事件处理看到同一状态
+      auto run = [this, connection_id, task = std::move(task)]()
+      {
+        RunMeasured(connection_id, [&]() { task(FindContext(connection_id)); });
+      };
+
+      if (delay.count() > 0)
+      {
+        return worker_pool_->SubmitDelayedTask(connection_id, delay, Guard(std::move(run)));
+      }
+      return worker_pool_->SubmitTask(connection_id, Guard(std::move(run)));
+    }
+
+    // ============ 阻塞任务 ============
+
+    bool Server::Impl::RunBlocking(uint64_t connection_id, Server::BlockingTask work,
+                                   Server::ConnectionTask resume)
+    {
+      if (!work)
+      {
+        NW_LOG_WARNING("[Server::RunBlocking] 无效参数");
+        return false;
+      }
+
+      if (!IsRunning() || !blocking_pool_)
+      {
+        NW_LOG_WARNING("[Server::RunBlocking] 服务器未运行或未配置 blocking_threads");
+        return false;
+      }
+
+      auto job = [this, connection_id, work = std::move(work), resume = std::move(resume)]()
+      {
+        try
+        {
+          work();
+        }
+        catch (const std::exception &e)
+        {
+          NW_LOG_ERROR("[Server::RunBlocking] 阻塞任务异常: conn_id=" << connection_id
+                                                                     << ", " << e.what());
+        }
+
+        if (!resume)
+        {
+          return;
+        }
+
+        // 直接投递给 WorkerPool：Stop() 期间（已不是 Running）提交的 work 也要能回到 Worker
+        auto run = [this, connection_id, resume]()
+        {
+          RunMeasured(connection_id, [&]() { resume(FindContext(connection_id)); });
+        };
+        if (!worker_pool_->SubmitTask(connection_id, Guard(std::move(run))))
+        {
+          NW_LOG_WARNING("[Server::RunBlocking] 后续回调入队失败: conn_id=" << connection_id);
+        }
+      };
+      return blocking_pool_->Submit(std::move(job));
+    }
+
+    // ============ 连接定时器 ============
+
+    Server::TimerId Server::Impl::RunTimer(uint64_t connection_id,
+                                           std::chrono::milliseconds delay,
+                                           std::chrono::milliseconds interval,
+                                           Server::ConnectionTask task)
+    {
+      if (!task)
+      {
+        NW_LOG_WARNING("[Server::RunTimer] 无效参数");
+        return 0;
+      }
+
+      if (!IsRunning() || !worker_pool_)
+      {
+        NW_LOG_WARNING("[Server::RunTimer] 服务器未运行");
+        return 0;
+      }
+
+      auto run = [this, connection_id, task = std::move(task)]()
+      {
+        RunMeasured(connection_id, [&]() { task(FindContext(connection_id)); });
+      };
+      return worker_pool_->ScheduleTimer(connection_id, delay, interval, Guard(std::move(run)));
+    }
+
+    bool Server::Impl::CancelTimer(Server::TimerId timer_id)
+    {
+      if (!IsRunning() || !worker_pool_)
+      {
+        return false;
+      }
+      return worker_pool_->CancelTimer(timer_id);
+    }
+
     // ============ 事件处理 ============
 
     void Server::Impl::OnNetworkEvent(const NetworkEvent &event)
@@ -494,6 +1149,23 @@ namespace darwincore
         NW_LOG_DEBUG("[Server] 新连接: conn_id=" << event.connection_id
                                                  << ", 活跃连接数=" << active_connections_.load());
 
+        if (context_factory_ && event.connection_info)
+        {
+          try
+          {
+            Server::ConnectionContext context = context_factory_(*event.connection_info);
+            if (context)
+            {
+              worker_contexts_[worker_pool_->GetWorkerIndex(event.connection_id)]
+                  [event.connection_id] = std::move(context);
+            }
+          }
+          catch (const std::exception &e)
+          {
+            NW_LOG_ERROR("[Server] context_factory_ 异常: " << e.what());
+          }
+        }
+
         if (on_client_connected_ && event.connection_info)
         {
           try
@@ -522,10 +1194,28 @@ namespace darwincore
             NW_LOG_ERROR("[Server] on_message_ 异常: " << e.what());
           }
         }
+
+        if (on_context_message_)
+        {
+          try
+          {
+            // 按 key 路由的消息不在连接的 Worker 上处理，不能访问连接上下文
+            on_context_message_(event.connection_id, event.payload,
+                                event.routing_key ? nullptr : FindContext(event.connection_id));
+          }
+          catch (const std::exception &e)
+          {
+            NW_LOG_ERROR("[Server] on_context_message_ 异常: " << e.what());
+          }
+        }
         break;
 
       case NetworkEventType::kDisconnected:
         active_connections_.fetch_sub(1, std::memory_order_relaxed);
+        if (balancer_)
+        {
+          balancer_->OnConnectionClosed(event.connection_id);
+        }
 
         NW_LOG_DEBUG("[Server] 连接断开: conn_id=" << event.connection_id
                                                    << ", 活跃连接数=" << active_connections_.load());
@@ -541,6 +1231,25 @@ namespace darwincore
             NW_LOG_ERROR("[Server] on_client_disconnected_ 异常: " << e.what());
           }
         }
+
+        if (on_context_disconnected_)
+        {
+          try
+          {
+            on_context_disconnected_(event.connection_id, FindContext(event.connection_id));
+          }
+          catch (const std::exception &e)
+          {
+            NW_LOG_ERROR("[Server] on_context_disconnected_ 异常: " << e.what());
+          }
+        }
+
+        // 断开回调全部返回后销毁上下文
+        if (context_factory_)
+        {
+          worker_contexts_[worker_pool_->GetWorkerIndex(event.connection_id)]
+              .erase(event.connection_id);
+        }
         break;
 
       case NetworkEventType::kError:
@@ -559,6 +1268,20 @@ namespace darwincore
             NW_LOG_ERROR("[Server] on_connection_error_ 异常: " << e.what());
           }
         }
+
+        if (on_context_connection_error_ && event.error)
+        {
+          try
+          {
+            on_context_connection_error_(event.connection_id, *event.error,
+                                         event.error_message,
+                                         FindContext(event.connection_id));
+          }
+          catch (const std::exception &e)
+          {
+            NW_LOG_ERROR("[Server] on_context_connection_error_ 异常: " << e.what());
+          }
+        }
         break;
 
       default:
@@ -567,10 +1290,68 @@ namespace darwincore
       }
     }
 
+    void Server::Impl::OnMessageBatch(std::vector<NetworkEvent> &events)
+    {
+      // 按连接分组（连接按首次出现的顺序），一批最多 64 个事件，线性查找即可；
+      // 按 key 路由的消息单独成组，不带连接上下文
+      std::vector<Server::ConnectionMessages> batch;
+      std::vector<bool> keyed;
+      for (NetworkEvent &event : events)
+      {
+        bool is_keyed = event.routing_key.has_value();
+        size_t index = 0;
+        while (index < batch.size() &&
+               (batch[index].connection_id != event.connection_id || keyed[index] != is_keyed))
+        {
+          ++index;
+        }
+        if (index == batch.size())
+        {
+          batch.push_back(Server::ConnectionMessages{
+              event.connection_id, is_keyed ? nullptr : FindContext(event.connection_id), {}});
+          keyed.push_back(is_keyed);
+        }
+        batch[index].messages.push_back(std::move(event.payload));
+      }
+
+      message_batches_.fetch_add(1, std::memory_order_relaxed);
+      batched_messages_.fetch_add(events.size(), std::memory_order_relaxed);
+
+      auto start = std::chrono::steady_clock::now();
+      try
+      {
+        on_message_batch_(batch);
+      }
+      catch (const std::exception &e)
+      {
+        NW_LOG_ERROR("[Server] on_message_batch_ 异常: " << e.what());
+      }
+
+      // 慢批量回调拖慢了批内的每个连接，逐个上报
+      if (options_.slow_callback_threshold.count() > 0)
+      {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        if (elapsed >= options_.slow_callback_threshold)
+        {
+          for (const auto &entry : batch)
+          {
+            ReportSlowCallback(entry.connection_id, elapsed);
+          }
+        }
+      }
+    }
+
     // ============ Server 公共接口 ============
 
     Server::Server() : impl_(std::make_unique<Impl>()) {}
 
+    Server::Server(std::shared_ptr<EventLoopGroup> loop_group, const ServerOptions &options)
+        : impl_(std::make_unique<Impl>(options, std::move(loop_group))) {}
+
+    Server::Server(const ServerOptions &options)
+        : impl_(std::make_unique<Impl>(options)) {}
+
     Server::~Server() = default;
 
     bool Server::StartIPv4(const std::string &host, uint16_t port)
@@ -603,6 +1384,17 @@ namespace darwincore
       return impl_->SendData(connection_id, data, size);
     }
 
+    bool Server::SendData(uint64_t connection_id, const uint8_t *data, size_t size,
+                          SendPriority priority)
+    {
+      return impl_->SendData(connection_id, data, size, priority);
+    }
+
+    ServerStatistics Server::GetStatistics() const
+    {
+      return impl_->GetStatistics();
+    }
+
     void Server::SetOnClientConnected(OnClientConnectedCallback callback)
     {
       impl_->SetOnClientConnected(std::move(callback));
@@ -623,5 +1415,78 @@ namespace darwincore
       impl_->SetOnConnectionError(std::move(callback));
     }
 
+    void Server::SetOnSlowCallback(OnSlowCallbackCallback callback)
+    {
+      impl_->SetOnSlowCallback(std::move(callback));
+    }
+
+    void Server::SetOnMessageBatch(OnMessageBatchCallback callback)
+    {
+      impl_->SetOnMessageBatch(std::move(callback));
+    }
+
+    void Server::SetMessageRouter(MessageFramer framer, MessageRouter router)
+    {
+      impl_->SetMessageRouter(std::move(framer), std::move(router));
+    }
+
+    void Server::SetConnectionContextFactory(ConnectionContextFactory factory)
+    {
+      impl_->SetConnectionContextFactory(std::move(factory));
+    }
+
+    void Server::SetOnContextMessage(OnContextMessageCallback callback)
+    {
+      impl_->SetOnContextMessage(std::move(callback));
+    }
+
+    void Server::SetOnContextDisconnected(OnContextDisconnectedCallback callback)
+    {
+      impl_->SetOnContextDisconnected(std::move(callback));
+    }
+
+    void Server::SetOnContextConnectionError(OnContextConnectionErrorCallback callback)
+    {
+      impl_->SetOnContextConnectionError(std::move(callback));
+    }
+
+    bool Server::Post(uint64_t connection_id, ConnectionTask task)
+    {
+      return impl_->Post(connection_id, std::move(task), std::chrono::milliseconds(0));
+    }
+
+    bool Server::PostAfter(uint64_t connection_id, std::chrono::milliseconds delay,
+                           ConnectionTask task)
+    {
+      // 延迟不足 1ms 也走时间轮，保证语义上“之后”执行
+      return impl_->Post(connection_id, std::move(task),
+                         std::max(delay, std::chrono::milliseconds(1)));
+    }
+
+    bool Server::RunBlocking(uint64_t connection_id, BlockingTask work, ConnectionTask resume)
+    {
+      return impl_->RunBlocking(connection_id, std::move(work), std::move(resume));
+    }
+
+    Server::TimerId Server::RunAfter(uint64_t connection_id, std::chrono::milliseconds delay,
+                                     ConnectionTask task)
+    {
+      return impl_->RunTimer(connection_id, delay, std::chrono::milliseconds(0),
+                             std::move(task));
+    }
+
+    Server::TimerId Server::RunEvery(uint64_t connection_id, std::chrono::milliseconds interval,
+                                     ConnectionTask task)
+    {
+      // 周期不足 1ms 按 1ms 计，避免退化为一次性定时器
+      interval = std::max(interval, std::chrono::milliseconds(1));
+      return impl_->RunTimer(connection_id, interval, interval, std::move(task));
+    }
+
+    bool Server::CancelTimer(TimerId timer_id)
+    {
+      return impl_->CancelTimer(timer_id);
+    }
+
   } // namespace network
 } // namespace darwincore
\ No newline at end of file
@@ -0,0 +1,592 @@
+//
+// DarwinCore Network 模块
+// ShmChannel 实现
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "shm_channel.h"
+#include "socket_helper.h"
+#include <darwincore/network/logger.h>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    namespace
+    {
+      /// 握手魔数（同时写在共享内存头部，用于校验）
+      constexpr char kHandshakeMagic[8] = {'D', 'C', 'S', 'H', 'M', '0', '1', '\0'};
+
+      constexpr size_t kCacheLineSize = 64;
+
+      /// 门铃上的字节：普通通知与服务端接受升级的确认
+      constexpr uint8_t kNotifySignal = 1;
+      constexpr uint8_t kAcceptSignal = 0xAC;
+
+      /// 共享内存头部（位于区域起始处）
+      struct RegionHeader
+      {
+        char magic[8];
+        uint64_t ring_capacity;
+      };
+
+      /// 握手消息（即 kHandshakeSize 字节的线上格式）
+      struct HandshakeMessage
+      {
+        char magic[8];
+        uint64_t ring_capacity;
+      };
+
+      static_assert(sizeof(HandshakeMessage) == ShmChannel::kHandshakeSize,
+                    "握手消息长度不匹配");
+
+      size_t AlignUp(size_t value, size_t alignment)
+      {
+        return (value + alignment - 1) / alignment * alignment;
+      }
+
+      size_t NormalizeCapacity(size_t capacity)
+      {
+        capacity = std::clamp(capacity, ShmChannel::kMinRingCapacity,
+                              ShmChannel::kMaxRingCapacity);
+        size_t normalized = ShmChannel::kMinRingCapacity;
+        while (normalized < capacity)
+        {
+          normalized <<= 1;
+        }
+        return normalized;
+      }
+
+      bool IsValidCapacity(uint64_t capacity)
+      {
+        return capacity >= ShmChannel::kMinRingCapacity &&
+               capacity <= ShmChannel::kMaxRingCapacity &&
+               (capacity & (capacity - 1)) == 0;
+      }
+
+      void CloseFds(const std::vector<int> &fds)
+      {
+        for (int fd : fds)
+        {
+          close(fd);
+        }
+      }
+
+      /**
+       * @brief 创建大小固定的共享内存 fd
+       *
+       * 服务端映射后如果对端把它缩小，访问映射区会触发 SIGBUS，所以大小必须
+       * 在交给服务端之前固定下来：memfd 用封印封住，POSIX 共享内存对象
+       * （macOS）只允许 ftruncate 一次。
+       */
+      int CreateFixedSizeMemory(size_t size)
+      {
+#if defined(F_ADD_SEALS)
+        int fd = memfd_create("darwincore.shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        if (fd < 0)
+        {
+          NW_LOG_WARNING("[ShmChannel] memfd_create 失败: " << strerror(errno));
+          return -1;
+        }
+        if (ftruncate(fd, static_cast<off_t>(size)) < 0 ||
+            fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) < 0)
+        {
+          NW_LOG_WARNING("[ShmChannel] 设置共享内存大小失败: " << strerror(errno));
+          close(fd);
+          return -1;
+        }
+        return fd;
+#else
+        static std::atomic<uint32_t> sequence{0};
+
+        // 名字只在 shm_open 与 shm_unlink 之间存在，之后只剩匿名 fd
+        char name[32];
+        snprintf(name, sizeof(name), "/dcshm.%d.%u", static_cast<int>(getpid()),
+                 sequence.fetch_add(1, std::memory_order_relaxed));
+
+        int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0)
+        {
+          NW_LOG_WARNING("[ShmChannel] shm_open 失败: " << strerror(errno));
+          return -1;
+        }
+        shm_unlink(name);
+
+        if (ftruncate(fd, static_cast<off_t>(size)) < 0)
+        {
+          NW_LOG_WARNING("[ShmChannel] ftruncate 失败: " << strerror(errno));
+          close(fd);
+          return -1;
+        }
+        return fd;
+#endif
+      }
+
+      /// 对端传来的共享内存 fd 大小是否已固定（未固定的一律拒绝）
+      bool IsFixedSizeMemory(int fd, const struct stat &st)
+      {
+#if defined(F_GET_SEALS)
+        (void)st;
+        int seals = fcntl(fd, F_GET_SEALS);
+        return seals >= 0 &&
+               (seals & (F_SEAL_SHRINK | F_SEAL_GROW)) == (F_SEAL_SHRINK | F_SEAL_GROW);
+#else
+        // 普通文件可以被对端随时截短；共享内存对象的大小只能设定一次
+        (void)fd;
+        return !S_ISREG(st.st_mode);
+#endif
+      }
+    } // namespace
+
+    /**
+     * @brief 单向字节环的控制块（位于共享内存中）
+     *
+     * write_pos/read_pos 为单调递增的字节计数，取模后得到环内偏移。
+     * 各字段独占缓存行，避免两个进程的写入互相干扰。
+     */
+    struct ShmChannel::Ring
+    {
+      alignas(kCacheLineSize) std::atomic<uint64_t> write_pos{0};
+      alignas(kCacheLineSize) std::atomic<uint64_t> read_pos{0};
+
+      /// 写端已发出门铃且读端尚未处理
+      alignas(kCacheLineSize) std::atomic<uint32_t> data_signaled{0};
+
+      /// 写端因环满而等待空间
+      std::atomic<uint32_t> writer_waiting{0};
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                  "共享内存中的原子变量必须是无锁的");
+
+    // ============ 创建与握手 ============
+
+    size_t ShmChannel::RegionSize(size_t ring_capacity)
+    {
+      return AlignUp(sizeof(RegionHeader), kCacheLineSize) +
+             2 * sizeof(Ring) + 2 * ring_capacity;
+    }
+
+    ShmChannel::ShmChannel(void *region, size_t region_size, size_t ring_capacity,
+                           int doorbell_fd, bool is_client)
+        : region_(region),
+          region_size_(region_size),
+          ring_capacity_(ring_capacity),
+          doorbell_fd_(doorbell_fd),
+          established_(!is_client)
+    {
+      uint8_t *base = static_cast<uint8_t *>(region_);
+      uint8_t *rings = base + AlignUp(sizeof(RegionHeader), kCacheLineSize);
+
+      // 环 0：客户端 -> 服务端；环 1：服务端 -> 客户端
+      Ring *ring0 = reinterpret_cast<Ring *>(rings);
+      Ring *ring1 = reinterpret_cast<Ring *>(rings + sizeof(Ring));
+      uint8_t *data0 = rings + 2 * sizeof(Ring);
+      uint8_t *data1 = data0 + ring_capacity_;
+
+      tx_ = is_client ? ring0 : ring1;
+      rx_ = is_client ? ring1 : ring0;
+      tx_data_ = is_client ? data0 : data1;
+      rx_data_ = is_client ? data1 : data0;
+    }
+
+    ShmChannel::~ShmChannel()
+    {
+      if (region_)
+      {
+        munmap(region_, region_size_);
+      }
+
+      for (int fd : {doorbell_fd_, memory_fd_, remote_doorbell_fd_})
+      {
+        if (fd >= 0)
+        {
+          close(fd);
+        }
+      }
+    }
+
+    std::shared_ptr<ShmChannel> ShmChannel::Create(size_t ring_capacity)
+    {
+      ring_capacity = NormalizeCapacity(ring_capacity);
+      size_t region_size = RegionSize(ring_capacity);
+
+      int memory_fd = CreateFixedSizeMemory(region_size);
+      if (memory_fd < 0)
+      {
+        return nullptr;
+      }
+
+      void *region = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                          memory_fd, 0);
+      if (region == MAP_FAILED)
+      {
+        NW_LOG_WARNING("[ShmChannel] mmap 失败: " << strerror(errno));
+        close(memory_fd);
+        return nullptr;
+      }
+
+      int doorbell[2];
+      if (socketpair(AF_UNIX, SOCK_STREAM, 0, doorbell) < 0)
+      {
+        NW_LOG_WARNING("[ShmChannel] socketpair 失败: " << strerror(errno));
+        munmap(region, region_size);
+        close(memory_fd);
+        return nullptr;
+      }
+      SocketHelper::SetNonBlocking(doorbell[0]);
+      SocketHelper::SetNonBlocking(doorbell[1]);
+
+      // 初始化头部与控制块（新建的共享内存全部为 0）
+      auto *header = new (region) RegionHeader();
+      memcpy(header->magic, kHandshakeMagic, sizeof(kHandshakeMagic));
+      header->ring_capacity = ring_capacity;
+
+      uint8_t *rings = static_cast<uint8_t *>(region) +
+                       AlignUp(sizeof(RegionHeader), kCacheLineSize);
+      new (rings) Ring();
+      new (rings + sizeof(Ring)) Ring();
+
+      std::shared_ptr<ShmChannel> channel(
+          new ShmChannel(region, region_size, ring_capacity, doorbell[0], true));
+      channel->memory_fd_ = memory_fd;
+      channel->remote_doorbell_fd_ = doorbell[1];
+      return channel;
+    }
+
+    bool ShmChannel::SendHandshake(int socket_fd)
+    {
+      if (memory_fd_ < 0 || remote_doorbell_fd_ < 0)
+      {
+        return false;
+      }
+
+      HandshakeMessage message{};
+      memcpy(message.magic, kHandshakeMagic, sizeof(kHandshakeMagic));
+      message.ring_capacity = ring_capacity_;
+
+      struct iovec iov{};
+      iov.iov_base = &message;
+      iov.iov_len = sizeof(message);
+
+      int fds[2] = {memory_fd_, remote_doorbell_fd_};
+      alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(fds))];
+      memset(control, 0, sizeof(control));
+
+      struct msghdr msg{};
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+
+      struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg->cmsg_level = SOL_SOCKET;
+      cmsg->cmsg_type = SCM_RIGHTS;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+      memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+      ssize_t ret;
+      do
+      {
+        ret = sendmsg(socket_fd, &msg, MSG_NOSIGNAL);
+      } while (ret < 0 && errno == EINTR);
+
+      // fd 已复制给对端（或发送失败），本端不再需要
+      close(memory_fd_);
+      close(remote_doorbell_fd_);
+      memory_fd_ = -1;
+      remote_doorbell_fd_ = -1;
+
+      if (ret != static_cast<ssize_t>(sizeof(message)))
+      {
+        NW_LOG_WARNING("[ShmChannel] 发送握手失败: " << strerror(errno));
+        return false;
+      }
+      return true;
+    }
+
+    ssize_t ShmChannel::ReceiveHandshake(int fd, uint8_t *buffer, size_t size,
+                                         std::shared_ptr<ShmChannel> &channel)
+    {
+      channel.reset();
+
+      // 只读取握手长度，握手之后的数据（如果是普通客户端）留给常规路径
+      struct iovec iov{};
+      iov.iov_base = buffer;
+      iov.iov_len = std::min(size, kHandshakeSize);
+
+      alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * 4)];
+      struct msghdr msg{};
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+
+      ssize_t ret = recvmsg(fd, &msg, 0);
+      if (ret <= 0)
+      {
+        return ret;
+      }
+
+      std::vector<int> fds;
+      for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+           cmsg = CMSG_NXTHDR(&msg, cmsg))
+      {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+        {
+          size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+          const int *received = reinterpret_cast<const int *>(CMSG_DATA(cmsg));
+          fds.insert(fds.end(), received, received + count);
+        }
+      }
+
+      // 没有附带 fd 的数据一律视为普通数据
+      if (fds.empty())
+      {
+        return ret;
+      }
+
+      HandshakeMessage message{};
+      bool is_handshake = ret == static_cast<ssize_t>(kHandshakeSize) &&
+                          fds.size() == 2 && !(msg.msg_flags & MSG_CTRUNC);
+      if (is_handshake)
+      {
+        memcpy(&message, buffer, sizeof(message));
+        is_handshake = memcmp(message.magic, kHandshakeMagic, sizeof(kHandshakeMagic)) == 0;
+      }
+
+      if (!is_handshake)
+      {
+        CloseFds(fds);
+        return ret;
+      }
+
+      // 到这里对端明确请求了升级，任何校验失败都只能断开连接
+      int memory_fd = fds[0];
+      int doorbell_fd = fds[1];
+      auto fail = [&](const char *reason) -> ssize_t
+      {
+        NW_LOG_ERROR("[ShmChannel] 握手无效: " << reason);
+        CloseFds(fds);
+        errno = EPROTO;
+        return -1;
+      };
+
+      if (!IsValidCapacity(message.ring_capacity))
+      {
+        return fail("环容量非法");
+      }
+
+      size_t ring_capacity = static_cast<size_t>(message.ring_capacity);
+      size_t region_size = RegionSize(ring_capacity);
+
+      // 映射之前确认大小足够且不能再被对端改变（否则缩小后访问映射区会 SIGBUS）
+      struct stat st{};
+      if (fstat(memory_fd, &st) < 0 || static_cast<size_t>(st.st_size) < region_size)
+      {
+        return fail("共享内存大小不足");
+      }
+      if (!IsFixedSizeMemory(memory_fd, st))
+      {
+        return fail("共享内存大小未固定");
+      }
+
+      void *region = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                          memory_fd, 0);
+      if (region == MAP_FAILED)
+      {
+        return fail("mmap 失败");
+      }
+
+      const auto *header = static_cast<const RegionHeader *>(region);
+      if (memcmp(header->magic, kHandshakeMagic, sizeof(kHandshakeMagic)) != 0 ||
+          header->ring_capacity != ring_capacity)
+      {
+        munmap(region, region_size);
+        return fail("共享内存头部不匹配");
+      }
+
+      // 确认升级：客户端收到之前不会往环里写数据
+      SocketHelper::SetNonBlocking(doorbell_fd);
+      uint8_t accept = kAcceptSignal;
+      if (send(doorbell_fd, &accept, 1, MSG_DONTWAIT | MSG_NOSIGNAL) != 1)
+      {
+        munmap(region, region_size);
+        return fail("发送确认失败");
+      }
+
+      close(memory_fd);
+
+      channel.reset(new ShmChannel(region, region_size, ring_capacity, doorbell_fd, false));
+      return ret;
+    }
+
+    // ============ 数据收发 ============
+
+    bool ShmChannel::Send(const uint8_t *data, size_t size)
+    {
+      // 暂存区非空时只能追加，保证顺序
+      if (!pending_.IsEmpty())
+      {
+        return pending_.Write(data, size);
+      }
+
+      size_t written = WriteRing(data, size);
+      if (written < size)
+      {
+        // 先声明等待再重试一次，避免与读端腾出空间的时机错过
+        tx_->writer_waiting.store(1);
+        written += WriteRing(data + written, size - written);
+      }
+
+      if (written < size)
+      {
+        return pending_.Write(data + written, size - written);
+      }
+      return true;
+    }
+
+    void ShmChannel::FlushPending()
+    {
+      while (!pending_.IsEmpty())
+      {
+        size_t written = WriteRing(pending_.ReadPtr(), pending_.Size());
+        if (written == 0)
+        {
+          tx_->writer_waiting.store(1);
+          written = WriteRing(pending_.ReadPtr(), pending_.Size());
+          if (written == 0)
+          {
+            return;
+          }
+        }
+        pending_.Consume(written);
+      }
+    }
+
+    size_t ShmChannel::WriteRing(const uint8_t *data, size_t size)
+    {
+      uint64_t write_pos = tx_->write_pos.load(std::memory_order_relaxed);
+      uint64_t read_pos = tx_->read_pos.load();
+
+      uint64_t used = write_pos - read_pos;
+      if (used > ring_capacity_)
+      {
+        // 对端写坏了读位置，不再写入（暂存区满后连接会被关闭）
+        return 0;
+      }
+
+      size_t count = std::min(size, static_cast<size_t>(ring_capacity_ - used));
+      if (count == 0)
+      {
+        return 0;
+      }
+
+      size_t offset = static_cast<size_t>(write_pos & (ring_capacity_ - 1));
+      size_t first = std::min(count, ring_capacity_ - offset);
+      memcpy(tx_data_ + offset, data, first);
+      memcpy(tx_data_, data + first, count - first);
+
+      tx_->write_pos.store(write_pos + count);
+
+      // 对端还没处理上一次门铃时无需再次通知
+      if (tx_->data_signaled.exchange(1) == 0)
+      {
+        Notify();
+      }
+      return count;
+    }
+
+    ssize_t ShmChannel::Receive(const DataSink &sink, size_t max_bytes)
+    {
+      uint64_t read_pos = rx_->read_pos.load(std::memory_order_relaxed);
+      uint64_t write_pos = rx_->write_pos.load();
+
+      uint64_t available = write_pos - read_pos;
+      if (available > ring_capacity_)
+      {
+        NW_LOG_ERROR("[ShmChannel] 接收环位置越界: available=" << available);
+        return -1;
+      }
+
+      size_t count = std::min(static_cast<size_t>(available), max_bytes);
+      if (count == 0)
+      {
+        return 0;
+      }
+
+      size_t offset = static_cast<size_t>(read_pos & (ring_capacity_ - 1));
+      size_t first = std::min(count, ring_capacity_ - offset);
+      sink(rx_data_ + offset, first);
+      if (count > first)
+      {
+        sink(rx_data_, count - first);
+      }
+
+      rx_->read_pos.store(read_pos + count);
+
+      // 写端在等待空间：腾出后唤醒它
+      if (rx_->writer_waiting.load() != 0 && rx_->writer_waiting.exchange(0) != 0)
+      {
+        Notify();
+      }
+      return static_cast<ssize_t>(count);
+    }
+
+    bool ShmChannel::DrainDoorbell()
+    {
+      uint8_t buffer[64];
+      while (true)
+      {
+        ssize_t ret = recv(doorbell_fd_, buffer, sizeof(buffer), 0);
+        if (ret > 0)
+        {
+          if (!established_ && memchr(buffer, kAcceptSignal, static_cast<size_t>(ret)))
+          {
+            established_ = true;
+          }
+          continue;
+        }
+        if (ret == 0)
+        {
+          return false;
+        }
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+          return false;
+        }
+        break;
+      }
+
+      // 先清除标记再读环：之后写入的数据一定会再次触发门铃
+      rx_->data_signaled.store(0);
+      return true;
+    }
+
+    void ShmChannel::Notify()
+    {
+      // 门铃 socket 写满说明对端还有未读通知，丢弃即可
+      uint8_t signal = kNotifySignal;
+      send(doorbell_fd_, &signal, 1, MSG_DONTWAIT | MSG_NOSIGNAL);
+    }
+
+  } // namespace network
+} // namespace darwincore
@@ -0,0 +1,185 @@
+//
+// DarwinCore Network 模块
+// ShmChannel - 同机 Unix Domain Socket 连接的共享内存快速通道
+//
+// 功能说明：
+//   在已建立的 UDS 连接上完成一次升级握手后，双向数据不再经过内核
+//   socket 缓冲区，而是通过共享内存中的两个 SPSC 字节环传递：
+//   - 客户端创建大小固定的共享内存（支持 memfd 封印的平台上封住大小；
+//     否则用 shm_open 后立即 shm_unlink 的匿名对象，其大小只能设定一次）
+//     和一对门铃 socket（socketpair）
+//   - 握手消息通过 SCM_RIGHTS 把共享内存 fd 和门铃的一端交给服务端
+//   - 服务端校验通过后在门铃上写入确认字节，之后才开始使用环
+//   - 环中有新数据或腾出空间时，通过门铃写入 1 字节唤醒对端事件循环
+//
+// 协议约定：
+//   - 握手必须是客户端在该连接上发送的第一段数据；收到确认之前客户端的
+//     数据仍写入原 socket，确认之后（原 socket 的待发数据写完后）改走环
+//   - 双方都先读原 socket 再读环（收到门铃时也是如此），升级前后的数据不乱序
+//   - 未开启该功能的服务端把握手当作普通数据，附带的 fd 被内核关闭；
+//     客户端看到门铃关闭而没有确认时放弃升级，继续使用普通 socket
+//
+// 设计原则：
+//   - 每个方向一个单生产者/单消费者字节环，只用原子读写位置，不加锁
+//   - 门铃按“有未处理通知时不再重复通知”的方式合并，
+//     连续写入只产生一次系统调用
+//   - 环写满时剩余数据暂存在本地 SendBuffer，对端腾出空间后再写入
+//   - 对端进程不受信任：读写位置越界视为协议错误
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_NETWORK_SHM_CHANNEL_H
+#define DARWINCORE_NETWORK_SHM_CHANNEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <sys/types.h>
+
+#include "send_buffer.h"
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    /**
+     * @brief 共享内存快速通道（一条 UDS 连接对应一个实例）
+     *
+     * 线程模型：
+     *   - 除 Create/SendHandshake 外，所有方法只能在持有连接的 Reactor 线程中调用
+     *   - 两个进程各自只写自己的发送环、只读自己的接收环
+     */
+    class ShmChannel
+    {
+    public:
+      /// 数据接收回调（指向共享内存，回调返回后数据即被释放）
+      using DataSink = std::function<void(const uint8_t *data, size_t size)>;
+
+      /// 默认每个方向的环容量（1MB）
+      static constexpr size_t kDefaultRingCapacity = 1024 * 1024;
+
+      /// 环容量下限/上限（容量会向上取整为 2 的幂）
+      static constexpr size_t kMinRingCapacity = 64 * 1024;
+      static constexpr size_t kMaxRingCapacity = 256 * 1024 * 1024;
+
+      /// 握手消息长度（8 字节魔数 + 8 字节环容量）
+      static constexpr size_t kHandshakeSize = 16;
+
+      /**
+       * @brief 创建客户端一侧的通道（共享内存 + 门铃）
+       * @param ring_capacity 每个方向的环容量
+       * @return 失败返回 nullptr（调用方应回退到普通 socket）
+       */
+      static std::shared_ptr<ShmChannel> Create(size_t ring_capacity);
+
+      /**
+       * @brief 服务端读取连接上的第一段数据，识别升级握手
+       * @param fd 连接的 socket
+       * @param buffer 接收缓冲区
+       * @param size 缓冲区大小
+       * @param channel 识别到握手时输出服务端一侧的通道
+       * @return 与 recv() 相同；channel 非空时返回的字节是握手本身，不应分发
+       */
+      static ssize_t ReceiveHandshake(int fd, uint8_t *buffer, size_t size,
+                                      std::shared_ptr<ShmChannel> &channel);
+
+      ~ShmChannel();
+
+      ShmChannel(const ShmChannel &) = delete;
+      ShmChannel &operator=(const ShmChannel &) = delete;
+
+      /**
+       * @brief 客户端发送升级握手（必须是连接上的第一段数据）
+       * @param socket_fd 已连接的 UDS socket
+       * @return 成功返回 true；失败时连接上没有写入任何数据，可以回退
+       */
+      bool SendHandshake(int socket_fd);
+
+      /**
+       * @brief 获取本端门铃 fd（注册到 kqueue 读事件）
+       */
+      int GetDoorbellFd() const { return doorbell_fd_; }
+
+      /**
+       * @brief 升级是否已生效（可以通过环发送）
+       *
+       * 服务端一侧总是 true；客户端一侧在 DrainDoorbell 读到服务端的确认后为 true。
+       */
+      bool IsEstablished() const { return established_; }
+
+      /**
+       * @brief 发送数据
+       * @return 全部写入环或暂存区返回 true；暂存区已满返回 false
+       *
+       * 暂存区非空时新数据直接追加到暂存区，保证顺序。
+       */
+      bool Send(const uint8_t *data, size_t size);
+
+      /**
+       * @brief 将暂存区数据尽量写入环（收到门铃时调用）
+       */
+      void FlushPending();
+
+      /**
+       * @brief 获取尚未写入环的暂存字节数
+       */
+      size_t GetPendingBytes() const { return pending_.Size(); }
+
+      /**
+       * @brief 读取接收环中的数据
+       * @param sink 数据回调（可能被调用多次，每次一段连续内存）
+       * @param max_bytes 本次最多读取的字节数
+       * @return 读取的字节数；-1 表示对端写坏了环（应关闭连接）
+       */
+      ssize_t Receive(const DataSink &sink, size_t max_bytes);
+
+      /**
+       * @brief 清空门铃并重新允许对端通知（在 Receive 之前调用）
+       * @return 对端已关闭门铃返回 false；此时 IsEstablished() 仍为 false
+       *         说明服务端没有接受升级，应放弃通道继续使用普通 socket
+       */
+      bool DrainDoorbell();
+
+      /**
+       * @brief 获取环容量
+       */
+      size_t GetRingCapacity() const { return ring_capacity_; }
+
+    private:
+      struct Ring;
+
+      ShmChannel(void *region, size_t region_size, size_t ring_capacity,
+                 int doorbell_fd, bool is_client);
+
+      static size_t RegionSize(size_t ring_capacity);
+
+      size_t WriteRing(const uint8_t *data, size_t size);
+      void Notify();
+
+      void *region_{nullptr};
+      size_t region_size_{0};
+      size_t ring_capacity_{0};
+
+      Ring *tx_{nullptr};
+      Ring *rx_{nullptr};
+      uint8_t *tx_data_{nullptr};
+      uint8_t *rx_data_{nullptr};
+
+      int doorbell_fd_{-1};
+      bool established_{false};
+
+      // 仅客户端在握手前持有：待发送给服务端的共享内存 fd 与门铃另一端
+      int memory_fd_{-1};
+      int remote_doorbell_fd_{-1};
+
+      SendBuffer pending_;
+    };
+
+  } // namespace network
+} // namespace darwincore
+
+#endif // DARWINCORE_NETWORK_SHM_CHANNEL_H
@@ -241,6 +241,27 @@ namespace darwincore
       return is_mapped;
     }
 
+    CompactAddress SocketHelper::CompactPeerAddress(const sockaddr_storage &addr)
+    {
+      CompactAddress compact;
+      compact.family = static_cast<uint8_t>(addr.ss_family);
+
+      if (addr.ss_family == AF_INET)
+      {
+        const auto *addr4 = reinterpret_cast<const sockaddr_in *>(&addr);
+        compact.port = ntohs(addr4->sin_port);
+        memcpy(compact.address, &addr4->sin_addr, sizeof(addr4->sin_addr));
+      }
+      else if (addr.ss_family == AF_INET6)
+      {
+        const auto *addr6 = reinterpret_cast<const sockaddr_in6 *>(&addr);
+        compact.port = ntohs(addr6->sin6_port);
+        memcpy(compact.address, &addr6->sin6_addr, sizeof(addr6->sin6_addr));
+      }
+
+      return compact;
+    }
+
     bool SocketHelper::SetUnixDomainAddress(const std::string &path,
                                             sockaddr_un *addr)
     {
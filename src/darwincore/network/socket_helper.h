@@ -24,6 +24,19 @@ namespace darwincore
   namespace network
   {
 
+    /**
+     * @brief 紧凑的对端地址（20 字节，替代 128 字节的 sockaddr_storage）
+     *
+     * 只保存地址族、端口和 IPv4/IPv6 地址；Unix Domain Socket 只保存地址族
+     * （服务端接受的 UDS 连接对端通常没有路径）。
+     */
+    struct CompactAddress
+    {
+      uint8_t family{0};      ///< AF_INET / AF_INET6 / AF_UNIX
+      uint16_t port{0};       ///< 端口（主机字节序）
+      uint8_t address[16]{};  ///< IPv4 使用前 4 字节
+    };
+
     /**
      * @brief Socket 辅助函数类
      *
@@ -117,6 +130,13 @@ namespace darwincore
        */
       static bool IsIPv4MappedIPv6(const sockaddr_storage &addr);
 
+      /**
+       * @brief 压缩对端地址
+       * @param addr Socket 地址
+       * @return 紧凑地址（UDS 地址只保留地址族）
+       */
+      static CompactAddress CompactPeerAddress(const sockaddr_storage &addr);
+
       // ==================== Unix Domain Socket 特殊处理 ====================
 
       /**
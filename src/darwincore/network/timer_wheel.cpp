@@ -0,0 +1,218 @@
+//
+// DarwinCore Network 模块
+// TimerWheel 实现
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include "timer_wheel.h"
+
+#include <algorithm>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    // ============ TimerWheel ============
+
+    TimerWheel::TimerWheel(std::chrono::milliseconds tick, size_t slot_count)
+        : tick_(std::max(tick, std::chrono::milliseconds(1))),
+          slots_(std::max<size_t>(slot_count, 1)),
+          last_tick_(Clock::now()) {}
+
+    TimerWheel::TimerId TimerWheel::Schedule(std::chrono::milliseconds delay,
+                                             Callback callback)
+    {
+      Clock::time_point now = Clock::now();
+
+      // 空闲时时间轮不推进，重新对齐起点，避免补转大量空槽
+      if (index_.empty())
+      {
+        last_tick_ = now;
+      }
+
+      // 相对 last_tick_ 计算需要经过的 tick 数（向上取整，保证不会提前触发）
+      auto deadline = now + std::max(delay, std::chrono::milliseconds(0));
+      auto span = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - last_tick_);
+      uint64_t ticks = static_cast<uint64_t>((span.count() + tick_.count() - 1) / tick_.count());
+      ticks = std::max<uint64_t>(ticks, 1);
+
+      size_t slot = (current_slot_ + ticks) % slots_.size();
+      TimerId id = next_id_++;
+
+      Slot &target = slots_[slot];
+      target.push_back(Entry{id, (ticks - 1) / slots_.size(), std::move(callback)});
+      index_.emplace(id, Location{slot, std::prev(target.end())});
+      return id;
+    }
+
+    bool TimerWheel::Cancel(TimerId id)
+    {
+      auto it = index_.find(id);
+      if (it == index_.end())
+      {
+        return false;
+      }
+
+      slots_[it->second.slot].erase(it->second.it);
+      index_.erase(it);
+      return true;
+    }
+
+    void TimerWheel::Advance(Clock::time_point now, std::vector<Callback> &expired)
+    {
+      if (index_.empty())
+      {
+        last_tick_ = now;
+        return;
+      }
+
+      while (last_tick_ + tick_ <= now)
+      {
+        last_tick_ += tick_;
+        current_slot_ = (current_slot_ + 1) % slots_.size();
+
+        Slot &slot = slots_[current_slot_];
+        for (auto it = slot.begin(); it != slot.end();)
+        {
+          if (it->rounds > 0)
+          {
+            --it->rounds;
+            ++it;
+            continue;
+          }
+
+          expired.push_back(std::move(it->callback));
+          index_.erase(it->id);
+          it = slot.erase(it);
+        }
+
+        if (index_.empty())
+        {
+          last_tick_ = now;
+          break;
+        }
+      }
+    }
+
+    std::chrono::milliseconds TimerWheel::GetTimeUntilNextTick(Clock::time_point now) const
+    {
+      auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+          last_tick_ + tick_ - now);
+      return std::max(remaining, std::chrono::milliseconds(0));
+    }
+
+    // ============ TimerService ============
+
+    TimerService::TimerService(std::chrono::milliseconds tick)
+        : state_(std::make_shared<State>(tick))
+    {
+      thread_ = std::thread(&TimerService::Run, state_);
+    }
+
+    TimerService::~TimerService()
+    {
+      {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->stopping = true;
+      }
+      state_->cv.notify_all();
+
+      if (!thread_.joinable())
+      {
+        return;
+      }
+
+      // 最后一个引用可能在定时回调中释放，此时不能 join 自身
+      if (thread_.get_id() == std::this_thread::get_id())
+      {
+        thread_.detach();
+      }
+      else
+      {
+        thread_.join();
+      }
+    }
+
+    std::shared_ptr<TimerService> TimerService::Shared()
+    {
+      static std::mutex mutex;
+      static std::weak_ptr<TimerService> instance;
+
+      std::lock_guard<std::mutex> lock(mutex);
+      auto service = instance.lock();
+      if (!service)
+      {
+        service = std::make_shared<TimerService>();
+        instance = service;
+      }
+      return service;
+    }
+
+    TimerService::TimerId TimerService::Schedule(std::chrono::milliseconds delay,
+                                                 Callback callback)
+    {
+      TimerId id;
+      bool was_empty;
+      {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        was_empty = state_->wheel.Empty();
+        id = state_->wheel.Schedule(delay, std::move(callback));
+      }
+
+      // 空闲时线程无限等待，需要唤醒开始计时
+      if (was_empty)
+      {
+        state_->cv.notify_one();
+      }
+      return id;
+    }
+
+    bool TimerService::Cancel(TimerId id)
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      return state_->wheel.Cancel(id);
+    }
+
+    size_t TimerService::Size() const
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      return state_->wheel.Size();
+    }
+
+    void TimerService::Run(std::shared_ptr<State> state)
+    {
+      std::vector<Callback> expired;
+
+      std::unique_lock<std::mutex> lock(state->mutex);
+      while (!state->stopping)
+      {
+        if (state->wheel.Empty())
+        {
+          state->cv.wait(lock, [&state]
+                         { return state->stopping || !state->wheel.Empty(); });
+          continue;
+        }
+
+        state->cv.wait_for(lock, state->wheel.GetTimeUntilNextTick(TimerWheel::Clock::now()));
+        state->wheel.Advance(TimerWheel::Clock::now(), expired);
+
+        if (expired.empty())
+        {
+          continue;
+        }
+
+        // 在锁外执行回调，允许回调中再次 Schedule/Cancel
+        lock.unlock();
+        for (auto &callback : expired)
+        {
+          callback();
+        }
+        expired.clear();
+        lock.lock();
+      }
+    }
+
+  } // namespace network
+} // namespace darwincore
@@ -0,0 +1,178 @@
+//
+// DarwinCore Network 模块
+// TimerWheel - 哈希时间轮
+//
+// 功能说明：
+//   以固定精度（tick）管理大量定时器，Schedule/Cancel 均为 O(1)。
+//   超时时间超过一圈的定时器通过 rounds 计数延后触发。
+//
+// 设计原则：
+//   - TimerWheel 本身不加锁，由持有者保证单线程访问
+//   - Advance() 只收集到期回调，由调用方在锁外执行
+//   - TimerService 提供带独立线程的线程安全版本，
+//     多个组件共享一个线程处理截止时间，而不是每个请求阻塞一个线程
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_NETWORK_TIMER_WHEEL_H
+#define DARWINCORE_NETWORK_TIMER_WHEEL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    /**
+     * @brief 哈希时间轮（非线程安全）
+     *
+     * 性能特性：
+     *   - Schedule(): O(1)
+     *   - Cancel(): O(1)（通过 id 索引直接定位槽内节点）
+     *   - Advance(): O(经过的槽数 + 槽内定时器数)
+     *
+     * 精度：
+     *   定时器最多晚一个 tick 触发，不会提前触发。
+     */
+    class TimerWheel
+    {
+    public:
+      using TimerId = uint64_t;
+      using Callback = std::function<void()>;
+      using Clock = std::chrono::steady_clock;
+
+      /// 默认精度 10ms，512 个槽（一圈约 5 秒）
+      static constexpr std::chrono::milliseconds kDefaultTick{10};
+      static constexpr size_t kDefaultSlotCount = 512;
+
+      /**
+       * @brief 构造时间轮
+       * @param tick 每个槽代表的时间跨度
+       * @param slot_count 槽数量
+       */
+      explicit TimerWheel(std::chrono::milliseconds tick = kDefaultTick,
+                          size_t slot_count = kDefaultSlotCount);
+
+      TimerWheel(const TimerWheel &) = delete;
+      TimerWheel &operator=(const TimerWheel &) = delete;
+
+      /**
+       * @brief 添加定时器
+       * @param delay 延迟时间（不足一个 tick 按一个 tick 计算）
+       * @param callback 到期回调
+       * @return 定时器 ID（从 1 开始，0 表示无效）
+       */
+      TimerId Schedule(std::chrono::milliseconds delay, Callback callback);
+
+      /**
+       * @brief 取消定时器
+       * @return 定时器存在且尚未触发返回 true
+       */
+      bool Cancel(TimerId id);
+
+      /**
+       * @brief 推进时间轮到指定时刻
+       * @param now 当前时间
+       * @param expired 输出：到期的回调（由调用方执行）
+       */
+      void Advance(Clock::time_point now, std::vector<Callback> &expired);
+
+      /**
+       * @brief 获取距离下一个 tick 的时间（用于计算等待超时）
+       */
+      std::chrono::milliseconds GetTimeUntilNextTick(Clock::time_point now) const;
+
+      /// 当前挂起的定时器数量
+      size_t Size() const { return index_.size(); }
+
+      /// 是否没有挂起的定时器
+      bool Empty() const { return index_.empty(); }
+
+      /// 时间轮精度
+      std::chrono::milliseconds GetTick() const { return tick_; }
+
+    private:
+      struct Entry
+      {
+        TimerId id;
+        uint64_t rounds;     ///< 还需要转过的整圈数
+        Callback callback;
+      };
+
+      using Slot = std::list<Entry>;
+
+      struct Location
+      {
+        size_t slot;
+        Slot::iterator it;
+      };
+
+      std::chrono::milliseconds tick_;
+      std::vector<Slot> slots_;
+      std::unordered_map<TimerId, Location> index_;
+
+      size_t current_slot_ = 0;
+      Clock::time_point last_tick_;
+      TimerId next_id_ = 1;
+    };
+
+    /**
+     * @brief 共享定时线程（线程安全）
+     *
+     * 一个后台线程驱动一个 TimerWheel，回调在该线程中执行。
+     * 通过 Shared() 获取进程内共享实例，最后一个使用者释放后线程退出。
+     *
+     * 注意：回调中不要执行耗时操作，否则会推迟其他定时器。
+     */
+    class TimerService
+    {
+    public:
+      using TimerId = TimerWheel::TimerId;
+      using Callback = TimerWheel::Callback;
+
+      explicit TimerService(std::chrono::milliseconds tick = TimerWheel::kDefaultTick);
+      ~TimerService();
+
+      TimerService(const TimerService &) = delete;
+      TimerService &operator=(const TimerService &) = delete;
+
+      /// 获取进程内共享实例（按需创建）
+      static std::shared_ptr<TimerService> Shared();
+
+      TimerId Schedule(std::chrono::milliseconds delay, Callback callback);
+      bool Cancel(TimerId id);
+      size_t Size() const;
+
+    private:
+      /// 线程与 TimerService 共享的状态（回调中释放最后一个引用时线程仍可安全退出）
+      struct State
+      {
+        explicit State(std::chrono::milliseconds tick) : wheel(tick) {}
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        TimerWheel wheel;
+        bool stopping = false;
+      };
+
+      static void Run(std::shared_ptr<State> state);
+
+      std::shared_ptr<State> state_;
+      std::thread thread_;
+    };
+
+  } // namespace network
+} // namespace darwincore
+
+#endif // DARWINCORE_NETWORK_TIMER_WHEEL_H
@@ -0,0 +1,332 @@
+//
+// DarwinCore Network 模块
+// UdpServer / UdpClient 实现
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <cstring>
+#include <errno.h>
+#include <mutex>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "datagram_reactor.h"
+#include "socket_helper.h"
+#include <darwincore/network/configuration.h>
+#include <darwincore/network/logger.h>
+#include <darwincore/network/udp.h>
+
+namespace darwincore
+{
+  namespace network
+  {
+
+    namespace
+    {
+      /**
+       * @brief 创建非阻塞 UDP socket 并绑定或连接到指定地址
+       * @param bind_address true 表示 bind（服务端），false 表示 connect（客户端）
+       * @return 成功返回 fd，失败返回 -1
+       */
+      int OpenDatagramSocket(const std::string &host, uint16_t port, SocketProtocol protocol,
+                             const UdpOptions &options, bool bind_address)
+      {
+        sockaddr_storage addr;
+        if (!SocketHelper::ResolveAddress(host, port, protocol, &addr))
+        {
+          NW_LOG_ERROR("[UDP] 地址解析失败: " << host << ":" << port);
+          return -1;
+        }
+
+        int family = protocol == SocketProtocol::kIPv6 ? AF_INET6 : AF_INET;
+        int fd = socket(family, SOCK_DGRAM, 0);
+        if (fd < 0)
+        {
+          NW_LOG_ERROR("[UDP] 创建 socket 失败: " << strerror(errno));
+          return -1;
+        }
+
+        int enable = 1;
+        SocketHelper::SetSocketOption(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        if (family == AF_INET6)
+        {
+          SocketHelper::SetSocketOption(fd, IPPROTO_IPV6, IPV6_V6ONLY, &enable, sizeof(enable));
+        }
+        if (options.socket_receive_buffer > 0)
+        {
+          // 高包量场景下默认的接收缓冲区很快被填满，失败时沿用系统值
+          SocketHelper::SetSocketOption(fd, SOL_SOCKET, SO_RCVBUF,
+                                        &options.socket_receive_buffer,
+                                        sizeof(options.socket_receive_buffer));
+        }
+
+        socklen_t addr_len = family == AF_INET6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in);
+        int result = bind_address
+                         ? bind(fd, reinterpret_cast<sockaddr *>(&addr), addr_len)
+                         : connect(fd, reinterpret_cast<sockaddr *>(&addr), addr_len);
+        if (result < 0)
+        {
+          NW_LOG_ERROR("[UDP] " << (bind_address ? "bind" : "connect") << " 失败: "
+                                << host << ":" << port << ", " << strerror(errno));
+          close(fd);
+          return -1;
+        }
+
+        if (!SocketHelper::SetNonBlocking(fd))
+        {
+          close(fd);
+          return -1;
+        }
+
+        return fd;
+      }
+    } // namespace
+
+    // ========== DatagramPeer ==========
+
+    std::string DatagramPeer::GetAddress() const
+    {
+      return SocketHelper::AddressToString(address);
+    }
+
+    uint16_t DatagramPeer::GetPort() const
+    {
+      uint16_t port = 0;
+      SocketHelper::AddressToString(address, &port);
+      return port;
+    }
+
+    // ========== UdpServer ==========
+
+    class UdpServer::Impl
+    {
+    public:
+      explicit Impl(const UdpOptions &options) : options_(options) {}
+
+      ~Impl() { Stop(); }
+
+      bool Start(const std::string &host, uint16_t port, SocketProtocol protocol)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (reactor_)
+        {
+          NW_LOG_WARNING("[UdpServer] 已经启动");
+          return false;
+        }
+
+        int fd = OpenDatagramSocket(host, port, protocol, options_, true);
+        if (fd < 0)
+        {
+          return false;
+        }
+
+        auto reactor = std::make_unique<DatagramReactor>(fd, options_, on_datagram_);
+        if (!reactor->Start())
+        {
+          return false;
+        }
+
+        sockaddr_storage local;
+        socklen_t local_len = sizeof(local);
+        if (getsockname(fd, reinterpret_cast<sockaddr *>(&local), &local_len) == 0)
+        {
+          SocketHelper::AddressToString(local, &local_port_);
+        }
+
+        reactor_ = std::move(reactor);
+        active_.store(reactor_.get(), std::memory_order_release);
+        NW_LOG_INFO("[UdpServer] 监听 " << host << ":" << local_port_);
+        return true;
+      }
+
+      void Stop()
+      {
+        std::unique_ptr<DatagramReactor> reactor;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          active_.store(nullptr, std::memory_order_release);
+          reactor = std::move(reactor_);
+          local_port_ = 0;
+        }
+        // 在锁外停止，回调中调用 SendTo 不会死锁
+        reactor.reset();
+      }
+
+      UdpOptions options_;
+      UdpServer::OnDatagramCallback on_datagram_;
+
+      std::mutex mutex_;
+      std::unique_ptr<DatagramReactor> reactor_;
+      uint16_t local_port_{0};
+
+      // 发送路径无锁读取；Stop 先清空再销毁，回调线程中的发送总是安全的
+      std::atomic<DatagramReactor *> active_{nullptr};
+    };
+
+    UdpServer::UdpServer() : UdpServer(UdpOptions()) {}
+
+    UdpServer::UdpServer(const UdpOptions &options) : impl_(std::make_unique<Impl>(options)) {}
+
+    UdpServer::~UdpServer() = default;
+
+    bool UdpServer::StartIPv4(const std::string &host, uint16_t port)
+    {
+      return impl_->Start(host, port, SocketProtocol::kIPv4);
+    }
+
+    bool UdpServer::StartIPv6(const std::string &host, uint16_t port)
+    {
+      return impl_->Start(host, port, SocketProtocol::kIPv6);
+    }
+
+    void UdpServer::Stop() { impl_->Stop(); }
+
+    bool UdpServer::SendTo(const DatagramPeer &peer, const uint8_t *data, size_t size)
+    {
+      DatagramReactor *reactor = impl_->active_.load(std::memory_order_acquire);
+      if (!reactor)
+      {
+        errno = ENOTCONN;
+        return false;
+      }
+      return reactor->SendTo(&peer, data, size);
+    }
+
+    size_t UdpServer::SendBatch(const std::vector<OutgoingDatagram> &datagrams)
+    {
+      DatagramReactor *reactor = impl_->active_.load(std::memory_order_acquire);
+      return reactor ? reactor->SendBatch(datagrams, true) : 0;
+    }
+
+    void UdpServer::SetOnDatagram(OnDatagramCallback callback)
+    {
+      impl_->on_datagram_ = std::move(callback);
+    }
+
+    uint16_t UdpServer::GetLocalPort() const
+    {
+      std::lock_guard<std::mutex> lock(impl_->mutex_);
+      return impl_->local_port_;
+    }
+
+    UdpStatistics UdpServer::GetStatistics() const
+    {
+      std::lock_guard<std::mutex> lock(impl_->mutex_);
+      return impl_->reactor_ ? impl_->reactor_->GetStatistics() : UdpStatistics();
+    }
+
+    // ========== UdpClient ==========
+
+    class UdpClient::Impl
+    {
+    public:
+      explicit Impl(const UdpOptions &options) : options_(options) {}
+
+      ~Impl() { Close(); }
+
+      bool Connect(const std::string &host, uint16_t port, SocketProtocol protocol)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (reactor_)
+        {
+          NW_LOG_WARNING("[UdpClient] 已经连接");
+          return false;
+        }
+
+        int fd = OpenDatagramSocket(host, port, protocol, options_, false);
+        if (fd < 0)
+        {
+          return false;
+        }
+
+        // 已连接 socket 只会收到对端的数据报，回调无需地址
+        auto callback = on_datagram_;
+        auto reactor = std::make_unique<DatagramReactor>(
+            fd, options_,
+            [callback](const DatagramPeer &, const uint8_t *data, size_t size)
+            {
+              if (callback)
+              {
+                callback(data, size);
+              }
+            });
+        if (!reactor->Start())
+        {
+          return false;
+        }
+
+        reactor_ = std::move(reactor);
+        active_.store(reactor_.get(), std::memory_order_release);
+        return true;
+      }
+
+      void Close()
+      {
+        std::unique_ptr<DatagramReactor> reactor;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          active_.store(nullptr, std::memory_order_release);
+          reactor = std::move(reactor_);
+        }
+        reactor.reset();
+      }
+
+      UdpOptions options_;
+      UdpClient::OnDatagramCallback on_datagram_;
+
+      std::mutex mutex_;
+      std::unique_ptr<DatagramReactor> reactor_;
+      std::atomic<DatagramReactor *> active_{nullptr};
+    };
+
+    UdpClient::UdpClient() : UdpClient(UdpOptions()) {}
+
+    UdpClient::UdpClient(const UdpOptions &options) : impl_(std::make_unique<Impl>(options)) {}
+
+    UdpClient::~UdpClient() = default;
+
+    bool UdpClient::ConnectIPv4(const std::string &host, uint16_t port)
+    {
+      return impl_->Connect(host, port, SocketProtocol::kIPv4);
+    }
+
+    bool UdpClient::ConnectIPv6(const std::string &host, uint16_t port)
+    {
+      return impl_->Connect(host, port, SocketProtocol::kIPv6);
+    }
+
+    void UdpClient::Close() { impl_->Close(); }
+
+    bool UdpClient::Send(const uint8_t *data, size_t size)
+    {
+      DatagramReactor *reactor = impl_->active_.load(std::memory_order_acquire);
+      if (!reactor)
+      {
+        errno = ENOTCONN;
+        return false;
+      }
+      return reactor->SendTo(nullptr, data, size);
+    }
+
+    size_t UdpClient::SendBatch(const std::vector<OutgoingDatagram> &datagrams)
+    {
+      DatagramReactor *reactor = impl_->active_.load(std::memory_order_acquire);
+      return reactor ? reactor->SendBatch(datagrams, false) : 0;
+    }
+
+    void UdpClient::SetOnDatagram(OnDatagramCallback callback)
+    {
+      impl_->on_datagram_ = std::move(callback);
+    }
+
+    UdpStatistics UdpClient::GetStatistics() const
+    {
+      std::lock_guard<std::mutex> lock(impl_->mutex_);
+      return impl_->reactor_ ? impl_->reactor_->GetStatistics() : UdpStatistics();
+    }
+
+  } // namespace network
+} // namespace darwincore
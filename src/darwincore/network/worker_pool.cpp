@@ -4,13 +4,15 @@
 //
 // 功能说明：
 //   实现工作线程池，用于处理网络事件和执行业务逻辑回调。
-//   支持背压控制和非阻塞事件提交。
+//   支持背压控制和非阻塞事件提交；弹性模式下按排队延迟增减线程。
 //
 // 作者: DarwinCore Network 团队
 // 日期: 2026
 
 #include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
 
 #include "worker_pool.h"
 #include <darwincore/network/configuration.h>
@@ -22,6 +24,31 @@ namespace darwincore
   namespace network
   {
 
+    namespace
+    {
+      /// 定时器 ID 低位存放 Worker 索引，CancelTimer 据此找到所属 Worker
+      constexpr int kTimerWorkerBits = 16;
+      constexpr uint64_t kTimerWorkerMask = (uint64_t(1) << kTimerWorkerBits) - 1;
+
+      /// 当前线程所属的 WorkerPool 与 Worker 索引（用于判断是否可同步取消）
+      thread_local const void *tls_current_pool = nullptr;
+      thread_local int tls_current_worker = -1;
+
+      /// 弹性模式：线程一次最多连续处理同一个槽的元素数，之后把槽交还就绪队列
+      constexpr size_t kSlotBatchSize = 64;
+
+      /// 批量模式：一批最多交付的数据事件数
+      constexpr size_t kMaxBatchEvents = 64;
+
+      /// 弹性模式：两次扩容之间的最短间隔（新线程开始领取槽之前不重复扩容）
+      constexpr auto kGrowCooldown = std::chrono::milliseconds(10);
+
+      int64_t ToNanoseconds(std::chrono::steady_clock::time_point time)
+      {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+      }
+    } // namespace
+
     WorkerPool::WorkerPool(size_t worker_count, size_t max_queue_size)
         : worker_count_(worker_count), max_queue_size_(max_queue_size),
           is_running_(false)
@@ -34,15 +61,58 @@ namespace darwincore
       event_queues_.resize(worker_count_);
       for (auto &queue : event_queues_)
       {
-        queue = std::make_unique<ConcurrentQueue<NetworkEvent>>(max_queue_size_);
+        queue = std::make_unique<ConcurrentQueue<WorkItem>>(max_queue_size_);
       }
 
+      worker_timers_.resize(worker_count_);
+      for (auto &timers : worker_timers_)
+      {
+        timers = std::make_unique<WorkerTimers>();
+      }
+      partial_messages_.resize(worker_count_);
+      closing_connections_.resize(worker_count_);
+
       NW_LOG_DEBUG("[WorkerPool] 构造: worker_count=" << worker_count_
                                                       << ", max_queue_size=" << max_queue_size_);
     }
 
     WorkerPool::~WorkerPool() { Stop(); }
 
+    bool WorkerPool::SetElastic(size_t min_workers, size_t max_workers,
+                                std::chrono::microseconds grow_latency,
+                                std::chrono::milliseconds idle_shrink)
+    {
+      if (is_running_ || max_workers == 0 || max_workers > kTimerWorkerMask)
+      {
+        return false;
+      }
+
+      elastic_ = true;
+      worker_count_ = max_workers;
+      min_workers_ = std::min(std::max<size_t>(min_workers, 1), max_workers);
+      grow_latency_ = grow_latency;
+      idle_shrink_ = idle_shrink;
+
+      // 槽数等于线程上限：每个槽的队列、时间轮与调度状态
+      event_queues_.resize(worker_count_);
+      worker_timers_.resize(worker_count_);
+      slot_states_.resize(worker_count_);
+      partial_messages_.resize(worker_count_);
+      closing_connections_.resize(worker_count_);
+      for (size_t slot = 0; slot < worker_count_; ++slot)
+      {
+        event_queues_[slot] = std::make_unique<ConcurrentQueue<WorkItem>>(max_queue_size_);
+        worker_timers_[slot] = std::make_unique<WorkerTimers>();
+        slot_states_[slot] = std::make_unique<SlotState>();
+      }
+
+      NW_LOG_DEBUG("[WorkerPool] 弹性模式: min_workers=" << min_workers_
+                   << ", max_workers=" << worker_count_
+                   << ", grow_latency_us=" << grow_latency_.count()
+                   << ", idle_shrink_ms=" << idle_shrink_.count());
+      return true;
+    }
+
     bool WorkerPool::Start()
     {
       if (is_running_)
@@ -51,6 +121,17 @@ namespace darwincore
       }
 
       is_running_ = true;
+      if (elastic_)
+      {
+        for (size_t i = 0; i < min_workers_; ++i)
+        {
+          SpawnElasticWorker(false);
+        }
+        NW_LOG_INFO("[WorkerPool] 启动（弹性）: " << min_workers_ << "~" << worker_count_
+                                                 << " 个工作线程");
+        return true;
+      }
+
       for (size_t i = 0; i < worker_count_; ++i)
       {
         worker_threads_.emplace_back(&WorkerPool::WorkerLoop, this, i);
@@ -75,6 +156,29 @@ namespace darwincore
         queue->NotifyStop();
       }
 
+      if (elastic_)
+      {
+        ready_slots_.NotifyStop();
+
+        std::vector<std::unique_ptr<ElasticWorker>> workers;
+        {
+          std::lock_guard<std::mutex> lock(scale_mutex_);
+          workers.swap(elastic_workers_);
+        }
+        for (auto &worker : workers)
+        {
+          if (worker->thread.joinable())
+          {
+            worker->thread.join();
+          }
+        }
+        active_workers_ = 0;
+
+        ResetSlots();
+        NW_LOG_INFO("[WorkerPool] 停止");
+        return;
+      }
+
       for (auto &worker_thread : worker_threads_)
       {
         if (worker_thread.joinable())
@@ -88,14 +192,26 @@ namespace darwincore
       NW_LOG_INFO("[WorkerPool] 停止");
     }
 
+    size_t WorkerPool::GetKeyWorkerIndex(uint64_t key) const
+    {
+      // splitmix64 的终混函数
+      key ^= key >> 30;
+      key *= 0xbf58476d1ce4e5b9ULL;
+      key ^= key >> 27;
+      key *= 0x94d049bb133111ebULL;
+      key ^= key >> 31;
+      return key % worker_count_;
+    }
+
     void WorkerPool::SubmitEvent(const NetworkEvent &event)
     {
-      size_t worker_id = event.connection_id % worker_count_;
+      size_t worker_id = GetWorkerIndex(event.connection_id);
+      WorkItem item(event);
 
       // 阻塞模式：如果队列满，等待直到有空间
       while (is_running_)
       {
-        if (event_queues_[worker_id]->TryEnqueue(event))
+        if (PushItem(worker_id, std::move(item)))
         {
           break;
         }
@@ -110,8 +226,8 @@ namespace darwincore
 
     bool WorkerPool::TrySubmitEvent(const NetworkEvent &event)
     {
-      size_t worker_id = event.connection_id % worker_count_;
-      bool success = event_queues_[worker_id]->TryEnqueue(event);
+      size_t worker_id = GetWorkerIndex(event.connection_id);
+      bool success = PushItem(worker_id, WorkItem(event));
 
       if (!success)
       {
@@ -129,6 +245,174 @@ namespace darwincore
       return success;
     }
 
+    bool WorkerPool::SubmitTask(uint64_t connection_id, Task task)
+    {
+      if (!task)
+      {
+        return false;
+      }
+
+      WorkItem item;
+      item.kind = WorkKind::kTask;
+      item.task = std::move(task);
+      return EnqueueItem(connection_id, std::move(item));
+    }
+
+    bool WorkerPool::SubmitDelayedTask(uint64_t connection_id,
+                                       std::chrono::milliseconds delay, Task task)
+    {
+      if (!task)
+      {
+        return false;
+      }
+
+      WorkItem item;
+      item.kind = WorkKind::kTimer;
+      item.task = std::move(task);
+      item.delay = delay;
+      return EnqueueItem(connection_id, std::move(item));
+    }
+
+    WorkerPool::TimerId WorkerPool::ScheduleTimer(uint64_t connection_id,
+                                                  std::chrono::milliseconds delay,
+                                                  std::chrono::milliseconds interval,
+                                                  Task task)
+    {
+      if (!task)
+      {
+        return 0;
+      }
+
+      TimerId timer_id = (next_timer_sequence_.fetch_add(1) << kTimerWorkerBits) |
+                         GetWorkerIndex(connection_id);
+
+      WorkItem item;
+      item.kind = WorkKind::kTimer;
+      item.task = std::move(task);
+      item.delay = delay;
+      item.interval = std::max(interval, std::chrono::milliseconds(0));
+      item.timer_id = timer_id;
+      return EnqueueItem(connection_id, std::move(item)) ? timer_id : 0;
+    }
+
+    bool WorkerPool::CancelTimer(TimerId timer_id)
+    {
+      size_t worker_id = timer_id & kTimerWorkerMask;
+      if (timer_id == 0 || worker_id >= worker_count_)
+      {
+        return false;
+      }
+
+      // 在所属 Worker 线程中直接取消
+      if (tls_current_pool == this && tls_current_worker == static_cast<int>(worker_id))
+      {
+        return RemoveTimer(static_cast<int>(worker_id), timer_id);
+      }
+
+      // 其他线程：经由队列交给所属 Worker（worker_id 即该 Worker 的连接路由值）
+      WorkItem item;
+      item.kind = WorkKind::kCancelTimer;
+      item.timer_id = timer_id;
+      return EnqueueItem(worker_id, std::move(item));
+    }
+
+    bool WorkerPool::DropConnectionTimers(uint64_t connection_id)
+    {
+      WorkItem item;
+      item.kind = WorkKind::kDropTimers;
+      return EnqueueItem(connection_id, std::move(item));
+    }
+
+    bool WorkerPool::Flush(std::chrono::milliseconds timeout)
+    {
+      // 每个 Worker 队列末尾放一个标记任务，队列先进先出，标记执行时此前的元素都已处理
+      struct Barrier
+      {
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t remaining = 0;
+      };
+      auto barrier = std::make_shared<Barrier>();
+      barrier->remaining = worker_count_;
+
+      for (size_t worker_id = 0; worker_id < worker_count_; ++worker_id)
+      {
+        WorkItem item;
+        item.kind = WorkKind::kTask;
+        item.task = [barrier]()
+        {
+          std::lock_guard<std::mutex> lock(barrier->mutex);
+          if (--barrier->remaining == 0)
+          {
+            barrier->cv.notify_all();
+          }
+        };
+        // connection_id == worker_id 时正好路由到该 Worker
+        if (!EnqueueItem(worker_id, std::move(item)))
+        {
+          return false;
+        }
+      }
+
+      std::unique_lock<std::mutex> lock(barrier->mutex);
+      return barrier->cv.wait_for(lock, timeout, [&]() { return barrier->remaining == 0; });
+    }
+
+    bool WorkerPool::EnqueueItem(uint64_t connection_id, WorkItem item)
+    {
+      if (!is_running_)
+      {
+        return false;
+      }
+
+      size_t worker_id = GetWorkerIndex(connection_id);
+      item.event.connection_id = connection_id;
+
+      if (!PushItem(worker_id, std::move(item)))
+      {
+        NW_LOG_WARNING("[WorkerPool::EnqueueItem] 队列满: conn_id="
+                       << connection_id << ", worker_id=" << worker_id);
+        return false;
+      }
+
+      NW_LOG_TRACE("[WorkerPool::EnqueueItem] conn_id=" << connection_id
+                   << ", worker_id=" << worker_id);
+      return true;
+    }
+
+    bool WorkerPool::PushItem(size_t worker_id, WorkItem &&item)
+    {
+      if (!event_queues_[worker_id]->TryEnqueue(std::move(item)))
+      {
+        return false;
+      }
+
+      // 先入队再调度：处理线程交还槽后会重新检查队列，两边不会同时错过
+      if (elastic_)
+      {
+        ScheduleSlot(worker_id);
+      }
+      return true;
+    }
+
+    void WorkerPool::SetBatchEventCallback(BatchEventCallback callback)
+    {
+      batch_callback_ = std::move(callback);
+    }
+
+    void WorkerPool::SetRouteCallback(FrameCallback framer, RouteCallback router,
+                                      size_t max_message_size)
+    {
+      frame_callback_ = std::move(framer);
+      route_callback_ = std::move(router);
+      max_message_size_ = max_message_size;
+    }
+
+    void WorkerPool::SetCloseCallback(CloseCallback callback)
+    {
+      close_callback_ = std::move(callback);
+    }
+
     void WorkerPool::SetEventCallback(EventCallback callback)
     {
       NW_LOG_DEBUG("[WorkerPool::SetEventCallback] 设置回调，callback="
@@ -146,48 +430,741 @@ namespace darwincore
       return total;
     }
 
+    WorkerPool::Statistics WorkerPool::GetStatistics() const
+    {
+      Statistics stats;
+      if (elastic_)
+      {
+        stats.worker_threads = active_workers_.load();
+      }
+      else
+      {
+        stats.worker_threads = is_running_ ? worker_count_ : 0;
+      }
+      stats.scale_ups = scale_ups_.load();
+      stats.scale_downs = scale_downs_.load();
+      stats.keyed_events = keyed_events_.load(std::memory_order_relaxed);
+      stats.dropped_keyed_events = dropped_keyed_events_.load(std::memory_order_relaxed);
+      return stats;
+    }
+
     void WorkerPool::WorkerLoop(int worker_id)
     {
       pthread_setname_np(("darwincore.network.worker." + std::to_string(worker_id)).c_str());
 
+      tls_current_pool = this;
+      tls_current_worker = worker_id;
+
       auto &queue = event_queues_[worker_id];
+      TimerWheel &wheel = worker_timers_[worker_id]->wheel;
+      std::vector<TimerWheel::Callback> expired;
       NW_LOG_DEBUG("[WorkerPool] Worker " << worker_id << " 启动");
 
       while (is_running_)
       {
-        NetworkEvent event(NetworkEventType::kData, 0);
+        WorkItem item;
 
-        // 使用阻塞等待（100ms超时），替代 TryDequeue + sleep_for
+        // 使用阻塞等待（最长 100ms），有挂起的定时器时等到下一个 tick
         // 这样既能快速响应事件，又能定期检查 is_running_ 状态
-        if (queue->WaitDequeue(event, std::chrono::milliseconds(100)))
-        {
-          NW_LOG_TRACE("[WorkerPool] Worker "
-                       << worker_id
-                       << " 处理事件: type=" << static_cast<int>(event.type)
-                       << ", conn_id=" << event.connection_id
-                       << ", payload_size=" << event.payload.size()
-                       << ", event_callback_=" << (event_callback_ != nullptr));
-          if (event_callback_)
+        auto timeout = std::chrono::milliseconds(100);
+        if (!wheel.Empty())
+        {
+          timeout = std::min(timeout, wheel.GetTimeUntilNextTick(TimerWheel::Clock::now()));
+        }
+
+        if (queue->WaitDequeue(item, timeout))
+        {
+          if (batch_callback_)
           {
-            NW_LOG_TRACE("[WorkerPool] 调用 event_callback_");
-            event_callback_(event);
-            NW_LOG_TRACE("[WorkerPool] event_callback_ 返回");
+            ProcessBatch(worker_id, *queue, item, kMaxBatchEvents);
           }
+          else
+          {
+            ProcessItem(worker_id, item);
+          }
+        }
+        // WaitDequeue 超时或被 NotifyStop 唤醒时，继续检查定时器和 is_running_
+
+        if (!wheel.Empty())
+        {
+          wheel.Advance(TimerWheel::Clock::now(), expired);
+          for (auto &callback : expired)
+          {
+            RunTask(worker_id, callback);
+          }
+          expired.clear();
+        }
+      }
+
+      // 处理剩余事件与任务（定时器操作忽略，未到期的定时器被丢弃）
+      WorkItem remaining_item;
+      while (queue->TryDequeue(remaining_item))
+      {
+        if (remaining_item.kind == WorkKind::kEvent || remaining_item.kind == WorkKind::kTask)
+        {
+          ProcessItem(worker_id, remaining_item);
+        }
+      }
+
+      NW_LOG_DEBUG("[WorkerPool] Worker " << worker_id << " 退出，丢弃 "
+                                         << wheel.Size() << " 个未到期定时器");
+      worker_timers_[worker_id] = std::make_unique<WorkerTimers>();
+      partial_messages_[worker_id].clear();
+      closing_connections_[worker_id].clear();
+
+      tls_current_pool = nullptr;
+      tls_current_worker = -1;
+    }
+
+    // ============ 弹性模式 ============
+
+    void WorkerPool::ScheduleSlot(size_t slot)
+    {
+      if (slot_states_[slot]->scheduled.exchange(true))
+      {
+        return; // 已在就绪队列中，或正被某个线程处理（处理完会重新检查）
+      }
+      if (!ready_slots_.Enqueue(ReadySlot{slot, std::chrono::steady_clock::now()}))
+      {
+        // 已停止：槽保持空闲，由退出前的 Worker 在 DrainSlots 中领取
+        slot_states_[slot]->scheduled = false;
+      }
+    }
+
+    std::chrono::milliseconds WorkerPool::ScheduleDueSlots()
+    {
+      int64_t now = ToNanoseconds(std::chrono::steady_clock::now());
+      int64_t next_due = INT64_MAX;
+      for (size_t slot = 0; slot < worker_count_; ++slot)
+      {
+        int64_t due = slot_states_[slot]->timer_due_ns.load(std::memory_order_relaxed);
+        if (due <= now)
+        {
+          ScheduleSlot(slot);
+        }
+        else
+        {
+          next_due = std::min(next_due, due);
+        }
+      }
+
+      auto timeout = std::chrono::milliseconds(100);
+      if (next_due != INT64_MAX)
+      {
+        // 向上取整，只会晚不会早
+        auto until = std::chrono::milliseconds((next_due - now + 999999) / 1000000);
+        timeout = std::min(timeout, until);
+      }
+      return timeout;
+    }
+
+    void WorkerPool::RunSlot(size_t slot)
+    {
+      SlotState &state = *slot_states_[slot];
+      auto &queue = event_queues_[slot];
+      tls_current_worker = static_cast<int>(slot);
+
+      // 与固定模式一样，每处理一个元素推进一次时间轮，定时器不因长批次而推迟
+      TimerWheel &wheel = worker_timers_[slot]->wheel;
+      std::vector<TimerWheel::Callback> expired;
+      auto advance = [&]()
+      {
+        if (wheel.Empty())
+        {
+          return;
         }
-        // WaitDequeue 超时或被 NotifyStop 唤醒时，继续检查 is_running_
+        wheel.Advance(TimerWheel::Clock::now(), expired);
+        for (auto &callback : expired)
+        {
+          RunTask(static_cast<int>(slot), callback);
+        }
+        expired.clear();
+      };
+
+      WorkItem item;
+      for (size_t n = 0; n < kSlotBatchSize && queue->TryDequeue(item);)
+      {
+        if (batch_callback_)
+        {
+          n += ProcessBatch(static_cast<int>(slot), *queue, item, kSlotBatchSize - n);
+        }
+        else
+        {
+          ProcessItem(static_cast<int>(slot), item);
+          ++n;
+        }
+        advance();
+      }
+      advance();
+
+      int64_t due = INT64_MAX;
+      if (!wheel.Empty())
+      {
+        auto now = TimerWheel::Clock::now();
+        due = ToNanoseconds(now + wheel.GetTimeUntilNextTick(now));
       }
+      state.timer_due_ns.store(due, std::memory_order_relaxed);
 
-      // 处理剩余事件
-      NetworkEvent remaining_event(NetworkEventType::kData, 0);
-      while (queue->TryDequeue(remaining_event))
+      // 交还槽；交还后才入队的元素由提交方调度，之前入队的在这里补调度
+      tls_current_worker = -1;
+      state.scheduled.store(false);
+      if (!queue->IsEmpty())
       {
+        ScheduleSlot(slot);
+      }
+    }
+
+    void WorkerPool::MaybeGrow(std::chrono::steady_clock::duration wait)
+    {
+      if (wait < grow_latency_ || active_workers_.load() >= worker_count_)
+      {
+        return;
+      }
+
+      int64_t now = ToNanoseconds(std::chrono::steady_clock::now());
+      int64_t last = last_grow_ns_.load();
+      if (now - last < std::chrono::nanoseconds(kGrowCooldown).count() ||
+          !last_grow_ns_.compare_exchange_strong(last, now))
+      {
+        return;
+      }
+
+      NW_LOG_DEBUG("[WorkerPool] 排队 "
+                   << std::chrono::duration_cast<std::chrono::microseconds>(wait).count()
+                   << "us，增加工作线程");
+      SpawnElasticWorker(true);
+    }
+
+    bool WorkerPool::SpawnElasticWorker(bool is_scale_up)
+    {
+      std::lock_guard<std::mutex> lock(scale_mutex_);
+      if (!is_running_ || active_workers_.load() >= worker_count_)
+      {
+        return false;
+      }
+
+      // 回收已退出的线程
+      for (auto it = elastic_workers_.begin(); it != elastic_workers_.end();)
+      {
+        if ((*it)->exited)
+        {
+          (*it)->thread.join();
+          it = elastic_workers_.erase(it);
+        }
+        else
+        {
+          ++it;
+        }
+      }
+
+      auto worker = std::make_unique<ElasticWorker>();
+      ++active_workers_;
+      worker->thread = std::thread(&WorkerPool::ElasticWorkerLoop, this, worker.get(),
+                                   next_worker_number_++);
+      elastic_workers_.push_back(std::move(worker));
+
+      if (is_scale_up)
+      {
+        ++scale_ups_;
+        NW_LOG_INFO("[WorkerPool] 扩容: " << active_workers_.load() << " 个工作线程");
+      }
+      return true;
+    }
+
+    bool WorkerPool::TryRetireWorker()
+    {
+      size_t active = active_workers_.load();
+      while (active > min_workers_)
+      {
+        if (active_workers_.compare_exchange_weak(active, active - 1))
+        {
+          ++scale_downs_;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void WorkerPool::ElasticWorkerLoop(ElasticWorker *self, size_t number)
+    {
+      pthread_setname_np(("darwincore.network.worker." + std::to_string(number)).c_str());
+
+      tls_current_pool = this;
+      auto idle_since = std::chrono::steady_clock::now();
+      NW_LOG_DEBUG("[WorkerPool] 弹性 Worker " << number << " 启动");
+
+      while (is_running_)
+      {
+        // 定时器到期的槽也放入就绪队列，等待时间不超过最近一个 tick
+        auto timeout = ScheduleDueSlots();
+
+        ReadySlot ready;
+        if (ready_slots_.WaitDequeue(ready, timeout))
+        {
+          MaybeGrow(std::chrono::steady_clock::now() - ready.since);
+          RunSlot(ready.slot);
+          idle_since = std::chrono::steady_clock::now();
+          continue;
+        }
+
+        if (is_running_ && std::chrono::steady_clock::now() - idle_since >= idle_shrink_ &&
+            TryRetireWorker())
+        {
+          NW_LOG_INFO("[WorkerPool] 缩容: 弹性 Worker " << number << " 空闲退出，剩余 "
+                                                       << active_workers_.load() << " 个");
+          break;
+        }
+      }
+
+      if (!is_running_)
+      {
+        DrainSlots();
+      }
+
+      tls_current_pool = nullptr;
+      self->exited = true;
+    }
+
+    void WorkerPool::DrainSlots()
+    {
+      // 停止后在 Worker 线程中处理剩余的事件与任务（定时器操作忽略）。就绪队列中的槽
+      // 取出即归本线程；空闲的槽抢占后处理；正被其他线程处理的槽由该线程随后处理
+      ReadySlot ready;
+      while (ready_slots_.TryDequeue(ready))
+      {
+        DrainSlot(ready.slot);
+      }
+      for (size_t slot = 0; slot < worker_count_; ++slot)
+      {
+        if (!slot_states_[slot]->scheduled.exchange(true))
+        {
+          DrainSlot(slot);
+        }
+      }
+    }
+
+    void WorkerPool::DrainSlot(size_t slot)
+    {
+      // 处理完不交还：停止后槽不再被调度，ResetSlots 统一复位
+      tls_current_worker = static_cast<int>(slot);
+      WorkItem item;
+      while (event_queues_[slot]->TryDequeue(item))
+      {
+        if (item.kind == WorkKind::kEvent || item.kind == WorkKind::kTask)
+        {
+          ProcessItem(static_cast<int>(slot), item);
+        }
+      }
+      tls_current_worker = -1;
+    }
+
+    void WorkerPool::ResetSlots()
+    {
+      // 所有线程已退出：丢弃未到期的定时器与停止过程中才入队的元素
+      size_t dropped_timers = 0;
+      size_t dropped_items = 0;
+      for (size_t slot = 0; slot < worker_count_; ++slot)
+      {
+        WorkItem item;
+        while (event_queues_[slot]->TryDequeue(item))
+        {
+          ++dropped_items;
+        }
+
+        dropped_timers += worker_timers_[slot]->wheel.Size();
+        worker_timers_[slot] = std::make_unique<WorkerTimers>();
+        partial_messages_[slot].clear();
+        closing_connections_[slot].clear();
+        slot_states_[slot]->scheduled = false;
+        slot_states_[slot]->timer_due_ns = INT64_MAX;
+      }
+
+      NW_LOG_DEBUG("[WorkerPool] 弹性模式停止，丢弃 " << dropped_timers << " 个未到期定时器、"
+                                                     << dropped_items << " 个停止后入队的元素");
+    }
+
+    void WorkerPool::ProcessItem(int worker_id, WorkItem &item)
+    {
+      switch (item.kind)
+      {
+      case WorkKind::kEvent:
+        if (NeedsSplit(item.event))
+        {
+          // 按 key 路由：在连接的 Worker 上分帧，留在本 Worker 的消息逐条交付
+          std::vector<NetworkEvent> messages;
+          SplitMessages(worker_id, item.event, messages);
+          if (batch_callback_)
+          {
+            DeliverBatch(worker_id, messages);
+          }
+          else if (event_callback_)
+          {
+            for (const NetworkEvent &message : messages)
+            {
+              event_callback_(message);
+            }
+          }
+          break;
+        }
+        if (batch_callback_ && item.event.type == NetworkEventType::kData)
+        {
+          // 批量模式下单独处理的数据事件（如 Stop 时的剩余事件）作为一批交付
+          std::vector<NetworkEvent> batch;
+          batch.push_back(std::move(item.event));
+          DeliverBatch(worker_id, batch);
+          break;
+        }
+        NW_LOG_TRACE("[WorkerPool] Worker "
+                     << worker_id
+                     << " 处理事件: type=" << static_cast<int>(item.event.type)
+                     << ", conn_id=" << item.event.connection_id
+                     << ", payload_size=" << item.event.payload.size()
+                     << ", event_callback_=" << (event_callback_ != nullptr));
+        if (item.event.type == NetworkEventType::kConnected)
+        {
+          // 先于回调登记，OnClientConnected 中添加的定时器才会被接受
+          worker_timers_[worker_id]->live_connections.insert(item.event.connection_id);
+        }
         if (event_callback_)
         {
-          event_callback_(remaining_event);
+          event_callback_(item.event);
+        }
+        if (item.event.type == NetworkEventType::kDisconnected)
+        {
+          CancelConnectionTimers(worker_id, item.event.connection_id);
+          partial_messages_[worker_id].erase(item.event.connection_id);
+          closing_connections_[worker_id].erase(item.event.connection_id);
+        }
+        break;
+
+      case WorkKind::kTask:
+        RunTask(worker_id, item.task);
+        break;
+
+      case WorkKind::kTimer:
+      {
+        WorkerTimers &timers = *worker_timers_[worker_id];
+        if (item.timer_id == 0)
+        {
+          timers.wheel.Schedule(item.delay, std::move(item.task));
+          break;
+        }
+
+        // 连接未知或已断开：不会再有 kDisconnected 取消它，直接丢弃
+        if (timers.live_connections.count(item.event.connection_id) == 0)
+        {
+          NW_LOG_DEBUG("[WorkerPool] Worker " << worker_id << " 丢弃不存活连接的定时器: conn_id="
+                                             << item.event.connection_id);
+          break;
+        }
+
+        TimerId timer_id = item.timer_id;
+        TimerWheel::TimerId wheel_id = timers.wheel.Schedule(
+            item.delay, [this, worker_id, timer_id]()
+            { FireTimer(worker_id, timer_id); });
+        timers.entries.emplace(timer_id, WorkerTimers::Entry{item.event.connection_id, wheel_id,
+                                                             item.interval, std::move(item.task)});
+        timers.by_connection[item.event.connection_id].insert(timer_id);
+        break;
+      }
+
+      case WorkKind::kCancelTimer:
+        RemoveTimer(worker_id, item.timer_id);
+        break;
+
+      case WorkKind::kDropTimers:
+        CancelConnectionTimers(worker_id, item.event.connection_id);
+        break;
+      }
+    }
+
+    size_t WorkerPool::ProcessBatch(int worker_id, ConcurrentQueue<WorkItem> &queue,
+                                    WorkItem &first, size_t limit)
+    {
+      std::vector<NetworkEvent> batch;
+      WorkItem next;
+      WorkItem *current = &first;
+      size_t processed = 0;
+
+      while (true)
+      {
+        if (current->kind == WorkKind::kEvent && NeedsSplit(current->event))
+        {
+          SplitMessages(worker_id, current->event, batch);
+        }
+        else if (current->kind == WorkKind::kEvent &&
+                 current->event.type == NetworkEventType::kData)
+        {
+          batch.push_back(std::move(current->event));
+        }
+        else
+        {
+          // 非数据元素：先交付之前的数据，保持与任务、连接事件的相对顺序
+          DeliverBatch(worker_id, batch);
+          ProcessItem(worker_id, *current);
+        }
+
+        if (++processed >= limit || batch.size() >= kMaxBatchEvents ||
+            !queue.TryDequeue(next))
+        {
+          break;
+        }
+        current = &next;
+      }
+
+      DeliverBatch(worker_id, batch);
+      return processed;
+    }
+
+    void WorkerPool::DeliverBatch(int worker_id, std::vector<NetworkEvent> &batch)
+    {
+      if (batch.empty())
+      {
+        return;
+      }
+
+      NW_LOG_TRACE("[WorkerPool] Worker " << worker_id << " 批量交付 " << batch.size()
+                                         << " 个数据事件");
+      try
+      {
+        batch_callback_(batch);
+      }
+      catch (const std::exception &e)
+      {
+        NW_LOG_ERROR("[WorkerPool] Worker " << worker_id << " 批量回调异常: " << e.what());
+      }
+      batch.clear();
+    }
+
+    void WorkerPool::SplitMessages(int worker_id, NetworkEvent &event,
+                                   std::vector<NetworkEvent> &local)
+    {
+      // 已要求断开：之后的数据不再交付，避免字节流出现缺口
+      if (closing_connections_[worker_id].count(event.connection_id) != 0)
+      {
+        return;
+      }
+
+      auto &partials = partial_messages_[worker_id];
+      std::vector<uint8_t> &buffer = partials[event.connection_id];
+      if (buffer.empty())
+      {
+        buffer.swap(event.payload);
+      }
+      else
+      {
+        buffer.insert(buffer.end(), event.payload.begin(), event.payload.end());
+      }
+
+      size_t offset = 0;
+      while (offset < buffer.size())
+      {
+        size_t length = 0;
+        bool framed = true;
+        try
+        {
+          length = frame_callback_(buffer.data() + offset, buffer.size() - offset);
+        }
+        catch (const std::exception &e)
+        {
+          NW_LOG_ERROR("[WorkerPool] 分帧函数异常: conn_id=" << event.connection_id << ", "
+                                                             << e.what());
+          length = buffer.size() - offset;
+          framed = false;
+        }
+        if (length == 0)
+        {
+          break; // 半条消息，等下一次读取
+        }
+
+        length = std::min(length, buffer.size() - offset);
+        NetworkEvent message(NetworkEventType::kData, event.connection_id);
+        message.payload.assign(buffer.begin() + offset, buffer.begin() + offset + length);
+        offset += length;
+        if (framed)
+        {
+          if (!RouteMessage(worker_id, std::move(message), local))
+          {
+            CloseRoutedConnection(worker_id, event.connection_id, ENOBUFS);
+            return;
+          }
+        }
+        else
+        {
+          local.push_back(std::move(message));
+        }
+      }
+
+      if (offset == buffer.size())
+      {
+        partials.erase(event.connection_id);
+        return;
+      }
+
+      // 对端声明了超长消息：不再缓存，断开连接
+      if (max_message_size_ > 0 && buffer.size() - offset > max_message_size_)
+      {
+        NW_LOG_WARNING("[WorkerPool] 半条消息超过上限，断开连接: conn_id="
+                       << event.connection_id << ", buffered=" << buffer.size() - offset);
+        CloseRoutedConnection(worker_id, event.connection_id, EMSGSIZE);
+        return;
+      }
+
+      if (offset > 0)
+      {
+        buffer.erase(buffer.begin(), buffer.begin() + offset);
+      }
+    }
+
+    bool WorkerPool::RouteMessage(int worker_id, NetworkEvent &&message,
+                                  std::vector<NetworkEvent> &local)
+    {
+      uint64_t key = 0;
+      bool keyed = false;
+      try
+      {
+        keyed = route_callback_(message, key);
+      }
+      catch (const std::exception &e)
+      {
+        NW_LOG_ERROR("[WorkerPool] 路由函数异常: conn_id=" << message.connection_id
+                                                           << ", " << e.what());
+      }
+      if (!keyed)
+      {
+        local.push_back(std::move(message));
+        return true;
+      }
+
+      message.routing_key = key;
+      keyed_events_.fetch_add(1, std::memory_order_relaxed);
+
+      // key 归本 Worker 时直接交付，与同一批的其他消息保持顺序
+      size_t target = GetKeyWorkerIndex(key);
+      if (target == static_cast<size_t>(worker_id))
+      {
+        local.push_back(std::move(message));
+        return true;
+      }
+
+      // 不在 Worker 之间阻塞等待队列空间：两个 Worker 互相转发时会死锁
+      WorkItem item;
+      item.event = std::move(message);
+      if (PushItem(target, std::move(item)))
+      {
+        return true;
+      }
+
+      dropped_keyed_events_.fetch_add(1, std::memory_order_relaxed);
+      NW_LOG_WARNING("[WorkerPool] 转发按 key 的消息失败（队列满或已停止），断开连接: conn_id="
+                     << item.event.connection_id << ", key=" << key
+                     << ", worker_id=" << target);
+      return false;
+    }
+
+    void WorkerPool::CloseRoutedConnection(int worker_id, uint64_t connection_id, int error_code)
+    {
+      partial_messages_[worker_id].erase(connection_id);
+      closing_connections_[worker_id].insert(connection_id);
+      if (close_callback_)
+      {
+        close_callback_(connection_id, error_code);
+      }
+    }
+
+    void WorkerPool::FireTimer(int worker_id, TimerId timer_id)
+    {
+      WorkerTimers &timers = *worker_timers_[worker_id];
+      auto it = timers.entries.find(timer_id);
+      if (it == timers.entries.end())
+      {
+        return;
+      }
+
+      // 回调中可能取消自身（或其他定时器），先把回调移出表项再执行
+      Task task = std::move(it->second.task);
+      std::chrono::milliseconds interval = it->second.interval;
+      if (interval.count() == 0)
+      {
+        RemoveTimer(worker_id, timer_id);
+      }
+
+      RunTask(worker_id, task);
+
+      if (interval.count() == 0)
+      {
+        return;
+      }
+
+      it = timers.entries.find(timer_id);
+      if (it == timers.entries.end())
+      {
+        return; // 回调中已取消
+      }
+      it->second.task = std::move(task);
+      it->second.wheel_id = timers.wheel.Schedule(
+          interval, [this, worker_id, timer_id]()
+          { FireTimer(worker_id, timer_id); });
+    }
+
+    bool WorkerPool::RemoveTimer(int worker_id, TimerId timer_id)
+    {
+      WorkerTimers &timers = *worker_timers_[worker_id];
+      auto it = timers.entries.find(timer_id);
+      if (it == timers.entries.end())
+      {
+        return false;
+      }
+
+      // 正在执行的定时器已从时间轮取出，Cancel 返回 false 不影响结果
+      timers.wheel.Cancel(it->second.wheel_id);
+
+      auto owner = timers.by_connection.find(it->second.connection_id);
+      if (owner != timers.by_connection.end())
+      {
+        owner->second.erase(timer_id);
+        if (owner->second.empty())
+        {
+          timers.by_connection.erase(owner);
         }
       }
 
-      NW_LOG_DEBUG("[WorkerPool] Worker " << worker_id << " 退出");
+      timers.entries.erase(it);
+      return true;
+    }
+
+    void WorkerPool::CancelConnectionTimers(int worker_id, uint64_t connection_id)
+    {
+      WorkerTimers &timers = *worker_timers_[worker_id];
+      timers.live_connections.erase(connection_id);
+      auto owner = timers.by_connection.find(connection_id);
+      if (owner == timers.by_connection.end())
+      {
+        return;
+      }
+
+      std::unordered_set<TimerId> timer_ids = std::move(owner->second);
+      timers.by_connection.erase(owner);
+      for (TimerId timer_id : timer_ids)
+      {
+        RemoveTimer(worker_id, timer_id);
+      }
+
+      NW_LOG_DEBUG("[WorkerPool] Worker " << worker_id << " 连接断开，取消 "
+                                         << timer_ids.size() << " 个定时器: conn_id="
+                                         << connection_id);
+    }
+
+    void WorkerPool::RunTask(int worker_id, const Task &task)
+    {
+      try
+      {
+        task();
+      }
+      catch (const std::exception &e)
+      {
+        NW_LOG_ERROR("[WorkerPool] Worker " << worker_id << " 任务异常: " << e.what());
+      }
     }
 
   } // namespace network
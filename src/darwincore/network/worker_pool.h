@@ -4,7 +4,9 @@
 //
 // 功能说明：
 //   WorkerPool 管理多个工作线程池用于业务逻辑处理。
-//   每个工作线程有独立的事件队列，处理来自 Reactor 的事件。
+//   每个工作线程有独立的事件队列，处理来自 Reactor 的事件，
+//   以及业务层投递到某个连接所在 Worker 的任务（可延迟执行）。
+//   弹性模式下线程数随排队延迟在 [min, max] 之间伸缩（见 SetElastic）。
 //
 // 设计规则：
 //   - Worker 永远不访问文件描述符（fd）
@@ -17,15 +19,20 @@
 #ifndef DARWINCORE_NETWORK_WORKER_POOL_H
 #define DARWINCORE_NETWORK_WORKER_POOL_H
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <darwincore/network/event.h> // 对外暴露的头文件
 #include "concurrent_queue.h"         // 内部头文件
+#include "timer_wheel.h"
 
 namespace darwincore
 {
@@ -55,6 +62,34 @@ namespace darwincore
       /// 事件回调函数类型别名
       using EventCallback = std::function<void(const NetworkEvent &)>;
 
+      /// 批量数据事件回调：Worker 一次取出的连续 kData 事件（按出队顺序）
+      using BatchEventCallback = std::function<void(std::vector<NetworkEvent> &)>;
+
+      /// 消息分帧函数：返回 data 开头第一条完整消息的长度，不足一条消息时返回 0
+      using FrameCallback = std::function<size_t(const uint8_t *data, size_t size)>;
+
+      /// 消息路由函数：返回 true 并写入 key 时按 key 路由，返回 false 时按连接路由
+      using RouteCallback = std::function<bool(const NetworkEvent &, uint64_t &key)>;
+
+      /// 断开连接的请求（Worker 无法继续按序交付该连接的数据时调用）
+      using CloseCallback = std::function<void(uint64_t connection_id, int error_code)>;
+
+      /// 投递到 Worker 线程执行的任务
+      using Task = std::function<void()>;
+
+      /// 连接定时器 ID（低 16 位为 Worker 索引，0 表示无效）
+      using TimerId = uint64_t;
+
+      /// 运行统计
+      struct Statistics
+      {
+        size_t worker_threads = 0;  ///< 当前工作线程数
+        uint64_t scale_ups = 0;     ///< 弹性模式：因排队延迟新增线程的次数
+        uint64_t scale_downs = 0;   ///< 弹性模式：空闲线程退出的次数
+        uint64_t keyed_events = 0;  ///< 按路由 key 分发的数据事件数
+        uint64_t dropped_keyed_events = 0; ///< 目标队列满而丢弃的按 key 消息数
+      };
+
       /**
        * @brief 构造一个新的 WorkerPool 对象
        * @param worker_count 要创建的工作线程数量
@@ -69,6 +104,24 @@ namespace darwincore
       WorkerPool(const WorkerPool &) = delete;
       WorkerPool &operator=(const WorkerPool &) = delete;
 
+      /**
+       * @brief 开启弹性模式（必须在 Start 之前调用）
+       * @param min_workers 最少线程数（至少 1）
+       * @param max_workers 最多线程数，同时也是路由槽的数量
+       * @param grow_latency 槽在就绪队列中等待超过此时间时增加一个线程
+       * @param idle_shrink 线程空闲超过此时间后退出（不少于 min_workers）
+       * @return 已启动或参数非法返回 false
+       *
+       * 弹性模式下连接按 connection_id % max_workers 固定路由到槽，每个槽有自己的
+       * 队列和时间轮；有待处理元素的槽进入共享的就绪队列，由任意空闲线程领取。
+       * 一个槽同一时刻只被一个线程处理，队列取空或处理完一批 kSlotBatchSize 个元素后
+       * 才交还；仍有排队元素的槽重新进入就绪队列，可能由另一个线程接着处理，
+       * 同一连接的事件仍按序串行执行。
+       */
+      bool SetElastic(size_t min_workers, size_t max_workers,
+                      std::chrono::microseconds grow_latency,
+                      std::chrono::milliseconds idle_shrink);
+
       /**
        * @brief 启动工作线程池
        * @return 启动成功返回 true，否则返回 false
@@ -101,6 +154,74 @@ namespace darwincore
        */
       bool TrySubmitEvent(const NetworkEvent &event);
 
+      /**
+       * @brief 投递任务到处理指定连接的 Worker（非阻塞）
+       * @param connection_id 连接 ID（决定由哪个 Worker 执行）
+       * @param task 要执行的任务
+       * @return 入队成功返回 true；未运行或队列满返回 false
+       *
+       * 任务与该连接的网络事件进入同一个队列，按提交顺序执行。
+       * 可以从任何线程调用，包括该 Worker 自身（不会阻塞等待队列空间）。
+       */
+      bool SubmitTask(uint64_t connection_id, Task task);
+
+      /**
+       * @brief 延迟投递任务到处理指定连接的 Worker
+       * @param connection_id 连接 ID
+       * @param delay 延迟时间（精度为 Worker 时间轮的 tick，只会晚不会早）
+       * @param task 到期后执行的任务
+       * @return 入队成功返回 true；未运行或队列满返回 false
+       *
+       * 定时器由该 Worker 线程自己的时间轮管理，到期后在同一线程执行。
+       * Stop() 时尚未到期的任务被丢弃。
+       */
+      bool SubmitDelayedTask(uint64_t connection_id, std::chrono::milliseconds delay, Task task);
+
+      /**
+       * @brief 在处理指定连接的 Worker 上添加定时器
+       * @param connection_id 连接 ID
+       * @param delay 首次触发的延迟
+       * @param interval 重复间隔（0 = 只触发一次）；从上次回调返回时重新计时
+       * @param task 到期回调（在该 Worker 线程中执行）
+       * @return 定时器 ID；未运行或队列满返回 0
+       *
+       * 与 SubmitDelayedTask 不同，定时器归属于连接：Worker 处理该连接的
+       * kDisconnected 事件后自动取消其所有定时器。连接未知或已断开时，
+       * Worker 收到定时器后直接丢弃，回调不会执行（此时返回的 ID 仍非 0）。
+       */
+      TimerId ScheduleTimer(uint64_t connection_id, std::chrono::milliseconds delay,
+                            std::chrono::milliseconds interval, Task task);
+
+      /**
+       * @brief 取消定时器，O(1)
+       * @param timer_id ScheduleTimer 返回的 ID
+       * @return 在所属 Worker 线程中调用时，定时器存在并被取消返回 true；
+       *         从其他线程调用时，取消请求入队成功返回 true
+       *
+       * 在所属 Worker 线程中（例如该连接的回调或定时器回调里）调用时立即生效；
+       * 从其他线程调用时经由队列异步生效，取消请求处理前已到期的回调仍会执行。
+       */
+      bool CancelTimer(TimerId timer_id);
+
+      /**
+       * @brief 取消连接的所有定时器（异步，经由该连接的 Worker 队列生效）
+       * @param connection_id 连接 ID
+       * @return 入队成功返回 true；未运行或队列满返回 false
+       *
+       * 连接没有经过 kDisconnected 事件就被移除时（共享事件循环组中的 Server
+       * 停止）使用，效果与 Worker 处理该连接的 kDisconnected 事件相同。
+       */
+      bool DropConnectionTimers(uint64_t connection_id);
+
+      /**
+       * @brief 等待每个 Worker 处理完调用前已入队的事件与任务
+       * @param timeout 最长等待时间
+       * @return 全部处理完返回 true；未运行、入队失败或超时返回 false
+       *
+       * 延迟任务与定时器不在等待范围内。不能在本池的 Worker 线程中调用。
+       */
+      bool Flush(std::chrono::milliseconds timeout);
+
       /**
        * @brief 设置事件回调函数
        * @param callback 当网络事件发生时调用的函数
@@ -109,13 +230,214 @@ namespace darwincore
        */
       void SetEventCallback(EventCallback callback);
 
+      /**
+       * @brief 设置批量数据事件回调（必须在 Start 之前调用）
+       * @param callback 非空时，kData 事件改为批量交给此回调
+       *
+       * Worker 取出一个 kData 事件后继续非阻塞地取出队列中已有的元素，
+       * 连续的 kData 事件（最多 64 个）合成一批交付；遇到其他元素（连接/断开事件、
+       * 任务、定时器操作）时先交付已收集的一批再处理它，保持同一队列内的顺序。
+       */
+      void SetBatchEventCallback(BatchEventCallback callback);
+
+      /**
+       * @brief 设置消息分帧与路由函数（必须在 Start 之前调用）
+       * @param framer 从连接的字节流中切出完整消息
+       * @param router 对每条完整消息调用，决定按 key 还是按连接分发
+       * @param max_message_size 半条消息的缓存上限（0 = 不限制），超过时以 EMSGSIZE 断开连接
+       *
+       * kData 事件仍先交给连接的 Worker（槽），在那里拼接上次剩下的半条消息后按
+       * framer 切分，保证同一连接的字节流只在一个线程上解析。router 返回 true 的
+       * 消息转给 GetKeyWorkerIndex(key) 对应的 Worker，key 记录在
+       * NetworkEvent::routing_key 中，同一 key 的消息不论来自哪个连接都由同一个
+       * Worker 串行处理；其余消息在连接的 Worker 上按序交付。
+       * framer 抛出异常时剩余数据整体按连接交付，router 抛出异常时按连接路由。
+       *
+       * Worker 之间不阻塞等待队列空间（互相转发时会死锁）：目标队列满时该消息被丢弃，
+       * 计入 dropped_keyed_events，并通过 CloseCallback 以 ENOBUFS 断开来源连接；
+       * 该连接之后的数据也被丢弃，字节流不会出现缺口。
+       */
+      void SetRouteCallback(FrameCallback framer, RouteCallback router,
+                            size_t max_message_size = 0);
+
+      /**
+       * @brief 设置断开连接的回调（必须在 Start 之前调用）
+       *
+       * 在 Worker 线程中调用，实现方只能异步关闭连接（例如投递到 Reactor）。
+       */
+      void SetCloseCallback(CloseCallback callback);
+
       /**
        * @brief 获取所有队列的总大小
        * @return 所有队列中的事件总数
        */
       size_t GetTotalQueueSize() const;
 
+      /**
+       * @brief 获取处理指定连接事件的 Worker 索引（弹性模式下为路由槽）
+       *
+       * 同一连接的事件总是路由到同一个 Worker（槽），按提交顺序串行处理。
+       */
+      size_t GetWorkerIndex(uint64_t connection_id) const { return connection_id % worker_count_; }
+
+      /**
+       * @brief 获取处理指定路由 key 的 Worker 索引（弹性模式下为路由槽）
+       *
+       * key 先经过混合散列再取模，租户 ID 等连续的 key 也能均匀分布。
+       * 槽数量在运行期间不变，所以弹性伸缩不会改变 key 的归属。
+       */
+      size_t GetKeyWorkerIndex(uint64_t key) const;
+
+      /**
+       * @brief 获取 Worker 数量（弹性模式下为路由槽数量，即 max_workers）
+       */
+      size_t GetWorkerCount() const { return worker_count_; }
+
+      /// 获取运行统计
+      Statistics GetStatistics() const;
+
     private:
+      /// Worker 队列元素类型
+      enum class WorkKind
+      {
+        kEvent,       ///< 网络事件
+        kTask,        ///< 立即执行的任务
+        kTimer,       ///< 放入时间轮（timer_id 为 0 时是不归属连接的延迟任务）
+        kCancelTimer, ///< 取消 timer_id
+        kDropTimers   ///< 取消连接的所有定时器
+      };
+
+      /// Worker 队列元素：网络事件、任务或定时器操作
+      struct WorkItem
+      {
+        WorkKind kind = WorkKind::kEvent;
+        NetworkEvent event{NetworkEventType::kData, 0};
+        Task task;
+        std::chrono::milliseconds delay{0};
+        std::chrono::milliseconds interval{0};
+        TimerId timer_id = 0;
+
+        WorkItem() = default;
+        explicit WorkItem(const NetworkEvent &e) : event(e) {}
+      };
+
+      /// 每个 Worker 的定时器状态，只在该 Worker 线程访问
+      struct WorkerTimers
+      {
+        struct Entry
+        {
+          uint64_t connection_id;
+          TimerWheel::TimerId wheel_id;
+          std::chrono::milliseconds interval;
+          Task task;
+        };
+
+        TimerWheel wheel;
+        std::unordered_map<TimerId, Entry> entries;
+        std::unordered_map<uint64_t, std::unordered_set<TimerId>> by_connection;
+        std::unordered_set<uint64_t> live_connections; ///< 已处理 kConnected、尚未断开的连接
+      };
+
+      /// 弹性模式下每个槽的调度状态
+      struct SlotState
+      {
+        std::atomic<bool> scheduled{false};            ///< 已在就绪队列中或正被某个线程处理
+        std::atomic<int64_t> timer_due_ns{INT64_MAX};  ///< 时间轮下一个 tick（steady_clock 纳秒）
+      };
+
+      /// 就绪队列元素：有待处理元素的槽及其进入就绪队列的时间
+      struct ReadySlot
+      {
+        size_t slot = 0;
+        std::chrono::steady_clock::time_point since;
+      };
+
+      /// 弹性模式下的工作线程
+      struct ElasticWorker
+      {
+        std::thread thread;
+        std::atomic<bool> exited{false};
+      };
+
+      /// 入队到处理 connection_id 的 Worker（任务/定时器操作共用，非阻塞）
+      bool EnqueueItem(uint64_t connection_id, WorkItem item);
+
+      /// 放入槽的队列；弹性模式下槽空闲时同时放入就绪队列
+      bool PushItem(size_t worker_id, WorkItem &&item);
+
+      /// 弹性模式：槽未被调度时放入就绪队列
+      void ScheduleSlot(size_t slot);
+
+      /// 弹性模式：调度定时器已到期的槽，返回距最近一个未到期 tick 的等待时间
+      std::chrono::milliseconds ScheduleDueSlots();
+
+      /// 弹性模式：处理一个槽的一批元素并推进其时间轮
+      void RunSlot(size_t slot);
+
+      /// 弹性模式：排队延迟超过阈值时增加一个线程（带冷却）
+      void MaybeGrow(std::chrono::steady_clock::duration wait);
+
+      /// 弹性模式：新建一个工作线程（is_scale_up 为 false 表示启动时的初始线程）
+      bool SpawnElasticWorker(bool is_scale_up);
+
+      /// 弹性模式：空闲线程申请退出，线程数已到下限时返回 false
+      bool TryRetireWorker();
+
+      /// 弹性模式的线程主循环
+      void ElasticWorkerLoop(ElasticWorker *self, size_t number);
+
+      /// 弹性模式：Stop 后在退出前的 Worker 线程中处理各槽剩余的事件与任务
+      void DrainSlots();
+
+      /// 弹性模式：处理一个已领取的槽中剩余的事件与任务
+      void DrainSlot(size_t slot);
+
+      /// 弹性模式：所有线程退出后复位各槽（丢弃定时器）
+      void ResetSlots();
+
+      /// 处理一个队列元素（Worker 线程）
+      void ProcessItem(int worker_id, WorkItem &item);
+
+      /**
+       * @brief 批量模式下处理 first 及其后队列中已有的元素（Worker 线程）
+       * @return 处理的元素数（不超过 limit）
+       */
+      size_t ProcessBatch(int worker_id, ConcurrentQueue<WorkItem> &queue, WorkItem &first,
+                          size_t limit);
+
+      /// 交付并清空已收集的数据事件
+      void DeliverBatch(int worker_id, std::vector<NetworkEvent> &batch);
+
+      /// 是否需要在连接的 Worker 上分帧（尚未按 key 转发过的数据事件）
+      bool NeedsSplit(const NetworkEvent &event) const
+      {
+        return frame_callback_ && event.type == NetworkEventType::kData && !event.routing_key;
+      }
+
+      /**
+       * @brief 在连接的 Worker 上把数据切成完整消息（Worker 线程）
+       * @param local 输出：留在本 Worker 交付的消息（按 key 的消息已转给 key 的 Worker）
+       */
+      void SplitMessages(int worker_id, NetworkEvent &event, std::vector<NetworkEvent> &local);
+
+      /**
+       * @brief 按 router 分发一条完整消息：按 key 的转给 key 的 Worker，其余追加到 local
+       * @return 按 key 的消息转发失败（已丢弃）返回 false
+       */
+      bool RouteMessage(int worker_id, NetworkEvent &&message, std::vector<NetworkEvent> &local);
+
+      /// 要求断开连接，丢弃其半条消息及之后的数据直到 kDisconnected（Worker 线程）
+      void CloseRoutedConnection(int worker_id, uint64_t connection_id, int error_code);
+
+      /// 定时器到期（Worker 线程）：执行回调，周期定时器重新调度
+      void FireTimer(int worker_id, TimerId timer_id);
+
+      /// 从时间轮和索引中移除定时器（Worker 线程）
+      bool RemoveTimer(int worker_id, TimerId timer_id);
+
+      /// 取消连接的所有定时器并标记连接不再存活（Worker 线程，处理 kDisconnected 之后）
+      void CancelConnectionTimers(int worker_id, uint64_t connection_id);
+
       /**
        * @brief Worker 线程的主循环
        * @param worker_id Worker ID（用于日志和调试）
@@ -124,6 +446,9 @@ namespace darwincore
        */
       void WorkerLoop(int worker_id);
 
+      /// 执行任务并捕获异常（任务异常不能终止 Worker 线程）
+      void RunTask(int worker_id, const Task &task);
+
       /**
        * @brief 使用轮询策略选择下一个 Worker
        * @return 选中 Worker 的索引
@@ -134,11 +459,39 @@ namespace darwincore
       size_t worker_count_;                                                      ///< 工作线程数量
       size_t max_queue_size_;                                                    ///< 每个队列的最大容量（0 = 无限制）
       std::vector<std::thread> worker_threads_;                                  ///< 工作线程列表
-      std::vector<std::unique_ptr<ConcurrentQueue<NetworkEvent>>> event_queues_; ///< 每个线程的事件队列
+      std::vector<std::unique_ptr<ConcurrentQueue<WorkItem>>> event_queues_;    ///< 每个线程的事件/任务队列
+      std::vector<std::unique_ptr<WorkerTimers>> worker_timers_;                 ///< 每个线程的定时器
+      std::atomic<uint64_t> next_timer_sequence_{1};                             ///< 定时器 ID 序号
       EventCallback event_callback_;                                             ///< 事件回调函数
+      BatchEventCallback batch_callback_;                                        ///< 批量数据事件回调（可为空）
+      FrameCallback frame_callback_;                                             ///< 消息分帧函数（可为空）
+      RouteCallback route_callback_;                                             ///< 消息路由函数（可为空）
+      size_t max_message_size_ = 0;                                              ///< 半条消息的缓存上限（0 = 不限制）
+      CloseCallback close_callback_;                                             ///< 断开连接的回调（可为空）
+      /// 每个 Worker（槽）上各连接未凑满一条消息的数据，只在该 Worker 线程访问
+      std::vector<std::unordered_map<uint64_t, std::vector<uint8_t>>> partial_messages_;
+      /// 每个 Worker（槽）上已要求断开、之后的数据被丢弃的连接，只在该 Worker 线程访问
+      std::vector<std::unordered_set<uint64_t>> closing_connections_;
+      std::atomic<uint64_t> keyed_events_{0};                                    ///< 按 key 分发的数据事件数
+      std::atomic<uint64_t> dropped_keyed_events_{0};                            ///< 转发失败丢弃的按 key 消息数
 
       std::atomic<size_t> next_worker_index_; ///< 下一个要分配的 Worker 索引（轮询）
-      bool is_running_;                       ///< Worker Pool 运行状态
+      std::atomic<bool> is_running_;          ///< Worker Pool 运行状态
+
+      // ============ 弹性模式 ============
+      bool elastic_ = false;                                           ///< 是否开启弹性模式
+      size_t min_workers_ = 0;                                         ///< 最少线程数
+      std::chrono::microseconds grow_latency_{0};                      ///< 扩容阈值（就绪队列等待时间）
+      std::chrono::milliseconds idle_shrink_{0};                       ///< 空闲线程退出阈值
+      std::vector<std::unique_ptr<SlotState>> slot_states_;            ///< 每个槽的调度状态
+      ConcurrentQueue<ReadySlot> ready_slots_;                         ///< 等待线程领取的槽
+      std::mutex scale_mutex_;                                         ///< 保护 elastic_workers_
+      std::vector<std::unique_ptr<ElasticWorker>> elastic_workers_;    ///< 弹性模式的工作线程
+      std::atomic<size_t> active_workers_{0};                          ///< 未申请退出的线程数
+      std::atomic<int64_t> last_grow_ns_{0};                           ///< 上次扩容时间（冷却用）
+      size_t next_worker_number_ = 0;                                  ///< 线程命名序号
+      std::atomic<uint64_t> scale_ups_{0};                             ///< 扩容次数
+      std::atomic<uint64_t> scale_downs_{0};                           ///< 缩容次数
     };
 
   } // namespace network
@@ -0,0 +1,196 @@
+//
+// DarwinCore Network - 阻塞任务池与慢回调检测测试
+//
+// 测试场景：
+//   1. OnMessage 把 1 秒的阻塞操作交给 RunBlocking：同一连接随后的请求
+//      立即得到响应（Worker 未被占住），后续回调回到该连接的 Worker 线程执行
+//   2. 直接在 OnMessage 中阻塞 80ms：触发慢回调通知，报告的是该连接，
+//      快速回调不会被误报
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kBlockingPool;
+constexpr auto kBlockingWork = std::chrono::milliseconds(1000);
+constexpr auto kInlineBlock = std::chrono::milliseconds(80);
+
+// 记录客户端收到的应答及其到达时间
+struct Replies {
+  std::mutex mutex;
+  std::string received;
+  std::unordered_map<std::string, std::chrono::steady_clock::time_point> arrived;
+
+  void Add(const std::vector<uint8_t>& data) {
+    std::lock_guard<std::mutex> lock(mutex);
+    received.append(data.begin(), data.end());
+    for (const char* word : {"PONG", "DONE", "SLOW"}) {
+      if (received.find(word) != std::string::npos && !arrived.count(word)) {
+        arrived[word] = std::chrono::steady_clock::now();
+      }
+    }
+  }
+
+  bool Has(const std::string& word) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return arrived.count(word) > 0;
+  }
+
+  std::chrono::steady_clock::time_point At(const std::string& word) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return arrived[word];
+  }
+};
+
+void Send(Server& server, uint64_t connection_id, const char* reply) {
+  server.SendData(connection_id, reinterpret_cast<const uint8_t*>(reply), 4);
+}
+
+void Send(Client& client, const char* request) {
+  client.SendData(reinterpret_cast<const uint8_t*>(request), 4);
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("阻塞任务池与慢回调测试");
+
+  ServerOptions options;
+  options.blocking_threads = 2;
+  options.slow_callback_threshold = std::chrono::milliseconds(50);
+  Server server(options);
+
+  std::mutex mutex;
+  std::unordered_map<uint64_t, std::thread::id> message_threads;
+  std::thread::id resume_thread;
+  std::thread::id work_thread;
+  std::vector<std::pair<uint64_t, std::chrono::microseconds>> slow_reports;
+
+  server.SetOnMessage([&](uint64_t connection_id, const std::vector<uint8_t>& data) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      message_threads[connection_id] = std::this_thread::get_id();
+    }
+    std::string request(data.begin(), data.end());
+    for (size_t i = 0; i + 4 <= request.size(); i += 4) {
+      std::string word = request.substr(i, 4);
+      if (word == "LOAD") {
+        server.RunBlocking(
+            connection_id,
+            [&] {
+              {
+                std::lock_guard<std::mutex> lock(mutex);
+                work_thread = std::this_thread::get_id();
+              }
+              std::this_thread::sleep_for(kBlockingWork);  // 模拟数据库调用
+            },
+            [&, connection_id](void*) {
+              {
+                std::lock_guard<std::mutex> lock(mutex);
+                resume_thread = std::this_thread::get_id();
+              }
+              Send(server, connection_id, "DONE");
+            });
+      } else if (word == "PING") {
+        Send(server, connection_id, "PONG");
+      } else if (word == "BLCK") {
+        std::this_thread::sleep_for(kInlineBlock);  // 错误用法：在 Worker 中阻塞
+        Send(server, connection_id, "SLOW");
+      }
+    }
+  });
+  server.SetOnSlowCallback([&](uint64_t connection_id, std::chrono::microseconds elapsed) {
+    std::lock_guard<std::mutex> lock(mutex);
+    slow_reports.emplace_back(connection_id, elapsed);
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  Client client;
+  Replies replies;
+  client.SetOnMessage([&](const std::vector<uint8_t>& data) { replies.Add(data); });
+  if (!client.ConnectIPv4("127.0.0.1", kTestPort) ||
+      !WaitUntil([&] { return client.IsConnected(); }, 5000)) {
+    std::cerr << "[Client] 连接失败!" << std::endl;
+    server.Stop();
+    return 1;
+  }
+
+  // ========== 测试 1: RunBlocking ==========
+  std::cout << "\n========== 测试 1: RunBlocking ==========" << std::endl;
+
+  auto sent = std::chrono::steady_clock::now();
+  Send(client, "LOAD");
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  Send(client, "PING");
+  bool got_both = WaitUntil([&] { return replies.Has("PONG") && replies.Has("DONE"); }, 5000);
+
+  auto pong_ms = std::chrono::duration_cast<std::chrono::milliseconds>(replies.At("PONG") - sent);
+  auto done_ms = std::chrono::duration_cast<std::chrono::milliseconds>(replies.At("DONE") - sent);
+  bool same_worker;
+  bool offloaded;
+  size_t early_reports;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t connection_id = message_threads.empty() ? 0 : message_threads.begin()->first;
+    same_worker = resume_thread == message_threads[connection_id];
+    offloaded = work_thread != std::thread::id() && work_thread != resume_thread;
+    early_reports = slow_reports.size();
+  }
+
+  bool pass1 = got_both && pong_ms < done_ms && done_ms >= kBlockingWork && same_worker &&
+               offloaded && early_reports == 0;
+  std::cout << (pass1 ? "[PASS]" : "[FAIL]") << " PONG " << pong_ms.count() << "ms 到达，DONE "
+            << done_ms.count() << "ms 到达；后续回调" << (same_worker ? "回到" : "未回到")
+            << "连接的 Worker，慢回调报告 " << early_reports << " 次" << std::endl;
+
+  // ========== 测试 2: 慢回调检测 ==========
+  std::cout << "\n========== 测试 2: 慢回调检测 ==========" << std::endl;
+
+  Send(client, "BLCK");
+  bool got_slow = WaitUntil([&] { return replies.Has("SLOW"); }, 5000);
+  bool reported = WaitUntil([&] { return server.GetStatistics().slow_callbacks > 0; }, 2000);
+  ServerStatistics stats = server.GetStatistics();
+
+  bool right_connection;
+  std::chrono::microseconds elapsed{0};
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    right_connection = slow_reports.size() == 1 && message_threads.count(slow_reports[0].first) == 1;
+    if (!slow_reports.empty()) {
+      elapsed = slow_reports[0].second;
+    }
+  }
+
+  client.Disconnect();
+  server.Stop();
+
+  bool pass2 = got_slow && reported && stats.slow_callbacks == 1 && right_connection &&
+               elapsed >= kInlineBlock;
+  std::cout << (pass2 ? "[PASS]" : "[FAIL]") << " 慢回调 " << stats.slow_callbacks << " 次，耗时 "
+            << elapsed.count() << "us，" << (right_connection ? "定位到该连接" : "连接不符")
+            << std::endl;
+
+  return FinishTest({{"RunBlocking", pass1}, {"慢回调检测", pass2}});
+}
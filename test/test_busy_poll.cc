@@ -0,0 +1,93 @@
+//
+// DarwinCore Network - 忙轮询测试
+//
+// 测试场景：
+//   1. 开启 busy_poll_spin 后，请求/响应往返结果正确
+//   2. 统计信息中同时记录了自旋时间和休眠时间（空闲后回到阻塞等待）
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kBusyPoll;
+constexpr int kRoundTrips = 50;
+
+}  // namespace
+
+int main() {
+  BeginTest("忙轮询测试");
+
+  ServerOptions options;
+  options.busy_poll_spin = std::chrono::microseconds(2000);
+  Server server(options);
+
+  server.SetOnMessage([&](uint64_t conn_id, const std::vector<uint8_t>& data) {
+    server.SendData(conn_id, data.data(), data.size());
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  std::atomic<int> received{0};
+  Client client;
+  client.SetOnMessage([&](const std::vector<uint8_t>& data) {
+    received.fetch_add(static_cast<int>(data.size()));
+  });
+
+  if (!client.ConnectIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Client] 连接失败!" << std::endl;
+    return 1;
+  }
+  WaitUntil([&] { return client.IsConnected(); }, 2000);
+
+  // 测试 1: 往返正确性
+  std::cout << "\n========== 测试 1: 请求/响应往返 ==========" << std::endl;
+  const uint8_t ping = 'p';
+  int completed = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRoundTrips; ++i) {
+    client.SendData(&ping, 1);
+    if (!WaitUntil([&] { return received.load() == i + 1; }, 2000,
+                   std::chrono::milliseconds(0))) {
+      break;
+    }
+    ++completed;
+  }
+  auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count();
+
+  bool pass1 = completed == kRoundTrips;
+  std::cout << (pass1 ? "[PASS]" : "[FAIL]") << " 完成 " << completed << "/" << kRoundTrips
+            << " 次往返，平均 " << (completed > 0 ? elapsed_us / completed : 0) << "us" << std::endl;
+
+  // 测试 2: 自旋与休眠统计
+  std::cout << "\n========== 测试 2: 自旋与休眠统计 ==========" << std::endl;
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  ServerStatistics stats = server.GetStatistics();
+  bool pass2 = stats.busy_poll_spin_us > 0 && stats.busy_poll_parked_us > 0;
+  std::cout << (pass2 ? "[PASS]" : "[FAIL]") << " 自旋 " << stats.busy_poll_spin_us
+            << "us，休眠 " << stats.busy_poll_parked_us << "us" << std::endl;
+
+  client.Disconnect();
+  server.Stop();
+
+  return FinishTest({{"往返正确性", pass1}, {"自旋统计", pass2}});
+}
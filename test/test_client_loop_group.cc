@@ -0,0 +1,151 @@
+//
+// DarwinCore Network - ClientLoopGroup 测试
+//
+// 测试场景：
+//   1. 多个 Client 共享同一个 ClientLoopGroup，回显数据正确送达各自的回调
+//   2. Client 断开/析构后从组中解绑，组内连接数归零
+//   3. 组停止后成员 Client 收到断开回调、变为未连接，发送失败
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/client_loop_group.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kClientLoopGroup;
+constexpr int kNumClients = 64;
+constexpr int kMessagesPerClient = 20;
+
+// 测试 1: 多个 Client 共享事件循环组进行回显
+bool TestSharedLoopEcho() {
+  std::cout << "\n========== 测试 1: 共享事件循环组回显 ==========" << std::endl;
+
+  auto group = std::make_shared<ClientLoopGroup>(2, 2);
+  std::vector<std::unique_ptr<Client>> clients;
+  std::vector<std::unique_ptr<std::atomic<size_t>>> received_bytes;
+  std::atomic<int> connected_count{0};
+
+  for (int i = 0; i < kNumClients; ++i) {
+    auto client = std::make_unique<Client>(group);
+    received_bytes.push_back(std::make_unique<std::atomic<size_t>>(0));
+    auto* counter = received_bytes.back().get();
+
+    client->SetOnConnected([&](const ConnectionInformation&) { connected_count++; });
+    client->SetOnMessage([counter](const std::vector<uint8_t>& data) {
+      counter->fetch_add(data.size());
+    });
+
+    if (!client->ConnectIPv4("127.0.0.1", kTestPort)) {
+      std::cerr << "[Client " << i << "] 连接失败" << std::endl;
+      return false;
+    }
+    clients.push_back(std::move(client));
+  }
+
+  if (!WaitUntil([&] { return connected_count.load() == kNumClients; }, 5000)) {
+    std::cerr << "连接回调数不足: " << connected_count.load() << std::endl;
+    return false;
+  }
+
+  // 每个 Client 发送带自身编号的消息，回显字节数应与发送字节数一致
+  std::vector<size_t> sent_bytes(kNumClients, 0);
+  for (int m = 0; m < kMessagesPerClient; ++m) {
+    for (int i = 0; i < kNumClients; ++i) {
+      std::string msg = "client-" + std::to_string(i) + "-msg-" + std::to_string(m);
+      if (!clients[i]->SendData(reinterpret_cast<const uint8_t*>(msg.data()), msg.size())) {
+        std::cerr << "[Client " << i << "] 发送失败" << std::endl;
+        return false;
+      }
+      sent_bytes[i] += msg.size();
+    }
+  }
+
+  bool all_received = WaitUntil([&] {
+    for (int i = 0; i < kNumClients; ++i) {
+      if (received_bytes[i]->load() != sent_bytes[i]) {
+        return false;
+      }
+    }
+    return true;
+  }, 10000);
+
+  std::cout << "Reactor 线程数: " << group->GetLoopCount()
+            << ", 组内连接数: " << group->GetConnectionCount() << std::endl;
+
+  bool count_ok = group->GetConnectionCount() == static_cast<size_t>(kNumClients);
+
+  for (auto& client : clients) {
+    client->Disconnect();
+  }
+  bool detached = WaitUntil([&] { return group->GetConnectionCount() == 0; }, 2000);
+
+  std::cout << (all_received ? "[PASS]" : "[FAIL]") << " 回显数据完整" << std::endl;
+  std::cout << (count_ok ? "[PASS]" : "[FAIL]") << " 组内连接数正确" << std::endl;
+  std::cout << (detached ? "[PASS]" : "[FAIL]") << " 断开后全部解绑" << std::endl;
+
+  return all_received && count_ok && detached;
+}
+
+// 测试 2: 组停止后成员 Client 不能再发送
+bool TestGroupStop() {
+  std::cout << "\n========== 测试 2: 停止事件循环组 ==========" << std::endl;
+
+  auto group = std::make_shared<ClientLoopGroup>(1, 1);
+  Client client(group);
+  std::atomic<int> disconnected{0};
+  client.SetOnDisconnected([&] { disconnected++; });
+
+  if (!client.ConnectIPv4("127.0.0.1", kTestPort) ||
+      !WaitUntil([&] { return client.IsConnected(); }, 2000)) {
+    std::cerr << "连接失败" << std::endl;
+    return false;
+  }
+
+  group->Stop();
+
+  bool notified = disconnected.load() == 1 && !client.IsConnected();
+  const uint8_t payload[] = {'p', 'i', 'n', 'g'};
+  bool send_failed = !client.SendData(payload, sizeof(payload));
+
+  std::cout << (notified ? "[PASS]" : "[FAIL]") << " 组停止后断开回调触发 "
+            << disconnected.load() << " 次，IsConnected()=" << client.IsConnected() << std::endl;
+  std::cout << (send_failed ? "[PASS]" : "[FAIL]") << " 组停止后发送失败" << std::endl;
+  return notified && send_failed;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("ClientLoopGroup 测试");
+
+  Server server;
+  server.SetOnMessage([&](uint64_t conn_id, const std::vector<uint8_t>& data) {
+    server.SendData(conn_id, data.data(), data.size());
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  bool pass1 = TestSharedLoopEcho();
+  bool pass2 = TestGroupStop();
+
+  server.Stop();
+
+  return FinishTest({{"共享回显", pass1}, {"停止组", pass2}});
+}
@@ -0,0 +1,102 @@
+//
+// DarwinCore Network 测试公共工具
+//
+// 功能说明：
+//   各测试共用的条件等待、标题与结果汇总输出，以及监听端口的统一分配
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#ifndef DARWINCORE_TEST_COMMON_HPP
+#define DARWINCORE_TEST_COMMON_HPP
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <thread>
+
+namespace darwincore {
+namespace test {
+
+// 各测试的监听端口（集中分配，测试可以并行运行；新增测试取未使用的端口）
+namespace ports {
+constexpr uint16_t kMessageRouterOversize = 9974;
+constexpr uint16_t kClientLoopGroup = 9975;
+constexpr uint16_t kRpc = 9976;
+constexpr uint16_t kWriteCoalescing = 9977;
+constexpr uint16_t kBusyPoll = 9978;
+constexpr uint16_t kUdp = 9979;
+constexpr uint16_t kRateLimit = 9980;
+constexpr uint16_t kSendBudgetReject = 9981;
+constexpr uint16_t kSendBudgetDisconnect = 9982;
+constexpr uint16_t kConnectionContext = 9983;
+constexpr uint16_t kPost = 9984;
+constexpr uint16_t kConnectionTimer = 9985;
+constexpr uint16_t kReadFairness = 9986;
+constexpr uint16_t kConnectionMemory = 9987;
+constexpr uint16_t kSendPriority = 9988;
+constexpr uint16_t kStreamFlowControl = 9989;
+constexpr uint16_t kElasticWorkers = 9990;
+constexpr uint16_t kBlockingPool = 9991;
+constexpr uint16_t kMessageBatch = 9992;
+constexpr uint16_t kMessageRouter = 9993;
+constexpr uint16_t kEventLoopGroup = 9994;
+constexpr uint16_t kReactorMigration = 9995;
+}  // namespace ports
+
+/**
+ * @brief 轮询等待条件成立
+ * @param timeout_ms 最长等待时间（毫秒）
+ * @param poll_interval 两次检查之间的休眠；0 表示只让出 CPU（测量往返延迟时使用）
+ * @return 超时前条件成立返回 true（超时时最后再检查一次）
+ */
+inline bool WaitUntil(const std::function<bool()>& predicate, int timeout_ms,
+                      std::chrono::milliseconds poll_interval = std::chrono::milliseconds(10)) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (predicate()) {
+      return true;
+    }
+    if (poll_interval.count() > 0) {
+      std::this_thread::sleep_for(poll_interval);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  return predicate();
+}
+
+/// 忽略 SIGPIPE 并输出测试标题
+inline void BeginTest(const char* title) {
+  signal(SIGPIPE, SIG_IGN);
+
+  std::cout << "========================================" << std::endl;
+  std::cout << "  DarwinCore - " << title << std::endl;
+  std::cout << "========================================" << std::endl;
+}
+
+// 单个测试项的结果
+struct TestResult {
+  const char* name;
+  bool passed;
+};
+
+/// 输出各测试项的结果汇总，返回进程退出码（全部通过为 0）
+inline int FinishTest(std::initializer_list<TestResult> results) {
+  bool all_passed = true;
+  std::cout << "\n========================================" << std::endl;
+  for (const auto& result : results) {
+    std::cout << result.name << ": " << (result.passed ? "✓ 通过" : "✗ 失败") << std::endl;
+    all_passed = all_passed && result.passed;
+  }
+  std::cout << "========================================" << std::endl;
+  return all_passed ? 0 : 1;
+}
+
+}  // namespace test
+}  // namespace darwincore
+
+#endif  // DARWINCORE_TEST_COMMON_HPP
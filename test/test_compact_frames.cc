@@ -0,0 +1,166 @@
+//
+// DarwinCore Network - 紧凑帧与批量帧测试
+//
+// 测试场景：
+//   1. 1000 条 20 字节的遥测消息：紧凑帧比普通帧省字节，批量帧不到普通帧的一半
+//   2. 普通帧、紧凑帧、批量帧混合并逐字节喂入 Decoder：每条消息都被单独、按序交付
+//   3. 截断的批量条目被拒绝（ProtocolError）
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <iostream>
+#include <vector>
+
+#include <darwincore/network/protocol.h>
+
+using namespace darwincore::network;
+
+namespace {
+
+constexpr int kMessageCount = 1000;
+constexpr size_t kTelemetrySize = 20;
+
+std::vector<uint8_t> Telemetry(int index) {
+  std::vector<uint8_t> data(kTelemetrySize);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(index * 7 + i);
+  }
+  return data;
+}
+
+void Append(std::vector<uint8_t>& wire, const proto::Frame& frame) {
+  auto bytes = frame.Serialize();
+  wire.insert(wire.end(), bytes.begin(), bytes.end());
+}
+
+// 把消息编码为批量帧，放不下时换一个新帧
+void AppendBatches(std::vector<uint8_t>& wire, int first, int count) {
+  proto::BatchEncoder batch;
+  for (int i = first; i < first + count; ++i) {
+    auto data = Telemetry(i);
+    if (!batch.Add(i, data.data(), data.size())) {
+      Append(wire, batch.Finish());
+      batch.Add(i, data.data(), data.size());
+    }
+  }
+  if (!batch.Empty()) {
+    Append(wire, batch.Finish());
+  }
+}
+
+// 测试 1: 线上字节数
+bool TestWireSize() {
+  std::cout << "\n========== 测试 1: 线上字节数 ==========" << std::endl;
+
+  std::vector<uint8_t> classic;
+  std::vector<uint8_t> compact;
+  std::vector<uint8_t> batched;
+  for (int i = 0; i < kMessageCount; ++i) {
+    auto data = Telemetry(i);
+    for (const auto& frame : proto::Encoder::EncodeMessage(i, data.data(), data.size())) {
+      Append(classic, frame);
+    }
+    Append(compact, proto::Encoder::EncodeCompactMessage(i, data.data(), data.size()));
+  }
+  AppendBatches(batched, 0, kMessageCount);
+
+  bool pass = compact.size() < classic.size() && batched.size() * 2 <= classic.size();
+  std::cout << (pass ? "[PASS]" : "[FAIL]") << " 普通帧 " << classic.size() << " 字节，紧凑帧 "
+            << compact.size() << " 字节，批量帧 " << batched.size() << " 字节" << std::endl;
+  return pass;
+}
+
+// 测试 2: 混合解码
+bool TestMixedDecode() {
+  std::cout << "\n========== 测试 2: 混合解码 ==========" << std::endl;
+
+  // 0..99 普通帧，100..199 紧凑帧，200..999 批量帧，最后一条大消息走普通分片
+  std::vector<uint8_t> wire;
+  for (int i = 0; i < 100; ++i) {
+    auto data = Telemetry(i);
+    for (const auto& frame : proto::Encoder::EncodeMessage(i, data.data(), data.size())) {
+      Append(wire, frame);
+    }
+  }
+  for (int i = 100; i < 200; ++i) {
+    auto data = Telemetry(i);
+    Append(wire, proto::Encoder::EncodeCompactMessage(i, data.data(), data.size()));
+  }
+  AppendBatches(wire, 200, kMessageCount - 200);
+  std::vector<uint8_t> large(proto::MAX_FRAME_PAYLOAD + 1000, 'L');
+  for (const auto& frame : proto::Encoder::EncodeMessage(kMessageCount, large.data(), large.size())) {
+    Append(wire, frame);
+  }
+
+  proto::Decoder decoder;
+  std::vector<proto::MessageComplete> messages;
+  proto::MessageComplete msg;
+  for (uint8_t byte : wire) {
+    decoder.Feed(&byte, 1);
+    while (decoder.GetMessage(msg)) {
+      messages.push_back(std::move(msg));
+    }
+  }
+
+  bool pass = messages.size() == kMessageCount + 1;
+  for (int i = 0; pass && i < kMessageCount; ++i) {
+    pass = messages[i].message_id == static_cast<uint64_t>(i) && messages[i].data == Telemetry(i);
+  }
+  pass = pass && messages.back().data == large && decoder.GetStats().messages_completed == kMessageCount + 1;
+
+  std::cout << (pass ? "[PASS]" : "[FAIL]") << " 逐字节喂入 " << wire.size() << " 字节，解出 "
+            << messages.size() << " 条消息" << std::endl;
+  return pass;
+}
+
+// 测试 3: 截断的批量条目
+bool TestMalformedBatch() {
+  std::cout << "\n========== 测试 3: 非法批量帧 ==========" << std::endl;
+
+  proto::BatchEncoder batch;
+  auto data = Telemetry(1);
+  batch.Add(1, data.data(), data.size());
+  proto::Frame frame = batch.Finish();
+  frame.payload[1] = static_cast<uint8_t>(kTelemetrySize + 10);  // 声明长度超出帧
+
+  bool rejected = false;
+  try {
+    proto::Decoder decoder;
+    auto bytes = frame.Serialize();
+    decoder.Feed(bytes.data(), bytes.size());
+  } catch (const proto::ProtocolError&) {
+    rejected = true;
+  }
+
+  proto::Frame parsed;
+  auto bytes = proto::Encoder::EncodeCompactMessage(42, data.data(), data.size()).Serialize();
+  bool parsed_ok = proto::Frame::Deserialize(bytes.data(), bytes.size(), parsed) &&
+                   parsed.header.version == proto::VERSION_COMPACT &&
+                   parsed.Serialize() == bytes;
+
+  bool pass = rejected && parsed_ok;
+  std::cout << (pass ? "[PASS]" : "[FAIL]") << " 越界条目" << (rejected ? "被拒绝" : "未被拒绝")
+            << "，紧凑帧反序列化" << (parsed_ok ? "正确" : "错误") << std::endl;
+  return pass;
+}
+
+}  // namespace
+
+int main() {
+  std::cout << "========================================" << std::endl;
+  std::cout << "  DarwinCore - 紧凑帧与批量帧测试" << std::endl;
+  std::cout << "========================================" << std::endl;
+
+  bool pass1 = TestWireSize();
+  bool pass2 = TestMixedDecode();
+  bool pass3 = TestMalformedBatch();
+
+  std::cout << "\n========================================" << std::endl;
+  std::cout << "线上字节数: " << (pass1 ? "✓ 通过" : "✗ 失败") << std::endl;
+  std::cout << "混合解码:   " << (pass2 ? "✓ 通过" : "✗ 失败") << std::endl;
+  std::cout << "非法批量帧: " << (pass3 ? "✓ 通过" : "✗ 失败") << std::endl;
+  std::cout << "========================================" << std::endl;
+
+  return (pass1 && pass2 && pass3) ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+//
+// DarwinCore Network - 连接上下文测试
+//
+// 测试场景：
+//   1. 每个连接在建立时创建上下文，消息/断开回调拿到的是本连接的上下文，
+//      断开回调返回后上下文被销毁
+//   2. Stop() 时仍在线的连接，其上下文随服务器停止一并销毁
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kConnectionContext;
+constexpr int kClients = 8;
+constexpr int kMessagesPerClient = 50;
+
+std::atomic<int> g_live_sessions{0};
+
+// 业务层的每连接状态：只在该连接的 Worker 线程中访问，不加锁
+struct Session {
+  explicit Session(uint64_t id) : connection_id(id) { g_live_sessions.fetch_add(1); }
+  ~Session() { g_live_sessions.fetch_sub(1); }
+
+  uint64_t connection_id;
+  size_t bytes = 0;
+};
+
+struct Observed {
+  std::atomic<size_t> bytes{0};
+  std::atomic<int> mismatches{0};
+  std::atomic<int> disconnects_with_context{0};
+};
+
+void InstallHandlers(Server& server, Observed& observed) {
+  server.SetConnectionContextFactory([](const ConnectionInformation& info) {
+    return std::make_shared<Session>(info.connection_id);
+  });
+  server.SetOnContextMessage(
+      [&](uint64_t conn_id, const std::vector<uint8_t>& data, void* context) {
+        auto* session = static_cast<Session*>(context);
+        if (session == nullptr || session->connection_id != conn_id) {
+          observed.mismatches.fetch_add(1);
+          return;
+        }
+        session->bytes += data.size();
+        observed.bytes.fetch_add(data.size());
+      });
+  server.SetOnContextDisconnected([&](uint64_t conn_id, void* context) {
+    auto* session = static_cast<Session*>(context);
+    if (session != nullptr && session->connection_id == conn_id &&
+        session->bytes == static_cast<size_t>(kMessagesPerClient) * 4) {
+      observed.disconnects_with_context.fetch_add(1);
+    }
+  });
+}
+
+// 测试 1: 上下文随连接创建和销毁
+bool TestContextLifecycle() {
+  std::cout << "\n========== 测试 1: 上下文生命周期 ==========" << std::endl;
+
+  Server server;
+  Observed observed;
+  InstallHandlers(server, observed);
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return false;
+  }
+
+  std::vector<std::unique_ptr<Client>> clients;
+  for (int i = 0; i < kClients; ++i) {
+    auto client = std::make_unique<Client>();
+    if (!client->ConnectIPv4("127.0.0.1", kTestPort)) {
+      std::cerr << "[Client " << i << "] 连接失败" << std::endl;
+      return false;
+    }
+    clients.push_back(std::move(client));
+  }
+  WaitUntil([&] { return g_live_sessions.load() == kClients; }, 3000);
+  bool created = g_live_sessions.load() == kClients;
+
+  const uint8_t message[4] = {'c', 't', 'x', '!'};
+  for (int m = 0; m < kMessagesPerClient; ++m) {
+    for (auto& client : clients) {
+      client->SendData(message, sizeof(message));
+    }
+  }
+  size_t expected = static_cast<size_t>(kClients) * kMessagesPerClient * sizeof(message);
+  WaitUntil([&] { return observed.bytes.load() == expected; }, 5000);
+  bool delivered = observed.bytes.load() == expected && observed.mismatches.load() == 0;
+
+  for (auto& client : clients) {
+    client->Disconnect();
+  }
+  WaitUntil([&] { return g_live_sessions.load() == 0; }, 3000);
+  bool destroyed = g_live_sessions.load() == 0 &&
+                   observed.disconnects_with_context.load() == kClients;
+
+  server.Stop();
+
+  std::cout << (created ? "[PASS]" : "[FAIL]") << " 连接建立时创建上下文" << std::endl;
+  std::cout << (delivered ? "[PASS]" : "[FAIL]") << " 消息回调拿到本连接的上下文（"
+            << observed.bytes.load() << "/" << expected << " 字节，错配 "
+            << observed.mismatches.load() << "）" << std::endl;
+  std::cout << (destroyed ? "[PASS]" : "[FAIL]") << " 断开回调拿到上下文后销毁（"
+            << observed.disconnects_with_context.load() << "/" << kClients << "）" << std::endl;
+  return created && delivered && destroyed;
+}
+
+// 测试 2: Stop() 销毁仍在线连接的上下文
+bool TestStopReleasesContexts() {
+  std::cout << "\n========== 测试 2: Stop 释放上下文 ==========" << std::endl;
+
+  Observed observed;
+  std::vector<std::unique_ptr<Client>> clients;
+  {
+    Server server;
+    InstallHandlers(server, observed);
+    if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+      std::cerr << "[Server] 启动失败!" << std::endl;
+      return false;
+    }
+
+    for (int i = 0; i < kClients; ++i) {
+      auto client = std::make_unique<Client>();
+      client->ConnectIPv4("127.0.0.1", kTestPort);
+      clients.push_back(std::move(client));
+    }
+    WaitUntil([&] { return g_live_sessions.load() == kClients; }, 3000);
+    server.Stop();
+  }
+
+  bool released = g_live_sessions.load() == 0;
+  std::cout << (released ? "[PASS]" : "[FAIL]") << " 停止后剩余上下文 "
+            << g_live_sessions.load() << std::endl;
+
+  for (auto& client : clients) {
+    client->Disconnect();
+  }
+  return released;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("连接上下文测试");
+
+  bool pass1 = TestContextLifecycle();
+  bool pass2 = TestStopReleasesContexts();
+
+  return FinishTest({{"上下文生命周期", pass1}, {"Stop 释放上下文", pass2}});
+}
@@ -0,0 +1,151 @@
+//
+// DarwinCore Network - 连接内存占用测试
+//
+// 测试场景：
+//   1. 大量空闲连接：发送缓冲区不分配，每连接库内存开销低于 1KB
+//   2. 突发写入使发送缓冲区扩容，对端读完并空闲一段时间后缓冲区被回收，
+//      每连接开销回到空闲水平
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kConnectionMemory;
+constexpr int kIdleConnections = 50;
+constexpr size_t kBurstBytes = 16 * 1024 * 1024;
+constexpr size_t kBurstChunk = 64 * 1024;
+constexpr uint64_t kIdleBudgetPerConnection = 1024;
+
+int ConnectRaw() {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(kTestPort);
+  inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+uint16_t LocalPort(int fd) {
+  sockaddr_in addr{};
+  socklen_t len = sizeof(addr);
+  getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+  return ntohs(addr.sin_port);
+}
+
+uint64_t PerConnection(const ServerStatistics& stats) {
+  return stats.active_connections == 0 ? 0
+                                       : stats.connection_memory_bytes / stats.active_connections;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("连接内存占用测试");
+
+  ServerOptions options;
+  options.send_buffer_idle_release = std::chrono::milliseconds(200);
+  Server server(options);
+
+  std::mutex mutex;
+  std::unordered_map<uint16_t, uint64_t> port_to_connection;
+  server.SetOnClientConnected([&](const ConnectionInformation& info) {
+    std::lock_guard<std::mutex> lock(mutex);
+    port_to_connection[info.peer_port] = info.connection_id;
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  // 测试 1: 空闲连接
+  std::cout << "\n========== 测试 1: 空闲连接 ==========" << std::endl;
+  std::vector<int> sockets;
+  for (int i = 0; i < kIdleConnections; ++i) {
+    int fd = ConnectRaw();
+    if (fd >= 0) {
+      sockets.push_back(fd);
+    }
+  }
+  WaitUntil([&] { return server.GetStatistics().active_connections == sockets.size(); }, 15000);
+
+  ServerStatistics idle = server.GetStatistics();
+  bool pass1 = idle.active_connections == kIdleConnections && idle.send_buffer_capacity_bytes == 0 &&
+               PerConnection(idle) < kIdleBudgetPerConnection;
+  std::cout << (pass1 ? "[PASS]" : "[FAIL]") << " " << idle.active_connections
+            << " 个空闲连接，每连接 " << PerConnection(idle) << " 字节，发送缓冲区 "
+            << idle.send_buffer_capacity_bytes << " 字节" << std::endl;
+
+  // 测试 2: 突发写入后回收
+  std::cout << "\n========== 测试 2: 突发后回收 ==========" << std::endl;
+  int reader = sockets.front();
+  uint64_t conn_id = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    conn_id = port_to_connection[LocalPort(reader)];
+  }
+
+  std::vector<uint8_t> chunk(kBurstChunk, 'm');
+  for (size_t sent = 0; sent < kBurstBytes; sent += kBurstChunk) {
+    server.SendData(conn_id, chunk.data(), chunk.size());
+  }
+  WaitUntil([&] { return server.GetStatistics().send_buffer_capacity_bytes > 1024 * 1024; }, 3000);
+  ServerStatistics burst = server.GetStatistics();
+
+  // 对端读完全部数据
+  std::vector<uint8_t> sink(256 * 1024);
+  size_t received = 0;
+  while (received < kBurstBytes) {
+    ssize_t ret = recv(reader, sink.data(), sink.size(), 0);
+    if (ret <= 0) {
+      break;
+    }
+    received += static_cast<size_t>(ret);
+  }
+
+  bool released = WaitUntil(
+      [&] {
+        ServerStatistics stats = server.GetStatistics();
+        return stats.send_buffer_capacity_bytes == 0 && stats.send_buffer_releases > 0;
+      },
+      3000);
+  ServerStatistics after = server.GetStatistics();
+
+  bool pass2 = received == kBurstBytes && burst.send_buffer_capacity_bytes > 1024 * 1024 &&
+               released && PerConnection(after) < kIdleBudgetPerConnection;
+  std::cout << (pass2 ? "[PASS]" : "[FAIL]") << " 突发时发送缓冲区 "
+            << burst.send_buffer_capacity_bytes << " 字节，读完 " << received
+            << " 字节后回收到 " << after.send_buffer_capacity_bytes << " 字节（每连接 "
+            << PerConnection(after) << " 字节）" << std::endl;
+
+  for (int fd : sockets) {
+    close(fd);
+  }
+  server.Stop();
+
+  return FinishTest({{"空闲连接", pass1}, {"突发后回收", pass2}});
+}
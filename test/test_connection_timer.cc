@@ -0,0 +1,232 @@
+//
+// DarwinCore Network - 连接定时器测试
+//
+// 测试场景：
+//   1. RunEvery 在连接所在 Worker 线程周期触发，回调中取消自身后不再触发
+//   2. RunAfter 到期触发；从其他线程取消的定时器不触发；大量定时器批量取消
+//   3. 连接断开后其定时器自动取消
+//   4. 对已断开或未知的连接添加的定时器不触发
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kConnectionTimer;
+constexpr int kBulkTimers = 10000;
+
+// 只在连接所在 Worker 线程访问
+struct Session {
+  std::thread::id worker_thread;
+  Server::TimerId heartbeat = 0;
+  int heartbeats = 0;
+};
+
+class TimerFixture {
+ public:
+  bool Start() {
+    server_.SetConnectionContextFactory([](const ConnectionInformation&) {
+      auto session = std::make_shared<Session>();
+      session->worker_thread = std::this_thread::get_id();
+      return session;
+    });
+    server_.SetOnClientConnected(
+        [this](const ConnectionInformation& info) { connection_id_.store(info.connection_id); });
+    server_.SetOnClientDisconnected([this](uint64_t) { disconnected_.store(true); });
+
+    if (!server_.StartIPv4("127.0.0.1", kTestPort)) {
+      std::cerr << "[Server] 启动失败!" << std::endl;
+      return false;
+    }
+    return Connect();
+  }
+
+  bool Connect() {
+    connection_id_.store(0);
+    disconnected_.store(false);
+    client_ = std::make_unique<Client>();
+    return client_->ConnectIPv4("127.0.0.1", kTestPort) &&
+           WaitUntil([this] { return connection_id_.load() != 0; }, 3000);
+  }
+
+  void Disconnect() {
+    client_->Disconnect();
+    WaitUntil([this] { return disconnected_.load(); }, 3000);
+  }
+
+  void Stop() { server_.Stop(); }
+
+  Server& server() { return server_; }
+  uint64_t connection_id() const { return connection_id_.load(); }
+
+ private:
+  Server server_;
+  std::unique_ptr<Client> client_;
+  std::atomic<uint64_t> connection_id_{0};
+  std::atomic<bool> disconnected_{false};
+};
+
+// 测试 1: 周期定时器与自身取消
+bool TestRunEvery(TimerFixture& fixture) {
+  std::cout << "\n========== 测试 1: RunEvery ==========" << std::endl;
+
+  Server& server = fixture.server();
+  uint64_t conn_id = fixture.connection_id();
+  std::atomic<int> fired{0};
+  std::atomic<bool> wrong_thread{false};
+
+  // 在连接线程中启动心跳，第 5 次触发时取消自身
+  server.Post(conn_id, [&](void* context) {
+    auto* session = static_cast<Session*>(context);
+    session->heartbeat = server.RunEvery(conn_id, std::chrono::milliseconds(20),
+                                         [&](void* ctx) {
+      auto* s = static_cast<Session*>(ctx);
+      wrong_thread.store(wrong_thread.load() || s->worker_thread != std::this_thread::get_id());
+      fired.fetch_add(1);
+      if (++s->heartbeats == 5) {
+        server.CancelTimer(s->heartbeat);
+      }
+    });
+  });
+
+  WaitUntil([&] { return fired.load() >= 5; }, 3000);
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  bool pass = fired.load() == 5 && !wrong_thread.load();
+  std::cout << (pass ? "[PASS]" : "[FAIL]") << " 周期触发 " << fired.load()
+            << " 次后在回调中取消自身" << std::endl;
+  return pass;
+}
+
+// 测试 2: 一次性定时器、跨线程取消与批量取消
+bool TestRunAfter(TimerFixture& fixture) {
+  std::cout << "\n========== 测试 2: RunAfter / CancelTimer ==========" << std::endl;
+
+  Server& server = fixture.server();
+  uint64_t conn_id = fixture.connection_id();
+
+  std::atomic<bool> had_context{false};
+  std::atomic<int> fired{0};
+  std::atomic<int> cancelled_fired{0};
+  server.RunAfter(conn_id, std::chrono::milliseconds(30), [&](void* context) {
+    had_context.store(context != nullptr);
+    fired.fetch_add(1);
+  });
+  Server::TimerId doomed = server.RunAfter(conn_id, std::chrono::milliseconds(200),
+                                           [&](void*) { cancelled_fired.fetch_add(1); });
+  bool cancel_accepted = server.CancelTimer(doomed);
+
+  // 批量添加并取消，验证取消不随定时器数量变慢
+  std::vector<Server::TimerId> bulk;
+  bulk.reserve(kBulkTimers);
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < kBulkTimers; ++i) {
+    bulk.push_back(server.RunAfter(conn_id, std::chrono::milliseconds(100 + i % 50),
+                                   [&](void*) { cancelled_fired.fetch_add(1); }));
+  }
+  for (Server::TimerId id : bulk) {
+    server.CancelTimer(id);
+  }
+  auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - begin)
+                        .count();
+
+  WaitUntil([&] { return fired.load() == 1; }, 3000);
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  bool one_shot = fired.load() == 1 && had_context.load();
+  bool cancelled = cancel_accepted && cancelled_fired.load() == 0;
+  std::cout << (one_shot ? "[PASS]" : "[FAIL]") << " RunAfter 触发一次并拿到上下文" << std::endl;
+  std::cout << (cancelled ? "[PASS]" : "[FAIL]") << " 取消的定时器未触发（含 " << kBulkTimers
+            << " 个批量定时器，添加+取消耗时 " << elapsed_ms << "ms）" << std::endl;
+  return one_shot && cancelled;
+}
+
+// 测试 3: 断开连接自动取消定时器
+bool TestCancelOnDisconnect(TimerFixture& fixture) {
+  std::cout << "\n========== 测试 3: 断开自动取消 ==========" << std::endl;
+
+  Server& server = fixture.server();
+  uint64_t conn_id = fixture.connection_id();
+  std::atomic<int> fired{0};
+  server.RunEvery(conn_id, std::chrono::milliseconds(20), [&](void*) { fired.fetch_add(1); });
+
+  WaitUntil([&] { return fired.load() >= 2; }, 3000);
+  fixture.Disconnect();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  int after_disconnect = fired.load();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  bool pass = after_disconnect >= 2 && fired.load() == after_disconnect;
+  std::cout << (pass ? "[PASS]" : "[FAIL]") << " 断开后定时器停止（断开前触发 "
+            << after_disconnect << " 次，之后 " << fired.load() - after_disconnect << " 次）"
+            << std::endl;
+  return pass;
+}
+
+// 测试 4: 断开后再添加定时器
+bool TestTimerAfterDisconnect(TimerFixture& fixture) {
+  std::cout << "\n========== 测试 4: 断开后添加定时器 ==========" << std::endl;
+
+  Server& server = fixture.server();
+  // 测试 3 已断开 connection_id() 对应的连接
+  uint64_t closed_id = fixture.connection_id();
+  std::atomic<int> fired{0};
+  server.RunEvery(closed_id, std::chrono::milliseconds(20), [&](void*) { fired.fetch_add(1); });
+  server.RunAfter(closed_id, std::chrono::milliseconds(20), [&](void*) { fired.fetch_add(1); });
+  server.RunEvery(closed_id + 0x10000, std::chrono::milliseconds(20),
+                  [&](void*) { fired.fetch_add(1); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  bool dropped = fired.load() == 0;
+
+  // 新连接的定时器不受影响
+  std::atomic<int> live_fired{0};
+  bool reconnected = fixture.Connect();
+  if (reconnected) {
+    server.RunAfter(fixture.connection_id(), std::chrono::milliseconds(20),
+                    [&](void*) { live_fired.fetch_add(1); });
+  }
+  bool live = reconnected && WaitUntil([&] { return live_fired.load() == 1; }, 3000);
+  fixture.Disconnect();
+
+  std::cout << (dropped ? "[PASS]" : "[FAIL]") << " 已断开/未知连接的定时器未触发（触发 "
+            << fired.load() << " 次）" << std::endl;
+  std::cout << (live ? "[PASS]" : "[FAIL]") << " 新连接的定时器正常触发" << std::endl;
+  return dropped && live;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("连接定时器测试");
+
+  TimerFixture fixture;
+  if (!fixture.Start()) {
+    return 1;
+  }
+
+  bool pass1 = TestRunEvery(fixture);
+  bool pass2 = TestRunAfter(fixture);
+  bool pass3 = TestCancelOnDisconnect(fixture);
+  bool pass4 = TestTimerAfterDisconnect(fixture);
+  fixture.Stop();
+
+  return FinishTest({{"RunEvery", pass1},
+                     {"RunAfter", pass2},
+                     {"断开自动取消", pass3},
+                     {"断开后添加", pass4}});
+}
@@ -0,0 +1,212 @@
+//
+// DarwinCore Network - 弹性 Worker 测试
+//
+// 测试场景：
+//   1. 多个连接突发大量处理较慢的消息：Worker 线程数增长到上限以下的某个值，
+//      每个连接的消息仍按序、串行处理，连接定时器在扩容期间正常触发
+//   2. 连接断开、负载消失后，空闲线程逐个退出，线程数回落到下限
+//   3. Stop 时仍在排队的任务在 Worker 线程中执行完，不在调用 Stop 的线程中执行
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kElasticWorkers;
+constexpr int kClientCount = 8;
+constexpr uint64_t kMessagesPerClient = 150;
+constexpr uint64_t kMessagesPerSend = 10;
+constexpr size_t kMinWorkers = 1;
+constexpr size_t kMaxWorkers = 4;
+constexpr int kTasksAtStop = 64;
+
+// 每个连接的状态：半包缓冲、期望的下一个序号、是否正在回调中
+struct Session {
+  std::vector<uint8_t> pending;
+  uint64_t next_seq = 0;
+  uint64_t timer_ticks = 0;
+  std::atomic<bool> busy{false};
+};
+
+}  // namespace
+
+int main() {
+  BeginTest("弹性 Worker 测试");
+
+  ServerOptions options;
+  options.max_workers = kMaxWorkers;
+  options.min_workers = kMinWorkers;
+  options.worker_grow_latency = std::chrono::microseconds(1000);
+  options.worker_idle_shrink = std::chrono::milliseconds(300);
+  Server server(options);
+
+  std::atomic<uint64_t> processed{0};
+  std::atomic<uint64_t> completed{0};
+  std::atomic<uint64_t> timer_ticks{0};
+  std::atomic<bool> out_of_order{false};
+  std::atomic<bool> overlapped{false};
+
+  // 同一连接的回调（消息与定时器）不能并发进入
+  auto enter = [&](Session* session) {
+    if (session->busy.exchange(true)) {
+      overlapped = true;
+    }
+  };
+  auto leave = [](Session* session) { session->busy = false; };
+
+  server.SetConnectionContextFactory([](const ConnectionInformation&) {
+    return std::make_shared<Session>();
+  });
+  server.SetOnClientConnected([&](const ConnectionInformation& info) {
+    server.RunEvery(info.connection_id, std::chrono::milliseconds(20), [&](void* context) {
+      auto* session = static_cast<Session*>(context);
+      if (session == nullptr) {
+        return;
+      }
+      enter(session);
+      ++session->timer_ticks;
+      ++timer_ticks;
+      leave(session);
+    });
+  });
+  server.SetOnContextMessage([&](uint64_t, const std::vector<uint8_t>& data, void* context) {
+    auto* session = static_cast<Session*>(context);
+    enter(session);
+    session->pending.insert(session->pending.end(), data.begin(), data.end());
+    size_t offset = 0;
+    for (; offset + sizeof(uint64_t) <= session->pending.size(); offset += sizeof(uint64_t)) {
+      uint64_t seq = 0;
+      std::memcpy(&seq, session->pending.data() + offset, sizeof(seq));
+      if (seq != session->next_seq) {
+        out_of_order = true;
+      }
+      session->next_seq = seq + 1;
+
+      // 模拟较慢的业务处理
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      ++processed;
+    }
+    session->pending.erase(session->pending.begin(), session->pending.begin() + offset);
+    leave(session);
+  });
+  server.SetOnContextDisconnected([&](uint64_t, void* context) {
+    auto* session = static_cast<Session*>(context);
+    if (session->next_seq == kMessagesPerClient) {
+      ++completed;
+    }
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+  size_t initial_threads = server.GetStatistics().worker_threads;
+
+  std::vector<std::unique_ptr<Client>> clients;
+  for (int i = 0; i < kClientCount; ++i) {
+    auto client = std::make_unique<Client>();
+    if (!client->ConnectIPv4("127.0.0.1", kTestPort)) {
+      std::cerr << "[Client] 连接失败!" << std::endl;
+      server.Stop();
+      return 1;
+    }
+    clients.push_back(std::move(client));
+  }
+  WaitUntil(
+      [&] {
+        return std::all_of(clients.begin(), clients.end(),
+                           [](const std::unique_ptr<Client>& c) { return c->IsConnected(); });
+      },
+      5000);
+
+  // ========== 测试 1: 突发负载 ==========
+  std::cout << "\n========== 测试 1: 突发负载 ==========" << std::endl;
+
+  // 每次发送 10 条消息，服务器按 8 字节切分
+  for (uint64_t first = 0; first < kMessagesPerClient; first += kMessagesPerSend) {
+    std::vector<uint64_t> batch;
+    for (uint64_t seq = first; seq < std::min(first + kMessagesPerSend, kMessagesPerClient); ++seq) {
+      batch.push_back(seq);
+    }
+    for (auto& client : clients) {
+      client->SendData(reinterpret_cast<const uint8_t*>(batch.data()), batch.size() * sizeof(uint64_t));
+    }
+  }
+
+  const uint64_t total = kClientCount * kMessagesPerClient;
+  size_t peak_threads = 0;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (processed < total && std::chrono::steady_clock::now() < deadline) {
+    peak_threads = std::max(peak_threads, server.GetStatistics().worker_threads);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  WaitUntil([&] { return timer_ticks >= kClientCount; }, 2000);
+  ServerStatistics burst = server.GetStatistics();
+
+  bool pass1 = initial_threads == kMinWorkers && processed == total && peak_threads > kMinWorkers &&
+               peak_threads <= kMaxWorkers && burst.worker_scale_ups > 0 && !out_of_order &&
+               !overlapped && timer_ticks >= kClientCount;
+  std::cout << (pass1 ? "[PASS]" : "[FAIL]") << " 处理 " << processed << "/" << total
+            << " 条消息，线程数 " << initial_threads << " -> 峰值 " << peak_threads << "（扩容 "
+            << burst.worker_scale_ups << " 次），" << (out_of_order ? "乱序" : "按序")
+            << "，" << (overlapped ? "同一连接并发" : "同一连接串行") << "，定时器触发 "
+            << timer_ticks << " 次" << std::endl;
+
+  // ========== 测试 2: 空闲缩容 ==========
+  std::cout << "\n========== 测试 2: 空闲缩容 ==========" << std::endl;
+
+  for (auto& client : clients) {
+    client->Disconnect();
+  }
+  bool all_closed = WaitUntil([&] { return completed == kClientCount; }, 5000);
+  bool shrunk = WaitUntil([&] { return server.GetStatistics().worker_threads == kMinWorkers; }, 5000);
+  ServerStatistics idle = server.GetStatistics();
+
+  bool pass2 = all_closed && shrunk && idle.worker_scale_downs > 0 && !overlapped;
+  std::cout << (pass2 ? "[PASS]" : "[FAIL]") << " " << completed << "/" << kClientCount
+            << " 个连接收齐全部消息，空闲后线程数 " << idle.worker_threads << "（缩容 "
+            << idle.worker_scale_downs << " 次）" << std::endl;
+
+  // ========== 测试 3: 停止时处理剩余任务 ==========
+  std::cout << "\n========== 测试 3: 停止时处理剩余任务 ==========" << std::endl;
+
+  // 先放一个慢任务占住 Worker，保证其余任务在 Stop 时仍在排队
+  const std::thread::id main_thread = std::this_thread::get_id();
+  std::atomic<int> ran_at_stop{0};
+  std::atomic<bool> ran_on_caller{false};
+  server.Post(0, [](void*) { std::this_thread::sleep_for(std::chrono::milliseconds(50)); });
+  for (int i = 0; i < kTasksAtStop; ++i) {
+    server.Post(static_cast<uint64_t>(i), [&](void*) {
+      if (std::this_thread::get_id() == main_thread) {
+        ran_on_caller = true;
+      }
+      ++ran_at_stop;
+    });
+  }
+
+  server.Stop();
+
+  bool pass3 = ran_at_stop == kTasksAtStop && !ran_on_caller;
+  std::cout << (pass3 ? "[PASS]" : "[FAIL]") << " Stop 前排队的任务执行 " << ran_at_stop << "/"
+            << kTasksAtStop << " 个，" << (ran_on_caller ? "有任务在调用线程执行" : "均在 Worker 线程执行")
+            << std::endl;
+
+  return FinishTest({{"突发扩容", pass1}, {"空闲缩容", pass2}, {"停止处理", pass3}});
+}
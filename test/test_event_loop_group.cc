@@ -0,0 +1,203 @@
+//
+// DarwinCore Network - EventLoopGroup 测试
+//
+// 测试场景：
+//   1. TCP 与 UDS 两个 Server 以及它们的 Client 共享同一个 EventLoopGroup，
+//      各自的回显互不串扰，每个 Server 只统计自己的连接，也不能向另一个
+//      Server 的连接发送
+//   2. 组内 Server 的 Post/RunAfter 在连接的 Worker 上执行并拿到连接上下文
+//   3. 停止一个 Server 只关闭它自己的连接（不触发断开回调），另一个 Server
+//      继续服务；停止后的 Server 可以在同一个组上重新启动
+//   4. 组内 Server 设置连接限速等保护性选项时启动失败
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/event_loop_group.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kEventLoopGroup;
+constexpr const char* kSocketPath = "/tmp/darwincore_test_event_loop_group.sock";
+constexpr int kMessages = 20;
+
+// 回显服务器：回显时在数据前加上自己的标签，用于检查消息没有串到另一个 Server
+struct EchoServer {
+  EchoServer(const std::shared_ptr<EventLoopGroup>& group, const std::string& tag)
+      : server(group), tag(tag) {
+    server.SetConnectionContextFactory([](const ConnectionInformation&) {
+      return std::make_shared<int>(0);
+    });
+    server.SetOnClientConnected([this](const ConnectionInformation& info) {
+      last_connection = info.connection_id;
+      ++connected;
+    });
+    server.SetOnMessage([this](uint64_t connection_id, const std::vector<uint8_t>& data) {
+      std::vector<uint8_t> reply(this->tag.begin(), this->tag.end());
+      reply.insert(reply.end(), data.begin(), data.end());
+      server.SendData(connection_id, reply.data(), reply.size());
+    });
+    server.SetOnClientDisconnected([this](uint64_t) { ++disconnected; });
+  }
+
+  Server server;
+  std::string tag;
+  std::atomic<uint64_t> last_connection{0};
+  std::atomic<int> connected{0};
+  std::atomic<int> disconnected{0};
+};
+
+// 组上的回显客户端：记录收到的字节数，以及是否收到过别的 Server 的标签
+struct EchoClient {
+  EchoClient(const std::shared_ptr<EventLoopGroup>& group, const std::string& tag)
+      : client(group), tag(tag) {
+    client.SetOnMessage([this](const std::vector<uint8_t>& data) {
+      std::string text(data.begin(), data.end());
+      if (text.find(this->tag) == std::string::npos) {
+        wrong_server = true;
+      }
+      received += data.size();
+    });
+    client.SetOnDisconnected([this]() { closed = true; });
+  }
+
+  // 发送 kMessages 条消息，等待全部回显
+  bool Echo(const std::string& prefix) {
+    size_t expected = received.load();
+    for (int i = 0; i < kMessages; ++i) {
+      std::string msg = prefix + "-" + std::to_string(i);
+      if (!client.SendData(reinterpret_cast<const uint8_t*>(msg.data()), msg.size())) {
+        return false;
+      }
+      expected += tag.size() + msg.size();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return WaitUntil([&] { return received.load() == expected; }, 5000) && !wrong_server;
+  }
+
+  Client client;
+  std::string tag;
+  std::atomic<size_t> received{0};
+  std::atomic<bool> wrong_server{false};
+  std::atomic<bool> closed{false};
+};
+
+}  // namespace
+
+int main() {
+  BeginTest("EventLoopGroup 测试");
+
+  auto group = std::make_shared<EventLoopGroup>(2, 2);
+  EchoServer tcp_server(group, "[tcp]");
+  EchoServer uds_server(group, "[uds]");
+
+  if (!tcp_server.server.StartIPv4("127.0.0.1", kTestPort) ||
+      !uds_server.server.StartUnixDomain(kSocketPath)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  // ========== 测试 1: 共享组回显 ==========
+  std::cout << "\n========== 测试 1: 共享组回显 ==========" << std::endl;
+
+  EchoClient tcp_client(group, "[tcp]");
+  auto uds_client = std::make_unique<EchoClient>(group, "[uds]");
+  bool connected = tcp_client.client.ConnectIPv4("127.0.0.1", kTestPort) &&
+                   uds_client->client.ConnectUnixDomain(kSocketPath) &&
+                   WaitUntil([&] {
+                     return tcp_server.connected == 1 && uds_server.connected == 1;
+                   }, 5000);
+
+  bool echoed = connected && tcp_client.Echo("tcp") && uds_client->Echo("uds");
+  ServerStatistics tcp_stats = tcp_server.server.GetStatistics();
+  ServerStatistics uds_stats = uds_server.server.GetStatistics();
+
+  const std::string foreign = "foreign";
+  bool foreign_rejected = !uds_server.server.SendData(
+      tcp_server.last_connection, reinterpret_cast<const uint8_t*>(foreign.data()), foreign.size());
+
+  // 两个服务端连接 + 两个客户端连接都挂在组上
+  bool pass1 = echoed && foreign_rejected && group->GetConnectionCount() == 4 &&
+               tcp_stats.active_connections == 1 && uds_stats.active_connections == 1;
+  std::cout << (pass1 ? "[PASS]" : "[FAIL]") << " 回显"
+            << (echoed ? "正确" : "失败") << "，跨 Server 发送"
+            << (foreign_rejected ? "被拒绝" : "未被拒绝") << "，组内连接数 " << group->GetConnectionCount()
+            << "，TCP/UDS 活跃连接 " << tcp_stats.active_connections << "/"
+            << uds_stats.active_connections << "，线程数 " << group->GetLoopCount() << "+"
+            << group->GetWorkerCount() << std::endl;
+
+  // ========== 测试 2: 连接线程任务 ==========
+  std::cout << "\n========== 测试 2: 连接线程任务 ==========" << std::endl;
+
+  uint64_t connection_id = tcp_server.last_connection;
+  std::atomic<int> posted{0};
+  std::atomic<int> fired{0};
+  std::atomic<bool> missing_context{false};
+  tcp_server.server.Post(connection_id, [&](void* context) {
+    missing_context = missing_context || context == nullptr;
+    ++posted;
+  });
+  tcp_server.server.RunAfter(connection_id, std::chrono::milliseconds(20), [&](void* context) {
+    missing_context = missing_context || context == nullptr;
+    ++fired;
+  });
+
+  bool pass2 = WaitUntil([&] { return posted == 1 && fired == 1; }, 2000) && !missing_context;
+  std::cout << (pass2 ? "[PASS]" : "[FAIL]") << " Post 执行 " << posted << " 次，定时器触发 "
+            << fired << " 次，" << (missing_context ? "缺少连接上下文" : "均带连接上下文")
+            << std::endl;
+
+  // ========== 测试 3: 单独停止一个 Server ==========
+  std::cout << "\n========== 测试 3: 单独停止一个 Server ==========" << std::endl;
+
+  uds_server.server.Stop();
+  bool uds_closed = WaitUntil([&] { return uds_client->closed.load(); }, 5000);
+  bool tcp_alive = tcp_client.Echo("tcp-after-stop");
+  uds_client.reset();
+  bool drained = WaitUntil([&] { return group->GetConnectionCount() == 2; }, 5000);
+
+  // 在同一个组上重新启动
+  bool restarted = uds_server.server.StartUnixDomain(kSocketPath);
+  EchoClient uds_again(group, "[uds]");
+  bool uds_echoed = restarted && uds_again.client.ConnectUnixDomain(kSocketPath) &&
+                    WaitUntil([&] { return uds_server.connected == 2; }, 5000) &&
+                    uds_again.Echo("uds-again");
+
+  bool pass3 = uds_closed && tcp_alive && drained && uds_server.disconnected == 0 &&
+               tcp_server.disconnected == 0 && uds_echoed;
+  std::cout << (pass3 ? "[PASS]" : "[FAIL]") << " UDS 客户端"
+            << (uds_closed ? "已断开" : "未断开") << "，TCP 回显" << (tcp_alive ? "正常" : "失败")
+            << "，断开回调 " << uds_server.disconnected << " 次，重新启动后回显"
+            << (uds_echoed ? "正常" : "失败") << std::endl;
+
+  uds_again.client.Disconnect();
+  tcp_client.client.Disconnect();
+  uds_server.server.Stop();
+  tcp_server.server.Stop();
+
+  // ========== 测试 4: 保护性选项拒绝启动 ==========
+  std::cout << "\n========== 测试 4: 保护性选项拒绝启动 ==========" << std::endl;
+
+  ServerOptions limited_options;
+  limited_options.connection_ingress_limit.bytes_per_second = 1024 * 1024;
+  Server limited(group, limited_options);
+  bool pass4 = !limited.StartIPv4("127.0.0.1", kTestPort) && group->IsRunning();
+  std::cout << (pass4 ? "[PASS]" : "[FAIL]") << " 设置连接限速的 Server "
+            << (pass4 ? "启动失败" : "未被拒绝") << std::endl;
+
+  return FinishTest({{"共享组回显", pass1}, {"连接线程任务", pass2}, {"单独停止", pass3}, {"保护性选项", pass4}});
+}
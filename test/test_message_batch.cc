@@ -0,0 +1,176 @@
+//
+// DarwinCore Network - 批量消息回调测试
+//
+// 测试场景：
+//   1. 多个连接每毫秒发送一条小消息，批量回调处理较慢（模拟一次数据库提交）：
+//      排队的数据事件合成一批交付，一批内按连接分组且带上下文，
+//      每个连接的数据仍按序到达，OnMessage 不再被调用
+//   2. 断开事件在该连接的全部数据之后交付（批次不越过其他类型的事件）
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kMessageBatch;
+constexpr int kClientCount = 4;
+constexpr uint64_t kMessagesPerClient = 200;
+
+int Connect() {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(kTestPort);
+  inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// 每个连接的状态：半包缓冲与期望的下一个序号
+struct Session {
+  std::vector<uint8_t> pending;
+  uint64_t next_seq = 0;
+};
+
+}  // namespace
+
+int main() {
+  BeginTest("批量消息回调测试");
+
+  Server server;
+  std::atomic<uint64_t> received{0};
+  std::atomic<uint64_t> single_calls{0};
+  std::atomic<size_t> largest_batch{0};
+  std::atomic<uint64_t> completed{0};
+  std::atomic<bool> out_of_order{false};
+  std::atomic<bool> bad_grouping{false};
+
+  server.SetConnectionContextFactory([](const ConnectionInformation&) {
+    return std::make_shared<Session>();
+  });
+  server.SetOnMessage([&](uint64_t, const std::vector<uint8_t>&) { ++single_calls; });
+  server.SetOnMessageBatch([&](const std::vector<Server::ConnectionMessages>& batch) {
+    size_t events = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+      const auto& conn = batch[i];
+      auto* session = static_cast<Session*>(conn.context);
+      bool duplicate = std::any_of(batch.begin(), batch.begin() + i,
+                                   [&](const Server::ConnectionMessages& other) {
+                                     return other.connection_id == conn.connection_id;
+                                   });
+      if (session == nullptr || duplicate || conn.messages.empty()) {
+        bad_grouping = true;
+        continue;
+      }
+
+      for (const auto& data : conn.messages) {
+        ++events;
+        session->pending.insert(session->pending.end(), data.begin(), data.end());
+      }
+      size_t offset = 0;
+      for (; offset + sizeof(uint64_t) <= session->pending.size(); offset += sizeof(uint64_t)) {
+        uint64_t seq = 0;
+        std::memcpy(&seq, session->pending.data() + offset, sizeof(seq));
+        if (seq != session->next_seq) {
+          out_of_order = true;
+        }
+        session->next_seq = seq + 1;
+        ++received;
+      }
+      session->pending.erase(session->pending.begin(), session->pending.begin() + offset);
+    }
+
+    size_t largest = largest_batch.load();
+    while (events > largest && !largest_batch.compare_exchange_weak(largest, events)) {
+    }
+
+    // 模拟一次批量提交的固定开销
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  });
+  server.SetOnContextDisconnected([&](uint64_t, void* context) {
+    auto* session = static_cast<Session*>(context);
+    if (session->next_seq == kMessagesPerClient) {
+      ++completed;
+    }
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  std::vector<int> clients;
+  for (int i = 0; i < kClientCount; ++i) {
+    int fd = Connect();
+    if (fd < 0) {
+      std::cerr << "[Client] 连接失败!" << std::endl;
+      server.Stop();
+      return 1;
+    }
+    clients.push_back(fd);
+  }
+  WaitUntil([&] { return server.GetStatistics().active_connections == kClientCount; }, 5000);
+
+  // ========== 测试 1: 批量交付 ==========
+  std::cout << "\n========== 测试 1: 批量交付 ==========" << std::endl;
+
+  // 每条消息单独到达，Worker 提交一批期间后续消息在队列中积压
+  for (uint64_t seq = 0; seq < kMessagesPerClient; ++seq) {
+    for (int fd : clients) {
+      send(fd, &seq, sizeof(seq), 0);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  const uint64_t total = kClientCount * kMessagesPerClient;
+  bool all_received = WaitUntil([&] { return received == total; }, 30000);
+  ServerStatistics stats = server.GetStatistics();
+
+  bool pass1 = all_received && !out_of_order && !bad_grouping && single_calls == 0 &&
+               stats.message_batches > 0 && stats.batched_messages > stats.message_batches &&
+               largest_batch <= 64;
+  std::cout << (pass1 ? "[PASS]" : "[FAIL]") << " 收到 " << received << "/" << total << " 条消息，"
+            << stats.batched_messages << " 个数据事件分 " << stats.message_batches
+            << " 批交付（最大一批 " << largest_batch << " 个），"
+            << (out_of_order ? "乱序" : "按序") << "，OnMessage 调用 " << single_calls << " 次"
+            << std::endl;
+
+  // ========== 测试 2: 断开顺序 ==========
+  std::cout << "\n========== 测试 2: 断开顺序 ==========" << std::endl;
+
+  for (int fd : clients) {
+    close(fd);
+  }
+  bool all_closed = WaitUntil([&] { return completed == kClientCount; }, 5000);
+  server.Stop();
+
+  bool pass2 = all_closed;
+  std::cout << (pass2 ? "[PASS]" : "[FAIL]") << " " << completed << "/" << kClientCount
+            << " 个连接在断开前收齐全部数据" << std::endl;
+
+  return FinishTest({{"批量交付", pass1}, {"断开顺序", pass2}});
+}
@@ -0,0 +1,318 @@
+//
+// DarwinCore Network - 按 key 路由消息测试
+//
+// 测试场景：
+//   1. 4 个连接两两共享一个 key（租户），每条消息头部带 key：
+//      同一 key 的消息不论来自哪个连接都在同一个 Worker 线程处理，
+//      key 的状态不加锁也不会丢失更新，同一连接的消息仍按序到达，
+//      按 key 分发的消息拿不到连接上下文
+//   2. 路由函数返回 false 的消息仍按连接分发，并带有连接上下文
+//   3. 一次读取里混有带 key 与不带 key 的消息、一条消息跨两次读取时，
+//      按分帧后的每条消息分别路由，不会被撕开或整块分到同一个 Worker
+//   4. 对端声明超长消息：半条消息超过 max_message_size 时连接被断开
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kMessageRouter;
+constexpr uint16_t kOversizePort = ports::kMessageRouterOversize;
+constexpr size_t kMaxMessageSize = 64 * 1024;
+constexpr int kClientCount = 4;
+constexpr uint32_t kKeyCount = 2;
+constexpr uint32_t kMessagesPerClient = 200;
+constexpr uint32_t kNoKey = 0xFFFFFFFF;  // 不带 key 的消息，按连接分发
+
+// 消息格式：[key:u32][seq:u32]
+struct Message {
+  uint32_t key;
+  uint32_t seq;
+};
+
+int Connect(uint16_t port = kTestPort) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// 每个 key 的状态：只由该 key 的 Worker 访问，不加锁
+struct KeyState {
+  uint64_t count = 0;
+  std::map<uint64_t, uint32_t> next_seq;  // 每个连接期望的下一个序号
+};
+
+struct Session {
+  uint64_t unkeyed = 0;
+};
+
+// 测试 4: 消息格式 [len:u32][body]，对端声明 1MB 的消息后持续发送
+bool TestOversizedMessage() {
+  std::cout << "\n========== 测试 4: 超长消息 ==========" << std::endl;
+
+  ServerOptions options;
+  options.max_message_size = kMaxMessageSize;
+  Server server(options);
+  std::atomic<int> messages{0};
+  std::atomic<int> disconnects{0};
+  server.SetMessageRouter(
+      [](const uint8_t* data, size_t size) -> size_t {
+        uint32_t length;
+        if (size < sizeof(length)) {
+          return 0;
+        }
+        std::memcpy(&length, data, sizeof(length));
+        return size >= sizeof(length) + length ? sizeof(length) + length : 0;
+      },
+      [](uint64_t, const std::vector<uint8_t>&, uint64_t&) { return false; });
+  server.SetOnMessage([&](uint64_t, const std::vector<uint8_t>&) { ++messages; });
+  server.SetOnClientDisconnected([&](uint64_t) { ++disconnects; });
+  if (!server.StartIPv4("127.0.0.1", kOversizePort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return false;
+  }
+
+  int fd = Connect(kOversizePort);
+  bool closed = false;
+  if (fd >= 0) {
+    uint32_t length = 1024 * 1024;
+    send(fd, &length, sizeof(length), 0);
+    std::vector<uint8_t> body(16 * 1024, 'x');
+    for (size_t sent = 0; sent < 2 * kMaxMessageSize; sent += body.size()) {
+      if (send(fd, body.data(), body.size(), MSG_NOSIGNAL) <= 0) {
+        break;
+      }
+    }
+    closed = WaitUntil([&] { return disconnects.load() == 1; }, 5000);
+    close(fd);
+  }
+  server.Stop();
+
+  bool pass = closed && messages.load() == 0;
+  std::cout << (pass ? "[PASS]" : "[FAIL]") << " 半条消息超过 " << kMaxMessageSize
+            << " 字节后连接被断开，交付 " << messages.load() << " 条消息" << std::endl;
+  return pass;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("按 key 路由消息测试");
+
+  Server server;
+  KeyState key_states[kKeyCount];
+  std::mutex mutex;
+  std::set<std::thread::id> key_threads[kKeyCount];  // 处理过每个 key 的线程
+  std::atomic<uint64_t> routed{0};
+  std::atomic<uint64_t> keyed_received{0};
+  std::atomic<uint64_t> unkeyed_received{0};
+  std::atomic<bool> out_of_order{false};
+  std::atomic<bool> keyed_with_context{false};
+  std::atomic<bool> unkeyed_without_context{false};
+  std::atomic<bool> torn{false};  // 回调或路由函数收到的不是一条完整消息
+
+  server.SetConnectionContextFactory([](const ConnectionInformation&) {
+    return std::make_shared<Session>();
+  });
+  server.SetMessageRouter(
+      [](const uint8_t*, size_t size) -> size_t {
+        return size >= sizeof(Message) ? sizeof(Message) : 0;
+      },
+      [&](uint64_t, const std::vector<uint8_t>& data, uint64_t& key) {
+        Message message;
+        if (data.size() != sizeof(message)) {
+          torn = true;
+          return false;
+        }
+        std::memcpy(&message, data.data(), sizeof(message));
+        if (message.key == kNoKey) {
+          return false;
+        }
+        key = message.key;
+        ++routed;
+        return true;
+      });
+  server.SetOnContextMessage([&](uint64_t connection_id, const std::vector<uint8_t>& data,
+                                 void* context) {
+    if (data.size() != sizeof(Message)) {
+      torn = true;
+    }
+    for (size_t offset = 0; offset + sizeof(Message) <= data.size(); offset += sizeof(Message)) {
+      Message message;
+      std::memcpy(&message, data.data() + offset, sizeof(message));
+
+      if (message.key == kNoKey) {
+        if (context == nullptr) {
+          unkeyed_without_context = true;
+        } else {
+          ++static_cast<Session*>(context)->unkeyed;
+        }
+        ++unkeyed_received;
+        continue;
+      }
+
+      if (context != nullptr) {
+        keyed_with_context = true;
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        key_threads[message.key].insert(std::this_thread::get_id());
+      }
+      KeyState& state = key_states[message.key];
+      ++state.count;  // 非原子自增：若同一 key 被并发处理会丢失更新
+      uint32_t& expected = state.next_seq[connection_id];
+      if (message.seq != expected) {
+        out_of_order = true;
+      }
+      expected = message.seq + 1;
+      ++keyed_received;
+    }
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  std::vector<int> clients;
+  for (int i = 0; i < kClientCount; ++i) {
+    int fd = Connect();
+    if (fd < 0) {
+      std::cerr << "[Client] 连接失败!" << std::endl;
+      server.Stop();
+      return 1;
+    }
+    clients.push_back(fd);
+  }
+  WaitUntil([&] { return server.GetStatistics().active_connections == kClientCount; }, 5000);
+
+  // ========== 测试 1: 按 key 分发 ==========
+  std::cout << "\n========== 测试 1: 按 key 分发 ==========" << std::endl;
+
+  // 连接 i 的消息都属于 key i % 2，一次读取到的内容总是同一个 key
+  for (uint32_t seq = 0; seq < kMessagesPerClient; ++seq) {
+    for (int i = 0; i < kClientCount; ++i) {
+      Message message{static_cast<uint32_t>(i) % kKeyCount, seq};
+      send(clients[i], &message, sizeof(message), 0);
+    }
+    if (seq % 10 == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  const uint64_t keyed_total = kClientCount * kMessagesPerClient;
+  bool all_keyed = WaitUntil([&] { return keyed_received == keyed_total; }, 10000);
+  ServerStatistics stats = server.GetStatistics();
+
+  bool single_thread = true;
+  uint64_t counted = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (uint32_t key = 0; key < kKeyCount; ++key) {
+      single_thread = single_thread && key_threads[key].size() == 1;
+      counted += key_states[key].count;
+    }
+  }
+
+  bool pass1 = all_keyed && single_thread && counted == keyed_total && !out_of_order &&
+               !keyed_with_context && routed > 0 && stats.keyed_messages == routed;
+  std::cout << (pass1 ? "[PASS]" : "[FAIL]") << " 收到 " << keyed_received << "/" << keyed_total
+            << " 条消息，key 状态计数 " << counted << "，"
+            << (single_thread ? "每个 key 只在一个线程处理" : "同一 key 出现在多个线程") << "，"
+            << (out_of_order ? "乱序" : "按序") << "，按 key 分发 " << stats.keyed_messages
+            << " 次" << std::endl;
+
+  // ========== 测试 2: 按连接分发 ==========
+  std::cout << "\n========== 测试 2: 按连接分发 ==========" << std::endl;
+
+  constexpr uint32_t kUnkeyedMessages = 50;
+  for (uint32_t seq = 0; seq < kUnkeyedMessages; ++seq) {
+    Message message{kNoKey, seq};
+    send(clients[0], &message, sizeof(message), 0);
+  }
+  bool all_unkeyed = WaitUntil([&] { return unkeyed_received == kUnkeyedMessages; }, 5000);
+  uint64_t keyed_after = server.GetStatistics().keyed_messages;
+
+  bool pass2 = all_unkeyed && !unkeyed_without_context && keyed_after == routed;
+  std::cout << (pass2 ? "[PASS]" : "[FAIL]") << " 收到 " << unkeyed_received << "/"
+            << kUnkeyedMessages << " 条不带 key 的消息，"
+            << (unkeyed_without_context ? "缺少连接上下文" : "均带连接上下文") << std::endl;
+
+  // ========== 测试 3: 混合与跨读取的消息 ==========
+  std::cout << "\n========== 测试 3: 混合与跨读取的消息 ==========" << std::endl;
+
+  // 连接 1 每次发送 [带 key][不带 key][带 key 的前半条]，下一次发送补上后半条
+  constexpr uint32_t kMixedRounds = 50;
+  const uint32_t mixed_key = 1 % kKeyCount;
+  uint32_t seq = kMessagesPerClient;
+  uint8_t pending_tail[sizeof(Message) / 2] = {};
+  bool has_tail = false;
+  for (uint32_t round = 0; round < kMixedRounds; ++round) {
+    std::vector<uint8_t> out;
+    if (has_tail) {
+      out.insert(out.end(), pending_tail, pending_tail + sizeof(pending_tail));
+    }
+    Message messages[3] = {{mixed_key, seq++}, {kNoKey, round}, {mixed_key, seq++}};
+    const uint8_t* raw = reinterpret_cast<const uint8_t*>(messages);
+    out.insert(out.end(), raw, raw + 2 * sizeof(Message) + sizeof(Message) / 2);
+    std::memcpy(pending_tail, raw + 2 * sizeof(Message) + sizeof(Message) / 2,
+                sizeof(pending_tail));
+    has_tail = true;
+    send(clients[1], out.data(), out.size(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  send(clients[1], pending_tail, sizeof(pending_tail), 0);
+
+  const uint64_t mixed_keyed = keyed_total + 2 * kMixedRounds;
+  const uint64_t mixed_unkeyed = kUnkeyedMessages + kMixedRounds;
+  bool all_mixed = WaitUntil([&] {
+    return keyed_received == mixed_keyed && unkeyed_received == mixed_unkeyed;
+  }, 5000);
+
+  for (int fd : clients) {
+    close(fd);
+  }
+  server.Stop();
+
+  bool pass3 = all_mixed && !torn && !out_of_order && !keyed_with_context &&
+               !unkeyed_without_context;
+  std::cout << (pass3 ? "[PASS]" : "[FAIL]") << " 带 key " << keyed_received << "/"
+            << mixed_keyed << "，不带 key " << unkeyed_received << "/" << mixed_unkeyed << "，"
+            << (torn ? "消息被撕开" : "每次回调一条完整消息") << "，"
+            << (out_of_order ? "乱序" : "按序") << std::endl;
+
+  bool pass4 = TestOversizedMessage();
+
+  return FinishTest({{"按 key 分发", pass1}, {"按连接分发", pass2}, {"混合与跨读取", pass3}, {"超长消息", pass4}});
+}
@@ -0,0 +1,175 @@
+//
+// DarwinCore Network - 连接线程任务测试
+//
+// 测试场景：
+//   1. 多个线程并发 Post 到同一连接：任务与该连接的消息回调在同一线程执行，
+//      非原子计数无竞争，同一线程投递的任务按顺序执行
+//   2. PostAfter 不会提前执行，连接断开后任务拿到的上下文为空
+//   3. 服务器未运行时 Post 返回 false
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kPost;
+constexpr int kPosters = 4;
+constexpr int kTasksPerPoster = 1000;
+
+// 只在连接所在 Worker 线程访问，故意不加锁
+struct Session {
+  std::thread::id worker_thread;
+  uint64_t counter = 0;
+  int last_sequence[kPosters] = {};
+  bool out_of_order = false;
+  bool wrong_thread = false;
+};
+
+// 测试 1 + 2: 任务在连接线程按序执行；延迟任务与断开后的任务
+bool TestPostOnConnectionThread() {
+  std::cout << "\n========== 测试 1: 连接线程任务 ==========" << std::endl;
+
+  Server server;
+  std::atomic<uint64_t> connection_id{0};
+  std::atomic<int> messages{0};
+  std::atomic<bool> disconnected{false};
+
+  server.SetConnectionContextFactory([](const ConnectionInformation&) {
+    auto session = std::make_shared<Session>();
+    session->worker_thread = std::this_thread::get_id();
+    return session;
+  });
+  server.SetOnClientConnected(
+      [&](const ConnectionInformation& info) { connection_id.store(info.connection_id); });
+  server.SetOnClientDisconnected([&](uint64_t) { disconnected.store(true); });
+  server.SetOnContextMessage([&](uint64_t, const std::vector<uint8_t>&, void* context) {
+    auto* session = static_cast<Session*>(context);
+    session->counter += 1;
+    messages.fetch_add(1);
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return false;
+  }
+
+  Client client;
+  if (!client.ConnectIPv4("127.0.0.1", kTestPort) ||
+      !WaitUntil([&] { return connection_id.load() != 0; }, 3000)) {
+    std::cerr << "[Client] 连接失败" << std::endl;
+    return false;
+  }
+  uint64_t conn_id = connection_id.load();
+
+  // 多个线程并发投递，同时客户端持续发送消息
+  std::atomic<int> executed{0};
+  std::vector<std::thread> posters;
+  for (int p = 0; p < kPosters; ++p) {
+    posters.emplace_back([&, p] {
+      for (int i = 1; i <= kTasksPerPoster; ++i) {
+        server.Post(conn_id, [&, p, i](void* context) {
+          auto* session = static_cast<Session*>(context);
+          if (session == nullptr) {
+            return;
+          }
+          session->wrong_thread |= session->worker_thread != std::this_thread::get_id();
+          session->out_of_order |= session->last_sequence[p] + 1 != i;
+          session->last_sequence[p] = i;
+          session->counter += 1;
+          executed.fetch_add(1);
+        });
+      }
+    });
+  }
+  const uint8_t message[8] = {'p', 'o', 's', 't', 't', 'e', 's', 't'};
+  for (int i = 0; i < 100; ++i) {
+    client.SendData(message, sizeof(message));
+  }
+  for (auto& poster : posters) {
+    poster.join();
+  }
+
+  const int expected_tasks = kPosters * kTasksPerPoster;
+  WaitUntil([&] { return executed.load() == expected_tasks; }, 5000);
+
+  // 读取最终状态也通过 Post 完成
+  std::atomic<bool> checked{false};
+  bool consistent = false;
+  server.Post(conn_id, [&](void* context) {
+    auto* session = static_cast<Session*>(context);
+    consistent = session != nullptr && !session->wrong_thread && !session->out_of_order &&
+                 session->counter == static_cast<uint64_t>(expected_tasks + messages.load());
+    checked.store(true);
+  });
+  WaitUntil([&] { return checked.load(); }, 3000);
+
+  std::cout << (executed.load() == expected_tasks && consistent ? "[PASS]" : "[FAIL]")
+            << " 任务在连接线程按序执行（" << executed.load() << "/" << expected_tasks
+            << "，消息 " << messages.load() << "）" << std::endl;
+  bool pass1 = executed.load() == expected_tasks && consistent;
+
+  std::cout << "\n========== 测试 2: 延迟任务 ==========" << std::endl;
+
+  auto posted_at = std::chrono::steady_clock::now();
+  std::atomic<int64_t> elapsed_ms{-1};
+  std::atomic<bool> had_context{false};
+  server.PostAfter(conn_id, std::chrono::milliseconds(50), [&](void* context) {
+    had_context.store(context != nullptr);
+    elapsed_ms.store(std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::steady_clock::now() - posted_at)
+                         .count());
+  });
+  WaitUntil([&] { return elapsed_ms.load() >= 0; }, 3000);
+  bool delayed = elapsed_ms.load() >= 50 && had_context.load();
+  std::cout << (delayed ? "[PASS]" : "[FAIL]") << " PostAfter(50ms) 实际延迟 "
+            << elapsed_ms.load() << "ms" << std::endl;
+
+  // 断开后投递：任务仍执行，但上下文已销毁
+  client.Disconnect();
+  WaitUntil([&] { return disconnected.load(); }, 3000);
+  std::atomic<int> after_disconnect{0};  // 0 = 未执行，1 = 空上下文，2 = 非空
+  server.Post(conn_id, [&](void* context) { after_disconnect.store(context ? 2 : 1); });
+  WaitUntil([&] { return after_disconnect.load() != 0; }, 3000);
+  bool cleared = after_disconnect.load() == 1;
+  std::cout << (cleared ? "[PASS]" : "[FAIL]") << " 断开后任务的上下文为空" << std::endl;
+
+  server.Stop();
+  return pass1 && delayed && cleared;
+}
+
+// 测试 3: 未运行时拒绝投递
+bool TestPostWhenStopped() {
+  std::cout << "\n========== 测试 3: 未运行时投递 ==========" << std::endl;
+
+  Server server;
+  bool rejected = !server.Post(1, [](void*) {}) &&
+                  !server.PostAfter(1, std::chrono::milliseconds(10), [](void*) {});
+  std::cout << (rejected ? "[PASS]" : "[FAIL]") << " 未运行时 Post 返回 false" << std::endl;
+  return rejected;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("连接线程任务测试");
+
+  bool pass1 = TestPostOnConnectionThread();
+  bool pass2 = TestPostWhenStopped();
+
+  return FinishTest({{"连接线程任务", pass1}, {"未运行时投递", pass2}});
+}
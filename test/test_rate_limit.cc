@@ -0,0 +1,171 @@
+//
+// DarwinCore Network - 连接限速测试
+//
+// 测试场景：
+//   1. 超出入站预算的连接被暂停读取，整体速率接近配置值，数据完整
+//   2. 被限速的连接不影响同一服务端上其他连接的往返延迟
+//   3. 升级为共享内存通道的连接同样受入站限速约束
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kRateLimit;
+const std::string kSocketPath = "/tmp/dc_rate_limit_test.sock";
+constexpr uint64_t kBytesPerSecond = 256 * 1024;
+constexpr uint64_t kBurstBytes = 32 * 1024;
+constexpr size_t kFloodSize = 768 * 1024;
+constexpr int kPings = 20;
+
+// 测试 3: 共享内存通道上的洪泛数据
+bool TestSharedMemoryIngress(ServerOptions options) {
+  std::cout << "\n========== 测试 3: 共享内存通道限速 ==========" << std::endl;
+
+  options.shared_memory_transport = true;
+  Server server(options);
+  std::atomic<size_t> received{0};
+  server.SetOnMessage([&](uint64_t, const std::vector<uint8_t>& data) {
+    received.fetch_add(data.size());
+  });
+  if (!server.StartUnixDomain(kSocketPath)) {
+    std::cout << "[FAIL] 服务端启动失败" << std::endl;
+    return false;
+  }
+
+  Client client;
+  client.SetSharedMemoryTransport(true);
+  bool upgraded = client.ConnectUnixDomain(kSocketPath) &&
+                  WaitUntil([&] { return server.GetStatistics().total_shm_connections == 1; },
+                            2000);
+  // 留出客户端读到服务端确认的时间，之后的数据全部经环发送
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  std::vector<uint8_t> flood(kFloodSize, 'h');
+  auto start = std::chrono::steady_clock::now();
+  client.SendData(flood.data(), flood.size());
+  WaitUntil([&] { return received.load() >= kFloodSize; }, 10000);
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  double expected = static_cast<double>(kFloodSize - kBurstBytes) / kBytesPerSecond;
+  bool complete = received.load() == kFloodSize;
+  bool throttled = elapsed >= expected * 0.8;
+  bool paused = server.GetStatistics().total_rate_limit_pauses > 0;
+
+  client.Disconnect();
+  server.Stop();
+
+  std::cout << (upgraded ? "[PASS]" : "[FAIL]") << " 连接已升级为共享内存通道" << std::endl;
+  std::cout << (complete ? "[PASS]" : "[FAIL]") << " 数据完整到达 (" << received.load() << "/"
+            << kFloodSize << ")" << std::endl;
+  std::cout << (throttled ? "[PASS]" : "[FAIL]") << " 用时 " << elapsed << "s，预期不少于 "
+            << expected << "s" << std::endl;
+  std::cout << (paused ? "[PASS]" : "[FAIL]") << " 统计记录了限速暂停" << std::endl;
+  return upgraded && complete && throttled && paused;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("连接限速测试");
+
+  ServerOptions options;
+  options.connection_ingress_limit.bytes_per_second = kBytesPerSecond;
+  options.connection_ingress_limit.burst_bytes = kBurstBytes;
+  Server server(options);
+
+  // 'h' 为洪泛数据，只计数；'p' 为探测消息，原样回显
+  std::atomic<size_t> flood_received{0};
+  server.SetOnMessage([&](uint64_t conn_id, const std::vector<uint8_t>& data) {
+    if (!data.empty() && data[0] == 'p') {
+      server.SendData(conn_id, data.data(), data.size());
+      return;
+    }
+    flood_received.fetch_add(data.size());
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  Client flooder;
+  Client prober;
+  std::atomic<int> pongs{0};
+  prober.SetOnMessage([&](const std::vector<uint8_t>& data) {
+    pongs.fetch_add(static_cast<int>(data.size()));
+  });
+
+  if (!flooder.ConnectIPv4("127.0.0.1", kTestPort) ||
+      !prober.ConnectIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Client] 连接失败!" << std::endl;
+    return 1;
+  }
+  WaitUntil([&] { return flooder.IsConnected() && prober.IsConnected(); }, 2000);
+
+  // 测试 1: 入站速率
+  std::cout << "\n========== 测试 1: 入站限速 ==========" << std::endl;
+  std::vector<uint8_t> flood(kFloodSize, 'h');
+  auto start = std::chrono::steady_clock::now();
+  flooder.SendData(flood.data(), flood.size());
+
+  // 测试 2: 洪泛进行中，另一条连接的往返不受影响
+  std::cout << "\n========== 测试 2: 其他连接不受影响 ==========" << std::endl;
+  const uint8_t ping = 'p';
+  auto worst = std::chrono::steady_clock::duration::zero();
+  for (int i = 0; i < kPings; ++i) {
+    auto sent_at = std::chrono::steady_clock::now();
+    prober.SendData(&ping, 1);
+    if (!WaitUntil([&] { return pongs.load() > i; }, 2000)) {
+      break;
+    }
+    worst = std::max(worst, std::chrono::steady_clock::now() - sent_at);
+  }
+  bool pings_ok = pongs.load() == kPings;
+  bool still_flooding = flood_received.load() < kFloodSize;
+
+  WaitUntil([&] { return flood_received.load() >= kFloodSize; }, 10000);
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  // 突发容量之外的数据至少需要 (总量 - 突发) / 速率 秒
+  double expected = static_cast<double>(kFloodSize - kBurstBytes) / kBytesPerSecond;
+  bool complete = flood_received.load() == kFloodSize;
+  bool throttled = elapsed >= expected * 0.8;
+  bool paused = server.GetStatistics().total_rate_limit_pauses > 0;
+
+  std::cout << (complete ? "[PASS]" : "[FAIL]") << " 洪泛数据完整到达 ("
+            << flood_received.load() << "/" << kFloodSize << ")" << std::endl;
+  std::cout << (throttled ? "[PASS]" : "[FAIL]") << " 用时 " << elapsed << "s，预期不少于 "
+            << expected << "s" << std::endl;
+  std::cout << (paused ? "[PASS]" : "[FAIL]") << " 统计记录了限速暂停" << std::endl;
+
+  auto worst_ms = std::chrono::duration_cast<std::chrono::milliseconds>(worst).count();
+  bool isolated = pings_ok && still_flooding;
+  std::cout << (isolated ? "[PASS]" : "[FAIL]") << " 洪泛期间 " << pongs.load() << "/" << kPings
+            << " 次往返完成，最长 " << worst_ms << "ms" << std::endl;
+
+  flooder.Disconnect();
+  prober.Disconnect();
+  server.Stop();
+
+  bool pass1 = complete && throttled && paused;
+  bool pass2 = isolated;
+  bool pass3 = TestSharedMemoryIngress(options);
+
+  return FinishTest({{"入站限速", pass1}, {"连接隔离", pass2}, {"共享内存限速", pass3}});
+}
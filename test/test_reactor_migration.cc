@@ -0,0 +1,210 @@
+//
+// DarwinCore Network - Reactor 间连接迁移测试
+//
+// 测试场景：
+//   1. 两个高流量连接落在同一个 Reactor 上（accept 轮询分配），开启负载均衡后
+//      其中一个被迁移到空闲 Reactor；迁移前后回显数据完整、按序，
+//      连接的定时器持续触发
+//   2. 迁移后的连接可以正常断开，断开回调与上下文销毁照常进行
+//
+// 说明：需要至少 2 个 Reactor（CPU 核数 >= 2），单核机器上跳过。
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kReactorMigration;
+constexpr size_t kChunkSize = 16 * 1024;
+constexpr auto kTrafficDuration = std::chrono::milliseconds(2500);
+
+int Connect() {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(kTestPort);
+  inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+  timeval timeout{2, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  return fd;
+}
+
+// 持续发送带序号的数据块并校验回显：任何丢失、重复或乱序都会破坏序列
+void PumpEcho(int fd, std::atomic<uint64_t>& echoed, std::atomic<bool>& corrupted) {
+  std::vector<uint8_t> out(kChunkSize);
+  std::vector<uint8_t> in(kChunkSize);
+  uint64_t next_out = 0;
+  uint64_t next_in = 0;
+  auto deadline = std::chrono::steady_clock::now() + kTrafficDuration;
+
+  while (std::chrono::steady_clock::now() < deadline && !corrupted) {
+    for (auto& byte : out) {
+      byte = static_cast<uint8_t>(next_out++ % 251);
+    }
+    if (send(fd, out.data(), out.size(), 0) != static_cast<ssize_t>(out.size())) {
+      corrupted = true;
+      return;
+    }
+
+    size_t received = 0;
+    while (received < in.size()) {
+      ssize_t ret = recv(fd, in.data() + received, in.size() - received, 0);
+      if (ret <= 0) {
+        corrupted = true;
+        return;
+      }
+      for (ssize_t i = 0; i < ret; ++i) {
+        if (in[received + i] != static_cast<uint8_t>(next_in++ % 251)) {
+          corrupted = true;
+          return;
+        }
+      }
+      received += static_cast<size_t>(ret);
+    }
+    echoed += received;
+  }
+}
+
+struct Session {};
+
+}  // namespace
+
+int main() {
+  BeginTest("Reactor 间连接迁移测试");
+
+  const size_t reactor_count = std::max(1u, std::thread::hardware_concurrency());
+  if (reactor_count < 2) {
+    std::cout << "[SKIP] 只有 1 个 Reactor，无法迁移" << std::endl;
+    return 0;
+  }
+
+  ServerOptions options;
+  options.rebalance_interval = std::chrono::milliseconds(200);
+  options.rebalance_threshold = 1.5;
+  Server server(options);
+
+  std::mutex mutex;
+  std::vector<uint64_t> connection_ids;
+  std::atomic<int> disconnected{0};
+  std::atomic<int> contexts_destroyed{0};
+
+  server.SetConnectionContextFactory([&](const ConnectionInformation&) {
+    return std::shared_ptr<Session>(new Session(), [&](Session* session) {
+      ++contexts_destroyed;
+      delete session;
+    });
+  });
+  server.SetOnClientConnected([&](const ConnectionInformation& info) {
+    std::lock_guard<std::mutex> lock(mutex);
+    connection_ids.push_back(info.connection_id);
+  });
+  server.SetOnMessage([&](uint64_t connection_id, const std::vector<uint8_t>& data) {
+    server.SendData(connection_id, data.data(), data.size());
+  });
+  server.SetOnClientDisconnected([&](uint64_t) { ++disconnected; });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  // 逐个建立连接，轮询分配下第 0 个与第 reactor_count 个落在同一个 Reactor
+  std::vector<int> clients;
+  for (size_t i = 0; i <= reactor_count; ++i) {
+    int fd = Connect();
+    bool accepted = fd >= 0 && WaitUntil([&] {
+      std::lock_guard<std::mutex> lock(mutex);
+      return connection_ids.size() == i + 1;
+    }, 5000);
+    if (!accepted) {
+      std::cerr << "[Client] 连接失败!" << std::endl;
+      server.Stop();
+      return 1;
+    }
+    clients.push_back(fd);
+  }
+  const int hot[2] = {clients.front(), clients.back()};
+  const uint64_t hot_ids[2] = {connection_ids.front(), connection_ids.back()};
+
+  // ========== 测试 1: 热点连接迁移 ==========
+  std::cout << "\n========== 测试 1: 热点连接迁移 ==========" << std::endl;
+
+  std::atomic<uint64_t> ticks[2];
+  for (int i = 0; i < 2; ++i) {
+    ticks[i] = 0;
+    server.RunEvery(hot_ids[i], std::chrono::milliseconds(50), [&ticks, i](void* context) {
+      if (context != nullptr) {
+        ++ticks[i];
+      }
+    });
+  }
+
+  std::atomic<uint64_t> echoed[2];
+  std::atomic<bool> corrupted{false};
+  std::vector<std::thread> pumps;
+  for (int i = 0; i < 2; ++i) {
+    echoed[i] = 0;
+    pumps.emplace_back(PumpEcho, hot[i], std::ref(echoed[i]), std::ref(corrupted));
+  }
+  for (auto& pump : pumps) {
+    pump.join();
+  }
+
+  ServerStatistics stats = server.GetStatistics();
+  uint64_t ticks_before[2] = {ticks[0].load(), ticks[1].load()};
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  bool timers_alive = ticks[0] > ticks_before[0] && ticks[1] > ticks_before[1];
+
+  bool pass1 = !corrupted && echoed[0] > 0 && echoed[1] > 0 && stats.connection_migrations >= 1 &&
+               timers_alive;
+  std::cout << (pass1 ? "[PASS]" : "[FAIL]") << " 迁移 " << stats.connection_migrations
+            << " 个连接，回显 " << echoed[0] << " / " << echoed[1] << " 字节，"
+            << (corrupted ? "数据损坏" : "数据完整有序") << "，定时器"
+            << (timers_alive ? "持续触发" : "停止") << std::endl;
+
+  // ========== 测试 2: 迁移后断开 ==========
+  std::cout << "\n========== 测试 2: 迁移后断开 ==========" << std::endl;
+
+  for (int fd : clients) {
+    close(fd);
+  }
+  const int total = static_cast<int>(clients.size());
+  bool all_closed = WaitUntil([&] {
+    return disconnected == total && contexts_destroyed == total &&
+           server.GetStatistics().active_connections == 0;
+  }, 5000);
+  server.Stop();
+
+  bool pass2 = all_closed;
+  std::cout << (pass2 ? "[PASS]" : "[FAIL]") << " " << disconnected << "/" << total
+            << " 个连接断开，销毁上下文 " << contexts_destroyed << " 个" << std::endl;
+
+  return FinishTest({{"热点连接迁移", pass1}, {"迁移后断开", pass2}});
+}
@@ -0,0 +1,269 @@
+//
+// DarwinCore Network - 读公平性与自适应接收测试
+//
+// 测试场景：
+//   1. 一个连接持续灌入数据时，同一服务器上的小消息连接仍能完成往返；
+//      灌入的数据完整交付，读预算用尽时让出（total_read_yields > 0），
+//      批量连接的单次读取超过默认 8KB
+//   2. 对端写完数据后立即关闭：内核缓冲区中剩余的数据先交付，再报告断开
+//   3. 共享内存通道：每次读取接收环同样受读预算约束，数据完整交付
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kReadFairness;
+const std::string kSocketPath = "/tmp/dc_read_fairness_test.sock";
+constexpr size_t kFirehoseBytes = 32 * 1024 * 1024;
+constexpr size_t kCloseAfterBytes = 4 * 1024 * 1024;
+constexpr int kPingCount = 50;
+constexpr size_t kShmBytes = 8 * 1024 * 1024;
+constexpr size_t kShmBudget = 64 * 1024;
+
+// 阻塞 socket：连接后写入 total 字节（'x'），然后关闭
+void BlastAndClose(size_t total) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(kTestPort);
+  inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    close(fd);
+    return;
+  }
+
+  std::vector<uint8_t> chunk(256 * 1024, 'x');
+  size_t sent = 0;
+  while (sent < total) {
+    ssize_t ret = send(fd, chunk.data(), std::min(chunk.size(), total - sent), 0);
+    if (ret <= 0) {
+      break;
+    }
+    sent += static_cast<size_t>(ret);
+  }
+  close(fd);
+}
+
+struct Observed {
+  std::mutex mutex;
+  std::unordered_map<uint64_t, size_t> bulk_bytes;     // 非 PING 数据按连接累计
+  std::unordered_map<uint64_t, size_t> bytes_at_close; // 断开时已交付的字节数
+  std::atomic<size_t> max_chunk{0};
+};
+
+void InstallHandlers(Server& server, Observed& observed) {
+  server.SetOnMessage([&](uint64_t conn_id, const std::vector<uint8_t>& data) {
+    if (data.size() >= 4 && std::memcmp(data.data(), "PING", 4) == 0) {
+      server.SendData(conn_id, data.data(), data.size());
+      return;
+    }
+    size_t seen = observed.max_chunk.load();
+    while (data.size() > seen && !observed.max_chunk.compare_exchange_weak(seen, data.size())) {
+    }
+    std::lock_guard<std::mutex> lock(observed.mutex);
+    observed.bulk_bytes[conn_id] += data.size();
+  });
+  server.SetOnClientDisconnected([&](uint64_t conn_id) {
+    std::lock_guard<std::mutex> lock(observed.mutex);
+    observed.bytes_at_close[conn_id] = observed.bulk_bytes[conn_id];
+  });
+}
+
+// 测试 1: 灌入数据时小消息连接不被饿死
+bool TestFairness() {
+  std::cout << "\n========== 测试 1: 读公平性 ==========" << std::endl;
+
+  ServerOptions options;
+  options.read_budget_bytes = 64 * 1024;
+  options.max_receive_size = 64 * 1024;
+  Server server(options);
+  Observed observed;
+  InstallHandlers(server, observed);
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return false;
+  }
+
+  Client chatty;
+  std::atomic<int> pongs{0};
+  chatty.SetOnMessage([&](const std::vector<uint8_t>& data) {
+    pongs.fetch_add(static_cast<int>(data.size() / 8));
+  });
+  if (!chatty.ConnectIPv4("127.0.0.1", kTestPort) ||
+      !WaitUntil([&] { return chatty.IsConnected(); }, 3000)) {
+    std::cerr << "[Client] 连接失败" << std::endl;
+    return false;
+  }
+
+  std::thread firehose(BlastAndClose, kFirehoseBytes);
+
+  // 灌入期间逐个往返
+  const uint8_t ping[8] = {'P', 'I', 'N', 'G', '-', '-', '-', '-'};
+  int completed = 0;
+  std::vector<double> rtts_ms;
+  for (int i = 0; i < kPingCount; ++i) {
+    auto begin = std::chrono::steady_clock::now();
+    chatty.SendData(ping, sizeof(ping));
+    if (!WaitUntil([&] { return pongs.load() > i; }, 2000)) {
+      break;
+    }
+    rtts_ms.push_back(std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - begin)
+                          .count());
+    ++completed;
+  }
+  firehose.join();
+
+  auto delivered = [&] {
+    std::lock_guard<std::mutex> lock(observed.mutex);
+    for (const auto& [conn_id, bytes] : observed.bytes_at_close) {
+      if (bytes == kFirehoseBytes) {
+        return true;
+      }
+    }
+    return false;
+  };
+  WaitUntil(delivered, 10000);
+  ServerStatistics stats = server.GetStatistics();
+  chatty.Disconnect();
+  server.Stop();
+
+  std::sort(rtts_ms.begin(), rtts_ms.end());
+  double p50 = rtts_ms.empty() ? 0 : rtts_ms[rtts_ms.size() / 2];
+  bool pass_ping = completed == kPingCount;
+  bool pass_bulk = delivered();
+  bool pass_yield = stats.total_read_yields > 0;
+  bool pass_adaptive = observed.max_chunk.load() > 8192;
+
+  std::cout << (pass_ping ? "[PASS]" : "[FAIL]") << " 灌入期间完成往返 " << completed << "/"
+            << kPingCount << "（p50 " << p50 << "ms）" << std::endl;
+  std::cout << (pass_bulk ? "[PASS]" : "[FAIL]") << " 灌入数据完整交付" << std::endl;
+  std::cout << (pass_yield ? "[PASS]" : "[FAIL]") << " 读预算让出 " << stats.total_read_yields
+            << " 次" << std::endl;
+  std::cout << (pass_adaptive ? "[PASS]" : "[FAIL]") << " 批量连接单次读取最大 "
+            << observed.max_chunk.load() << " 字节" << std::endl;
+  return pass_ping && pass_bulk && pass_yield && pass_adaptive;
+}
+
+// 测试 2: 写完立即关闭，剩余数据先交付
+bool TestDataBeforeClose() {
+  std::cout << "\n========== 测试 2: 关闭前数据交付 ==========" << std::endl;
+
+  ServerOptions options;
+  options.read_budget_reads = 1;  // 每次就绪只读一次，放大 EOF 与剩余数据同时出现的情况
+  Server server(options);
+  Observed observed;
+  InstallHandlers(server, observed);
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return false;
+  }
+
+  BlastAndClose(kCloseAfterBytes);
+
+  size_t at_close = 0;
+  WaitUntil([&] {
+    std::lock_guard<std::mutex> lock(observed.mutex);
+    if (observed.bytes_at_close.empty()) {
+      return false;
+    }
+    at_close = observed.bytes_at_close.begin()->second;
+    return true;
+  }, 10000);
+  server.Stop();
+
+  bool pass = at_close == kCloseAfterBytes;
+  std::cout << (pass ? "[PASS]" : "[FAIL]") << " 断开前交付 " << at_close << "/"
+            << kCloseAfterBytes << " 字节" << std::endl;
+  return pass;
+}
+
+// 测试 3: 共享内存通道的读预算
+bool TestSharedMemoryBudget() {
+  std::cout << "\n========== 测试 3: 共享内存通道读预算 ==========" << std::endl;
+
+  ServerOptions options;
+  options.shared_memory_transport = true;
+  options.read_budget_bytes = kShmBudget;
+  Server server(options);
+  Observed observed;
+  InstallHandlers(server, observed);
+  if (!server.StartUnixDomain(kSocketPath)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return false;
+  }
+
+  Client client;
+  client.SetSharedMemoryTransport(true);
+  bool upgraded = client.ConnectUnixDomain(kSocketPath) &&
+                  WaitUntil([&] { return server.GetStatistics().total_shm_connections == 1; },
+                            3000);
+  // 留出客户端读到服务端确认的时间，之后的数据全部经环发送
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  std::vector<uint8_t> payload(kShmBytes, 'x');
+  client.SendData(payload.data(), payload.size());
+
+  auto delivered = [&] {
+    std::lock_guard<std::mutex> lock(observed.mutex);
+    for (const auto& [conn_id, bytes] : observed.bulk_bytes) {
+      if (bytes == kShmBytes) {
+        return true;
+      }
+    }
+    return false;
+  };
+  WaitUntil(delivered, 20000);
+  ServerStatistics stats = server.GetStatistics();
+  client.Disconnect();
+  server.Stop();
+
+  bool pass_bulk = delivered();
+  bool pass_yield = stats.total_read_yields > 0;
+  bool pass_chunk = observed.max_chunk.load() <= kShmBudget;
+
+  std::cout << (upgraded ? "[PASS]" : "[FAIL]") << " 连接已升级为共享内存通道" << std::endl;
+  std::cout << (pass_bulk ? "[PASS]" : "[FAIL]") << " 数据完整交付" << std::endl;
+  std::cout << (pass_yield ? "[PASS]" : "[FAIL]") << " 读预算让出 " << stats.total_read_yields
+            << " 次" << std::endl;
+  std::cout << (pass_chunk ? "[PASS]" : "[FAIL]") << " 单次分发最大 "
+            << observed.max_chunk.load() << " 字节，不超过预算" << std::endl;
+  return upgraded && pass_bulk && pass_yield && pass_chunk;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("读公平性测试");
+
+  bool pass1 = TestFairness();
+  bool pass2 = TestDataBeforeClose();
+  bool pass3 = TestSharedMemoryBudget();
+
+  return FinishTest({{"读公平性", pass1}, {"关闭前数据交付", pass2}, {"共享内存读预算", pass3}});
+}
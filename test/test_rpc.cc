@@ -0,0 +1,199 @@
+//
+// DarwinCore Network - RPC 测试
+//
+// 测试场景：
+//   1. 流水线：同一连接上同时发出大量请求，响应按 request_id 正确关联
+//   2. future 方式调用
+//   3. 截止时间：服务端不响应的请求以 kTimeout 结束，超时回调与响应回调在同一线程
+//   4. 断开连接：未完成的请求以 kDisconnected 结束
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/rpc.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kRpc;
+constexpr int kPipelinedCalls = 1000;
+
+// 以 "drop:" 开头的请求服务端不响应，用于测试截止时间
+const std::string kDropPrefix = "drop:";
+
+std::vector<uint8_t> ToBytes(const std::string& s) {
+  return std::vector<uint8_t>(s.begin(), s.end());
+}
+
+// 测试 1: 流水线请求
+bool TestPipelining(RpcClient& rpc) {
+  std::cout << "\n========== 测试 1: 流水线请求 ==========" << std::endl;
+
+  std::atomic<int> ok_count{0};
+  std::atomic<int> mismatch_count{0};
+  std::atomic<int> done_count{0};
+
+  for (int i = 0; i < kPipelinedCalls; ++i) {
+    auto request = ToBytes("req-" + std::to_string(i));
+    auto expected = ToBytes("resp:req-" + std::to_string(i));
+
+    rpc.Call(request.data(), request.size(),
+             [&, expected](RpcStatus status, const std::vector<uint8_t>& response) {
+               if (status == RpcStatus::kOk && response == expected) {
+                 ok_count++;
+               } else {
+                 mismatch_count++;
+               }
+               done_count++;
+             },
+             5000);
+  }
+
+  bool finished = WaitUntil([&] { return done_count.load() == kPipelinedCalls; }, 10000);
+  bool passed = finished && ok_count.load() == kPipelinedCalls && rpc.GetPendingCount() == 0;
+
+  std::cout << (passed ? "[PASS]" : "[FAIL]") << " 成功 " << ok_count.load()
+            << "/" << kPipelinedCalls << "，错配 " << mismatch_count.load() << std::endl;
+  return passed;
+}
+
+// 测试 2: future 方式
+bool TestFuture(RpcClient& rpc) {
+  std::cout << "\n========== 测试 2: future 方式 ==========" << std::endl;
+
+  auto request = ToBytes("future");
+  auto future = rpc.CallFuture(request.data(), request.size(), 2000);
+
+  if (future.wait_for(std::chrono::seconds(3)) != std::future_status::ready) {
+    std::cout << "[FAIL] future 未完成" << std::endl;
+    return false;
+  }
+
+  RpcResponse response = future.get();
+  bool passed = response.status == RpcStatus::kOk && response.data == ToBytes("resp:future");
+  std::cout << (passed ? "[PASS]" : "[FAIL]") << " future 响应正确" << std::endl;
+  return passed;
+}
+
+// 测试 3: 截止时间
+bool TestDeadline(RpcClient& rpc) {
+  std::cout << "\n========== 测试 3: 截止时间 ==========" << std::endl;
+
+  // 记录响应回调所在线程
+  std::promise<std::thread::id> response_thread;
+  auto ping = ToBytes("thread");
+  rpc.Call(ping.data(), ping.size(),
+           [&](RpcStatus, const std::vector<uint8_t>&) {
+             response_thread.set_value(std::this_thread::get_id());
+           },
+           2000);
+
+  std::promise<std::pair<RpcStatus, std::thread::id>> timeout_result;
+  auto request = ToBytes(kDropPrefix + "timeout");
+  auto start = std::chrono::steady_clock::now();
+  rpc.Call(request.data(), request.size(),
+           [&](RpcStatus status, const std::vector<uint8_t>&) {
+             timeout_result.set_value({status, std::this_thread::get_id()});
+           },
+           200);
+
+  auto future = timeout_result.get_future();
+  if (future.wait_for(std::chrono::seconds(3)) != std::future_status::ready) {
+    std::cout << "[FAIL] 超时回调未触发" << std::endl;
+    return false;
+  }
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start).count();
+  auto [status, timeout_thread] = future.get();
+
+  bool passed = status == RpcStatus::kTimeout && elapsed >= 200 && elapsed < 1000;
+  bool same_thread = response_thread.get_future().get() == timeout_thread;
+  std::cout << (passed ? "[PASS]" : "[FAIL]") << " 请求在 " << elapsed
+            << "ms 后超时" << std::endl;
+  std::cout << (same_thread ? "[PASS]" : "[FAIL]") << " 超时回调与响应回调在同一 Worker 线程"
+            << std::endl;
+  return passed && same_thread;
+}
+
+// 测试 4: 断开连接
+bool TestDisconnect(Client& client, RpcClient& rpc) {
+  std::cout << "\n========== 测试 4: 断开连接 ==========" << std::endl;
+
+  std::atomic<int> disconnected_count{0};
+  for (int i = 0; i < 10; ++i) {
+    auto request = ToBytes(kDropPrefix + std::to_string(i));
+    rpc.Call(request.data(), request.size(),
+             [&](RpcStatus status, const std::vector<uint8_t>&) {
+               if (status == RpcStatus::kDisconnected) {
+                 disconnected_count++;
+               }
+             },
+             0);
+  }
+
+  // 等待请求发出后再断开
+  WaitUntil([&] { return client.GetSendBufferSize() == 0; }, 1000);
+  client.Disconnect();
+
+  bool passed = WaitUntil([&] { return disconnected_count.load() == 10; }, 3000) &&
+                rpc.GetPendingCount() == 0;
+  std::cout << (passed ? "[PASS]" : "[FAIL]") << " 未完成请求以 kDisconnected 结束: "
+            << disconnected_count.load() << "/10" << std::endl;
+  return passed;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("RPC 测试");
+
+  Server server;
+  RpcServer rpc_server(server);
+  rpc_server.SetRequestHandler([&](uint64_t conn_id, uint64_t request_id,
+                                   const std::vector<uint8_t>& request) {
+    std::string text(request.begin(), request.end());
+    if (text.compare(0, kDropPrefix.size(), kDropPrefix) == 0) {
+      return;
+    }
+    std::string reply = "resp:" + text;
+    rpc_server.Respond(conn_id, request_id,
+                       reinterpret_cast<const uint8_t*>(reply.data()), reply.size());
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  Client client;
+  RpcClient rpc(client);
+  if (!client.ConnectIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Client] 连接失败!" << std::endl;
+    return 1;
+  }
+  WaitUntil([&] { return client.IsConnected(); }, 2000);
+
+  bool pass1 = TestPipelining(rpc);
+  bool pass2 = TestFuture(rpc);
+  bool pass3 = TestDeadline(rpc);
+  bool pass4 = TestDisconnect(client, rpc);
+
+  server.Stop();
+
+  return FinishTest({{"流水线", pass1}, {"future", pass2}, {"截止时间", pass3}, {"断开连接", pass4}});
+}
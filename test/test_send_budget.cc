@@ -0,0 +1,178 @@
+//
+// DarwinCore Network - 发送缓冲内存预算测试
+//
+// 测试场景：
+//   1. 多个只连接不读取的慢速客户端：达到拒绝线后 SendData 返回 false，
+//      预算用量（含排队数据）始终低于预算，连接关闭后用量归零
+//   2. 关闭拒绝（拒绝比例 > 1）：超出预算后断开积压最多的连接
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr size_t kBudget = 8 * 1024 * 1024;
+constexpr size_t kChunkSize = 256 * 1024;
+constexpr int kSlowReaders = 8;
+constexpr int kRounds = 200;
+
+// 只连接、从不读取的客户端
+int ConnectSlowReader(uint16_t port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  int rcvbuf = 4096;
+  setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+struct Scenario {
+  uint64_t rejected_calls = 0;
+  size_t peak_usage = 0;
+  ServerStatistics final_stats;
+  size_t usage_after_close = 0;
+};
+
+// 向所有慢速连接轮流发送，记录用量峰值
+Scenario Flood(uint16_t port, const ServerOptions& options) {
+  Scenario result;
+  Server server(options);
+
+  std::mutex mutex;
+  std::vector<uint64_t> connections;
+  server.SetOnClientConnected([&](const ConnectionInformation& info) {
+    std::lock_guard<std::mutex> lock(mutex);
+    connections.push_back(info.connection_id);
+  });
+
+  if (!server.StartIPv4("127.0.0.1", port)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return result;
+  }
+
+  std::vector<int> fds;
+  for (int i = 0; i < kSlowReaders; ++i) {
+    fds.push_back(ConnectSlowReader(port));
+  }
+  WaitUntil([&] {
+    std::lock_guard<std::mutex> lock(mutex);
+    return connections.size() == static_cast<size_t>(kSlowReaders);
+  }, 3000);
+
+  std::vector<uint8_t> chunk(kChunkSize, 'x');
+  std::vector<uint64_t> targets;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    targets = connections;
+  }
+
+  for (int round = 0; round < kRounds; ++round) {
+    for (uint64_t conn_id : targets) {
+      if (!server.SendData(conn_id, chunk.data(), chunk.size())) {
+        ++result.rejected_calls;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    result.peak_usage = std::max<size_t>(result.peak_usage,
+                                         server.GetStatistics().send_budget_usage);
+  }
+
+  // 等待 Reactor 处理完队列中剩余的发送
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  result.peak_usage = std::max<size_t>(result.peak_usage,
+                                       server.GetStatistics().send_budget_usage);
+  result.final_stats = server.GetStatistics();
+
+  for (int fd : fds) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+  WaitUntil([&] { return server.GetStatistics().send_buffer_bytes == 0; }, 3000);
+  result.usage_after_close = server.GetStatistics().send_buffer_bytes;
+
+  server.Stop();
+  return result;
+}
+
+// 测试 1: 拒绝发送
+bool TestRejectSends() {
+  std::cout << "\n========== 测试 1: 达到拒绝线后 SendData 失败 ==========" << std::endl;
+
+  ServerOptions options;
+  options.send_buffer_budget = kBudget;
+  options.send_budget_pause_ratio = 0.5;
+  options.send_budget_reject_ratio = 0.75;
+
+  Scenario result = Flood(ports::kSendBudgetReject, options);
+
+  // 排队中的数据同样计入预算，用量不会越过拒绝线太多
+  bool bounded = result.peak_usage <= kBudget;
+  bool rejected = result.rejected_calls > 0 && result.final_stats.send_budget_rejects > 0;
+  bool released = result.usage_after_close == 0;
+
+  std::cout << (rejected ? "[PASS]" : "[FAIL]") << " 拒绝 " << result.rejected_calls
+            << " 次 SendData" << std::endl;
+  std::cout << (bounded ? "[PASS]" : "[FAIL]") << " 缓冲峰值 " << result.peak_usage / 1024
+            << "KB，预算 " << kBudget / 1024 << "KB" << std::endl;
+  std::cout << (released ? "[PASS]" : "[FAIL]") << " 连接关闭后用量归零" << std::endl;
+  return bounded && rejected && released;
+}
+
+// 测试 2: 断开积压最多的连接
+bool TestDisconnectOffenders() {
+  std::cout << "\n========== 测试 2: 超出预算后断开积压连接 ==========" << std::endl;
+
+  ServerOptions options;
+  options.send_buffer_budget = kBudget;
+  options.send_budget_pause_ratio = 0.5;
+  options.send_budget_reject_ratio = 2.0;  // 关闭拒绝，只依赖断开
+
+  Scenario result = Flood(ports::kSendBudgetDisconnect, options);
+
+  bool disconnected = result.final_stats.send_budget_disconnects > 0;
+  bool released = result.usage_after_close == 0;
+
+  std::cout << (disconnected ? "[PASS]" : "[FAIL]") << " 断开 "
+            << result.final_stats.send_budget_disconnects << " 个积压连接（峰值 "
+            << result.peak_usage / 1024 << "KB）" << std::endl;
+  std::cout << (released ? "[PASS]" : "[FAIL]") << " 连接关闭后用量归零" << std::endl;
+  return disconnected && released;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("发送缓冲内存预算测试");
+
+  bool pass1 = TestRejectSends();
+  bool pass2 = TestDisconnectOffenders();
+
+  return FinishTest({{"拒绝发送", pass1}, {"断开积压连接", pass2}});
+}
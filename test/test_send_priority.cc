@@ -0,0 +1,202 @@
+//
+// DarwinCore Network - 发送优先级测试
+//
+// 测试场景：
+//   1. FrameScheduler：控制消息先于批量消息取出，多条批量消息的分片轮流交错，
+//      交错后的字节流仍能被 Decoder 正确重组
+//   2. 对端读得慢、连接积压了大量批量数据时，kControl 数据插队写出：
+//      控制通道建立前缓存的批量数据整体先写完，之后缓存的批量数据被控制数据
+//      越过；字节总数完整
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <darwincore/network/protocol.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kSendPriority;
+constexpr size_t kBulkUnit = 256 * 1024;
+constexpr size_t kLeadBytes = 6 * 1024 * 1024;
+constexpr size_t kBulkBytes = 12 * 1024 * 1024;
+constexpr char kMarker[] = "CTRL";
+
+uint64_t MessageIdOf(const proto::Frame& frame) {
+  uint64_t id = 0;
+  std::memcpy(&id, frame.payload.data(), sizeof(id));
+  return id;
+}
+
+// 测试 1: 调度顺序与重组
+bool TestSchedulerOrdering() {
+  std::cout << "\n========== 测试 1: 帧调度顺序 ==========" << std::endl;
+
+  // 两条各 3 个分片的批量消息 + 一条控制消息
+  const size_t big = proto::MAX_FRAME_PAYLOAD * 2 + 100;
+  std::vector<uint8_t> a(big, 'a');
+  std::vector<uint8_t> b(big, 'b');
+  std::vector<uint8_t> c = {'p', 'i', 'n', 'g'};
+
+  proto::FrameScheduler scheduler;
+  scheduler.Enqueue(proto::Encoder::EncodeMessage(1, a.data(), a.size()));
+  scheduler.Enqueue(proto::Encoder::EncodeMessage(2, b.data(), b.size()));
+  scheduler.Enqueue(proto::Encoder::EncodeMessage(3, c.data(), c.size()), SendPriority::kControl);
+
+  const size_t frames = scheduler.PendingFrames();
+  std::vector<uint64_t> order;
+  std::vector<uint8_t> wire;
+  proto::Frame frame;
+  SendPriority priority;
+  bool control_flagged = false;
+  while (scheduler.Next(frame, &priority)) {
+    if (order.empty()) {
+      control_flagged = priority == SendPriority::kControl;
+    }
+    order.push_back(MessageIdOf(frame));
+    auto bytes = frame.Serialize();
+    wire.insert(wire.end(), bytes.begin(), bytes.end());
+  }
+
+  const std::vector<uint64_t> expected = {3, 1, 2, 1, 2, 1, 2};
+  bool ordered = frames == 7 && order == expected && control_flagged && scheduler.Empty() &&
+                 scheduler.PendingBytes() == 0;
+
+  proto::Decoder decoder;
+  decoder.Feed(wire.data(), wire.size());
+  std::unordered_map<uint64_t, std::vector<uint8_t>> messages;
+  proto::MessageComplete msg;
+  while (decoder.GetMessage(msg)) {
+    messages[msg.message_id] = msg.data;
+  }
+  bool decoded = messages.size() == 3 && messages[1] == a && messages[2] == b && messages[3] == c;
+
+  bool pass = ordered && decoded;
+  std::cout << (pass ? "[PASS]" : "[FAIL]") << " 取出顺序:";
+  for (uint64_t id : order) {
+    std::cout << " " << id;
+  }
+  std::cout << "，重组 " << messages.size() << " 条消息" << std::endl;
+  return pass;
+}
+
+// 测试 2: 积压时控制数据插队
+bool TestControlBypassesBacklog() {
+  std::cout << "\n========== 测试 2: 控制数据插队 ==========" << std::endl;
+
+  Server server;
+  std::mutex mutex;
+  std::unordered_map<uint16_t, uint64_t> port_to_connection;
+  server.SetOnClientConnected([&](const ConnectionInformation& info) {
+    std::lock_guard<std::mutex> lock(mutex);
+    port_to_connection[info.peer_port] = info.connection_id;
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return false;
+  }
+
+  // 小接收缓冲区：批量数据很快积压在服务器的发送缓冲区中
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  int rcvbuf = 64 * 1024;
+  setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(kTestPort);
+  inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    close(fd);
+    server.Stop();
+    return false;
+  }
+  sockaddr_in local{};
+  socklen_t len = sizeof(local);
+  getsockname(fd, reinterpret_cast<sockaddr*>(&local), &len);
+  uint16_t port = ntohs(local.sin_port);
+
+  uint64_t conn_id = 0;
+  WaitUntil(
+      [&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = port_to_connection.find(port);
+        conn_id = it == port_to_connection.end() ? 0 : it->second;
+        return conn_id != 0;
+      },
+      5000);
+
+  // 先积压一段批量数据，第一条控制数据建立控制通道；之后的批量数据记录发送边界，
+  // 第二条控制数据越过它们
+  std::vector<uint8_t> unit(kBulkUnit, 'b');
+  for (size_t queued = 0; queued < kLeadBytes; queued += kBulkUnit) {
+    server.SendData(conn_id, unit.data(), unit.size());
+  }
+  server.SendData(conn_id, reinterpret_cast<const uint8_t*>(kMarker), 4, SendPriority::kControl);
+  for (size_t queued = 0; queued < kBulkBytes; queued += kBulkUnit) {
+    server.SendData(conn_id, unit.data(), unit.size());
+  }
+  server.SendData(conn_id, reinterpret_cast<const uint8_t*>(kMarker), 4, SendPriority::kControl);
+  WaitUntil([&] { return server.GetStatistics().total_priority_bypasses >= 2; }, 5000);
+
+  // 读出全部数据，记录两条控制数据出现的位置
+  const size_t total = kLeadBytes + kBulkBytes + 8;
+  std::vector<uint8_t> sink(64 * 1024);
+  size_t received = 0;
+  std::vector<size_t> marker_offsets;
+  while (received < total) {
+    ssize_t ret = recv(fd, sink.data(), sink.size(), 0);
+    if (ret <= 0) {
+      break;
+    }
+    for (ssize_t i = 0; i < ret; ++i) {
+      if (sink[i] == 'C') {
+        marker_offsets.push_back(received + static_cast<size_t>(i));
+      }
+    }
+    received += static_cast<size_t>(ret);
+  }
+
+  ServerStatistics stats = server.GetStatistics();
+  close(fd);
+  server.Stop();
+
+  // 控制通道建立前的积压没有边界记录，整体写完后才插入控制数据；
+  // 之后积压的 kBulkBytes 全部被第二条控制数据越过
+  bool pass = received == total && marker_offsets.size() == 2 &&
+              marker_offsets[0] == kLeadBytes && marker_offsets[1] == marker_offsets[0] + 4 &&
+              stats.total_priority_bypasses >= 2;
+  std::cout << (pass ? "[PASS]" : "[FAIL]") << " 控制数据出现在第 "
+            << (marker_offsets.empty() ? SIZE_MAX : marker_offsets[0]) << "/"
+            << (marker_offsets.size() < 2 ? SIZE_MAX : marker_offsets[1]) << " 字节（之后积压 "
+            << kBulkBytes << " 字节），共收到 " << received << " 字节，插队 "
+            << stats.total_priority_bypasses << " 次" << std::endl;
+  return pass;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("发送优先级测试");
+
+  bool pass1 = TestSchedulerOrdering();
+  bool pass2 = TestControlBypassesBacklog();
+
+  return FinishTest({{"帧调度顺序", pass1}, {"控制数据插队", pass2}});
+}
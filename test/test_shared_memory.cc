@@ -0,0 +1,270 @@
+//
+// DarwinCore Network - 共享内存快速通道测试
+//
+// 测试场景：
+//   1. 升级后的连接：服务端欢迎语（升级前写入 socket）与回显数据按序到达
+//   2. 大块数据远超环容量：环写满后暂存、对端腾出空间后继续，数据完整
+//   3. 未开启共享内存的客户端连接同一服务端，行为不变
+//   4. ClientLoopGroup 模式下的客户端同样可以升级
+//   5. 开启共享内存的客户端连接未开启该功能的服务端：收不到确认，
+//      数据继续经 socket 发送，不会丢失
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/client_loop_group.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+const std::string kSocketPath = "/tmp/dc_shm_test.sock";
+const std::string kPlainSocketPath = "/tmp/dc_shm_test_plain.sock";
+const std::string kGreeting = "hello;";
+
+// 使用最小的环，便于覆盖环绕与写满的路径
+constexpr size_t kRingSize = 64 * 1024;
+constexpr int kMessageCount = 200;
+constexpr size_t kLargeSize = 4 * 1024 * 1024;
+
+// 收集客户端收到的全部字节
+struct Collector {
+  std::mutex mutex;
+  std::string data;
+
+  void Append(const std::vector<uint8_t>& chunk) {
+    std::lock_guard<std::mutex> lock(mutex);
+    data.append(chunk.begin(), chunk.end());
+  }
+
+  size_t Size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return data.size();
+  }
+
+  bool EndsWith(const std::string& suffix) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return data.size() >= suffix.size() &&
+           data.compare(data.size() - suffix.size(), suffix.size(), suffix) == 0;
+  }
+
+  std::string Take() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string result;
+    result.swap(data);
+    return result;
+  }
+};
+
+// 在一个已连接的客户端上回显 kMessageCount 条长度不等的消息
+bool EchoMessages(Client& client, Collector& collector) {
+  std::string expected = kGreeting;
+  for (int i = 0; i < kMessageCount; ++i) {
+    std::string message = "m" + std::to_string(i) + ":" + std::string(i % 97, 'x') + ";";
+    expected += message;
+    if (!client.SendData(reinterpret_cast<const uint8_t*>(message.data()), message.size())) {
+      std::cout << "  发送失败: " << i << std::endl;
+      return false;
+    }
+  }
+
+  WaitUntil([&] { return collector.Size() >= expected.size(); }, 10000);
+  return collector.Take() == expected;
+}
+
+// 测试 1: 升级后的连接
+bool TestUpgradedEcho(Server& server) {
+  std::cout << "\n========== 测试 1: 升级后回显 ==========" << std::endl;
+
+  Collector collector;
+  Client client;
+  client.SetSharedMemoryTransport(true, kRingSize);
+  client.SetOnMessage([&](const std::vector<uint8_t>& data) { collector.Append(data); });
+
+  if (!client.ConnectUnixDomain(kSocketPath)) {
+    std::cout << "[FAIL] 连接失败" << std::endl;
+    return false;
+  }
+  WaitUntil([&] { return client.IsConnected(); }, 2000);
+
+  bool echoed = EchoMessages(client, collector);
+  bool upgraded = server.GetStatistics().total_shm_connections == 1;
+  client.Disconnect();
+
+  std::cout << (echoed ? "[PASS]" : "[FAIL]") << " 欢迎语与 " << kMessageCount
+            << " 条回显按序到达" << std::endl;
+  std::cout << (upgraded ? "[PASS]" : "[FAIL]") << " 连接已升级为共享内存通道" << std::endl;
+  return echoed && upgraded;
+}
+
+// 测试 2: 大块数据
+bool TestLargePayload() {
+  std::cout << "\n========== 测试 2: 大块数据（远超环容量） ==========" << std::endl;
+
+  Collector collector;
+  Client client;
+  client.SetSharedMemoryTransport(true, kRingSize);
+  client.SetOnMessage([&](const std::vector<uint8_t>& data) { collector.Append(data); });
+
+  if (!client.ConnectUnixDomain(kSocketPath)) {
+    std::cout << "[FAIL] 连接失败" << std::endl;
+    return false;
+  }
+  WaitUntil([&] { return client.IsConnected(); }, 2000);
+
+  std::string payload(kLargeSize, '\0');
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<char>('a' + (i * 7 + i / 4096) % 26);
+  }
+
+  client.SendData(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+  std::string expected = kGreeting + payload;
+
+  WaitUntil([&] { return collector.Size() >= expected.size(); }, 20000);
+  bool passed = collector.Take() == expected;
+  client.Disconnect();
+
+  std::cout << (passed ? "[PASS]" : "[FAIL]") << " " << kLargeSize / 1024
+            << "KB 数据完整回显" << std::endl;
+  return passed;
+}
+
+// 测试 3: 普通客户端
+bool TestPlainClient() {
+  std::cout << "\n========== 测试 3: 未开启共享内存的客户端 ==========" << std::endl;
+
+  Collector collector;
+  Client client;
+  client.SetOnMessage([&](const std::vector<uint8_t>& data) { collector.Append(data); });
+
+  if (!client.ConnectUnixDomain(kSocketPath)) {
+    std::cout << "[FAIL] 连接失败" << std::endl;
+    return false;
+  }
+  WaitUntil([&] { return client.IsConnected(); }, 2000);
+
+  bool passed = EchoMessages(client, collector);
+  client.Disconnect();
+
+  std::cout << (passed ? "[PASS]" : "[FAIL]") << " 普通 socket 回显正确" << std::endl;
+  return passed;
+}
+
+// 测试 4: ClientLoopGroup 模式
+bool TestLoopGroupClient(Server& server) {
+  std::cout << "\n========== 测试 4: ClientLoopGroup 模式 ==========" << std::endl;
+
+  uint64_t before = server.GetStatistics().total_shm_connections;
+
+  auto group = std::make_shared<ClientLoopGroup>(1);
+  Collector collector;
+  bool passed = false;
+  {
+    Client client(group);
+    client.SetSharedMemoryTransport(true, kRingSize);
+    client.SetOnMessage([&](const std::vector<uint8_t>& data) { collector.Append(data); });
+
+    if (client.ConnectUnixDomain(kSocketPath)) {
+      WaitUntil([&] { return client.IsConnected(); }, 2000);
+      passed = EchoMessages(client, collector);
+      client.Disconnect();
+    }
+  }
+  group->Stop();
+
+  bool upgraded = server.GetStatistics().total_shm_connections == before + 1;
+  std::cout << (passed ? "[PASS]" : "[FAIL]") << " 回显正确" << std::endl;
+  std::cout << (upgraded ? "[PASS]" : "[FAIL]") << " 连接已升级为共享内存通道" << std::endl;
+  return passed && upgraded;
+}
+
+// 测试 5: 服务端未开启共享内存
+bool TestPlainServer() {
+  std::cout << "\n========== 测试 5: 服务端未开启共享内存 ==========" << std::endl;
+
+  Server plain_server;
+  plain_server.SetOnMessage([&](uint64_t conn_id, const std::vector<uint8_t>& data) {
+    plain_server.SendData(conn_id, data.data(), data.size());
+  });
+  if (!plain_server.StartUnixDomain(kPlainSocketPath)) {
+    std::cout << "[FAIL] 服务端启动失败" << std::endl;
+    return false;
+  }
+
+  Collector collector;
+  Client client;
+  client.SetSharedMemoryTransport(true, kRingSize);
+  client.SetOnMessage([&](const std::vector<uint8_t>& data) { collector.Append(data); });
+
+  bool passed = false;
+  if (client.ConnectUnixDomain(kPlainSocketPath) &&
+      WaitUntil([&] { return client.IsConnected(); }, 2000)) {
+    // 握手被服务端当作普通数据回显，其后是全部消息
+    std::string expected;
+    for (int i = 0; i < kMessageCount; ++i) {
+      std::string message = "p" + std::to_string(i) + ";";
+      expected += message;
+      client.SendData(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+    }
+    passed = WaitUntil([&] { return collector.EndsWith(expected); }, 5000);
+    client.Disconnect();
+  }
+
+  bool upgraded = plain_server.GetStatistics().total_shm_connections != 0;
+  plain_server.Stop();
+
+  std::cout << (passed ? "[PASS]" : "[FAIL]") << " " << kMessageCount
+            << " 条消息经 socket 回显" << std::endl;
+  std::cout << (!upgraded ? "[PASS]" : "[FAIL]") << " 连接未升级" << std::endl;
+  return passed && !upgraded;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("共享内存快速通道测试");
+
+  ServerOptions options;
+  options.shared_memory_transport = true;
+  Server server(options);
+
+  // 连接建立即发送欢迎语：可能早于握手写入 socket，用于验证升级前后的顺序
+  server.SetOnClientConnected([&](const ConnectionInformation& info) {
+    server.SendData(info.connection_id, reinterpret_cast<const uint8_t*>(kGreeting.data()),
+                    kGreeting.size());
+  });
+  server.SetOnMessage([&](uint64_t conn_id, const std::vector<uint8_t>& data) {
+    server.SendData(conn_id, data.data(), data.size());
+  });
+
+  if (!server.StartUnixDomain(kSocketPath)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  bool pass1 = TestUpgradedEcho(server);
+  bool pass2 = TestLargePayload();
+  bool pass3 = TestPlainClient();
+  bool pass4 = TestLoopGroupClient(server);
+  bool pass5 = TestPlainServer();
+
+  server.Stop();
+
+  return FinishTest({{"升级后回显", pass1},
+                     {"大块数据", pass2},
+                     {"普通客户端", pass3},
+                     {"共享事件循环", pass4},
+                     {"服务端未开启", pass5}});
+}
@@ -0,0 +1,267 @@
+//
+// DarwinCore Network - 流控测试
+//
+// 测试场景：
+//   1. StreamSender 只在额度内编码数据块，收到 StreamWindow 后继续；
+//      StreamReceiver 在半个窗口处交还额度，并拒绝超出窗口的数据以及未开始或已结束的流的数据
+//   2. 服务器向处理较慢的客户端发送 64MB 的流：数据完整、按序到达，
+//      已发出但接收方尚未处理的数据（内核缓冲区 + 库内队列）始终不超过一个窗口
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/protocol.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kStreamFlowControl;
+constexpr uint64_t kStreamId = 7;
+constexpr size_t kStreamBytes = 64 * 1024 * 1024;
+constexpr uint32_t kWindow = proto::DEFAULT_STREAM_WINDOW;
+
+uint8_t PatternAt(uint64_t offset) {
+  return static_cast<uint8_t>(offset * 131 + (offset >> 12));
+}
+
+proto::StreamEvent Decode(const proto::Frame& frame) {
+  proto::Decoder decoder;
+  auto bytes = frame.Serialize();
+  decoder.Feed(bytes.data(), bytes.size());
+  proto::StreamEvent event;
+  decoder.GetStreamEvent(event);
+  return event;
+}
+
+// 测试 1: 额度记账
+bool TestCreditAccounting() {
+  std::cout << "\n========== 测试 1: 额度记账 ==========" << std::endl;
+
+  std::vector<uint8_t> data(3 * kWindow, 'x');
+  proto::StreamSender sender(kWindow);
+  proto::StreamReceiver receiver(kWindow);
+  receiver.OnEvent(Decode(sender.Start(kStreamId, data.size())));
+
+  std::vector<proto::Frame> frames;
+  size_t first = sender.Write(kStreamId, data.data(), data.size(), frames);
+  size_t blocked = sender.Write(kStreamId, data.data() + first, data.size() - first, frames);
+
+  // 接收方处理完半个窗口后交还额度
+  size_t received = 0;
+  bool early_update = false;
+  proto::Frame update;
+  for (const auto& frame : frames) {
+    proto::StreamEvent event = Decode(frame);
+    receiver.OnEvent(event);
+    received += event.data.size();
+    if (received < kWindow / 2 && receiver.Consume(kStreamId, event.data.size(), update)) {
+      early_update = true;
+    }
+  }
+  bool granted = receiver.Consume(kStreamId, kWindow, update);
+  proto::StreamEvent window_event = Decode(update);
+  bool handled = sender.HandleEvent(window_event);
+  uint64_t available = sender.Available(kStreamId);
+
+  // 超出窗口发送：对端额度已用尽时再发一个数据块
+  proto::StreamSender rogue(2 * kWindow);
+  proto::StreamReceiver strict(kWindow);
+  strict.OnEvent(Decode(rogue.Start(kStreamId)));
+  std::vector<proto::Frame> rogue_frames;
+  rogue.Write(kStreamId, data.data(), 2 * kWindow, rogue_frames);
+  bool rejected = false;
+  try {
+    for (const auto& frame : rogue_frames) {
+      strict.OnEvent(Decode(frame));
+    }
+  } catch (const proto::ProtocolError&) {
+    rejected = true;
+  }
+
+  // 未开始的流与已结束的流的数据块都被拒绝
+  proto::StreamReceiver fresh(kWindow);
+  proto::Frame stray = proto::Encoder::EncodeStreamChunk(kStreamId + 1, 0, data.data(), 16);
+  bool unknown_rejected = false;
+  try {
+    fresh.OnEvent(Decode(stray));
+  } catch (const proto::ProtocolError&) {
+    unknown_rejected = true;
+  }
+  receiver.OnEvent(Decode(sender.End(kStreamId, 0)));
+  bool ended_rejected = false;
+  try {
+    receiver.OnEvent(Decode(proto::Encoder::EncodeStreamChunk(kStreamId, 0, data.data(), 16)));
+  } catch (const proto::ProtocolError&) {
+    ended_rejected = true;
+  }
+
+  bool pass = first == kWindow && blocked == 0 && received == kWindow && !early_update &&
+              granted && handled && window_event.type == proto::FrameType::StreamWindow &&
+              available == kWindow && rejected && unknown_rejected && ended_rejected;
+  std::cout << (pass ? "[PASS]" : "[FAIL]") << " 首次写入 " << first << " 字节，额度用尽后写入 "
+            << blocked << " 字节，交还额度后可写 " << available << " 字节，超额数据"
+            << (rejected ? "被拒绝" : "未被拒绝") << "，未知流数据"
+            << (unknown_rejected && ended_rejected ? "被拒绝" : "未被拒绝") << std::endl;
+  return pass;
+}
+
+// 测试 2: 慢速接收方的大流
+bool TestBoundedTransfer() {
+  std::cout << "\n========== 测试 2: 64MB 流 ==========" << std::endl;
+
+  std::vector<uint8_t> source(kStreamBytes);
+  for (size_t i = 0; i < source.size(); ++i) {
+    source[i] = PatternAt(i);
+  }
+
+  Server server;
+  std::mutex sender_mutex;
+  proto::StreamSender sender(kWindow);
+  proto::Decoder server_decoder;
+  std::atomic<uint64_t> conn_id{0};
+  size_t position = 0;
+  bool ended = false;
+  std::atomic<uint64_t> consumed{0};
+  uint64_t peak_in_flight = 0;
+
+  // 在额度内尽量多写，写完后发送结束帧
+  auto pump = [&] {
+    std::lock_guard<std::mutex> lock(sender_mutex);
+    if (ended) {
+      return;
+    }
+    std::vector<proto::Frame> frames;
+    position += sender.Write(kStreamId, source.data() + position, source.size() - position, frames);
+    peak_in_flight = std::max<uint64_t>(peak_in_flight, position - consumed.load());
+    if (position == source.size()) {
+      frames.push_back(sender.End(kStreamId));
+      ended = true;
+    }
+    for (const auto& frame : frames) {
+      auto bytes = frame.Serialize();
+      server.SendData(conn_id, bytes.data(), bytes.size());
+    }
+  };
+
+  server.SetOnClientConnected([&](const ConnectionInformation& info) { conn_id = info.connection_id; });
+  server.SetOnMessage([&](uint64_t, const std::vector<uint8_t>& data) {
+    bool credited = false;
+    {
+      std::lock_guard<std::mutex> lock(sender_mutex);
+      server_decoder.Feed(data.data(), data.size());
+      proto::StreamEvent event;
+      while (server_decoder.GetStreamEvent(event)) {
+        credited = sender.HandleEvent(event) || credited;
+      }
+    }
+    if (credited) {
+      pump();
+    }
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return false;
+  }
+
+  Client client;
+  proto::Decoder client_decoder;
+  proto::StreamReceiver receiver(kWindow);
+  std::atomic<uint64_t> received{0};
+  std::atomic<bool> intact{true};
+  std::atomic<bool> overrun{false};
+  std::atomic<bool> finished{false};
+
+  client.SetOnMessage([&](const std::vector<uint8_t>& data) {
+    try {
+      client_decoder.Feed(data.data(), data.size());
+      proto::StreamEvent event;
+      while (client_decoder.GetStreamEvent(event)) {
+        receiver.OnEvent(event);
+        if (event.type == proto::FrameType::StreamChunk) {
+          if (event.offset != received.load()) {
+            intact = false;
+          }
+          for (size_t i = 0; i < event.data.size(); i += 4096) {
+            if (event.data[i] != PatternAt(event.offset + i)) {
+              intact = false;
+            }
+          }
+          received += event.data.size();
+
+          // 模拟较慢的应用处理
+          std::this_thread::sleep_for(std::chrono::microseconds(200));
+          consumed += event.data.size();
+          proto::Frame update;
+          if (receiver.Consume(event.stream_id, event.data.size(), update)) {
+            auto bytes = update.Serialize();
+            client.SendData(bytes.data(), bytes.size());
+          }
+        } else if (event.type == proto::FrameType::StreamEnd) {
+          finished = true;
+        }
+      }
+    } catch (const proto::ProtocolError&) {
+      overrun = true;
+    }
+  });
+
+  if (!client.ConnectIPv4("127.0.0.1", kTestPort) ||
+      !WaitUntil([&] { return client.IsConnected() && conn_id != 0; }, 5000)) {
+    std::cerr << "[Client] 连接失败!" << std::endl;
+    server.Stop();
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(sender_mutex);
+    auto bytes = sender.Start(kStreamId, source.size()).Serialize();
+    server.SendData(conn_id, bytes.data(), bytes.size());
+  }
+  pump();
+
+  // 采样服务器发送缓冲区的积压
+  uint64_t peak = 0;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(120);
+  while (!finished && !overrun && std::chrono::steady_clock::now() < deadline) {
+    peak = std::max<uint64_t>(peak, server.GetStatistics().send_buffer_bytes);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  client.Disconnect();
+  server.Stop();
+
+  // 发送缓冲区中还包含每个数据块 16 字节的帧头和 16 字节的块头
+  const uint64_t buffer_bound = kWindow + 1024;
+  bool pass = finished && !overrun && intact && received == kStreamBytes &&
+              peak_in_flight <= kWindow && peak <= buffer_bound;
+  std::cout << (pass ? "[PASS]" : "[FAIL]") << " 收到 " << received << "/" << kStreamBytes
+            << " 字节，" << (intact ? "内容正确" : "内容错误") << "，在途峰值 " << peak_in_flight
+            << " 字节，发送缓冲区峰值 " << peak << " 字节（窗口 " << kWindow << "）" << std::endl;
+  return pass;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("流控测试");
+
+  bool pass1 = TestCreditAccounting();
+  bool pass2 = TestBoundedTransfer();
+
+  return FinishTest({{"额度记账", pass1}, {"有界传输", pass2}});
+}
@@ -0,0 +1,197 @@
+//
+// DarwinCore Network - UDP 数据报测试
+//
+// 测试场景：
+//   1. 回显：客户端发出的数据报被服务端按对端地址原样发回
+//   2. 超长数据报被丢弃并计数，不影响后续数据报
+//   3. 吞吐：批量发送大量小数据报，统计接收速率（仅输出，不作为判定）
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <darwincore/network/udp.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kPort = ports::kUdp;
+constexpr int kEchoCount = 1000;
+constexpr size_t kMaxDatagramSize = 512;
+constexpr int kThroughputCount = 200000;
+
+// 测试 1: 回显
+bool TestEcho(std::atomic<bool>& peer_ok) {
+  std::cout << "\n========== 测试 1: 回显 ==========" << std::endl;
+
+  std::mutex mutex;
+  std::set<std::string> received;
+
+  UdpClient client;
+  client.SetOnDatagram([&](const uint8_t* data, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    received.emplace(reinterpret_cast<const char*>(data), size);
+  });
+  if (!client.ConnectIPv4("127.0.0.1", kPort)) {
+    std::cout << "[FAIL] 连接失败" << std::endl;
+    return false;
+  }
+
+  // 分组发送，避免本机 socket 缓冲区溢出造成丢包
+  for (int i = 0; i < kEchoCount; ++i) {
+    std::string message = "echo-" + std::to_string(i);
+    client.Send(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+    if (i % 100 == 99) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+
+  WaitUntil([&] {
+    std::lock_guard<std::mutex> lock(mutex);
+    return received.size() >= static_cast<size_t>(kEchoCount);
+  }, 5000);
+
+  size_t count;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    count = received.size();
+  }
+  client.Close();
+
+  bool passed = count == static_cast<size_t>(kEchoCount);
+  std::cout << (passed ? "[PASS]" : "[FAIL]") << " 收到回显 " << count << "/" << kEchoCount
+            << std::endl;
+  std::cout << (peer_ok ? "[PASS]" : "[FAIL]") << " 回调中的对端地址为 127.0.0.1" << std::endl;
+  return passed && peer_ok;
+}
+
+// 测试 2: 超长数据报
+bool TestTruncated(UdpServer& server) {
+  std::cout << "\n========== 测试 2: 超长数据报 ==========" << std::endl;
+
+  UdpStatistics before = server.GetStatistics();
+
+  UdpClient client;
+  if (!client.ConnectIPv4("127.0.0.1", kPort)) {
+    std::cout << "[FAIL] 连接失败" << std::endl;
+    return false;
+  }
+
+  std::vector<uint8_t> oversized(kMaxDatagramSize * 2, 'x');
+  std::string tail = "after-oversized";
+  client.Send(oversized.data(), oversized.size());
+  client.Send(reinterpret_cast<const uint8_t*>(tail.data()), tail.size());
+
+  bool passed = WaitUntil([&] {
+    UdpStatistics stats = server.GetStatistics();
+    return stats.truncated_datagrams == before.truncated_datagrams + 1 &&
+           stats.datagrams_received == before.datagrams_received + 1;
+  }, 2000);
+  client.Close();
+
+  std::cout << (passed ? "[PASS]" : "[FAIL]") << " 超长数据报被丢弃，后续数据报正常接收"
+            << std::endl;
+  return passed;
+}
+
+// 测试 3: 吞吐
+bool TestThroughput(UdpServer& server, std::atomic<uint64_t>& sink_count) {
+  std::cout << "\n========== 测试 3: 吞吐 ==========" << std::endl;
+
+  UdpOptions options;
+  options.worker_count = 1;
+  UdpClient client(options);
+  if (!client.ConnectIPv4("127.0.0.1", kPort)) {
+    std::cout << "[FAIL] 连接失败" << std::endl;
+    return false;
+  }
+
+  uint8_t payload[64] = {'t'};
+  std::vector<OutgoingDatagram> batch(64);
+  for (auto& datagram : batch) {
+    datagram.data = payload;
+    datagram.size = sizeof(payload);
+  }
+
+  UdpStatistics before = server.GetStatistics();
+  uint64_t sink_before = sink_count.load();
+  auto start = std::chrono::steady_clock::now();
+
+  int sent = 0;
+  while (sent < kThroughputCount) {
+    size_t n = client.SendBatch(batch);
+    sent += static_cast<int>(n);
+    if (n < batch.size()) {
+      std::this_thread::yield();
+    }
+  }
+
+  // 等待接收端追平（允许少量内核丢包）
+  WaitUntil([&] {
+    return server.GetStatistics().datagrams_received - before.datagrams_received >=
+           static_cast<uint64_t>(kThroughputCount);
+  }, 3000);
+
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  UdpStatistics after = server.GetStatistics();
+  uint64_t received = after.datagrams_received - before.datagrams_received;
+  uint64_t batches = after.batches_dispatched - before.batches_dispatched;
+  client.Close();
+
+  WaitUntil([&] { return sink_count.load() - sink_before >= received; }, 2000);
+
+  std::cout << "  发送 " << sent << ", 接收 " << received << ", 批次 " << batches
+            << ", 丢弃 " << after.dropped_datagrams - before.dropped_datagrams << std::endl;
+  std::cout << "  接收速率: " << static_cast<uint64_t>(received / elapsed) << " 数据报/秒"
+            << std::endl;
+
+  bool passed = received > 0 && batches > 0 && batches <= received;
+  std::cout << (passed ? "[PASS]" : "[FAIL]") << " 批量接收并分发" << std::endl;
+  return passed;
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("UDP 数据报测试");
+
+  UdpOptions options;
+  options.max_datagram_size = kMaxDatagramSize;
+  UdpServer server(options);
+
+  std::atomic<bool> peer_ok{false};
+  std::atomic<uint64_t> sink_count{0};
+  server.SetOnDatagram([&](const DatagramPeer& peer, const uint8_t* data, size_t size) {
+    if (size > 5 && std::string(reinterpret_cast<const char*>(data), 5) == "echo-") {
+      peer_ok = peer.GetAddress() == "127.0.0.1" && peer.GetPort() != 0;
+      server.SendTo(peer, data, size);
+      return;
+    }
+    sink_count.fetch_add(1, std::memory_order_relaxed);
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  bool pass1 = TestEcho(peer_ok);
+  bool pass2 = TestTruncated(server);
+  bool pass3 = TestThroughput(server, sink_count);
+
+  server.Stop();
+
+  return FinishTest({{"回显", pass1}, {"超长数据报", pass2}, {"吞吐", pass3}});
+}
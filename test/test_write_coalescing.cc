@@ -0,0 +1,134 @@
+//
+// DarwinCore Network - 写合并测试
+//
+// 测试场景：
+//   1. 开启 write_coalescing 后，回调中连续发送的大量小响应按序完整到达
+//   2. 大块数据与小块数据交错发送时顺序不变（部分写入后进入发送缓冲区）
+//
+// 作者: DarwinCore Network 团队
+// 日期: 2026
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <darwincore/network/client.h>
+#include <darwincore/network/server.h>
+
+#include "test_common.hpp"
+
+using namespace darwincore::network;
+using namespace darwincore::test;
+
+namespace {
+
+constexpr uint16_t kTestPort = ports::kWriteCoalescing;
+constexpr int kResponsesPerRequest = 50;
+constexpr size_t kLargeChunkSize = 512 * 1024;
+
+// 生成第 i 个小响应（固定 8 字节，便于校验顺序）
+std::string SmallResponse(int i) {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "r%06d;", i);
+  return std::string(buf, 8);
+}
+
+}  // namespace
+
+int main() {
+  BeginTest("写合并测试");
+
+  ServerOptions options;
+  options.write_coalescing = true;
+  Server server(options);
+
+  server.SetOnMessage([&](uint64_t conn_id, const std::vector<uint8_t>& data) {
+    std::string request(data.begin(), data.end());
+    if (request.find("small") != std::string::npos) {
+      for (int i = 0; i < kResponsesPerRequest; ++i) {
+        std::string r = SmallResponse(i);
+        server.SendData(conn_id, reinterpret_cast<const uint8_t*>(r.data()), r.size());
+      }
+    }
+    if (request.find("mixed") != std::string::npos) {
+      std::vector<uint8_t> large(kLargeChunkSize, 'L');
+      std::string head = SmallResponse(-1);
+      std::string tail = SmallResponse(1);
+      server.SendData(conn_id, reinterpret_cast<const uint8_t*>(head.data()), head.size());
+      server.SendData(conn_id, large.data(), large.size());
+      server.SendData(conn_id, reinterpret_cast<const uint8_t*>(tail.data()), tail.size());
+    }
+  });
+
+  if (!server.StartIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Server] 启动失败!" << std::endl;
+    return 1;
+  }
+
+  std::mutex received_mutex;
+  std::string received;
+
+  Client client;
+  client.SetOnMessage([&](const std::vector<uint8_t>& data) {
+    std::lock_guard<std::mutex> lock(received_mutex);
+    received.append(data.begin(), data.end());
+  });
+
+  if (!client.ConnectIPv4("127.0.0.1", kTestPort)) {
+    std::cerr << "[Client] 连接失败!" << std::endl;
+    return 1;
+  }
+  WaitUntil([&] { return client.IsConnected(); }, 2000);
+
+  auto received_size = [&] {
+    std::lock_guard<std::mutex> lock(received_mutex);
+    return received.size();
+  };
+
+  // 测试 1: 大量小响应
+  std::cout << "\n========== 测试 1: 大量小响应按序到达 ==========" << std::endl;
+  const std::string small_request = "small";
+  client.SendData(reinterpret_cast<const uint8_t*>(small_request.data()), small_request.size());
+
+  std::string expected;
+  for (int i = 0; i < kResponsesPerRequest; ++i) {
+    expected += SmallResponse(i);
+  }
+
+  WaitUntil([&] { return received_size() >= expected.size(); }, 5000);
+  bool pass1;
+  {
+    std::lock_guard<std::mutex> lock(received_mutex);
+    pass1 = (received == expected);
+    received.clear();
+  }
+  std::cout << (pass1 ? "[PASS]" : "[FAIL]") << " " << kResponsesPerRequest
+            << " 个响应顺序与内容正确" << std::endl;
+
+  // 回调中连续发送的响应至少有一部分落在同一轮循环中被合并
+  uint64_t coalesced = server.GetStatistics().total_coalesced_sends;
+  bool merged = coalesced > 0;
+  std::cout << (merged ? "[PASS]" : "[FAIL]") << " 合并发送次数: " << coalesced << std::endl;
+  pass1 = pass1 && merged;
+
+  // 测试 2: 大小块交错
+  std::cout << "\n========== 测试 2: 大小块交错发送 ==========" << std::endl;
+  const std::string mixed_request = "mixed";
+  client.SendData(reinterpret_cast<const uint8_t*>(mixed_request.data()), mixed_request.size());
+
+  expected = SmallResponse(-1) + std::string(kLargeChunkSize, 'L') + SmallResponse(1);
+  WaitUntil([&] { return received_size() >= expected.size(); }, 10000);
+  bool pass2;
+  {
+    std::lock_guard<std::mutex> lock(received_mutex);
+    pass2 = (received == expected);
+  }
+  std::cout << (pass2 ? "[PASS]" : "[FAIL]") << " 交错数据顺序正确" << std::endl;
+
+  client.Disconnect();
+  server.Stop();
+
+  return FinishTest({{"小响应合并", pass1}, {"大小块交错", pass2}});
+}